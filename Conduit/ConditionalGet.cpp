@@ -0,0 +1,50 @@
+#include "ConditionalGet.h"
+
+#include <QCryptographicHash>
+#include <QHttpServerResponse>
+#include <QList>
+
+QByteArray ConditionalGet::etagFor(const QByteArray &body)
+{
+    return '"' + QCryptographicHash::hash(body, QCryptographicHash::Sha1).toHex() + '"';
+}
+
+bool ConditionalGet::matches(const QByteArray &ifNoneMatch, const QByteArray &etag)
+{
+    for (const QByteArray &candidate : ifNoneMatch.split(',')) {
+        QByteArray value = candidate.trimmed();
+        if (value.startsWith("W/")) value.remove(0, 2);
+        if (!value.isEmpty() && (value == etag || value == "*")) return true;
+    }
+    return false;
+}
+
+QHttpServerResponse ConditionalGet::apply(QHttpServerResponse &&response, const QByteArray &ifNoneMatch)
+{
+    if (response.statusCode() != QHttpServerResponse::StatusCode::Ok || response.mimeType() != "application/json") {
+        return std::move(response);
+    }
+
+    // Однакові дані -> однаковий ETag для будь-якого клієнта
+    const QByteArray etag = etagFor(response.data());
+
+    if (!ifNoneMatch.isEmpty() && matches(ifNoneMatch, etag)) {
+        QHttpServerResponse notModified(QHttpServerResponse::StatusCode::NotModified);
+        notModified.setHeader("ETag", etag);
+        notModified.setHeader("Cache-Control", "no-cache");
+        // Курсор, вік сторінки та ID запиту не входять у тіло — переносимо їх і в 304
+        for (const QByteArray &pageHeader : {QByteArrayLiteral("X-Total-Count"), QByteArrayLiteral("X-Next-Cursor"),
+                                             QByteArrayLiteral("Age"), QByteArrayLiteral("X-Cache"),
+                                             QByteArrayLiteral("X-Request-ID")}) {
+            if (response.hasHeader(pageHeader)) {
+                notModified.setHeader(pageHeader, response.headers(pageHeader).value(0));
+            }
+        }
+        return notModified;
+    }
+
+    response.setHeader("ETag", etag);
+    // no-cache: клієнт може зберігати відповідь, але зобов'язаний її перевіряти
+    response.setHeader("Cache-Control", "no-cache");
+    return std::move(response);
+}
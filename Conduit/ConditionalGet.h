@@ -0,0 +1,30 @@
+#ifndef CONDITIONALGET_H
+#define CONDITIONALGET_H
+
+#include <QByteArray>
+
+class QHttpServerResponse;
+
+/**
+ * @brief Умовний GET для JSON-відповідей Conduit: сильний ETag (SHA-1 тіла)
+ * і 304 Not Modified, якщо клієнт надіслав такий самий If-None-Match.
+ *
+ * Окремий GET і підзапит /api/batch отримують однаковий ETag для однакових даних,
+ * тож кеш валідаторів ApiClient спільний для обох шляхів.
+ */
+class ConditionalGet
+{
+public:
+    // "<sha1 hex>" у лапках
+    static QByteArray etagFor(const QByteArray& body);
+    // If-None-Match — список значень або *; слабкий W/"..." (стиснута відповідь) теж збігається
+    static bool matches(const QByteArray& ifNoneMatch, const QByteArray& etag);
+    /**
+     * @brief Додає ETag і Cache-Control: no-cache до відповіді 200 application/json
+     * або замінює її на 304 (з заголовками сторінки), якщо збігся ifNoneMatch.
+     * Решта відповідей повертається без змін.
+     */
+    static QHttpServerResponse apply(QHttpServerResponse&& response, const QByteArray& ifNoneMatch);
+};
+
+#endif // CONDITIONALGET_H
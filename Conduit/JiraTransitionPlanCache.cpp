@@ -0,0 +1,105 @@
+#include "JiraTransitionPlanCache.h"
+#include "Oracle/AppParams.h"
+#include "Oracle/Logger.h"
+
+#include <QDateTime>
+#include <QMutexLocker>
+
+namespace {
+// Контекстів задач стільки, скільки задач бачили користувачі бота; прибираємо прострочені, коли їх забагато
+const int kMaxIssueContexts = 5000;
+}
+
+JiraTransitionPlanCache& JiraTransitionPlanCache::instance()
+{
+    static JiraTransitionPlanCache self;
+    return self;
+}
+
+JiraTransitionPlanCache::JiraTransitionPlanCache()
+{
+    m_ttlMs = qMax(0, AppParams::instance().getParam("Global", "JiraTransitionPlanTtlSec", 3600).toInt()) * 1000LL;
+}
+
+JiraTransitionPlanCache::IssueContext JiraTransitionPlanCache::contextFromIssue(const QJsonObject &issue)
+{
+    const QJsonObject fields = issue["fields"].toObject();
+
+    IssueContext context;
+    context.project = fields["project"].toObject()["key"].toString();
+    context.issueType = fields["issuetype"].toObject()["id"].toString();
+    context.status = fields["status"].toObject()["id"].toString();
+    return context;
+}
+
+QString JiraTransitionPlanCache::planKey(const IssueContext &context, const QString &actionType, const QString &resolutionMethod)
+{
+    return QStringList{context.project, context.issueType, context.status, actionType, resolutionMethod}.join('|');
+}
+
+void JiraTransitionPlanCache::rememberIssues(const QJsonArray &issues)
+{
+    for (const QJsonValue& value : issues) {
+        const QJsonObject issue = value.toObject();
+        rememberIssue(issue["key"].toString(), contextFromIssue(issue));
+    }
+}
+
+void JiraTransitionPlanCache::rememberIssue(const QString &issueKey, const IssueContext &context)
+{
+    if (issueKey.isEmpty() || !context.isValid()) return;
+
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    QMutexLocker locker(&m_mutex);
+    if (m_issues.size() >= kMaxIssueContexts) pruneExpired(m_issues, nowMs);
+    m_issues.insert(issueKey, {context, nowMs + m_ttlMs});
+}
+
+bool JiraTransitionPlanCache::issueContext(const QString &issueKey, IssueContext *context) const
+{
+    QMutexLocker locker(&m_mutex);
+    auto it = m_issues.constFind(issueKey);
+    if (it == m_issues.constEnd() || it->expiresAtMs <= QDateTime::currentMSecsSinceEpoch()) return false;
+    *context = it->value;
+    return true;
+}
+
+void JiraTransitionPlanCache::forgetIssue(const QString &issueKey)
+{
+    QMutexLocker locker(&m_mutex);
+    m_issues.remove(issueKey);
+}
+
+bool JiraTransitionPlanCache::plan(const QString &key, Plan *plan) const
+{
+    QMutexLocker locker(&m_mutex);
+    auto it = m_plans.constFind(key);
+    if (it == m_plans.constEnd() || it->expiresAtMs <= QDateTime::currentMSecsSinceEpoch()) return false;
+    *plan = it->value;
+    return true;
+}
+
+void JiraTransitionPlanCache::storePlan(const QString &key, const Plan &plan)
+{
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    QMutexLocker locker(&m_mutex);
+    pruneExpired(m_plans, nowMs);
+    m_plans.insert(key, {plan, nowMs + m_ttlMs});
+}
+
+void JiraTransitionPlanCache::invalidatePlan(const QString &key)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_plans.remove(key) > 0) {
+        logDebug() << "JiraTransitionPlanCache: Invalidated plan" << key;
+    }
+}
+
+template <typename T>
+void JiraTransitionPlanCache::pruneExpired(QHash<QString, Timed<T>> &hash, qint64 nowMs)
+{
+    for (auto it = hash.begin(); it != hash.end();) {
+        if (it->expiresAtMs <= nowMs) it = hash.erase(it);
+        else ++it;
+    }
+}
@@ -0,0 +1,77 @@
+#ifndef JIRATRANSITIONPLANCACHE_H
+#define JIRATRANSITIONPLANCACHE_H
+
+#include <QObject>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QMutex>
+
+/**
+ * @brief Кеш готових планів переходів Jira для JiraWorkflowManager.
+ *
+ * План (ID переходу + поля з обраними опціями) залежить лише від проєкту, типу задачі,
+ * поточного статусу та дії, тож для однакових workflow він однаковий. Контекст задачі
+ * (проєкт/тип/статус) запам'ятовується зі списків задач бота, тому типове закриття —
+ * це один POST без GET метаданих. Якщо Jira відповіла 400, план скидається і будується заново.
+ *
+ * Налаштування (Global): JiraTransitionPlanTtlSec (3600).
+ */
+class JiraTransitionPlanCache
+{
+public:
+    struct IssueContext {
+        QString project;   // Ключ проєкту
+        QString issueType; // ID типу задачі
+        QString status;    // ID поточного статусу
+
+        bool isValid() const { return !project.isEmpty() && !issueType.isEmpty() && !status.isEmpty(); }
+    };
+
+    struct Plan {
+        QString transitionId;
+        QString transitionName;
+        QJsonObject fields; // ID поля -> {"id": ID обраної опції}
+    };
+
+    static JiraTransitionPlanCache& instance();
+
+    // Контекст з об'єкта задачі Jira (поля project, issuetype, status)
+    static IssueContext contextFromIssue(const QJsonObject& issue);
+    static QString planKey(const IssueContext& context, const QString& actionType, const QString& resolutionMethod);
+
+    // Запам'ятовує контекст задач зі сторінки пошуку (tasksArray JiraClient)
+    void rememberIssues(const QJsonArray& issues);
+    void rememberIssue(const QString& issueKey, const IssueContext& context);
+    bool issueContext(const QString& issueKey, IssueContext* context) const;
+    // Після переходу статус задачі інший — старий контекст більше не дійсний
+    void forgetIssue(const QString& issueKey);
+
+    bool plan(const QString& key, Plan* plan) const;
+    void storePlan(const QString& key, const Plan& plan);
+    void invalidatePlan(const QString& key);
+
+private:
+    JiraTransitionPlanCache();
+    ~JiraTransitionPlanCache() = default;
+
+    JiraTransitionPlanCache(const JiraTransitionPlanCache&) = delete;
+    JiraTransitionPlanCache& operator=(const JiraTransitionPlanCache&) = delete;
+
+    template <typename T>
+    struct Timed {
+        T value;
+        qint64 expiresAtMs = 0;
+    };
+
+    template <typename T>
+    static void pruneExpired(QHash<QString, Timed<T>>& hash, qint64 nowMs);
+
+private:
+    mutable QMutex m_mutex;
+    QHash<QString, Timed<Plan>> m_plans;           // planKey -> план
+    QHash<QString, Timed<IssueContext>> m_issues;  // ключ задачі -> проєкт/тип/статус
+    qint64 m_ttlMs;
+};
+
+#endif // JIRATRANSITIONPLANCACHE_H
@@ -1,5 +1,7 @@
 #include "JiraWorkflowManager.h"
 #include "../Oracle/Logger.h"
+#include "../Oracle/Metrics.h"
+#include "../Oracle/SecretCache.h"
 
 JiraWorkflowManager::JiraWorkflowManager(JiraClient* client, QObject *parent)
     : QObject(parent), m_client(client)
@@ -7,12 +9,41 @@ JiraWorkflowManager::JiraWorkflowManager(JiraClient* client, QObject *parent)
 }
 
 bool JiraWorkflowManager::performSafeTransition(const QString& baseUrl, const QString& issueKey,
-                                                const QString& userToken, const QString& actionType,
+                                                const SecureBuffer& userToken, const QString& actionType,
                                                 const QString& resolutionMethod, const QString& comment,
                                                 const QString& timeSpent, QString& outError)
 {
     logInfo() << "JiraWorkflowManager: Starting SMART transition for" << issueKey << "Action:" << actionType;
 
+    JiraTransitionPlanCache& cache = JiraTransitionPlanCache::instance();
+    const QString url = baseUrl + QString("/rest/api/2/issue/%1/transitions").arg(issueKey);
+
+    // ---------------------------------------------------------
+    // ЕТАП 0: ГОТОВИЙ ПЛАН (без GET Metadata)
+    // ---------------------------------------------------------
+    // Контекст задачі (проєкт/тип/статус) відомий зі списку задач бота, а план для нього вже будували
+    JiraTransitionPlanCache::IssueContext context;
+    JiraTransitionPlanCache::Plan plan;
+    if (cache.issueContext(issueKey, &context)) {
+        const QString planKey = JiraTransitionPlanCache::planKey(context, actionType, resolutionMethod);
+        if (cache.plan(planKey, &plan)) {
+            logInfo() << "Smart Transition: Using cached plan" << plan.transitionName << "(ID:" << plan.transitionId << ")";
+
+            int httpStatus = 0;
+            if (sendTransition(url, userToken, buildPayload(plan, comment, timeSpent), outError, &httpStatus)) {
+                cache.forgetIssue(issueKey);
+                return true;
+            }
+            if (httpStatus != 400) return false;
+
+            // 400: статус задачі або workflow змінились — план застарів, будуємо заново
+            logWarning() << "Smart Transition: Cached plan rejected by Jira (" << outError << "), rebuilding.";
+            cache.invalidatePlan(planKey);
+            cache.forgetIssue(issueKey);
+            outError.clear();
+        }
+    }
+
     // ---------------------------------------------------------
     // ЕТАП 1: РОЗВІДКА (GET Metadata)
     // ---------------------------------------------------------
@@ -20,8 +51,28 @@ bool JiraWorkflowManager::performSafeTransition(const QString& baseUrl, const QS
     if (meta.isEmpty()) return false;
 
     // ---------------------------------------------------------
-    // ЕТАП 2: ПОШУК ПЕРЕХОДУ (Find Transition ID)
+    // ЕТАП 2-3: ПОШУК ПЕРЕХОДУ ТА ЗАПОВНЕННЯ ПОЛІВ
     // ---------------------------------------------------------
+    if (!resolvePlan(meta, actionType, resolutionMethod, &plan, outError)) return false;
+
+    // План однаковий для всіх задач з тим самим проєктом, типом і статусом
+    context = JiraTransitionPlanCache::contextFromIssue(meta);
+    if (context.isValid()) {
+        cache.storePlan(JiraTransitionPlanCache::planKey(context, actionType, resolutionMethod), plan);
+    }
+
+    // ---------------------------------------------------------
+    // ЕТАП 4-5: ФОРМУВАННЯ ПАКЕТУ ТА ВІДПРАВКА
+    // ---------------------------------------------------------
+    const bool success = sendTransition(url, userToken, buildPayload(plan, comment, timeSpent), outError);
+    cache.forgetIssue(issueKey);
+    return success;
+}
+
+bool JiraWorkflowManager::resolvePlan(const QJsonObject& meta, const QString& actionType,
+                                      const QString& resolutionMethod, JiraTransitionPlanCache::Plan* plan,
+                                      QString& outError)
+{
     QStringList searchWords;
     if (actionType == "close") {
         // Слова-маркери для закриття
@@ -42,10 +93,6 @@ bool JiraWorkflowManager::performSafeTransition(const QString& baseUrl, const QS
 
     logInfo() << "Smart Transition: Found button" << transitionName << "(ID:" << transitionId << ")";
 
-    // ---------------------------------------------------------
-    // ЕТАП 3: АНАЛІЗ ПОЛІВ ТА ЗАПОВНЕННЯ (Construct Payload)
-    // ---------------------------------------------------------
-
     // Знаходимо об'єкт переходу в JSON
     QJsonObject transitionObj;
     QJsonArray transitions = meta["transitions"].toArray();
@@ -58,7 +105,6 @@ bool JiraWorkflowManager::performSafeTransition(const QString& baseUrl, const QS
 
     QJsonObject fieldsDefinition = transitionObj["fields"].toObject();
     QJsonObject fieldsPayload;
-    QJsonObject updatePayload;
 
     // Проходимось по всіх полях, які вимагає (або пропонує) цей перехід
     for (auto it = fieldsDefinition.begin(); it != fieldsDefinition.end(); ++it) {
@@ -107,9 +153,16 @@ bool JiraWorkflowManager::performSafeTransition(const QString& baseUrl, const QS
         }
     }
 
-    // ---------------------------------------------------------
-    // ЕТАП 4: ФОРМУВАННЯ ПАКЕТУ (Update Block)
-    // ---------------------------------------------------------
+    plan->transitionId = transitionId;
+    plan->transitionName = transitionName;
+    plan->fields = fieldsPayload;
+    return true;
+}
+
+QJsonObject JiraWorkflowManager::buildPayload(const JiraTransitionPlanCache::Plan& plan,
+                                              const QString& comment, const QString& timeSpent)
+{
+    QJsonObject updatePayload;
 
     // Коментар
     if (!comment.isEmpty()) {
@@ -128,33 +181,29 @@ bool JiraWorkflowManager::performSafeTransition(const QString& baseUrl, const QS
 
     // Збираємо фінальний JSON
     QJsonObject finalPayload;
-    finalPayload["transition"] = QJsonObject{{"id", transitionId}};
+    finalPayload["transition"] = QJsonObject{{"id", plan.transitionId}};
 
-    if (!fieldsPayload.isEmpty()) finalPayload["fields"] = fieldsPayload;
+    if (!plan.fields.isEmpty()) finalPayload["fields"] = plan.fields;
     if (!updatePayload.isEmpty()) finalPayload["update"] = updatePayload;
 
     logInfo() << "Smart Transition: Sending Payload:" << QJsonDocument(finalPayload).toJson(QJsonDocument::Compact);
-
-    // ---------------------------------------------------------
-    // ЕТАП 5: ВІДПРАВКА (Execute)
-    // ---------------------------------------------------------
-    QString url = baseUrl + QString("/rest/api/2/issue/%1/transitions").arg(issueKey);
-    return sendTransition(url, userToken, finalPayload, outError);
+    return finalPayload;
 }
 
 // --- ДОПОМІЖНІ МЕТОДИ ---
 
-QJsonObject JiraWorkflowManager::fetchTransitionsMeta(const QString& baseUrl, const QString& issueKey, const QString& userToken, QString& outError)
+QJsonObject JiraWorkflowManager::fetchTransitionsMeta(const QString& baseUrl, const QString& issueKey, const SecureBuffer& userToken, QString& outError)
 {
     // 1. Формуємо URL запиту
-    // Нам обов'язково треба параметр ?expand=transitions.fields, щоб Jira показала, які поля обов'язкові
-    QUrl url(baseUrl + QString("/rest/api/2/issue/%1/transitions?expand=transitions.fields").arg(issueKey));
+    // Нам обов'язково треба параметр ?expand=transitions.fields, щоб Jira показала, які поля обов'язкові.
+    // Через /issue/{key} (а не /transitions) разом з переходами приходять проєкт, тип і статус — ключ кешу плану
+    QUrl url(baseUrl + QString("/rest/api/2/issue/%1?fields=project,issuetype,status&expand=transitions.fields").arg(issueKey));
 
     QNetworkRequest request(url);
 
     // 2. Налаштовуємо заголовки
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-    request.setRawHeader("Authorization", ("Bearer " + userToken).toUtf8());
+    request.setRawHeader("Authorization", userToken.toByteArray("Bearer "));
     request.setRawHeader("X-Atlassian-Token", "no-check");
 
     // 3. Налаштовуємо SSL (ігноруємо помилки сертифікатів для локальних серверів)
@@ -168,6 +217,7 @@ QJsonObject JiraWorkflowManager::fetchTransitionsMeta(const QString& baseUrl, co
     // 4. Відправляємо GET запит
     // Використовуємо мережевий менеджер з JiraClient
     QNetworkReply* reply = m_client->networkManager()->get(request);
+    MetricsRegistry::instance().observeUpstream(reply, "jira", "fetchTransitionsMeta");
 
     // 5. СИНХРОННЕ ОЧІКУВАННЯ
     // Ми зупиняємо виконання цього методу тут, поки сервер не відповість.
@@ -238,11 +288,12 @@ QString JiraWorkflowManager::findOptionId(const QJsonObject& fieldJson, const QS
     return QString();
 }
 
-bool JiraWorkflowManager::sendTransition(const QString& url, const QString& userToken, const QJsonObject& payload, QString& outError)
+bool JiraWorkflowManager::sendTransition(const QString& url, const SecureBuffer& userToken, const QJsonObject& payload,
+                                         QString& outError, int* outHttpStatus)
 {
     QNetworkRequest request(url);
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-    request.setRawHeader("Authorization", ("Bearer " + userToken).toUtf8());
+    request.setRawHeader("Authorization", userToken.toByteArray("Bearer "));
 
     QSslConfiguration sslConfig = QSslConfiguration::defaultConfiguration();
     sslConfig.setPeerVerifyMode(QSslSocket::VerifyNone);
@@ -250,11 +301,14 @@ bool JiraWorkflowManager::sendTransition(const QString& url, const QString& user
     request.setSslConfiguration(sslConfig);
 
     QNetworkReply* reply = m_client->networkManager()->post(request, QJsonDocument(payload).toJson());
+    MetricsRegistry::instance().observeUpstream(reply, "jira", "sendTransition");
 
     QEventLoop loop;
     connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
     loop.exec();
 
+    if (outHttpStatus) *outHttpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+
     if (reply->error() != QNetworkReply::NoError) {
         // Пробуємо дістати деталі
         QString body = reply->readAll();
@@ -10,6 +10,7 @@
 
 // Підключаємо клієнта, бо менеджер буде використовувати його для запитів
 #include "../Oracle/JiraClient.h"
+#include "JiraTransitionPlanCache.h"
 
 class JiraWorkflowManager : public QObject
 {
@@ -19,12 +20,14 @@ public:
 
     /**
      * @brief Головний метод: виконує безпечний перехід, автоматично шукаючи потрібні ID.
+     * Якщо для проєкту/типу/статусу задачі вже є план у JiraTransitionPlanCache — лише один POST;
+     * на 400 план скидається і будується заново з метаданих.
      * @return true, якщо успішно, false - якщо помилка (текст помилки запишеться в outError).
      */
     bool performSafeTransition(
         const QString& baseUrl,
         const QString& issueKey,
-        const QString& userToken,
+        const SecureBuffer& userToken,
         const QString& actionType,       // "close" або "reject"
         const QString& resolutionMethod, // "visit" або "remote"
         const QString& comment,
@@ -35,9 +38,9 @@ public:
 private:
     JiraClient* m_client; // Посилання на наш існуючий JiraClient
 
-    // Робить запит GET /issue/{key}/transitions?expand=transitions.fields
+    // Робить запит GET /issue/{key}?fields=project,issuetype,status&expand=transitions.fields
     // Повертає "сирий" JSON з відповіддю Jira або порожній об'єкт при помилці.
-    QJsonObject fetchTransitionsMeta(const QString& baseUrl, const QString& issueKey, const QString& userToken, QString& outError);
+    QJsonObject fetchTransitionsMeta(const QString& baseUrl, const QString& issueKey, const SecureBuffer& userToken, QString& outError);
 
     // Шукає ID переходу, назва якого містить одне з ключових слів
     QString findTransitionId(const QJsonObject& meta, const QStringList& keywords, QString& outNameFound);
@@ -45,8 +48,16 @@ private:
     // Шукає ID опції всередині поля (наприклад, шукає "Візит" у полі "customfield_13102")
     QString findOptionId(const QJsonObject& fieldJson, const QStringList& keywords);
 
-    // Відправляє фінальний POST запит (Transition)
-    bool sendTransition(const QString& url, const QString& userToken, const QJsonObject& payload, QString& outError);
+    // Обирає перехід і опції полів за ключовими словами (план, який можна кешувати)
+    bool resolvePlan(const QJsonObject& meta, const QString& actionType, const QString& resolutionMethod,
+                     JiraTransitionPlanCache::Plan* plan, QString& outError);
+
+    // Додає до плану коментар і worklog конкретного запиту
+    QJsonObject buildPayload(const JiraTransitionPlanCache::Plan& plan, const QString& comment, const QString& timeSpent);
+
+    // Відправляє фінальний POST запит (Transition); outHttpStatus — HTTP-код відповіді Jira
+    bool sendTransition(const QString& url, const SecureBuffer& userToken, const QJsonObject& payload,
+                        QString& outError, int* outHttpStatus = nullptr);
 };
 
 #endif // JIRAWORKFLOWMANAGER_H
@@ -0,0 +1,183 @@
+#include "RateLimiter.h"
+#include "Oracle/AppParams.h"
+#include "Oracle/Logger.h"
+
+#include <QDateTime>
+#include <QMutexLocker>
+#include <QtMath>
+
+namespace {
+
+struct ClassDefaults {
+    const char* name;
+    int perMin;
+    int burst;
+    int maxInFlight;
+};
+
+// Індекс — RateLimiter::RouteClass
+const ClassDefaults kDefaults[] = {
+    {"Exempt",  0,   0,   0},
+    {"Light",   600, 120, 0},
+    {"Heavy",   60,  20,  8},
+    {"Sync",    6,   3,   2},
+    {"Tracker", 120, 30,  16},
+};
+
+}
+
+RateLimiter& RateLimiter::instance()
+{
+    static RateLimiter self;
+    return self;
+}
+
+RateLimiter::RateLimiter()
+{
+    reload();
+}
+
+void RateLimiter::reload()
+{
+    const AppParams& params = AppParams::instance();
+    QMutexLocker locker(&m_mutex);
+
+    m_enabled = params.getParam("Global", "RateLimitEnabled", true).toBool();
+    m_maxInFlightTotal = qMax(0, params.getParam("Global", "MaxInFlightTotal", 48).toInt());
+    m_pruneIntervalMs = qMax(0, params.getParam("Global", "RateLimitPruneIntervalSec", 60).toInt()) * qint64(1000);
+    for (int i = 1; i < kClassCount; ++i) {
+        const QString name = QString::fromLatin1(kDefaults[i].name);
+        const int perMin = qMax(0, params.getParam("Global", "RateLimit" + name + "PerMin", kDefaults[i].perMin).toInt());
+        const int burst = qMax(1, params.getParam("Global", "RateLimit" + name + "Burst", kDefaults[i].burst).toInt());
+        m_limits[i].perSec = perMin / 60.0;
+        m_limits[i].burst = burst;
+        m_limits[i].maxInFlight = qMax(0, params.getParam("Global", "MaxInFlight" + name, kDefaults[i].maxInFlight).toInt());
+    }
+    // Кошики зберігаємо: інакше кожна зміна налаштувань видавала б усім повний burst.
+    // Токенів не більше за новий burst; поповнення далі йде за новою швидкістю
+    for (auto it = m_buckets.begin(); it != m_buckets.end(); ++it) {
+        it->tokens = qMin(it->tokens, m_limits[it.key().section('|', 0, 0).toInt()].burst);
+    }
+
+    logInfo() << "RateLimiter:" << (m_enabled ? "enabled," : "disabled,") << "max in flight" << m_maxInFlightTotal;
+}
+
+RateLimiter::RouteClass RateLimiter::classify(const QString &route, const QString &method)
+{
+    if (route == "/" || route == "/status") return RouteClass::Exempt;
+
+    if (route.startsWith("/api/bot/redmine") || route.startsWith("/api/bot/jira") || route.startsWith("/api/bot/tasks")) {
+        return RouteClass::Tracker;
+    }
+    if (route == "/api/connections/test" || (method == "POST" && route.endsWith("/sync"))) {
+        return RouteClass::Sync;
+    }
+    if (route == "/api/objects" || route == "/api/objects/info" || route.startsWith("/api/stations/")
+        || route == "/api/dashboard" || route.contains("/station/")
+        || route.endsWith("/stations") || route.endsWith("/workplaces")
+        || (method == "GET" && route == "/api/export-tasks")) {
+        return RouteClass::Heavy;
+    }
+    return RouteClass::Light;
+}
+
+QString RateLimiter::className(RouteClass routeClass)
+{
+    return QString::fromLatin1(kDefaults[classIndex(routeClass)].name).toLower();
+}
+
+RateLimiter::Decision RateLimiter::admit(const QString &identity, RouteClass routeClass)
+{
+    Decision decision;
+    if (routeClass == RouteClass::Exempt) return decision;
+
+    const int index = classIndex(routeClass);
+    QMutexLocker locker(&m_mutex);
+    if (!m_enabled) {
+        ++m_inFlight[index];
+        ++m_inFlightTotal;
+        return decision;
+    }
+
+    const Limits& limits = m_limits[index];
+
+    // 1. Перевантаження: скидаємо одразу, до витрати токенів особи
+    if ((m_maxInFlightTotal > 0 && m_inFlightTotal >= m_maxInFlightTotal)
+        || (limits.maxInFlight > 0 && m_inFlight[index] >= limits.maxInFlight)) {
+        decision.allowed = false;
+        decision.overloaded = true;
+        decision.retryAfterSec = 1;
+        return decision;
+    }
+
+    // 2. Token bucket особи в цьому класі
+    if (!takeToken(identity, index, &decision)) return decision;
+
+    ++m_inFlight[index];
+    ++m_inFlightTotal;
+    return decision;
+}
+
+RateLimiter::Decision RateLimiter::charge(const QString &identity, RouteClass routeClass)
+{
+    Decision decision;
+    if (routeClass == RouteClass::Exempt) return decision;
+
+    QMutexLocker locker(&m_mutex);
+    if (m_enabled) takeToken(identity, classIndex(routeClass), &decision);
+    return decision;
+}
+
+bool RateLimiter::takeToken(const QString &identity, int index, Decision *decision)
+{
+    const Limits& limits = m_limits[index];
+    if (limits.perSec <= 0) return true;
+
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    if (nowMs - m_lastPruneMs >= m_pruneIntervalMs) pruneBuckets(nowMs);
+
+    const QString key = QString::number(index) + '|' + identity;
+    auto it = m_buckets.find(key);
+    if (it == m_buckets.end()) {
+        it = m_buckets.insert(key, Bucket{limits.burst, nowMs});
+    } else {
+        it->tokens = qMin(limits.burst, it->tokens + (nowMs - it->updatedMs) / 1000.0 * limits.perSec);
+        it->updatedMs = nowMs;
+    }
+
+    if (it->tokens < 1.0) {
+        decision->allowed = false;
+        decision->retryAfterSec = qMax(1, qCeil((1.0 - it->tokens) / limits.perSec));
+        return false;
+    }
+    it->tokens -= 1.0;
+    return true;
+}
+
+int RateLimiter::bucketCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return int(m_buckets.size());
+}
+
+void RateLimiter::release(RouteClass routeClass)
+{
+    if (routeClass == RouteClass::Exempt) return;
+
+    const int index = classIndex(routeClass);
+    QMutexLocker locker(&m_mutex);
+    if (m_inFlight[index] > 0) --m_inFlight[index];
+    if (m_inFlightTotal > 0) --m_inFlightTotal;
+}
+
+void RateLimiter::pruneBuckets(qint64 nowMs)
+{
+    m_lastPruneMs = nowMs;
+    // Кошик, що встиг наповнитись повністю, нічим не відрізняється від нового — його можна забути
+    for (auto it = m_buckets.begin(); it != m_buckets.end();) {
+        const Limits& limits = m_limits[it.key().section('|', 0, 0).toInt()];
+        const qint64 refillMs = limits.perSec > 0 ? qint64(limits.burst / limits.perSec * 1000) : 0;
+        if (nowMs - it->updatedMs >= refillMs) it = m_buckets.erase(it);
+        else ++it;
+    }
+}
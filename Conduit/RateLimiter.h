@@ -0,0 +1,95 @@
+#ifndef RATELIMITER_H
+#define RATELIMITER_H
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+/**
+ * @brief Обмеження навантаження на Conduit: token bucket на кожну особу (сесія Gandalf,
+ * системний бот, користувач Telegram, для анонімних — IP) і клас маршруту, плюс ліміт
+ * одночасних запитів у роботі.
+ *
+ * Обробники чекають на трекери у вкладених QEventLoop, тож поки один запит чекає, інші
+ * виконуються і звертаються до єдиного з'єднання з БД. Ліміт "у роботі" відсікає зайве
+ * до того, як черга до БД розтягне час відповіді для всіх: понад ліміт — 503, понад
+ * швидкість особи — 429. В обох випадках Retry-After каже, коли повторити.
+ *
+ * Налаштування (Global, APP_SETTINGS), <Class> — Light, Heavy, Sync, Tracker:
+ * RateLimitEnabled (true), RateLimit<Class>PerMin і RateLimit<Class>Burst (0 — без ліміту),
+ * MaxInFlight<Class> і MaxInFlightTotal (0 — без ліміту), RateLimitPruneIntervalSec (60) — як часто
+ * прибирати кошики осіб, що давно не заходили. Значення перечитуються через reload()
+ * без скидання кошиків: запаси токенів лише обрізаються до нового burst.
+ */
+class RateLimiter
+{
+public:
+    enum class RouteClass {
+        Exempt,   // Службові маршрути (/, /status) — не обмежуються
+        Light,    // Дешеві читання і звичайні зміни; сам /api/batch (підзапити — кожен у своєму класі)
+        Heavy,    // Великі вибірки: об'єкти, довідник АЗС, дашборд, дані АЗС
+        Sync,     // Синхронізація клієнта і перевірка з'єднань — робота в іншій БД
+        Tracker   // Проксі до Jira / Redmine
+    };
+
+    struct Decision {
+        bool allowed = true;
+        bool overloaded = false;  // true — 503 (сервер перевантажений), false — 429 (ліміт особи)
+        int retryAfterSec = 0;
+    };
+
+    static RateLimiter& instance();
+
+    // Перечитує ліміти з AppParams (після зміни налаштувань)
+    void reload();
+    bool isEnabled() const { return m_enabled; }
+
+    static RouteClass classify(const QString& route, const QString& method);
+    static QString className(RouteClass routeClass);
+
+    // Рішення для запиту; якщо допущено, після обробки потрібно викликати release()
+    Decision admit(const QString& identity, RouteClass routeClass);
+    void release(RouteClass routeClass);
+    // Лише токен особи в класі, без місця "у роботі": підзапит /api/batch виконується всередині пакета
+    Decision charge(const QString& identity, RouteClass routeClass);
+
+    // Кількість кошиків осіб (діагностика)
+    int bucketCount() const;
+
+private:
+    RateLimiter();
+    ~RateLimiter() = default;
+
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+
+    struct Limits {
+        double perSec = 0;   // Швидкість поповнення; 0 — ліміту швидкості немає
+        double burst = 0;
+        int maxInFlight = 0;
+    };
+    struct Bucket {
+        double tokens = 0;
+        qint64 updatedMs = 0;
+    };
+
+    static int classIndex(RouteClass routeClass) { return static_cast<int>(routeClass); }
+    // Знімає токен з кошика особи (під m_mutex); false — токенів немає, decision заповнено
+    bool takeToken(const QString& identity, int index, Decision* decision);
+    void pruneBuckets(qint64 nowMs);
+
+private:
+    static const int kClassCount = 5;
+
+    mutable QMutex m_mutex;
+    bool m_enabled = true;
+    Limits m_limits[kClassCount];
+    int m_maxInFlightTotal = 0;
+    int m_inFlight[kClassCount] = {};
+    int m_inFlightTotal = 0;
+    QHash<QString, Bucket> m_buckets; // "<клас>|<особа>" -> кошик
+    qint64 m_pruneIntervalMs = 60 * 1000;
+    qint64 m_lastPruneMs = 0;
+};
+
+#endif // RATELIMITER_H
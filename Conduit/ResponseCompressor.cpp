@@ -0,0 +1,187 @@
+#include "ResponseCompressor.h"
+#include "Oracle/AppParams.h"
+#include "Oracle/Metrics.h"
+
+#include <QHttpServerResponse>
+#include <QList>
+
+#ifdef CONDUIT_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace {
+
+// Заголовки, які маршрути та afterRequest виставляють відповіді; apply() переносить їх
+// у стиснуту копію (Content-Type задає конструктор, ETag — окремо, як слабкий)
+const QByteArray kCarriedResponseHeaders[] = {
+    "Cache-Control", "Vary", "X-Cache", "X-Total-Count", "X-Next-Cursor", "Age", "Retry-After", "X-Request-ID"
+};
+
+#ifdef CONDUIT_HAVE_ZLIB
+// z_stream, що живе весь час роботи потоку: deflateInit2 (виділення ~256 КБ) — лише один раз
+struct DeflateContext {
+    z_stream stream{};
+    bool initialized = false;
+
+    ~DeflateContext()
+    {
+        if (initialized) deflateEnd(&stream);
+    }
+
+    bool begin(int level, int windowBits)
+    {
+        if (initialized) return deflateReset(&stream) == Z_OK;
+        initialized = deflateInit2(&stream, level, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+        return initialized;
+    }
+};
+
+QByteArray deflateWith(DeflateContext& context, int level, int windowBits, const QByteArray& data)
+{
+    if (!context.begin(level, windowBits)) return QByteArray();
+
+    QByteArray out(qsizetype(deflateBound(&context.stream, uLong(data.size()))), Qt::Uninitialized);
+    context.stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.constData()));
+    context.stream.avail_in = uInt(data.size());
+    context.stream.next_out = reinterpret_cast<Bytef*>(out.data());
+    context.stream.avail_out = uInt(out.size());
+
+    if (deflate(&context.stream, Z_FINISH) != Z_STREAM_END) return QByteArray();
+    out.resize(qsizetype(context.stream.total_out));
+    return out;
+}
+#endif
+
+}
+
+ResponseCompressor& ResponseCompressor::instance()
+{
+    static ResponseCompressor self;
+    return self;
+}
+
+ResponseCompressor::ResponseCompressor()
+{
+    m_level = qBound(0, AppParams::instance().getParam("Global", "CompressionLevel", 6).toInt(), 9);
+    m_minBytes = qMax(0, AppParams::instance().getParam("Global", "CompressionMinBytes", 1024).toInt());
+}
+
+ResponseCompressor::Encoding ResponseCompressor::negotiate(const QByteArray &acceptEncoding) const
+{
+    if (!isEnabled() || acceptEncoding.isEmpty()) return Encoding::Identity;
+
+    // "gzip;q=1.0, deflate;q=0.5, *;q=0": -1 — кодування не згадане
+    double gzipQ = -1, deflateQ = -1, anyQ = -1;
+    for (const QByteArray& item : acceptEncoding.split(',')) {
+        const QList<QByteArray> parts = item.split(';');
+        const QByteArray name = parts.first().trimmed().toLower();
+        double q = 1.0;
+        for (int i = 1; i < parts.size(); ++i) {
+            const QByteArray param = parts.at(i).trimmed();
+            if (param.startsWith("q=")) q = param.mid(2).toDouble();
+        }
+        if (name == "gzip" || name == "x-gzip") gzipQ = q;
+        else if (name == "deflate") deflateQ = q;
+        else if (name == "*") anyQ = q;
+    }
+    if (gzipQ < 0) gzipQ = anyQ;
+    if (deflateQ < 0) deflateQ = anyQ;
+
+#ifdef CONDUIT_HAVE_ZLIB
+    if (gzipQ > 0 && gzipQ >= deflateQ) return Encoding::Gzip;
+#endif
+    if (deflateQ > 0) return Encoding::Deflate;
+    return Encoding::Identity;
+}
+
+QByteArray ResponseCompressor::compress(const QByteArray &data, Encoding encoding) const
+{
+    switch (encoding) {
+    case Encoding::Identity:
+        return QByteArray();
+#ifdef CONDUIT_HAVE_ZLIB
+    case Encoding::Gzip: {
+        thread_local DeflateContext gzipContext;
+        return deflateWith(gzipContext, m_level, 15 + 16, data); // +16 — обгортка gzip
+    }
+    case Encoding::Deflate: {
+        thread_local DeflateContext zlibContext;
+        return deflateWith(zlibContext, m_level, 15, data);
+    }
+#else
+    case Encoding::Gzip:
+        return QByteArray();
+    case Encoding::Deflate: {
+        // HTTP "deflate" — це потік zlib; qCompress дає його ж із 4-байтовим префіксом довжини
+        const QByteArray compressed = qCompress(data, m_level);
+        return compressed.size() > 4 ? compressed.mid(4) : QByteArray();
+    }
+#endif
+    }
+    return QByteArray();
+}
+
+QHttpServerResponse ResponseCompressor::apply(QHttpServerResponse &&response, const QByteArray &acceptEncoding) const
+{
+    const QByteArray body = response.data();
+    if (!isEnabled() || body.size() < m_minBytes || !isCompressibleType(response.mimeType())
+        || response.hasHeader("Content-Encoding")) {
+        return std::move(response);
+    }
+
+    // Тіло залежить від Accept-Encoding — проміжні кеші мають це враховувати
+    response.setHeader("Vary", "Accept-Encoding");
+
+    const Encoding encoding = negotiate(acceptEncoding);
+    if (encoding == Encoding::Identity) {
+        return std::move(response);
+    }
+
+    MetricsRegistry& metrics = MetricsRegistry::instance();
+    static Histogram& duration = metrics.histogram("conduit_http_compression_duration_seconds",
+                                                   "Time spent compressing HTTP responses.");
+    QByteArray compressed;
+    {
+        MetricsTimer timer(duration);
+        compressed = compress(body, encoding);
+    }
+    // Вже стиснуті або випадкові дані можуть "вирости" — тоді віддаємо як є
+    if (compressed.isEmpty() || compressed.size() >= body.size()) {
+        return std::move(response);
+    }
+
+    QHttpServerResponse encoded(response.mimeType(), compressed, response.statusCode());
+    for (const QByteArray &name : kCarriedResponseHeaders) {
+        for (const QByteArray &value : response.headers(name)) {
+            encoded.addHeader(name, value);
+        }
+    }
+    const QByteArray etag = response.headers("ETag").value(0);
+    if (!etag.isEmpty()) {
+        encoded.setHeader("ETag", etag.startsWith("W/") ? etag : "W/" + etag);
+    }
+    const QByteArray name = encodingName(encoding);
+    encoded.setHeader("Content-Encoding", name);
+
+    const MetricLabels labels = {{"encoding", QString::fromLatin1(name)}};
+    metrics.counter("conduit_http_compressed_responses_total", "HTTP responses sent compressed.", labels).inc();
+    metrics.counter("conduit_http_compression_saved_bytes_total",
+                    "Bytes not sent thanks to response compression.", labels).inc(quint64(body.size() - compressed.size()));
+    return encoded;
+}
+
+QByteArray ResponseCompressor::encodingName(Encoding encoding)
+{
+    switch (encoding) {
+    case Encoding::Gzip:    return "gzip";
+    case Encoding::Deflate: return "deflate";
+    case Encoding::Identity: break;
+    }
+    return "identity";
+}
+
+bool ResponseCompressor::isCompressibleType(const QByteArray &mimeType)
+{
+    return mimeType.startsWith("application/json") || mimeType.startsWith("text/")
+           || mimeType.startsWith("application/javascript") || mimeType.startsWith("application/xml");
+}
@@ -0,0 +1,56 @@
+#ifndef RESPONSECOMPRESSOR_H
+#define RESPONSECOMPRESSOR_H
+
+#include <QByteArray>
+
+class QHttpServerResponse;
+
+/**
+ * @brief Стиснення тіла відповіді Conduit (Content-Encoding: gzip / deflate).
+ *
+ * Кодування обирається за Accept-Encoding клієнта (з урахуванням q=0). Тіла, менші за поріг,
+ * не стискаються — заголовки і час CPU там дорожчі за виграш. Контекст zlib (z_stream) свій
+ * у кожного потоку й перевикористовується через deflateReset, а не створюється на кожну відповідь.
+ *
+ * Без zlib (CONDUIT_HAVE_ZLIB не визначено) доступний лише deflate через qCompress.
+ *
+ * Налаштування (Global): CompressionLevel (6; 0 — вимкнено), CompressionMinBytes (1024).
+ */
+class ResponseCompressor
+{
+public:
+    enum class Encoding { Identity, Gzip, Deflate };
+
+    static ResponseCompressor& instance();
+
+    bool isEnabled() const { return m_level > 0; }
+    int minBytes() const { return m_minBytes; }
+
+    // Найкраще кодування, дозволене заголовком Accept-Encoding (gzip має перевагу)
+    Encoding negotiate(const QByteArray& acceptEncoding) const;
+    // Стиснуте тіло; порожнє — стиснути не вдалося (відповідь піде як є)
+    QByteArray compress(const QByteArray& data, Encoding encoding) const;
+    /**
+     * @brief Стискає тіло відповіді, якщо клієнт це дозволяє (Accept-Encoding) і тіло більше за поріг.
+     * Відомі заголовки переносяться в стиснуту копію; ETag стає слабким: байти на дроті інші,
+     * але дані ті самі (як у nginx).
+     */
+    QHttpServerResponse apply(QHttpServerResponse&& response, const QByteArray& acceptEncoding) const;
+
+    static QByteArray encodingName(Encoding encoding);
+    // JSON і текст стискаються добре; зображення, архіви тощо — ні
+    static bool isCompressibleType(const QByteArray& mimeType);
+
+private:
+    ResponseCompressor();
+    ~ResponseCompressor() = default;
+
+    ResponseCompressor(const ResponseCompressor&) = delete;
+    ResponseCompressor& operator=(const ResponseCompressor&) = delete;
+
+private:
+    int m_level;
+    int m_minBytes;
+};
+
+#endif // RESPONSECOMPRESSOR_H
@@ -0,0 +1,16 @@
+#include "RoutePattern.h"
+
+bool RoutePattern::match(const QString &pattern, const QString &path, QStringList *args)
+{
+    const QStringList patternSegments = pattern.split('/', Qt::SkipEmptyParts);
+    const QStringList pathSegments = path.split('/', Qt::SkipEmptyParts);
+    if (patternSegments.size() != pathSegments.size()) return false;
+
+    QStringList matched;
+    for (int i = 0; i < patternSegments.size(); ++i) {
+        if (patternSegments.at(i) == "<arg>") matched << pathSegments.at(i);
+        else if (patternSegments.at(i) != pathSegments.at(i)) return false;
+    }
+    if (args) *args = matched;
+    return true;
+}
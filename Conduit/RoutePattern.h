@@ -0,0 +1,20 @@
+#ifndef ROUTEPATTERN_H
+#define ROUTEPATTERN_H
+
+#include <QStringList>
+
+/**
+ * @brief Зіставлення шляху з шаблоном маршруту у форматі QHttpServer ("/api/clients/<arg>").
+ *
+ * Потрібне там, де маршрутизатор QHttpServer недоступний, — для підзапитів /api/batch.
+ * Сегменти порівнюються поштучно, порожні (подвійний чи кінцевий "/") ігноруються;
+ * "<arg>" збігається з будь-яким сегментом і потрапляє в args у порядку появи.
+ */
+class RoutePattern
+{
+public:
+    // true — шлях відповідає шаблону; args (якщо задано) отримує значення <arg>
+    static bool match(const QString& pattern, const QString& path, QStringList* args = nullptr);
+};
+
+#endif // ROUTEPATTERN_H
@@ -0,0 +1,146 @@
+#include "TrackerIssueCache.h"
+#include "Oracle/AppParams.h"
+#include "Oracle/Logger.h"
+
+#include <QDateTime>
+#include <QEventLoop>
+#include <QNetworkReply>
+
+int TrackerIssueCache::Page::ageSec() const
+{
+    return fetchedAtMs > 0 ? int((QDateTime::currentMSecsSinceEpoch() - fetchedAtMs) / 1000) : 0;
+}
+
+TrackerIssueCache::TrackerIssueCache(QObject *parent)
+    : QObject(parent)
+{
+    m_ttlMs = qMax(0, AppParams::instance().getParam("Global", "TrackerCacheTtlSec", 60).toInt()) * 1000LL;
+    m_refreshAheadMs = qMax(0, AppParams::instance().getParam("Global", "TrackerCacheRefreshAheadSec", 45).toInt()) * 1000LL;
+}
+
+QString TrackerIssueCache::pageKey(const QString &tracker, int terminalId, int cursor, int limit)
+{
+    return QString("%1|%2|%3|%4").arg(tracker).arg(terminalId).arg(cursor).arg(limit);
+}
+
+bool TrackerIssueCache::get(int userId, const QString &key, const StartFn &start, const ReadFn &read,
+                            Page *page, ApiError *error)
+{
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+
+    auto userIt = m_pages.constFind(userId);
+    if (userIt != m_pages.constEnd()) {
+        auto it = userIt->constFind(key);
+        if (it != userIt->constEnd() && nowMs - it->fetchedAtMs < m_ttlMs) {
+            *page = it.value();
+            page->fromCache = true;
+
+            // Refresh-ahead: користувач отримує кеш одразу, а свіжі дані підтягуються для наступного запиту
+            if (nowMs - it->fetchedAtMs >= m_refreshAheadMs) {
+                refreshInBackground(userId, key, start, read);
+            }
+            return true;
+        }
+    }
+
+    const quint64 generation = m_generations.value(userId);
+    const quint64 globalGeneration = m_globalGeneration;
+    if (!fetchBlocking(start, read, page, error)) {
+        return false;
+    }
+    // Поки чекали на трекер, користувач міг щось записати (або кеш скинули для всіх) — таку сторінку не кешуємо
+    if (m_generations.value(userId) == generation && m_globalGeneration == globalGeneration) {
+        store(userId, key, *page);
+    }
+    return true;
+}
+
+void TrackerIssueCache::invalidateUser(int userId)
+{
+    m_generations[userId] += 1;
+    if (m_pages.remove(userId) > 0) {
+        logDebug() << "TrackerIssueCache: Invalidated task lists of user" << userId;
+    }
+}
+
+void TrackerIssueCache::invalidateAll()
+{
+    // Загальне покоління зачіпає й користувачів, чий перший запит ще чекає на трекер
+    m_globalGeneration += 1;
+    m_pages.clear();
+    logDebug() << "TrackerIssueCache: Invalidated task lists of all users";
+}
+
+bool TrackerIssueCache::fetchBlocking(const StartFn &start, const ReadFn &read, Page *page, ApiError *error)
+{
+    QObject scope;
+    QNetworkReply* reply = start(&scope);
+    if (!reply) {
+        error->errorString = "Tracker client failed to initiate fetch (check URL/Token).";
+        error->httpStatusCode = 500;
+        return false;
+    }
+
+    // !!! Блокування та очікування відповіді трекера (як і раніше в обробниках WebServer) !!!
+    QEventLoop loop;
+    connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
+    loop.exec();
+
+    *page = Page();
+    if (!read(reply, page, error)) {
+        return false;
+    }
+    page->fetchedAtMs = QDateTime::currentMSecsSinceEpoch();
+    return true;
+}
+
+void TrackerIssueCache::refreshInBackground(int userId, const QString &key, const StartFn &start, const ReadFn &read)
+{
+    const QString refreshKey = QString::number(userId) + "|" + key;
+    if (m_refreshing.contains(refreshKey)) return;
+
+    // scope живе до кінця запиту і забирає з собою клієнта трекера разом з відповіддю
+    QObject* scope = new QObject(this);
+    QNetworkReply* reply = start(scope);
+    if (!reply) {
+        delete scope;
+        return;
+    }
+
+    m_refreshing.insert(refreshKey);
+    const quint64 generation = m_generations.value(userId);
+    const quint64 globalGeneration = m_globalGeneration;
+
+    connect(reply, &QNetworkReply::finished, this, [this, reply, scope, userId, key, refreshKey, read,
+                                                    generation, globalGeneration]() {
+        m_refreshing.remove(refreshKey);
+
+        Page page;
+        ApiError error;
+        if (read(reply, &page, &error)) {
+            if (m_generations.value(userId) == generation && m_globalGeneration == globalGeneration) {
+                page.fetchedAtMs = QDateTime::currentMSecsSinceEpoch();
+                store(userId, key, page);
+            }
+        } else {
+            logWarning() << "TrackerIssueCache: Background refresh failed for user" << userId << ":" << error.errorString;
+        }
+        scope->deleteLater();
+    });
+}
+
+void TrackerIssueCache::store(int userId, const QString &key, const Page &page)
+{
+    QHash<QString, Page>& pages = m_pages[userId];
+
+    // Заодно прибираємо протерміновані сторінки користувача
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    for (auto it = pages.begin(); it != pages.end();) {
+        if (nowMs - it->fetchedAtMs >= m_ttlMs) it = pages.erase(it);
+        else ++it;
+    }
+
+    Page stored = page;
+    stored.fromCache = false;
+    pages.insert(key, stored);
+}
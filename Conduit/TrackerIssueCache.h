@@ -0,0 +1,72 @@
+#ifndef TRACKERISSUECACHE_H
+#define TRACKERISSUECACHE_H
+
+#include "Oracle/ApiClient.h" // ApiError
+
+#include <QObject>
+#include <QHash>
+#include <QJsonArray>
+#include <QSet>
+#include <functional>
+
+class QNetworkReply;
+
+/**
+ * @brief Кеш списків задач Jira/Redmine кожного користувача (для /api/bot/jira/tasks і /api/bot/redmine/tasks).
+ *
+ * Сторінка, молодша за TTL, віддається одразу, без походу в трекер. Якщо вона старша
+ * за поріг refresh-ahead, паралельно запускається фонове оновлення, і наступний запит
+ * отримує вже свіжі дані. Записи WebServer (призначення, звіт, коментар) скидають кеш користувача.
+ *
+ * Налаштування (Global): TrackerCacheTtlSec (60), TrackerCacheRefreshAheadSec (45).
+ */
+class TrackerIssueCache : public QObject
+{
+    Q_OBJECT
+public:
+    struct Page {
+        QJsonArray items;
+        int total = 0;
+        int nextCursor = -1;      // -1 — наступної сторінки немає
+        qint64 fetchedAtMs = 0;
+        bool fromCache = false;
+
+        int ageSec() const;
+    };
+
+    // Запускає запит до трекера; клієнт створюється з батьком scope і живе до кінця запиту
+    using StartFn = std::function<QNetworkReply*(QObject* scope)>;
+    // Читає сторінку з властивостей завершеної відповіді клієнта
+    using ReadFn = std::function<bool(QNetworkReply* reply, Page* page, ApiError* error)>;
+
+    explicit TrackerIssueCache(QObject *parent = nullptr);
+
+    static QString pageKey(const QString& tracker, int terminalId, int cursor, int limit);
+
+    /**
+     * @brief Повертає сторінку з кешу або (якщо її немає чи вона протермінована) чекає на трекер.
+     * @return false, якщо трекер відповів помилкою (деталі в error).
+     */
+    bool get(int userId, const QString& key, const StartFn& start, const ReadFn& read,
+             Page* page, ApiError* error);
+
+    // Скидає всі сторінки користувача (після наших записів у трекер)
+    void invalidateUser(int userId);
+    // Скидає сторінки всіх користувачів (облікові дані трекерів змінено ззовні)
+    void invalidateAll();
+
+private:
+    bool fetchBlocking(const StartFn& start, const ReadFn& read, Page* page, ApiError* error);
+    void refreshInBackground(int userId, const QString& key, const StartFn& start, const ReadFn& read);
+    void store(int userId, const QString& key, const Page& page);
+
+private:
+    QHash<int, QHash<QString, Page>> m_pages; // userId -> ключ сторінки -> сторінка
+    QHash<int, quint64> m_generations;         // Зростає при invalidateUser: старі фонові відповіді відкидаються
+    quint64 m_globalGeneration = 0;            // Зростає при invalidateAll: так само для всіх користувачів
+    QSet<QString> m_refreshing;                // "userId|key", для яких уже йде фонове оновлення
+    qint64 m_ttlMs;
+    qint64 m_refreshAheadMs;
+};
+
+#endif // TRACKERISSUECACHE_H
@@ -0,0 +1,182 @@
+#include "TrackerTaskGraph.h"
+#include "Oracle/Logger.h"
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QNetworkReply>
+
+TrackerTaskGraph::TrackerTaskGraph(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void TrackerTaskGraph::addStep(const QString &name, const QStringList &dependsOn,
+                               const StartFn &start, const ReadFn &read, bool required)
+{
+    Step step;
+    step.name = name;
+    step.dependsOn = dependsOn;
+    step.start = start;
+    step.read = read;
+    step.required = required;
+    m_steps.append(step);
+}
+
+TrackerTaskGraph::ReadFn TrackerTaskGraph::httpSuccess()
+{
+    return [](QNetworkReply* reply, Results*, ApiError* error) {
+        const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        if (reply->error() == QNetworkReply::NoError && status >= 200 && status < 300) {
+            return true;
+        }
+        *error = reply->property("errorDetails").value<ApiError>();
+        if (error->errorString.isEmpty()) {
+            error->errorString = reply->error() != QNetworkReply::NoError
+                                     ? "Network error: " + reply->errorString()
+                                     : "Tracker error: " + QString::fromUtf8(reply->readAll());
+        }
+        if (error->httpStatusCode == 0) {
+            error->httpStatusCode = status > 0 ? status : 502;
+        }
+        return false;
+    };
+}
+
+int TrackerTaskGraph::indexOf(const QString &name) const
+{
+    for (int i = 0; i < m_steps.size(); ++i) {
+        if (m_steps[i].name == name) return i;
+    }
+    return -1;
+}
+
+void TrackerTaskGraph::start()
+{
+    if (m_started) return;
+    m_started = true;
+    schedule();
+}
+
+bool TrackerTaskGraph::wait()
+{
+    start();
+
+    QElapsedTimer timer;
+    timer.start();
+    // finishStep виходить з циклу, коли не лишилось кроків у роботі
+    if (m_running > 0) m_loop.exec();
+
+    logDebug() << "TrackerTaskGraph:" << m_steps.size() << "step(s) finished in" << timer.elapsed() << "ms";
+    return requiredError().errorString.isEmpty();
+}
+
+void TrackerTaskGraph::schedule()
+{
+    // Повторюємо, поки щось змінюється: пропуск кроку може зробити "готовими до пропуску" залежні від нього
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int i = 0; i < m_steps.size(); ++i) {
+            Step& step = m_steps[i];
+            if (step.state != State::Pending) continue;
+
+            bool ready = true;
+            QString blockedBy;
+            for (const QString& dependency : step.dependsOn) {
+                const int depIndex = indexOf(dependency);
+                if (depIndex < 0) {
+                    blockedBy = dependency;
+                    break;
+                }
+                const Step& dep = m_steps[depIndex];
+                const bool depFinished = dep.state == State::Succeeded || dep.state == State::Failed || dep.state == State::Skipped;
+                // Невдача необов'язкового кроку не блокує залежних: вони лише чекають на його завершення
+                if (dep.required && (dep.state == State::Failed || dep.state == State::Skipped)) {
+                    blockedBy = dependency;
+                    break;
+                }
+                if (!depFinished) ready = false;
+            }
+
+            if (!blockedBy.isEmpty()) {
+                step.state = State::Skipped;
+                step.error.errorString = QString("Skipped: step '%1' did not succeed.").arg(blockedBy);
+                step.error.httpStatusCode = 424; // Failed Dependency
+                changed = true;
+                continue;
+            }
+            if (!ready) continue;
+
+            QNetworkReply* reply = step.start(m_results);
+            if (!reply) {
+                step.state = State::Failed;
+                step.error.errorString = QString("Failed to start step '%1' (check URL/Token).").arg(step.name);
+                step.error.httpStatusCode = 500;
+                changed = true;
+                continue;
+            }
+
+            step.state = State::Running;
+            ++m_running;
+            connect(reply, &QNetworkReply::finished, this, [this, i, reply]() { finishStep(i, reply); });
+        }
+    }
+}
+
+void TrackerTaskGraph::finishStep(int index, QNetworkReply *reply)
+{
+    Step& step = m_steps[index];
+    --m_running;
+
+    if (step.read(reply, &m_results, &step.error)) {
+        step.state = State::Succeeded;
+    } else {
+        step.state = State::Failed;
+        if (step.error.httpStatusCode == 0) step.error.httpStatusCode = 502;
+        if (step.error.errorString.isEmpty()) step.error.errorString = QString("Step '%1' failed.").arg(step.name);
+        logWarning() << "TrackerTaskGraph: Step" << step.name << "failed:" << step.error.errorString;
+    }
+    reply->deleteLater();
+
+    schedule();
+    if (m_running == 0) m_loop.quit();
+}
+
+bool TrackerTaskGraph::hasFailures() const
+{
+    for (const Step& step : m_steps) {
+        if (step.state == State::Failed || step.state == State::Skipped) return true;
+    }
+    return false;
+}
+
+ApiError TrackerTaskGraph::requiredError() const
+{
+    for (const Step& step : m_steps) {
+        if (step.required && (step.state == State::Failed || step.state == State::Skipped)) {
+            return step.error;
+        }
+    }
+    return ApiError();
+}
+
+QJsonArray TrackerTaskGraph::report() const
+{
+    QJsonArray steps;
+    for (const Step& step : m_steps) {
+        QJsonObject item;
+        item["step"] = step.name;
+        switch (step.state) {
+        case State::Succeeded: item["status"] = "ok"; break;
+        case State::Failed:    item["status"] = "failed"; break;
+        case State::Skipped:   item["status"] = "skipped"; break;
+        default:               item["status"] = "pending"; break;
+        }
+        if (step.state == State::Failed || step.state == State::Skipped) {
+            item["error"] = step.error.errorString;
+            item["httpStatus"] = step.error.httpStatusCode;
+        }
+        steps.append(item);
+    }
+    return steps;
+}
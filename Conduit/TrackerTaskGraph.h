@@ -0,0 +1,89 @@
+#ifndef TRACKERTASKGRAPH_H
+#define TRACKERTASKGRAPH_H
+
+#include "Oracle/ApiClient.h" // ApiError
+
+#include <QObject>
+#include <QEventLoop>
+#include <QJsonArray>
+#include <QList>
+#include <QStringList>
+#include <QVariantHash>
+#include <functional>
+
+class QNetworkReply;
+
+/**
+ * @brief Граф мережевих кроків до трекера (Jira/Redmine) з урахуванням залежностей.
+ *
+ * Кроки без спільних залежностей (коментар, worklog, завантаження вкладень) стартують
+ * одночасно; крок, що залежить від інших (напр., оновлення задачі Redmine, якому потрібні
+ * токени завантажень), — лише після їх завершення. Якщо впала обов'язкова залежність, залежний
+ * крок пропускається; невдача необов'язкової (вкладення) не блокує, а лише потрапляє у звіт.
+ * Замість першої помилки — звіт по кожному кроку (report()).
+ *
+ * Очікування — один QEventLoop на весь граф (як і раніше в обробниках WebServer, але не по черзі).
+ */
+class TrackerTaskGraph : public QObject
+{
+    Q_OBJECT
+public:
+    // Спільні результати кроків: "redmineUserId", "upload:0" -> токен тощо
+    using Results = QVariantHash;
+    // Запускає крок; nullptr — крок не вдалося почати
+    using StartFn = std::function<QNetworkReply*(const Results& results)>;
+    // Читає завершену відповідь, може дописати результат; false — крок невдалий (деталі в error)
+    using ReadFn = std::function<bool(QNetworkReply* reply, Results* results, ApiError* error)>;
+
+    explicit TrackerTaskGraph(QObject *parent = nullptr);
+
+    /**
+     * @brief Додає крок.
+     * @param required Невдача обов'язкового кроку робить увесь граф невдалим;
+     *                 необов'язкового (вкладення, worklog) — лише частковим.
+     */
+    void addStep(const QString& name, const QStringList& dependsOn,
+                 const StartFn& start, const ReadFn& read, bool required = true);
+
+    // Успіх, якщо HTTP 2xx; помилка — з errorDetails клієнта або з тіла відповіді
+    static ReadFn httpSuccess();
+
+    // Запускає всі готові кроки й одразу повертається (можна паралельно робити іншу роботу)
+    void start();
+    // Чекає на завершення всіх кроків; true, якщо всі обов'язкові кроки успішні
+    bool wait();
+    bool run() { start(); return wait(); }
+
+    bool hasFailures() const;
+    // Помилка першого невдалого обов'язкового кроку (порожня, якщо таких немає)
+    ApiError requiredError() const;
+    // [{"step", "status": "ok"|"failed"|"skipped", "error", "httpStatus"}]
+    QJsonArray report() const;
+    const Results& results() const { return m_results; }
+
+private:
+    enum class State { Pending, Running, Succeeded, Failed, Skipped };
+
+    struct Step {
+        QString name;
+        QStringList dependsOn;
+        StartFn start;
+        ReadFn read;
+        bool required = true;
+        State state = State::Pending;
+        ApiError error;
+    };
+
+    int indexOf(const QString& name) const;
+    void schedule();
+    void finishStep(int index, QNetworkReply* reply);
+
+private:
+    QList<Step> m_steps;
+    Results m_results;
+    int m_running = 0;
+    bool m_started = false;
+    QEventLoop m_loop;
+};
+
+#endif // TRACKERTASKGRAPH_H
@@ -5,12 +5,24 @@
 #include "version.h"
 #include "Oracle/SessionManager.h"
 #include "JiraWorkflowManager.h"
+#include "JiraTransitionPlanCache.h"
 
 #include "Oracle/User.h"         // Потрібен для доступу до токенів користувача
-#include "Oracle/CriptPass.h"    // Потрібен для дешифрування токенів
+#include "Oracle/SecretCache.h"  // Розшифровані токени користувачів (кеш)
 #include "Oracle/RedmineClient.h" // Потрібен для виклику зовнішнього API
 #include "Oracle/JiraClient.h"
 #include "Oracle/AppParams.h"    // Потрібен для Redmine Base URL
+#include "Oracle/SyncEventBus.h" // Події синхронізації для WebSocket-підписників
+#include "Oracle/Metrics.h"
+#include "Oracle/Tracing.h"
+#include "Oracle/ReferenceResponseCache.h"
+#include "Oracle/DbEventListener.h"
+#include "TrackerIssueCache.h"
+#include "TrackerTaskGraph.h"
+#include "ConditionalGet.h"
+#include "ResponseCompressor.h"
+#include "RateLimiter.h"
+#include "RoutePattern.h"
 #include <QEventLoop>            // Потрібен для синхронного очікування відповіді Redmine
 
 
@@ -24,6 +36,72 @@
 #include <QCryptographicHash>
 #include <QHttpServerResponse>
 #include <QUrlQuery>
+#include <QWebSocket>
+#include <QDateTime>
+#include <QScopeGuard>
+#include <QElapsedTimer>
+
+namespace {
+
+// Сторінка задач з властивостей відповіді JiraClient (див. JiraClient::onIssuesReplyFinished)
+bool readJiraPage(QNetworkReply* reply, TrackerIssueCache::Page* page, ApiError* error)
+{
+    if (!reply->property("success").toBool()) {
+        *error = reply->property("errorDetails").value<ApiError>();
+        return false;
+    }
+    page->items = reply->property("tasksArray").toJsonArray();
+    page->total = reply->property("total").toInt();
+    page->nextCursor = reply->property("nextStartAt").toInt();
+    // Проєкт/тип/статус задач знадобляться при закритті: план переходу береться з кешу без GET
+    JiraTransitionPlanCache::instance().rememberIssues(page->items);
+    logInfo() << "Successfully fetched" << page->items.count() << "of" << page->total << "tasks from Jira.";
+    return true;
+}
+
+// Вкладення звіту по задачі: {"fileName", "data" (Base64)}
+struct ReportAttachment {
+    QString fileName;
+    QByteArray data;
+};
+
+// Вкладення з тіла запиту звіту; порожні пропускаються, безіменні отримують attachment_N.jpg
+QList<ReportAttachment> readReportAttachments(const QJsonArray& items)
+{
+    QList<ReportAttachment> attachments;
+    for (int i = 0; i < items.size(); ++i) {
+        const QJsonObject item = items.at(i).toObject();
+        ReportAttachment attachment;
+        attachment.fileName = item["fileName"].toString();
+        attachment.data = QByteArray::fromBase64(item["data"].toString().toLatin1());
+        if (attachment.data.isEmpty()) {
+            logWarning() << "Report attachment" << i << "has no data. Skipping.";
+            continue;
+        }
+        if (attachment.fileName.isEmpty()) attachment.fileName = QString("attachment_%1.jpg").arg(i + 1);
+        attachments.append(attachment);
+    }
+    return attachments;
+}
+
+// Сторінка задач з властивостей відповіді RedmineClient (див. RedmineClient::onIssuesReplyFinished)
+bool readRedminePage(QNetworkReply* reply, TrackerIssueCache::Page* page, ApiError* error)
+{
+    if (!reply->property("issuesFetched").toBool()) {
+        *error = reply->property("errorDetails").value<ApiError>();
+        return false;
+    }
+    page->items = reply->property("issuesArray").toJsonArray();
+    page->total = reply->property("totalCount").toInt();
+    page->nextCursor = reply->property("nextOffset").toInt();
+    logInfo() << "Successfully retrieved" << page->items.count() << "of" << page->total << "tasks from Redmine.";
+    return true;
+}
+
+// Скільки автентифікованих сесій пам'ятає rateLimitIdentity
+const int kMaxKnownSessions = 10000;
+
+}
 
 WebServer::WebServer(quint16 port, const QString& botApiKey, QObject *parent)
     : QObject{parent},
@@ -31,118 +109,168 @@ WebServer::WebServer(quint16 port, const QString& botApiKey, QObject *parent)
     m_botApiKey(botApiKey) // <-- Зберігаємо ключ
 {
     m_httpServer = new QHttpServer(this);
+    m_trackerCache = new TrackerIssueCache(this);
+    m_batchMaxItems = qMax(1, AppParams::instance().getParam("Global", "BatchMaxItems", 20).toInt());
     setupRoutes();
+    setupBatchRoutes();
+
+    // --- Push-канал подій синхронізації (WebSocket /api/events/sync) ---
+    connect(m_httpServer, &QHttpServer::newWebSocketConnection, this, &WebServer::onNewWebSocketConnection);
+    connect(&SyncEventBus::instance(), &SyncEventBus::syncEvent, this, &WebServer::broadcastSyncEvent);
+
+    // --- Зміни в БД в обхід цього сервера (POST_EVENT) -> адресне скидання кешів ---
+    DbEventListener& dbEvents = DbEventListener::instance();
+    connect(&dbEvents, &DbEventListener::clientsChanged, this, [] {
+        ReferenceResponseCache::instance().invalidate(ReferenceResponseCache::Clients);
+        DbManager::instance().markExternalChange(true, true); // Назва клієнта входить у довідник АЗС
+    });
+    connect(&dbEvents, &DbEventListener::objectsChanged, this, [] {
+        ReferenceResponseCache::instance().invalidate(ReferenceResponseCache::Regions);
+        DbManager::instance().markExternalChange(true, true);
+    });
+    connect(&dbEvents, &DbEventListener::settingsChanged, this, [] {
+        // Подія не каже, якої програми стосуються налаштування — скидаємо всі записи
+        ReferenceResponseCache::instance().invalidateAll();
+        DbManager::instance().markExternalChange(false, true);
+    });
+    connect(&dbEvents, &DbEventListener::settingsChanged, this, &WebServer::reloadRateLimits);
+    connect(&dbEvents, &DbEventListener::usersChanged, this, [this] {
+        // Подія не каже, якого користувача змінено: токени трекерів, їхні списки задач
+        // і визнані сесії (користувача могли деактивувати) — для всіх
+        SecretCache::instance().invalidateUsers();
+        m_trackerCache->invalidateAll();
+        m_knownSessions.clear();
+    });
+    // Кешу SYNC_STATUS / EXPORT_TASKS на сервері немає, але відкриті дашборди Gandalf отримують
+    // push-події лише від цього процесу — повідомляємо їх про зміни, зроблені в обхід нього
+    connect(&dbEvents, &DbEventListener::syncStatusChanged, this, [this] {
+        broadcastSyncEvent(QJsonObject{{"type", "db_changed"}, {"table", "sync_status"}});
+    });
+    connect(&dbEvents, &DbEventListener::exportTasksChanged, this, [this] {
+        broadcastSyncEvent(QJsonObject{{"type", "db_changed"}, {"table", "export_tasks"}});
+    });
 }
 
 void WebServer::setupRoutes()
 {
     m_httpServer->route("/", [this](const QHttpServerRequest &request) {
-        return handleRootRequest(request);
+        return observeRoute("/", request, [&] { return handleRootRequest(request); });
+    });
+    // Метрики у текстовому форматі Prometheus (сам маршрут не вимірюється)
+    m_httpServer->route("/metrics", QHttpServerRequest::Method::Get, [this](const QHttpServerRequest &request) {
+        return handleMetricsRequest(request);
+    });
+    // Останні траси запитів (лише для адміністратора)
+    m_httpServer->route("/api/debug/traces", QHttpServerRequest::Method::Get, [this](const QHttpServerRequest &request) {
+        return handleGetTracesRequest(request);
     });
     m_httpServer->route("/status", [this](const QHttpServerRequest &request) {
-        return handleStatusRequest(request);
+        return observeRoute("/status", request, [&] { return handleStatusRequest(request); });
     });
     m_httpServer->route("/api/login", QHttpServerRequest::Method::Post, [this](const QHttpServerRequest &request) {
-        return handleLoginRequest(request);
+        return observeRoute("/api/login", request, [&] { return handleLoginRequest(request); });
+    });
+    m_httpServer->route("/api/batch", QHttpServerRequest::Method::Post, [this](const QHttpServerRequest &request) {
+        return observeRoute("/api/batch", request, [&] { return handleBatchRequest(request); });
     });
     m_httpServer->route("/api/users", QHttpServerRequest::Method::Get, [this](const QHttpServerRequest &request) {
-        return handleGetUsersRequest(request);
+        return observeRoute("/api/users", request, [&] { return handleGetUsersRequest(request); });
     });
     m_httpServer->route("/api/users/<arg>", QHttpServerRequest::Method::Get,
                         [this](const QString &userId, const QHttpServerRequest &request) {
-                            return handleGetUserByIdRequest(userId, request);
+                            return observeRoute("/api/users/<arg>", request, [&] { return handleGetUserByIdRequest(userId, request); });
                         });
     m_httpServer->route("/api/roles", QHttpServerRequest::Method::Get, [this](const QHttpServerRequest &request) {
-        return handleGetRolesRequest(request);
+        return observeRoute("/api/roles", request, [&] { return handleGetRolesRequest(request); });
     });
     m_httpServer->route("/api/users/<arg>", QHttpServerRequest::Method::Put,
                         [this](const QString &userId, const QHttpServerRequest &request) {
-                            return handleUpdateUserRequest(userId, request);
+                            return observeRoute("/api/users/<arg>", request, [&] { return handleUpdateUserRequest(userId, request); });
                         });
     m_httpServer->route("/api/clients", QHttpServerRequest::Method::Get, [this](const QHttpServerRequest &request) {
-        return handleGetClientsRequest(request);
+        return observeRoute("/api/clients", request, [&] { return handleGetClientsRequest(request); });
     });
     m_httpServer->route("/api/clients", QHttpServerRequest::Method::Post, [this](const QHttpServerRequest &request) {
-        return handleCreateClientRequest(request);
+        return observeRoute("/api/clients", request, [&] { return handleCreateClientRequest(request); });
     });
     m_httpServer->route("/api/clients/<arg>", QHttpServerRequest::Method::Get,
                         [this](const QString &clientId, const QHttpServerRequest &request) {
-                            return handleGetClientByIdRequest(clientId, request);
+                            return observeRoute("/api/clients/<arg>", request, [&] { return handleGetClientByIdRequest(clientId, request); });
                         });
     m_httpServer->route("/api/ip-gen-methods", QHttpServerRequest::Method::Get, [this](const QHttpServerRequest &request) {
-        return handleGetIpGenMethodsRequest(request);
+        return observeRoute("/api/ip-gen-methods", request, [&] { return handleGetIpGenMethodsRequest(request); });
     });
     m_httpServer->route("/api/connections/test", QHttpServerRequest::Method::Post, [this](const QHttpServerRequest &request) {
-        return handleTestConnectionRequest(request);
+        return observeRoute("/api/connections/test", request, [&] { return handleTestConnectionRequest(request); });
     });
     m_httpServer->route("/api/clients/<arg>", QHttpServerRequest::Method::Put,
                         [this](const QString &clientId, const QHttpServerRequest &request) {
-                            return handleUpdateClientRequest(clientId, request);
+                            return observeRoute("/api/clients/<arg>", request, [&] { return handleUpdateClientRequest(clientId, request); });
                         });
     m_httpServer->route("/api/settings/<arg>", QHttpServerRequest::Method::Get,
                         [this](const QString& appName, const QHttpServerRequest& request){
-                            return handleGetSettingsRequest(appName, request);
+                            return observeRoute("/api/settings/<arg>", request, [&] { return handleGetSettingsRequest(appName, request); });
                         });
     m_httpServer->route("/api/settings/<arg>", QHttpServerRequest::Method::Put,
                         [this](const QString& appName, const QHttpServerRequest& request){
-                            return handleUpdateSettingsRequest(appName, request);
+                            return observeRoute("/api/settings/<arg>", request, [&] { return handleUpdateSettingsRequest(appName, request); });
                         });
     m_httpServer->route("/api/clients/<arg>/sync", QHttpServerRequest::Method::Post,
                         [this](const QString& clientId, const QHttpServerRequest& request) {
-                            return handleSyncClientObjectsRequest(clientId, request);
+                            return observeRoute("/api/clients/<arg>/sync", request, [&] { return handleSyncClientObjectsRequest(clientId, request); });
                         });
     m_httpServer->route("/api/clients/<arg>/sync-status", QHttpServerRequest::Method::Get,
                         [this](const QString& clientId, const QHttpServerRequest& request) {
-                            return handleGetSyncStatusRequest(clientId, request);
+                            return observeRoute("/api/clients/<arg>/sync-status", request, [&] { return handleGetSyncStatusRequest(clientId, request); });
                         });
     m_httpServer->route("/api/objects", QHttpServerRequest::Method::Get,
                         [this](const QHttpServerRequest &request) {
-                            return handleGetObjectsRequest(request);
+                            return observeRoute("/api/objects", request, [&] { return handleGetObjectsRequest(request); });
                         });
     m_httpServer->route("/api/regions-list", QHttpServerRequest::Method::Get,
                         [this](const QHttpServerRequest &request) {
-                            return handleGetRegionsListRequest(request);
+                            return observeRoute("/api/regions-list", request, [&] { return handleGetRegionsListRequest(request); });
                         });
     m_httpServer->route("/api/bot/register", QHttpServerRequest::Method::Post, [this](const QHttpServerRequest &request) {
-        return handleBotRegisterRequest(request);
+        return observeRoute("/api/bot/register", request, [&] { return handleBotRegisterRequest(request); });
     });
     m_httpServer->route("/api/bot/requests", QHttpServerRequest::Method::Get, [this](const QHttpServerRequest& request) {
-        return handleGetBotRequests(request);
+        return observeRoute("/api/bot/requests", request, [&] { return handleGetBotRequests(request); });
     });
 
     m_httpServer->route("/api/bot/reject", QHttpServerRequest::Method::Post, [this](const QHttpServerRequest& request) {
-        return handleRejectBotRequest(request);
+        return observeRoute("/api/bot/reject", request, [&] { return handleRejectBotRequest(request); });
     });
 
     m_httpServer->route("/api/bot/approve", QHttpServerRequest::Method::Post, [this](const QHttpServerRequest& request) {
-        return handleApproveBotRequest(request);
+        return observeRoute("/api/bot/approve", request, [&] { return handleApproveBotRequest(request); });
     });
 
     m_httpServer->route("/api/bot/link", QHttpServerRequest::Method::Post, [this](const QHttpServerRequest& request) {
-        return handleLinkBotRequest(request);
+        return observeRoute("/api/bot/link", request, [&] { return handleLinkBotRequest(request); });
     });
 
     m_httpServer->route("/api/bot/me", QHttpServerRequest::Method::Post, [this](const QHttpServerRequest& request) {
-        return handleBotStatusRequest(request);
+        return observeRoute("/api/bot/me", request, [&] { return handleBotStatusRequest(request); });
     });
 
     // Маршрут для отримання списку активних користувачів бота (для адмінів)
     m_httpServer->route("/api/bot/users", QHttpServerRequest::Method::Get, [this](const QHttpServerRequest& request) {
-        return handleGetBotUsersRequest(request);
+        return observeRoute("/api/bot/users", request, [&] { return handleGetBotUsersRequest(request); });
     });
 
     // Маршрут для отримання списку АЗС клієнта
     // /api/bot/clients/<clientId>/stations
     m_httpServer->route("/api/bot/clients/<arg>/stations", QHttpServerRequest::Method::Get,
                         [this](const QString& clientId, const QHttpServerRequest& request) {
-                            return handleGetClientStations(clientId, request);
+                            return observeRoute("/api/bot/clients/<arg>/stations", request, [&] { return handleGetClientStations(clientId, request); });
                         });
 
     // Маршрут для отримання деталей однієї АЗС
     // /api/bot/clients/<clientId>/station/<terminalNo>
     m_httpServer->route("/api/bot/clients/<arg>/station/<arg>", QHttpServerRequest::Method::Get,
                         [this](const QString& clientId, const QString& terminalNo, const QHttpServerRequest& request) {
-                            return handleGetStationDetails(clientId, terminalNo, request);
+                            return observeRoute("/api/bot/clients/<arg>/station/<arg>", request, [&] { return handleGetStationDetails(clientId, terminalNo, request); });
                         });
 
     // --- Export Tasks Management (Керування завданнями експорту) ---
@@ -151,98 +279,275 @@ void WebServer::setupRoutes()
     // Отримати список усіх завдань. Залишаємо лише один GET маршрут для списку.
     m_httpServer->route("/api/export-tasks", QHttpServerRequest::Method::Get, [this](const QHttpServerRequest &request) {
         // Видаляємо handleGetExportTasksRequest, оскільки він, ймовірно, дублює handleGetAllExportTasksRequest
-        return handleGetAllExportTasksRequest(request);
+        return observeRoute("/api/export-tasks", request, [&] { return handleGetAllExportTasksRequest(request); });
     });
 
     // POST /api/export-tasks (НОВИЙ МАРШРУТ: СТВОРЕННЯ)
     m_httpServer->route("/api/export-tasks", QHttpServerRequest::Method::Post, [this](const QHttpServerRequest &request) {
-        return handleCreateExportTaskRequest(request); // Метод для створення нового завдання
+        return observeRoute("/api/export-tasks", request, [&] { return handleCreateExportTaskRequest(request); }); // Метод для створення нового завдання
     });
 
     // GET /api/export-tasks/<taskId> (Отримання ДЕТАЛЕЙ одного завдання)
     m_httpServer->route("/api/export-tasks/<arg>", QHttpServerRequest::Method::Get,
                         [this](const QString &taskId, const QHttpServerRequest &request) {
-                            return handleGetExportTaskRequest(taskId, request);
+                            return observeRoute("/api/export-tasks/<arg>", request, [&] { return handleGetExportTaskRequest(taskId, request); });
                         });
 
     // Маршрут для ОНОВЛЕННЯ ОДНОГО завдання (PUT /api/export-tasks/<taskId>)
     m_httpServer->route("/api/export-tasks/<arg>", QHttpServerRequest::Method::Put,
                         [this](const QString &taskId, const QHttpServerRequest &request) {
-                            return handleUpdateExportTaskRequest(taskId, request);
+                            return observeRoute("/api/export-tasks/<arg>", request, [&] { return handleUpdateExportTaskRequest(taskId, request); });
                         });
 
     // --- API для Дашборду ---
     m_httpServer->route("/api/dashboard", QHttpServerRequest::Method::Get, [this](const QHttpServerRequest &request) {
-        return handleDashboardRequest(request);
+        return observeRoute("/api/dashboard", request, [&] { return handleDashboardRequest(request); });
     });
 
     // Додаємо новий маршрут для РРО
     m_httpServer->route("/api/clients/<arg>/station/<arg>/pos", QHttpServerRequest::Method::Get,
                         [this](const QString &clientId, const QString &terminalNo, const QHttpServerRequest &request) {
-                            return handleGetStationPosData(clientId, terminalNo, request);
+                            return observeRoute("/api/clients/<arg>/station/<arg>/pos", request, [&] { return handleGetStationPosData(clientId, terminalNo, request); });
                         });
 
     // Додаємо маршрут для резервуарів
     m_httpServer->route("/api/clients/<arg>/station/<arg>/tanks", QHttpServerRequest::Method::Get,
                         [this](const QString &clientId, const QString &terminalNo, const QHttpServerRequest &request) {
-                            return handleGetStationTanks(clientId, terminalNo, request);
+                            return observeRoute("/api/clients/<arg>/station/<arg>/tanks", request, [&] { return handleGetStationTanks(clientId, terminalNo, request); });
                         });
 
     // GET /api/clients/<clientId>/station/<terminalNo>/dispensers
     m_httpServer->route(QStringLiteral("/api/clients/<arg>/station/<arg>/dispensers"), [this](const QString& clientId, const QString& terminalNo, const QHttpServerRequest &request) {
-        return handleGetStationDispensers(clientId, terminalNo, request);
+        return observeRoute("/api/clients/<arg>/station/<arg>/dispensers", request, [&] { return handleGetStationDispensers(clientId, terminalNo, request); });
     });
 
     m_httpServer->route("/api/bot/redmine/tasks", QHttpServerRequest::Method::Get, [this](const QHttpServerRequest &request) {
-        return handleGetRedmineTasks(request);
+        return observeRoute("/api/bot/redmine/tasks", request, [&] { return handleGetRedmineTasks(request); });
     });
 
     // !!!  МАРШРУТ ДЛЯ ОТРИМАННЯ ЗАДАЧ JIRA ДЛЯ БОТА !!!
     m_httpServer->route("/api/bot/jira/tasks", QHttpServerRequest::Method::Get,
                         [this](const QHttpServerRequest& request) {
-                            return handleGetJiraTasks(request);
+                            return observeRoute("/api/bot/jira/tasks", request, [&] { return handleGetJiraTasks(request); });
                         });
 
     // !!!  МАРШРУТ: GET /api/bot/tasks/details (Валідація задачі) !!!
     m_httpServer->route("/api/bot/tasks/details", QHttpServerRequest::Method::Get,
                         [this](const QHttpServerRequest& request) {
-                            return handleGetTaskDetails(request);
+                            return observeRoute("/api/bot/tasks/details", request, [&] { return handleGetTaskDetails(request); });
                         });
 
     // !!!  МАРШРУТ: POST /api/bot/tasks/assign (Призначення на себе) !!!
     m_httpServer->route("/api/bot/tasks/assign", QHttpServerRequest::Method::Post,
                         [this](const QHttpServerRequest& request) {
-                            return handleAssignTaskToSelf(request);
+                            return observeRoute("/api/bot/tasks/assign", request, [&] { return handleAssignTaskToSelf(request); });
                         });
 
     m_httpServer->route("/api/bot/tasks/report", [this](const QHttpServerRequest& request) {
-        return handleReportTask(request);
+        return observeRoute("/api/bot/tasks/report", request, [&] { return handleReportTask(request); });
     });
 
     // маршрут для завантаження вкладень Jira
     m_httpServer->route("/api/bot/jira/attach", QHttpServerRequest::Method::Post,
                         [this](const QHttpServerRequest &request) {
-                            return handleJiraAttach(request);
+                            return observeRoute("/api/bot/jira/attach", request, [&] { return handleJiraAttach(request); });
                         });
 
 
     m_httpServer->route("/api/bot/tasks/comment", QHttpServerRequest::Method::Post,
                         [this](const QHttpServerRequest &request) {
-                            return handleTaskComment(request);
+                            return observeRoute("/api/bot/tasks/comment", request, [&] { return handleTaskComment(request); });
                         });
 
     m_httpServer->route("/api/stations/search", QHttpServerRequest::Method::Get,
                         [this](const QHttpServerRequest &request) {
-                            return handleSearchStations(request);
+                            return observeRoute("/api/stations/search", request, [&] { return handleSearchStations(request); });
+                        });
+
+    m_httpServer->route("/api/stations/catalog", QHttpServerRequest::Method::Get,
+                        [this](const QHttpServerRequest &request) {
+                            return observeRoute("/api/stations/catalog", request, [&] { return handleGetStationCatalog(request); });
+                        });
+
+    m_httpServer->route("/api/reference/revision", QHttpServerRequest::Method::Get,
+                        [this](const QHttpServerRequest &request) {
+                            return observeRoute("/api/reference/revision", request, [&] { return handleGetReferenceRevision(request); });
                         });
 
     m_httpServer->route("/api/objects/info", QHttpServerRequest::Method::Get,
-                        [this](const QHttpServerRequest &request) { return handleGetObjectInfo(request); });
+                        [this](const QHttpServerRequest &request) { return observeRoute("/api/objects/info", request, [&] { return handleGetObjectInfo(request); }); });
 
     // Маршрут для робочих місць
     m_httpServer->route(QStringLiteral("/api/clients/<arg>/station/<arg>/workplaces"), [this](const QString& clientId, const QString& terminalNo, const QHttpServerRequest &request) {
-        return handleGetStationWorkplaces(clientId, terminalNo, request);
+        return observeRoute("/api/clients/<arg>/station/<arg>/workplaces", request, [&] { return handleGetStationWorkplaces(clientId, terminalNo, request); });
     });
+
+    // Масова перевірка доступності кас
+    m_httpServer->route("/api/clients/<arg>/workplaces", QHttpServerRequest::Method::Get,
+                        [this](const QString& clientId, const QHttpServerRequest& request) {
+                            return observeRoute("/api/clients/<arg>/workplaces", request, [&] { return handleGetClientWorkplaces(clientId, request); });
+                        });
+    m_httpServer->route("/api/clients/<arg>/reachability", QHttpServerRequest::Method::Post,
+                        [this](const QString& clientId, const QHttpServerRequest& request) {
+                            return observeRoute("/api/clients/<arg>/reachability", request, [&] { return handlePostReachability(clientId, request); });
+                        });
+    m_httpServer->route("/api/clients/<arg>/reachability", QHttpServerRequest::Method::Get,
+                        [this](const QString& clientId, const QHttpServerRequest& request) {
+                            return observeRoute("/api/clients/<arg>/reachability", request, [&] { return handleGetReachability(clientId, request); });
+                        });
+
+    // --- Умовні GET (ETag / If-None-Match), потім стиснення (gzip / deflate) для всіх маршрутів ---
+    m_httpServer->afterRequest([this](QHttpServerResponse &&response, const QHttpServerRequest &request) {
+        return applyCompression(applyConditionalGet(std::move(response), request), request);
+    });
+}
+
+QHttpServerResponse WebServer::observeRoute(const QString &route, const QHttpServerRequest &request,
+                                            const std::function<QHttpServerResponse()> &handler)
+{
+    MetricsRegistry& metrics = MetricsRegistry::instance();
+    // Обробники чекають на трекери у вкладених QEventLoop, тож кількох запитів "у роботі" одночасно — норма
+    static Gauge& inFlight = metrics.gauge("conduit_http_requests_in_flight", "HTTP requests currently being handled.");
+
+    const auto metaEnum = QMetaEnum::fromType<QHttpServerRequest::Method>();
+    const QString method = QString::fromLatin1(metaEnum.valueToKey(static_cast<int>(request.method())));
+
+    // Траса запиту: ID від клієнта (X-Request-ID) або новий; повертається у відповіді
+    const std::shared_ptr<Trace> trace =
+        Tracer::instance().begin(Tracer::acceptRequestId(request.value("X-Request-ID")), method + ' ' + route);
+
+    // Допуск до обробки: ліміт особи в класі маршруту і ліміт запитів у роботі
+    RateLimiter& limiter = RateLimiter::instance();
+    const RateLimiter::RouteClass routeClass = RateLimiter::classify(route, method);
+    const RateLimiter::Decision decision = limiter.admit(rateLimitIdentity(request), routeClass);
+
+    inFlight.inc();
+    QElapsedTimer timer;
+    timer.start();
+    QHttpServerResponse response = [&] {
+        TraceScope traceScope(trace);
+        if (!decision.allowed) {
+            metrics.counter("conduit_http_rejected_total", "Requests rejected by rate limiting or load shedding.",
+                            {{"class", RateLimiter::className(routeClass)},
+                             {"reason", decision.overloaded ? "overload" : "rate"}}).inc();
+            return createRejectedResponse(decision.retryAfterSec, decision.overloaded);
+        }
+        const auto releaseGuard = qScopeGuard([&] { limiter.release(routeClass); });
+        return handler();
+    }();
+    const double elapsedSec = timer.nsecsElapsed() / 1e9;
+    inFlight.dec();
+
+    const int status = static_cast<int>(response.statusCode());
+    Tracer::instance().finish(trace, status);
+    response.setHeader("X-Request-ID", trace->requestId().toLatin1());
+
+    metrics.histogram("conduit_http_request_duration_seconds", "HTTP request latency by route.",
+                      {{"route", route}, {"method", method}}).observe(elapsedSec);
+    metrics.counter("conduit_http_requests_total", "HTTP requests by route and status code.",
+                    {{"route", route}, {"method", method},
+                     {"status", QString::number(status)}}).inc();
+    return response;
+}
+
+/**
+ * @brief Ключ особи для RateLimiter. Сесію Gandalf визнаємо лише за токеном, який уже пройшов
+ * автентифікацію (m_knownSessions): інакше довільні Bearer-токени давали б кожному запиту
+ * новий повний кошик і роздували б таблицю кошиків. Невідомий токен — ліміт за IP.
+ */
+QString WebServer::rateLimitIdentity(const QHttpServerRequest &request) const
+{
+    const QByteArray authHeader = request.value("Authorization");
+    if (authHeader.startsWith("Bearer ")) {
+        // Сам токен у пам'яті не тримаємо — лише його хеш
+        const QByteArray tokenHash = QCryptographicHash::hash(authHeader.mid(7), QCryptographicHash::Sha256).toHex();
+        if (m_knownSessions.contains(tokenHash)) {
+            return "session:" + QString::fromLatin1(tokenHash.left(16));
+        }
+    }
+
+    // Ідентичність бота приймаємо лише з вірним ключем: інакше чужий X-Telegram-ID вичерпав би ліміт користувача
+    const QByteArray botToken = request.value("X-Bot-Token");
+    if (!botToken.isEmpty() && !m_botApiKey.isEmpty() && botToken == m_botApiKey.toUtf8()) {
+        const QByteArray telegramId = request.value("X-Telegram-ID");
+        return telegramId.isEmpty() ? QStringLiteral("bot") : "telegram:" + QString::fromLatin1(telegramId);
+    }
+
+    return "ip:" + request.remoteAddress().toString();
+}
+
+/**
+ * @brief Відповідь на запит, який RateLimiter не допустив: 503 при перевантаженні сервера,
+ * 429 при вичерпаному ліміті особи. Retry-After — через скільки секунд повторити.
+ */
+QHttpServerResponse WebServer::createRejectedResponse(int retryAfterSec, bool overloaded)
+{
+    QHttpServerResponse response = overloaded
+        ? createJsonResponse(QJsonObject{{"error", "Server is overloaded, try again later"}},
+                             QHttpServerResponse::StatusCode::ServiceUnavailable)
+        : createJsonResponse(QJsonObject{{"error", "Too many requests"}},
+                             QHttpServerResponse::StatusCode::TooManyRequests);
+    response.setHeader("Retry-After", QByteArray::number(retryAfterSec));
+    return response;
+}
+
+/**
+ * @brief Перечитує налаштування Global з БД і, якщо вони змінились, оновлює AppParams
+ * і ліміти RateLimiter. Викликається на кожну подію зміни APP_SETTINGS, тому зміни
+ * інших груп (Gandalf, Isengard) ліміти не чіпають.
+ */
+void WebServer::reloadRateLimits()
+{
+    const QVariantMap globalSettings = DbManager::instance().loadSettings("Global");
+    if (globalSettings == m_globalSettings) return;
+
+    m_globalSettings = globalSettings;
+    for (auto it = globalSettings.constBegin(); it != globalSettings.constEnd(); ++it) {
+        AppParams::instance().setParam("Global", it.key(), it.value());
+    }
+    RateLimiter::instance().reload();
+}
+
+/**
+ * @brief Метрики процесу для Prometheus.
+ * Маршрут: GET /metrics. Якщо задано Global/MetricsToken — потрібен заголовок "Authorization: Bearer <токен>".
+ */
+QHttpServerResponse WebServer::handleMetricsRequest(const QHttpServerRequest &request)
+{
+    const QString token = AppParams::instance().getParam("Global", "MetricsToken").toString();
+    if (!token.isEmpty() && request.value("Authorization") != "Bearer " + token.toUtf8()) {
+        return createTextResponse("Unauthorized", QHttpServerResponse::StatusCode::Unauthorized);
+    }
+    return QHttpServerResponse("text/plain; version=0.0.4; charset=utf-8",
+                               MetricsRegistry::instance().exposition());
+}
+
+/**
+ * @brief Останні траси запитів: відрізки auth, db.*, json, upstream.* з часом кожного.
+ * Маршрут: GET /api/debug/traces?limit=50&slow=1 (slow — лише довші за Global/TraceSlowMs). Лише адміністратор.
+ */
+QHttpServerResponse WebServer::handleGetTracesRequest(const QHttpServerRequest &request)
+{
+    User* user = authenticateRequest(request);
+    if (!user) {
+        return createJsonResponse(QJsonObject{{"error", "Unauthorized"}}, QHttpServerResponse::StatusCode::Unauthorized);
+    }
+    if (!user->hasRole("Адміністратор")) {
+        delete user;
+        return createJsonResponse(QJsonObject{{"error", "Forbidden"}}, QHttpServerResponse::StatusCode::Forbidden);
+    }
+    delete user;
+
+    const QUrlQuery query(request.url());
+    bool ok = false;
+    int limit = query.queryItemValue("limit").toInt(&ok);
+    if (!ok || limit <= 0) limit = 50;
+    const bool slowOnly = query.queryItemValue("slow") == "1";
+
+    return createJsonResponse(QJsonObject{
+        {"slow_threshold_ms", Tracer::instance().slowThresholdMs()},
+        {"traces", Tracer::instance().recent(limit, slowOnly)}
+    }, QHttpServerResponse::StatusCode::Ok);
 }
 
 void WebServer::logRequest(const QHttpServerRequest &request)
@@ -267,6 +572,7 @@ QHttpServerResponse WebServer::createTextResponse(const QByteArray &body, QHttpS
 
 QHttpServerResponse WebServer::createJsonResponse(const QJsonObject &body, QHttpServerResponse::StatusCode statusCode)
 {
+    TraceSpan span("json");
     QByteArray bodyJson = QJsonDocument(body).toJson(QJsonDocument::Compact);
     if (statusCode >= QHttpServerResponse::StatusCode::BadRequest) {
         logCritical() << "Server Response Error:" << static_cast<int>(statusCode)
@@ -280,6 +586,7 @@ QHttpServerResponse WebServer::createJsonResponse(const QJsonObject &body, QHttp
 
 QHttpServerResponse WebServer::createJsonResponse(const QJsonArray &body, QHttpServerResponse::StatusCode statusCode)
 {
+    TraceSpan span("json");
     QByteArray bodyJson = QJsonDocument(body).toJson(QJsonDocument::Compact);
     if (statusCode >= QHttpServerResponse::StatusCode::BadRequest) {
         logCritical() << "Server Response Error:" << static_cast<int>(statusCode)
@@ -291,6 +598,85 @@ QHttpServerResponse WebServer::createJsonResponse(const QJsonArray &body, QHttpS
     return QHttpServerResponse("application/json", bodyJson, statusCode);
 }
 
+/**
+ * @brief Відповідь з кешу довідкових даних (ReferenceResponseCache): готові байти JSON.
+ * build() (запит до БД) виконується лише при промаху. Порожній результат не кешується —
+ * так само виглядає і помилка БД. Заголовок X-Cache: HIT/MISS.
+ */
+QHttpServerResponse WebServer::createReferenceResponse(const QString &key, const std::function<QJsonDocument()> &build)
+{
+    ReferenceResponseCache& cache = ReferenceResponseCache::instance();
+    QByteArray body;
+    quint64 generation = 0;
+    const bool hit = cache.lookup(key, &body, &generation);
+    if (!hit) {
+        const QJsonDocument doc = build();
+        {
+            TraceSpan span("json");
+            body = doc.toJson(QJsonDocument::Compact);
+        }
+        const bool empty = doc.isArray() ? doc.array().isEmpty() : doc.object().isEmpty();
+        if (!empty) cache.store(key, body, generation);
+    }
+
+    QHttpServerResponse response("application/json", body, QHttpServerResponse::StatusCode::Ok);
+    response.setHeader("X-Cache", hit ? "HIT" : "MISS");
+    return response;
+}
+
+void WebServer::readPageRequest(const QHttpServerRequest &request, int *cursor, int *limit)
+{
+    const QUrlQuery query(request.url());
+    const int maxPageSize = qMax(1, AppParams::instance().getParam("Global", "TrackerMaxPageSize", 100).toInt());
+    const int defaultPageSize = AppParams::instance().getParam("Global", "TrackerPageSize", 50).toInt();
+
+    bool ok = false;
+    int requested = query.queryItemValue("limit").toInt(&ok);
+    if (!ok || requested <= 0) requested = defaultPageSize;
+
+    *limit = qBound(1, requested, maxPageSize);
+    *cursor = qMax(0, query.queryItemValue("cursor").toInt());
+}
+
+QHttpServerResponse WebServer::createPageResponse(const TrackerIssueCache::Page &page)
+{
+    QHttpServerResponse response = createJsonResponse(page.items, QHttpServerResponse::StatusCode::Ok);
+    response.setHeader("X-Total-Count", QByteArray::number(page.total));
+    if (page.nextCursor >= 0) {
+        response.setHeader("X-Next-Cursor", QByteArray::number(page.nextCursor));
+    }
+    // Вік даних: скільки секунд тому сторінку отримано з трекера
+    response.setHeader("Age", QByteArray::number(page.ageSec()));
+    response.setHeader("X-Cache", page.fromCache ? "HIT" : "MISS");
+    return response;
+}
+
+QHttpServerResponse WebServer::applyConditionalGet(QHttpServerResponse &&response, const QHttpServerRequest &request)
+{
+    if (request.method() != QHttpServerRequest::Method::Get) {
+        return std::move(response);
+    }
+
+    QByteArray ifNoneMatch;
+    for (const auto &headerPair : request.headers()) {
+        if (headerPair.first.compare("If-None-Match", Qt::CaseInsensitive) == 0) {
+            ifNoneMatch = headerPair.second;
+            break;
+        }
+    }
+
+    QHttpServerResponse result = ConditionalGet::apply(std::move(response), ifNoneMatch);
+    if (result.statusCode() == QHttpServerResponse::StatusCode::NotModified) {
+        logDebug() << "Conditional GET:" << request.url().path() << "not modified.";
+    }
+    return result;
+}
+
+QHttpServerResponse WebServer::applyCompression(QHttpServerResponse &&response, const QHttpServerRequest &request)
+{
+    return ResponseCompressor::instance().apply(std::move(response), request.value("Accept-Encoding"));
+}
+
 QHttpServerResponse WebServer::handleRootRequest(const QHttpServerRequest &request)
 {
     logRequest(request);
@@ -319,6 +705,52 @@ bool WebServer::start()
     return true;
 }
 
+void WebServer::onNewWebSocketConnection()
+{
+    while (m_httpServer->hasPendingWebSocketConnections()) {
+        QWebSocket* socket = m_httpServer->nextPendingWebSocketConnection().release();
+        const QNetworkRequest handshake = socket->request();
+
+        if (socket->requestUrl().path() != "/api/events/sync") {
+            logWarning() << "WebSocket: unknown endpoint" << socket->requestUrl().path();
+            socket->close(QWebSocketProtocol::CloseCodeBadOperation, "Unknown endpoint");
+            socket->deleteLater();
+            continue;
+        }
+
+        // Аутентифікація тими ж заголовками, що й для звичайних запитів
+        User* user = authenticateHeaders(handshake.rawHeader("Authorization"),
+                                         handshake.rawHeader("X-Bot-Token"),
+                                         handshake.rawHeader("X-Telegram-ID"));
+        if (!user) {
+            logWarning() << "WebSocket: unauthorized subscription attempt from" << socket->peerAddress().toString();
+            socket->close(QWebSocketProtocol::CloseCodePolicyViolated, "Unauthorized");
+            socket->deleteLater();
+            continue;
+        }
+        logInfo() << "WebSocket: sync events subscriber connected:" << user->login();
+        delete user;
+
+        socket->setParent(this);
+        m_syncSubscribers.append(socket);
+        connect(socket, &QWebSocket::disconnected, this, [this, socket]() {
+            m_syncSubscribers.removeAll(socket);
+            socket->deleteLater();
+            logDebug() << "WebSocket: subscriber disconnected. Active:" << m_syncSubscribers.size();
+        });
+    }
+}
+
+void WebServer::broadcastSyncEvent(const QJsonObject &event)
+{
+    if (m_syncSubscribers.isEmpty()) return;
+
+    const QString message = QString::fromUtf8(QJsonDocument(event).toJson(QJsonDocument::Compact));
+    for (QWebSocket* socket : std::as_const(m_syncSubscribers)) {
+        socket->sendTextMessage(message);
+    }
+}
+
 QHttpServerResponse WebServer::handleLoginRequest(const QHttpServerRequest &request)
 {
     logRequest(request);
@@ -393,12 +825,13 @@ QHttpServerResponse WebServer::handleGetUserByIdRequest(const QString &userId, c
 QHttpServerResponse WebServer::handleGetRolesRequest(const QHttpServerRequest &request)
 {
     logRequest(request);
-    QList<QVariantMap> rolesData = DbManager::instance().loadAllRoles();
-    QJsonArray jsonArray;
-    for (const QVariantMap &roleMap : rolesData) {
-        jsonArray.append(QJsonObject::fromVariantMap(roleMap));
-    }
-    return createJsonResponse(jsonArray, QHttpServerResponse::StatusCode::Ok); // Fixed to use helper
+    return createReferenceResponse(ReferenceResponseCache::Roles, [] {
+        QJsonArray jsonArray;
+        for (const QVariantMap &roleMap : DbManager::instance().loadAllRoles()) {
+            jsonArray.append(QJsonObject::fromVariantMap(roleMap));
+        }
+        return QJsonDocument(jsonArray);
+    });
 }
 
 QHttpServerResponse WebServer::handleUpdateUserRequest(const QString &userId, const QHttpServerRequest &request)
@@ -472,6 +905,12 @@ QHttpServerResponse WebServer::handleUpdateUserRequest(const QString &userId, co
  */
 User* WebServer::authenticateRequest(const QHttpServerRequest &request)
 {
+    // Підзапит /api/batch: пакет уже автентифіковано, віддаємо копію (викликач її видаляє)
+    if (m_batchContext) {
+        return new User(*m_batchContext->user);
+    }
+
+    TraceSpan span("auth");
     // --- 1. Пошук всіх заголовків ---
     const auto &headers = request.headers();
     QByteArray authHeader;
@@ -489,6 +928,29 @@ User* WebServer::authenticateRequest(const QHttpServerRequest &request)
         }
     }
 
+    return authenticateHeaders(authHeader, botTokenHeader, telegramIdHeader);
+}
+
+/**
+ * @brief Запам'ятовує хеш токена, що пройшов автентифікацію, для rateLimitIdentity.
+ * Набір обмежений: при переповненні починаємо з чистого (сесії знову потраплять сюди при наступному вході в API).
+ */
+void WebServer::rememberSession(const QByteArray &tokenHash)
+{
+    if (!m_knownSessions.contains(tokenHash) && m_knownSessions.size() >= kMaxKnownSessions) {
+        m_knownSessions.clear();
+    }
+    m_knownSessions.insert(tokenHash);
+}
+
+/**
+ * @brief Спільна логіка аутентифікації за вже зібраними заголовками.
+ * Використовується і для HTTP-запитів, і для WebSocket-рукостискання.
+ * @return Об'єкт User* у разі успіху (вимагає delete), або nullptr.
+ */
+User* WebServer::authenticateHeaders(const QByteArray &authHeader, const QByteArray &botTokenHeader,
+                                     const QByteArray &telegramIdHeader)
+{
     // --- Спроба №1: Аутентифікація Gandalf (токен сесії) ---
     if (authHeader.startsWith("Bearer ")) {
         QByteArray token = authHeader.mid(7);
@@ -498,6 +960,7 @@ User* WebServer::authenticateRequest(const QHttpServerRequest &request)
         if (userId > 0) {
             User* user = DbManager::instance().loadUser(userId);
             if (user && user->isActive()) {
+                rememberSession(tokenHash);
                 return user; // Успіх (Gandalf)
             }
             if (user) delete user;
@@ -568,12 +1031,13 @@ User* WebServer::authenticateRequest(const QHttpServerRequest &request)
 QHttpServerResponse WebServer::handleGetClientsRequest(const QHttpServerRequest &request)
 {
     logRequest(request);
-    QList<QVariantMap> clientsData = DbManager::instance().loadAllClients();
-    QJsonArray jsonArray;
-    for (const QVariantMap &clientMap : clientsData) {
-        jsonArray.append(QJsonObject::fromVariantMap(clientMap));
-    }
-    return createJsonResponse(jsonArray, QHttpServerResponse::StatusCode::Ok); // Fixed to use helper
+    return createReferenceResponse(ReferenceResponseCache::Clients, [] {
+        QJsonArray jsonArray;
+        for (const QVariantMap &clientMap : DbManager::instance().loadAllClients()) {
+            jsonArray.append(QJsonObject::fromVariantMap(clientMap));
+        }
+        return QJsonDocument(jsonArray);
+    });
 }
 
 QHttpServerResponse WebServer::handleCreateClientRequest(const QHttpServerRequest &request)
@@ -620,12 +1084,13 @@ QHttpServerResponse WebServer::handleGetClientByIdRequest(const QString &clientI
 QHttpServerResponse WebServer::handleGetIpGenMethodsRequest(const QHttpServerRequest &request)
 {
     logRequest(request);
-    QList<QVariantMap> methodsData = DbManager::instance().loadAllIpGenMethods();
-    QJsonArray jsonArray;
-    for (const QVariantMap &methodMap : methodsData) {
-        jsonArray.append(QJsonObject::fromVariantMap(methodMap));
-    }
-    return createJsonResponse(jsonArray, QHttpServerResponse::StatusCode::Ok); // Fixed to use helper
+    return createReferenceResponse(ReferenceResponseCache::IpGenMethods, [] {
+        QJsonArray jsonArray;
+        for (const QVariantMap &methodMap : DbManager::instance().loadAllIpGenMethods()) {
+            jsonArray.append(QJsonObject::fromVariantMap(methodMap));
+        }
+        return QJsonDocument(jsonArray);
+    });
 }
 
 QHttpServerResponse WebServer::handleTestConnectionRequest(const QHttpServerRequest &request)
@@ -674,11 +1139,14 @@ QHttpServerResponse WebServer::handleUpdateClientRequest(const QString &clientId
 
 QHttpServerResponse WebServer::handleGetSettingsRequest(const QString& appName, const QHttpServerRequest& request)
 {
-    if (!authenticateRequest(request))
+    User* user = authenticateRequest(request);
+    if (!user)
         return createJsonResponse(QJsonObject{{"error", "Unauthorized"}}, QHttpServerResponse::StatusCode::Unauthorized);
+    delete user;
     logRequest(request);
-    QVariantMap settings = DbManager::instance().loadSettings(appName);
-    return createJsonResponse(QJsonObject::fromVariantMap(settings), QHttpServerResponse::StatusCode::Ok);
+    return createReferenceResponse(ReferenceResponseCache::settingsKey(appName), [&appName] {
+        return QJsonDocument(QJsonObject::fromVariantMap(DbManager::instance().loadSettings(appName)));
+    });
 }
 
 QHttpServerResponse WebServer::handleUpdateSettingsRequest(const QString& appName, const QHttpServerRequest& request)
@@ -690,6 +1158,8 @@ QHttpServerResponse WebServer::handleUpdateSettingsRequest(const QString& appNam
     if (!doc.isObject())
         return createJsonResponse(QJsonObject{{"error", "Invalid JSON body"}}, QHttpServerResponse::StatusCode::BadRequest);
     if (DbManager::instance().saveSettings(appName, doc.object().toVariantMap())) {
+        // Ліміти навантаження діють одразу, без перезапуску сервера
+        if (appName == "Global") reloadRateLimits();
         return QHttpServerResponse(QHttpServerResponse::StatusCode::Ok);
     } else {
         return createJsonResponse(QJsonObject{{"error", "Failed to save settings"}}, QHttpServerResponse::StatusCode::InternalServerError);
@@ -713,11 +1183,13 @@ QHttpServerResponse WebServer::handleSyncClientObjectsRequest(const QString& cli
 
     // 1. СТАВИМО СТАТУС "ВИКОНУЄТЬСЯ" ОДРАЗУ
     DbManager::instance().setSyncStatus(id, "RUNNING", "Підготовка до синхронізації...");
+    SyncEventBus::instance().publish(id, "QUEUED", "Синхронізацію поставлено в чергу.");
 
     // 2. ЗАПУСКАЄМО ФОНОВИЙ ПОТІК
     QThreadPool::globalInstance()->start([id]() {
         try {
             logInfo() << "Starting background synchronization for client ID:" << id;
+            SyncEventBus::instance().publish(id, "RUNNING", "Синхронізація розпочата...");
 
             // Цей метод всередині себе робить всю роботу і САМ записує фінальні
             // красиві статуси (напр. "Direct Sync. Processed: 261") в БД!
@@ -725,9 +1197,15 @@ QHttpServerResponse WebServer::handleSyncClientObjectsRequest(const QString& cli
 
             if (result.contains("error")) {
                 logCritical() << "Synchronization failed for client" << id << ":" << result["error"].toString();
+                SyncEventBus::instance().publish(id, "ERROR", result["error"].toString());
             } else {
                 logInfo() << "Synchronization completed for client" << id
                           << ". Processed" << result["processed_count"].toInt() << "objects.";
+                QJsonObject extra;
+                extra["processed"] = result["processed_count"].toInt();
+                SyncEventBus::instance().publish(id, "SUCCESS",
+                                                 QString("Processed: %1").arg(result["processed_count"].toInt()),
+                                                 extra);
             }
 
             // УВАГА: ТУТ НІЧОГО НЕ ПИШЕМО В БАЗУ ДЛЯ SUCCESS/FAILED!
@@ -737,9 +1215,11 @@ QHttpServerResponse WebServer::handleSyncClientObjectsRequest(const QString& cli
             logCritical() << "!!! CRITICAL EXCEPTION in sync thread for client" << id << ":" << e.what();
             // Записуємо в базу ТІЛЬКИ якщо стався краш C++, щоб вікно не зависло вічно в RUNNING
             DbManager::instance().setSyncStatus(id, "ERROR", QString("Критична помилка: %1").arg(e.what()));
+            SyncEventBus::instance().publish(id, "ERROR", QString("Критична помилка: %1").arg(e.what()));
         } catch (...) {
             logCritical() << "!!! UNKNOWN CRITICAL EXCEPTION in sync thread for client" << id;
             DbManager::instance().setSyncStatus(id, "ERROR", "Невідома критична помилка сервера");
+            SyncEventBus::instance().publish(id, "ERROR", "Невідома критична помилка сервера");
         }
     });
 
@@ -766,11 +1246,13 @@ QHttpServerResponse WebServer::handleGetSyncStatusRequest(const QString &clientI
 QHttpServerResponse WebServer::handleGetObjectsRequest(const QHttpServerRequest &request)
 {
     logRequest(request);
-    if (!authenticateRequest(request)) {
+    User* user = authenticateRequest(request);
+    if (!user) {
         return createJsonResponse(QJsonObject{{"error", "Unauthorized"}}, QHttpServerResponse::StatusCode::Unauthorized);
     }
+    delete user;
     QVariantMap filters;
-    const QUrlQuery query(request.url());
+    const QUrlQuery query = requestQuery(request);
     if (query.hasQueryItem("clientId"))
         filters["clientId"] = query.queryItemValue("clientId").toInt();
     if (query.hasQueryItem("region"))
@@ -783,22 +1265,49 @@ QHttpServerResponse WebServer::handleGetObjectsRequest(const QHttpServerRequest
         filters["isWork"] = query.queryItemValue("isWork") == "true";
     if (query.hasQueryItem("terminalId"))
         filters["terminalId"] = query.queryItemValue("terminalId").toInt();
+
+    // Посторінковий режим: ?offset=N&limit=M. Беремо на один рядок більше,
+    // щоб дізнатися, чи є наступна сторінка, без окремого COUNT(*)
+    int offset = 0;
+    int limit = 0;
+    if (query.hasQueryItem("limit")) {
+        offset = qMax(0, query.queryItemValue("offset").toInt());
+        limit = qBound(1, query.queryItemValue("limit").toInt(), 1000);
+        filters["offset"] = offset;
+        filters["limit"] = limit + 1;
+    }
+
     QList<QVariantMap> objects = DbManager::instance().getObjects(filters);
+    bool hasMore = false;
+    if (limit > 0 && objects.size() > limit) {
+        hasMore = true;
+        objects.removeLast();
+    }
+
     QJsonArray jsonArray;
     for (const auto& map : objects) {
         jsonArray.append(QJsonObject::fromVariantMap(map));
     }
     QJsonObject responseBody;
     responseBody["objects"] = jsonArray;
+    if (limit > 0) {
+        responseBody["offset"] = offset;
+        responseBody["has_more"] = hasMore;
+    }
     return createJsonResponse(responseBody, QHttpServerResponse::StatusCode::Ok);
 }
 
 QHttpServerResponse WebServer::handleGetRegionsListRequest(const QHttpServerRequest &request)
 {
-    if (!authenticateRequest(request))
+    User* user = authenticateRequest(request);
+    if (!user)
         return createJsonResponse(QJsonObject{{"error", "Unauthorized"}}, QHttpServerResponse::StatusCode::Unauthorized);
-    QStringList regions = DbManager::instance().getUniqueRegionsList();
-    return createJsonResponse(QJsonObject{{"regions", QJsonArray::fromStringList(regions)}}, QHttpServerResponse::StatusCode::Ok);
+    delete user;
+    // SELECT DISTINCT по всіх OBJECTS — лише при промаху кешу
+    return createReferenceResponse(ReferenceResponseCache::Regions, [] {
+        const QStringList regions = DbManager::instance().getUniqueRegionsList();
+        return QJsonDocument(QJsonObject{{"regions", QJsonArray::fromStringList(regions)}});
+    });
 }
 
 QHttpServerResponse WebServer::handleBotRegisterRequest(const QHttpServerRequest &request)
@@ -1400,7 +1909,8 @@ QHttpServerResponse WebServer::handleGetStationDispensers(const QString& clientI
 
 /**
  * @brief Обробляє запит бота на отримання списку відкритих Redmine задач.
- * Маршрут: GET /api/bot/redmine/tasks
+ * Маршрут: GET /api/bot/redmine/tasks[?cursor=<зміщення>&limit=<розмір>]
+ * Наступна сторінка — у заголовку X-Next-Cursor, загальна кількість — у X-Total-Count.
  */
 QHttpServerResponse WebServer::handleGetRedmineTasks(const QHttpServerRequest& request)
 {
@@ -1425,7 +1935,7 @@ QHttpServerResponse WebServer::handleGetRedmineTasks(const QHttpServerRequest& r
     }
 
     // !!! ВИКЛИК КРИПТОГРАФІЇ ПЕРЕД ВИКОРИСТАННЯМ !!!
-    QString decryptedToken = CriptPass::instance().decriptPass(encryptedToken);
+    const SecretCache::Secret decryptedToken = SecretCache::instance().acquire(encryptedToken, SecretCache::userOwner(user->id()));
 
     // --- 3. НАЛАШТУВАННЯ ---
     QString redmineUrl = AppParams::instance().getParam("Global", "RedmineBaseUrl").toString();
@@ -1436,59 +1946,38 @@ QHttpServerResponse WebServer::handleGetRedmineTasks(const QHttpServerRequest& r
                                   QHttpServerResponse::StatusCode::InternalServerError);
     }
 
-    // --- 4. ВИКЛИК ЗОВНІШНЬОГО КЛІЄНТА (Синхронний виклик) ---
-    QJsonArray tasksArray;
-    ApiError clientError;
+    // --- 4. СТОРІНКА ЗАДАЧ: З КЕШУ АБО З REDMINE ---
+    int cursor = 0;
+    int limit = 0;
+    readPageRequest(request, &cursor, &limit);
 
-    // Створюємо клієнт для виконання запиту
-    RedmineClient client;
-    QNetworkReply* reply = client.fetchOpenIssues(redmineUrl, decryptedToken);
-
-    if (reply) {
-        // !!! Блокування та очікування відповіді Redmine !!!
-        QEventLoop loop;
-        QObject::connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-        loop.exec();
-
-        // Перевіряємо, чи був успішно випущений сигнал issuesFetched
-        if (reply->property("issuesFetched").toBool()) {
-            // Якщо issuesFetched спрацював, масив задач зберігається у властивостях
-            tasksArray = reply->property("issuesArray").toJsonArray();
-            logInfo() << "Successfully retrieved" << tasksArray.count() << "tasks from Redmine.";
-        } else {
-            // Якщо issuesFetched НЕ спрацював, помилка була оброблена в onIssuesReplyFinished
-            // Помилка вже знаходиться у властивості "errorDetails"
-            clientError = reply->property("errorDetails").value<ApiError>();
-            logCritical() << "Redmine API failed during sync call. Error:" << clientError.errorString;
-        }
+    const auto start = [redmineUrl, decryptedToken, cursor, limit](QObject* scope) {
+        RedmineClient* client = new RedmineClient(scope);
+        return client->fetchOpenIssues(redmineUrl, *decryptedToken, cursor, limit);
+    };
 
-        // Оскільки reply вже буде видалено у RedmineClient::onIssuesReplyFinished,
-        // тут ми просто продовжуємо.
-        // Але нам потрібно тимчасово змінити RedmineClient.cpp, щоб він зберігав дані
-        // у властивостях, а не просто емітував сигнал, бо тут ми синхронно чекаємо.
-    } else {
-        // Помилка вхідних параметрів (URL/токен порожні)
-        clientError.errorString = "RedmineClient failed to initiate fetch (check URL/Token).";
-        clientError.httpStatusCode = 500;
-    }
+    TrackerIssueCache::Page page;
+    ApiError clientError;
+    const bool ok = m_trackerCache->get(user->id(), TrackerIssueCache::pageKey("redmine", 0, cursor, limit),
+                                        start, readRedminePage, &page, &clientError);
 
     // --- 5. ФІНАЛЬНА ВІДПОВІДЬ ---
     delete user;
 
-    if (tasksArray.isEmpty() && clientError.httpStatusCode != 0 && clientError.httpStatusCode != 404) {
-        // Помилка, відмінна від "не знайдено"
+    if (!ok && clientError.httpStatusCode != 0 && clientError.httpStatusCode != 404) {
+        logCritical() << "Redmine API failed during sync call. Error:" << clientError.errorString;
         return createJsonResponse(QJsonObject{{"error", clientError.errorString}},
                                   (QHttpServerResponse::StatusCode)clientError.httpStatusCode);
-    } else {
-        // Успіх або 404/порожній список (що вважається успіхом для бота)
-        return createJsonResponse(tasksArray, QHttpServerResponse::StatusCode::Ok);
     }
+    // Успіх або 404/порожній список (що вважається успіхом для бота)
+    return createPageResponse(page);
 }
 
 
 /**
  * @brief Обробляє запит бота на отримання списку відкритих Jira задач.
- * Маршрут: GET /api/bot/jira/tasks
+ * Маршрут: GET /api/bot/jira/tasks[?terminalId=<номер АЗС>][&cursor=<зміщення>&limit=<розмір>]
+ * Пагінація — як у /api/bot/redmine/tasks.
  */
 QHttpServerResponse WebServer::handleGetJiraTasks(const QHttpServerRequest &request)
 {
@@ -1525,59 +2014,45 @@ QHttpServerResponse WebServer::handleGetJiraTasks(const QHttpServerRequest &requ
     }
 
     // Розшифровуємо токен (Без змін)
-    QString jiraUserToken;
+    SecretCache::Secret jiraUserToken;
     try {
-        jiraUserToken = CriptPass::instance().decriptPass(jiraTokenEncrypted);
+        jiraUserToken = SecretCache::instance().acquire(jiraTokenEncrypted, SecretCache::userOwner(user->id()));
     } catch (const std::exception& e) {
         logCritical() << "Failed to decrypt Jira API Token for user" << user->id() << ". Error:" << e.what();
         delete user;
         return createJsonResponse(QJsonObject{{"error", "Failed to decrypt Jira API Token."}}, QHttpServerResponse::StatusCode::InternalServerError);
     }
 
-    // --- 3. ЗАПИТ ДО ЗОВНІШНЬОГО API (JIRA) ---
-    QJsonArray tasksArray;
-    ApiError clientError;
-    JiraClient jiraClient;
-    QNetworkReply* reply = nullptr;
+    // --- 3. СТОРІНКА ЗАДАЧ: З КЕШУ АБО З JIRA ---
+    int cursor = 0;
+    int limit = 0;
+    readPageRequest(request, &cursor, &limit);
 
     // --- РОЗГАЛУЖЕННЯ: Пошук по АЗС або список призначених задач ---
-    if (terminalId > 0) {
-        logInfo() << "Server: Searching Jira issues for terminal:" << terminalId;
-        // Викликаємо ваш новий метод пошуку
-        reply = jiraClient.searchIssuesByTerminal(jiraBaseUrl, terminalId, jiraUserToken);
-    } else {
+    const auto start = [jiraBaseUrl, jiraLogin, jiraUserToken, terminalId, cursor, limit](QObject* scope) {
+        JiraClient* client = new JiraClient(scope);
+        if (terminalId > 0) {
+            logInfo() << "Server: Searching Jira issues for terminal:" << terminalId;
+            return client->searchIssuesByTerminal(jiraBaseUrl, terminalId, *jiraUserToken, cursor, limit);
+        }
         logInfo() << "Server: Fetching assigned issues for user:" << jiraLogin;
-        // Викликаємо стандартний метод отримання призначених задач
-        reply = jiraClient.fetchIssues(jiraBaseUrl, jiraLogin, jiraUserToken);
-    }
+        return client->fetchIssues(jiraBaseUrl, jiraLogin, *jiraUserToken, cursor, limit);
+    };
 
-    if (reply) {
-        QEventLoop loop;
-        connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-        loop.exec();
-
-        if (reply->property("success").toBool()) {
-            tasksArray = reply->property("tasksArray").toJsonArray();
-            logInfo() << "Successfully fetched" << tasksArray.count() << "tasks from Jira.";
-        } else {
-            clientError = reply->property("errorDetails").value<ApiError>();
-            logCritical() << "Jira API failed during sync call. Error:" << clientError.errorString;
-        }
-        reply->deleteLater();
-    } else {
-        clientError.errorString = "JiraClient failed to initiate fetch.";
-        clientError.httpStatusCode = 500;
-    }
+    TrackerIssueCache::Page page;
+    ApiError clientError;
+    const bool ok = m_trackerCache->get(user->id(), TrackerIssueCache::pageKey("jira", terminalId, cursor, limit),
+                                        start, readJiraPage, &page, &clientError);
 
-    // --- 4. ФІНАЛЬНА ВІДПОВІДЬ (Без змін) ---
+    // --- 4. ФІНАЛЬНА ВІДПОВІДЬ ---
     delete user;
 
-    if (tasksArray.isEmpty() && clientError.httpStatusCode != 0 && clientError.httpStatusCode != 404) {
+    if (!ok && clientError.httpStatusCode != 0 && clientError.httpStatusCode != 404) {
+        logCritical() << "Jira API failed during sync call. Error:" << clientError.errorString;
         return createJsonResponse(QJsonObject{{"error", clientError.errorString}},
                                   (QHttpServerResponse::StatusCode)clientError.httpStatusCode);
-    } else {
-        return createJsonResponse(tasksArray, QHttpServerResponse::StatusCode::Ok);
     }
+    return createPageResponse(page);
 }
 
 
@@ -1607,9 +2082,9 @@ QHttpServerResponse WebServer::handleGetTaskDetails(const QHttpServerRequest& re
         }
 
         QString tokenEncrypted = user->redmineToken();
-        QString token = CriptPass::instance().decriptPass(tokenEncrypted);
+        const SecretCache::Secret token = SecretCache::instance().acquire(tokenEncrypted, SecretCache::userOwner(user->id()));
         RedmineClient client;
-        QNetworkReply* reply = client.fetchIssueDetails(redmineBaseUrl, taskId, token);
+        QNetworkReply* reply = client.fetchIssueDetails(redmineBaseUrl, taskId, *token);
 
         if (reply) {
             QEventLoop loop;
@@ -1632,15 +2107,15 @@ QHttpServerResponse WebServer::handleGetTaskDetails(const QHttpServerRequest& re
     } else if (tracker == "jira") {
         const QString jiraBaseUrl = AppParams::instance().getParam("Global", "JiraBaseUrl").toString();
         QString tokenEncrypted = user->jiraToken();
-        QString token = CriptPass::instance().decriptPass(tokenEncrypted);
+        const SecretCache::Secret token = SecretCache::instance().acquire(tokenEncrypted, SecretCache::userOwner(user->id()));
 
-        if (jiraBaseUrl.isEmpty() || token.isEmpty()) {
+        if (jiraBaseUrl.isEmpty() || token->isEmpty()) {
             delete user;
             return createTextResponse("Jira configuration missing.", QHttpServerResponse::StatusCode::InternalServerError);
         }
 
         JiraClient client;
-        QNetworkReply* reply = client.fetchIssueDetails(jiraBaseUrl, taskId, token);
+        QNetworkReply* reply = client.fetchIssueDetails(jiraBaseUrl, taskId, *token);
 
         if (reply) {
             QEventLoop loop;
@@ -1684,6 +2159,9 @@ QHttpServerResponse WebServer::handleAssignTaskToSelf(const QHttpServerRequest&
     User* user = authenticateRequest(request);
     if (!user) { return createTextResponse("Unauthorized", QHttpServerResponse::StatusCode::Unauthorized); }
 
+    // Після запису в трекер список задач користувача зміниться — скидаємо кеш при будь-якому виході
+    const auto invalidateTasks = qScopeGuard([this, userId = user->id()] { m_trackerCache->invalidateUser(userId); });
+
     const QString redmineBaseUrl = AppParams::instance().getParam("Global", "RedmineBaseUrl").toString();
 
     QJsonDocument doc = QJsonDocument::fromJson(request.body());
@@ -1711,9 +2189,9 @@ QHttpServerResponse WebServer::handleAssignTaskToSelf(const QHttpServerRequest&
 
         // --- Redmine Логіка ---
         QString tokenEncrypted = user->redmineToken();
-        QString token = CriptPass::instance().decriptPass(tokenEncrypted);
+        const SecretCache::Secret token = SecretCache::instance().acquire(tokenEncrypted, SecretCache::userOwner(user->id()));
 
-        if (token.isEmpty()) {
+        if (token->isEmpty()) {
             delete user;
             return createTextResponse("Redmine API Token is empty after decryption.", QHttpServerResponse::StatusCode::Forbidden);
         }
@@ -1727,7 +2205,7 @@ QHttpServerResponse WebServer::handleAssignTaskToSelf(const QHttpServerRequest&
 
             RedmineClient client;
             // Синхронний запит на /users/current.json для визначення ID
-            QNetworkReply* detailsReply = client.fetchCurrentUserId(redmineBaseUrl, token);
+            QNetworkReply* detailsReply = client.fetchCurrentUserId(redmineBaseUrl, *token);
 
             if (detailsReply) {
                 QEventLoop detailLoop;
@@ -1766,7 +2244,7 @@ QHttpServerResponse WebServer::handleAssignTaskToSelf(const QHttpServerRequest&
         // Призначення задачі (ВИКОРИСТОВУЄМО ПРАВИЛЬНИЙ redmineUserId)
         RedmineClient client;
         // !!! ТУТ ЗМІНА: Передаємо коректний ID Redmine !!!
-        QNetworkReply* reply = client.assignIssue(redmineBaseUrl, taskId, token, redmineUserId);
+        QNetworkReply* reply = client.assignIssue(redmineBaseUrl, taskId, *token, redmineUserId);
 
         if (reply) {
             QEventLoop loop;
@@ -1794,12 +2272,24 @@ QHttpServerResponse WebServer::handleAssignTaskToSelf(const QHttpServerRequest&
     return createJsonResponse(QJsonObject{{"status", "assigned"}}, QHttpServerResponse::StatusCode::Ok);
 }
 
+/**
+ * @brief Звіт по задачі з бота: коментар, закриття або відхилення.
+ * Маршрут: POST /api/bot/tasks/report
+ * Тіло: {"tracker", "taskId", "action", "comment", ["timeSpent"], ["resolutionMethod"],
+ *        ["attachments": [{"fileName", "data" (Base64)}]]}
+ * Незалежні виклики до трекера (вкладення, коментар, worklog, ID користувача Redmine) йдуть
+ * паралельно через TrackerTaskGraph. У відповіді "steps" — результат кожного кроку;
+ * "partial": true, якщо основна дія вдалась, а щось необов'язкове (вкладення, worklog) — ні.
+ */
 QHttpServerResponse WebServer::handleReportTask(const QHttpServerRequest& request)
 {
     logRequest(request);
     User* user = authenticateRequest(request);
     if (!user) { return createTextResponse("Unauthorized", QHttpServerResponse::StatusCode::Unauthorized); }
 
+    // Після запису в трекер список задач користувача зміниться — скидаємо кеш при будь-якому виході
+    const auto invalidateTasks = qScopeGuard([this, userId = user->id()] { m_trackerCache->invalidateUser(userId); });
+
     QJsonDocument doc = QJsonDocument::fromJson(request.body());
     if (!doc.isObject()) {
         delete user;
@@ -1811,16 +2301,17 @@ QHttpServerResponse WebServer::handleReportTask(const QHttpServerRequest& reques
     QString taskId = body["taskId"].toString().trimmed();
     QString action = body["action"].toString().toLower();
     QString comment = body["comment"].toString();
+    QString timeSpent = body["timeSpent"].toString();
 
     // !!! 1. ЗЧИТУВАННЯ МАСИВУ ВКЛАДЕНЬ !!!
-    QJsonArray attachments = body["attachments"].toArray();
+    const QList<ReportAttachment> attachments = readReportAttachments(body["attachments"].toArray());
 
     if (tracker.isEmpty() || taskId.isEmpty() || action.isEmpty()) {
         delete user;
         return createTextResponse("Missing tracker, task ID, or action.", QHttpServerResponse::StatusCode::BadRequest);
     }
 
-    ApiError clientError;
+    TrackerTaskGraph graph;
 
     // ==============================================================================
     // ЛОГІКА REDMINE
@@ -1833,31 +2324,70 @@ QHttpServerResponse WebServer::handleReportTask(const QHttpServerRequest& reques
         }
 
         QString tokenEncrypted = user->redmineToken();
-        QString token = CriptPass::instance().decriptPass(tokenEncrypted);
-        int redmineUserId = user->redmineUserId();
+        const SecretCache::Secret token = SecretCache::instance().acquire(tokenEncrypted, SecretCache::userOwner(user->id()));
+        const int redmineUserId = user->redmineUserId();
+        const int userId = user->id();
+
+        RedmineClient client;
+        QStringList updateDependsOn;
 
+        // А. ID виконавця: якщо в БД його немає — з /users/current.json, паралельно з вкладеннями
         if (redmineUserId <= 0) {
-            delete user;
-            return createTextResponse("Redmine User ID is not defined in DB.", QHttpServerResponse::StatusCode::Forbidden);
+            graph.addStep("redmineUser", {},
+                [&client, redmineBaseUrl, token](const TrackerTaskGraph::Results&) {
+                    return client.fetchCurrentUserId(redmineBaseUrl, *token);
+                },
+                [userId](QNetworkReply* reply, TrackerTaskGraph::Results* results, ApiError* error) {
+                    if (!reply->property("success").toBool()) {
+                        *error = reply->property("errorDetails").value<ApiError>();
+                        return false;
+                    }
+                    const int redmineId = reply->property("redmineId").toInt();
+                    DbManager::instance().updateRedmineUserId(userId, redmineId);
+                    results->insert("redmineUserId", redmineId);
+                    return true;
+                });
+            updateDependsOn << "redmineUser";
         }
 
-        if (!attachments.isEmpty()) {
-            logWarning() << "Received" << attachments.count() << "attachments for Redmine. Skipping (not implemented).";
+        // Б. Вкладення: кожне завантажується окремо, токени потрібні фінальному оновленню
+        for (int i = 0; i < attachments.size(); ++i) {
+            const ReportAttachment attachment = attachments.at(i);
+            const QString step = QString("upload:%1").arg(i);
+            graph.addStep(step, {},
+                [&client, redmineBaseUrl, token, attachment](const TrackerTaskGraph::Results&) {
+                    return client.uploadFile(redmineBaseUrl, *token, attachment.data, attachment.fileName);
+                },
+                [step, attachment](QNetworkReply* reply, TrackerTaskGraph::Results* results, ApiError* error) {
+                    if (!reply->property("success").toBool()) {
+                        *error = reply->property("errorDetails").value<ApiError>();
+                        return false;
+                    }
+                    results->insert(step, QJsonObject{{"token", reply->property("uploadToken").toString()},
+                                                      {"filename", attachment.fileName}});
+                    return true;
+                },
+                false);
+            updateDependsOn << step;
         }
 
-        RedmineClient client;
-        QNetworkReply* reply = client.reportTask(redmineBaseUrl, taskId, token, redmineUserId, action, comment);
-
-        if (reply) {
-            QEventLoop loop;
-            connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-            loop.exec();
+        // В. Оновлення задачі (коментар/закриття + токени вкладень) — після всіх залежностей
+        graph.addStep("update", updateDependsOn,
+            [&client, redmineBaseUrl, taskId, token, redmineUserId, action, comment](const TrackerTaskGraph::Results& results) {
+                QJsonArray uploads;
+                for (auto it = results.constBegin(); it != results.constEnd(); ++it) {
+                    if (it.key().startsWith("upload:")) uploads.append(it.value().toJsonObject());
+                }
+                const int assigneeId = redmineUserId > 0 ? redmineUserId : results.value("redmineUserId").toInt();
+                return client.reportTask(redmineBaseUrl, taskId, *token, assigneeId, action, comment, uploads);
+            },
+            [](QNetworkReply* reply, TrackerTaskGraph::Results*, ApiError* error) {
+                if (reply->property("success").toBool()) return true;
+                *error = reply->property("errorDetails").value<ApiError>();
+                return false;
+            });
 
-            if (!reply->property("success").toBool()) {
-                clientError = reply->property("errorDetails").value<ApiError>();
-            }
-            reply->deleteLater();
-        }
+        graph.run();
     }
     // ==============================================================================
     // ЛОГІКА JIRA
@@ -1865,27 +2395,50 @@ QHttpServerResponse WebServer::handleReportTask(const QHttpServerRequest& reques
     else if (tracker == "jira") {
         QString jiraBaseUrl = AppParams::instance().getParam("Global", "JiraBaseUrl").toString();
         QString encryptedToken = user->jiraToken();
-        QString userToken = CriptPass::instance().decriptPass(encryptedToken);
+        const SecretCache::Secret userToken = SecretCache::instance().acquire(encryptedToken, SecretCache::userOwner(user->id()));
 
-        if (userToken.isEmpty()) {
+        if (userToken->isEmpty()) {
             delete user;
             return createTextResponse("No Jira Token", QHttpServerResponse::StatusCode::Unauthorized);
         }
 
         JiraClient jiraClient;
-        QNetworkReply* reply = nullptr;
 
-        // --- A. ПРОСТИЙ КОМЕНТАР ---
+        // Вкладення не залежать ні від чого — стартують першими і йдуть паралельно з рештою
+        for (int i = 0; i < attachments.size(); ++i) {
+            const ReportAttachment attachment = attachments.at(i);
+            graph.addStep(QString("attachment:%1").arg(i), {},
+                [&jiraClient, jiraBaseUrl, taskId, userToken, attachment](const TrackerTaskGraph::Results&) {
+                    return jiraClient.uploadAttachment(jiraBaseUrl, taskId, *userToken, attachment.data, attachment.fileName);
+                },
+                TrackerTaskGraph::httpSuccess(), false);
+        }
+
+        // --- A. ПРОСТИЙ КОМЕНТАР (+ worklog, якщо вказано час) ---
         if (action == "comment") {
-            reply = jiraClient.addComment(jiraBaseUrl, taskId, userToken, comment);
+            graph.addStep("comment", {},
+                [&jiraClient, jiraBaseUrl, taskId, userToken, comment](const TrackerTaskGraph::Results&) {
+                    return jiraClient.addComment(jiraBaseUrl, taskId, *userToken, comment);
+                },
+                TrackerTaskGraph::httpSuccess());
+
+            if (!timeSpent.isEmpty()) {
+                graph.addStep("worklog", {},
+                    [&jiraClient, jiraBaseUrl, taskId, userToken, timeSpent](const TrackerTaskGraph::Results&) {
+                        return jiraClient.addWorklog(jiraBaseUrl, taskId, *userToken, timeSpent);
+                    },
+                    TrackerTaskGraph::httpSuccess(), false);
+            }
 
-            // Цей reply буде оброблено внизу, у спільному блоці
+            graph.run();
         }
         // --- B. ЗАКРИТТЯ АБО ВІДХИЛЕННЯ (SMART TRANSITION) ---
         else if (action == "close" || action == "reject") {
 
             QString methodType = body["resolutionMethod"].toString(); // "visit" або "remote"
-            QString timeSpentParam = body["timeSpent"].toString();    // "30m"
+
+            // Вкладення вантажаться, поки менеджер робить перехід (коментар і worklog — в тому ж POST переходу)
+            graph.start();
 
             // Створюємо менеджера, передаючи йому існуючого клієнта
             JiraWorkflowManager workflowManager(&jiraClient);
@@ -1897,14 +2450,16 @@ QHttpServerResponse WebServer::handleReportTask(const QHttpServerRequest& reques
             bool success = workflowManager.performSafeTransition(
                 jiraBaseUrl,
                 taskId,
-                userToken,
+                *userToken,
                 action,         // "close" / "reject"
                 methodType,     // "visit" / "remote"
                 comment,
-                timeSpentParam,
+                timeSpent,
                 errorMsg
                 );
 
+            graph.wait();
+
             // Оскільки Smart Transition самостійний, ми повертаємо відповідь ОДРАЗУ
             delete user; // Не забуваємо чистити пам'ять перед виходом
 
@@ -1913,39 +2468,22 @@ QHttpServerResponse WebServer::handleReportTask(const QHttpServerRequest& reques
                 // ВИПРАВЛЕНО: Додано другий аргумент QHttpServerResponse::StatusCode::Ok
                 return createJsonResponse(QJsonObject{
                                               {"status", "success"},
-                                              {"message", "Task updated via Smart Transition"}
+                                              {"message", "Task updated via Smart Transition"},
+                                              {"partial", graph.hasFailures()},
+                                              {"steps", graph.report()}
                                           }, QHttpServerResponse::StatusCode::Ok);
             } else {
                 logCritical() << "WebServer: Smart Transition failed:" << errorMsg;
                 return createJsonResponse(QJsonObject{
-                                              {"error", errorMsg}
+                                              {"error", errorMsg},
+                                              {"steps", graph.report()}
                                           }, QHttpServerResponse::StatusCode::BadGateway);
             }
         }
-
-        // --- ОБРОБКА ВІДПОВІДІ (Тільки для comment, бо close/reject вже вийшли через return) ---
-        if (reply) {
-            QEventLoop loop;
-            connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-            loop.exec();
-
-            if (reply->error() == QNetworkReply::NoError &&
-                (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 200 ||
-                 reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 201 ||
-                 reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 204))
-            {
-                // Успіх
-            } else {
-                clientError = reply->property("errorDetails").value<ApiError>();
-                if (clientError.errorString.isEmpty()) {
-                    clientError.errorString = "Jira Error: " + reply->readAll();
-                    clientError.httpStatusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
-                    logCritical() << "Jira Action Failed:" << clientError.errorString;
-                }
-            }
-            reply->deleteLater();
+        else {
+            delete user;
+            return createTextResponse("Unknown action.", QHttpServerResponse::StatusCode::BadRequest);
         }
-        // Якщо reply == nullptr і ми тут, значить action був невідомий (але ми перевіряли це на вході)
     }
     else {
         delete user;
@@ -1954,12 +2492,17 @@ QHttpServerResponse WebServer::handleReportTask(const QHttpServerRequest& reques
 
     delete user;
 
-    if (clientError.httpStatusCode != 0) {
-        return createJsonResponse(QJsonObject{{"error", clientError.errorString}},
+    const ApiError clientError = graph.requiredError();
+    if (!clientError.errorString.isEmpty()) {
+        logCritical() << "Task report failed:" << clientError.errorString;
+        return createJsonResponse(QJsonObject{{"error", clientError.errorString}, {"steps", graph.report()}},
                                   (QHttpServerResponse::StatusCode)clientError.httpStatusCode);
     }
 
-    return createJsonResponse(QJsonObject{{"status", "reported"}}, QHttpServerResponse::StatusCode::Ok);
+    return createJsonResponse(QJsonObject{{"status", "reported"},
+                                          {"partial", graph.hasFailures()},
+                                          {"steps", graph.report()}},
+                              QHttpServerResponse::StatusCode::Ok);
 }
 
 QHttpServerResponse WebServer::handleJiraAttach(const QHttpServerRequest &request)
@@ -1989,7 +2532,7 @@ QHttpServerResponse WebServer::handleJiraAttach(const QHttpServerRequest &reques
 
     // !!! ВИПРАВЛЕННЯ: ДЕШИФРУВАННЯ ТОКЕНА !!!
     QString encryptedToken = userObj["jira_token"].toString();
-    QString userJiraToken = CriptPass::instance().decriptPass(encryptedToken);
+    const SecretCache::Secret userJiraToken = SecretCache::instance().acquire(encryptedToken, SecretCache::userOwner(userObj["user_id"].toInt()));
 
     // --- 3. ID ЗАДАЧІ ---
     QString taskId = request.value("X-Task-ID");
@@ -2065,7 +2608,7 @@ QHttpServerResponse WebServer::handleJiraAttach(const QHttpServerRequest &reques
     }
 
     // Перевіряємо вже розшифрований токен
-    if (userJiraToken.isEmpty()) {
+    if (userJiraToken->isEmpty()) {
         logWarning() << "WebServer: User" << userLogin << "has no valid Jira Token (decryption failed or empty).";
         return createTextResponse("User has no Jira token configured", QHttpServerResponse::StatusCode::Unauthorized);
     }
@@ -2074,7 +2617,7 @@ QHttpServerResponse WebServer::handleJiraAttach(const QHttpServerRequest &reques
 
     JiraClient jiraClient;
     // Передаємо розшифрований токен
-    QNetworkReply *reply = jiraClient.uploadAttachment(jiraBaseUrl, taskId, userJiraToken, fileData, fileName);
+    QNetworkReply *reply = jiraClient.uploadAttachment(jiraBaseUrl, taskId, *userJiraToken, fileData, fileName);
 
     if (!reply) {
         return createTextResponse("Failed to create Jira request", QHttpServerResponse::StatusCode::InternalServerError);
@@ -2106,6 +2649,9 @@ QHttpServerResponse WebServer::handleTaskComment(const QHttpServerRequest &reque
     User* user = authenticateRequest(request);
     if (!user) return createTextResponse("Unauthorized", QHttpServerResponse::StatusCode::Unauthorized);
 
+    // Після запису в трекер список задач користувача зміниться — скидаємо кеш при будь-якому виході
+    const auto invalidateTasks = qScopeGuard([this, userId = user->id()] { m_trackerCache->invalidateUser(userId); });
+
     // 2. Парсинг JSON
     QJsonObject json = QJsonDocument::fromJson(request.body()).object();
     QString taskId = json["taskId"].toString();
@@ -2125,15 +2671,15 @@ QHttpServerResponse WebServer::handleTaskComment(const QHttpServerRequest &reque
         // --- JIRA LOGIC ---
         QString jiraBaseUrl = AppParams::instance().getParam("Global", "JiraBaseUrl").toString();
         QString encryptedToken = user->jiraToken(); // Беремо з об'єкта User
-        QString userToken = CriptPass::instance().decriptPass(encryptedToken);
+        const SecretCache::Secret userToken = SecretCache::instance().acquire(encryptedToken, SecretCache::userOwner(user->id()));
 
-        if (userToken.isEmpty()) {
+        if (userToken->isEmpty()) {
             delete user;
             return createTextResponse("No Jira Token", QHttpServerResponse::StatusCode::Unauthorized);
         }
 
         JiraClient jiraClient;
-        QNetworkReply* reply = jiraClient.addComment(jiraBaseUrl, taskId, userToken, comment);
+        QNetworkReply* reply = jiraClient.addComment(jiraBaseUrl, taskId, *userToken, comment);
 
         // Синхронне очікування
         if (reply) {
@@ -2177,7 +2723,7 @@ QHttpServerResponse WebServer::handleSearchStations(const QHttpServerRequest &re
     delete user; // User нам далі не потрібен, лише факт авторизації
 
     // 2. Розбір параметрів запиту
-    QUrlQuery query(request.url());
+    QUrlQuery query = requestQuery(request);
     if (!query.hasQueryItem("terminal")) {
         return createTextResponse("Missing 'terminal' parameter", QHttpServerResponse::StatusCode::BadRequest);
     }
@@ -2197,6 +2743,44 @@ QHttpServerResponse WebServer::handleSearchStations(const QHttpServerRequest &re
 }
 
 
+QHttpServerResponse WebServer::handleGetStationCatalog(const QHttpServerRequest &request)
+{
+    User* user = authenticateRequest(request);
+    if (!user) {
+        return createTextResponse("Unauthorized", QHttpServerResponse::StatusCode::Unauthorized);
+    }
+    delete user;
+
+    // Дешева перевірка версії: без звернення до БД
+    const QString version = DbManager::instance().stationCatalogVersion();
+    const QString clientVersion = requestQuery(request).queryItemValue("version");
+    if (!clientVersion.isEmpty() && clientVersion == version) {
+        return createJsonResponse(QJsonObject{{"version", version}, {"unchanged", true}},
+                                  QHttpServerResponse::StatusCode::Ok);
+    }
+
+    QJsonObject responseBody;
+    responseBody["version"] = version;
+    responseBody["stations"] = DbManager::instance().getStationCatalog();
+    return createJsonResponse(responseBody, QHttpServerResponse::StatusCode::Ok);
+}
+
+QHttpServerResponse WebServer::handleGetReferenceRevision(const QHttpServerRequest &request)
+{
+    User* user = authenticateRequest(request);
+    if (!user) {
+        return createTextResponse("Unauthorized", QHttpServerResponse::StatusCode::Unauthorized);
+    }
+    delete user;
+
+    // Без звернення до БД: лічильник у пам'яті сервера
+    QJsonObject responseBody;
+    responseBody["server_version"] = PROJECT_VERSION_STR;
+    responseBody["revision"] = DbManager::instance().referenceDataRevision();
+    return createJsonResponse(responseBody, QHttpServerResponse::StatusCode::Ok);
+}
+
+
 QHttpServerResponse WebServer::handleGetObjectInfo(const QHttpServerRequest &request)
 {
     // 1. Авторизація десктопного користувача
@@ -2207,7 +2791,7 @@ QHttpServerResponse WebServer::handleGetObjectInfo(const QHttpServerRequest &req
     delete user;
 
     // 2. Отримуємо ID
-    QUrlQuery query(request.url());
+    QUrlQuery query = requestQuery(request);
     int objectId = query.queryItemValue("id").toInt();
 
     // 3. Беремо готові дані з БД (ваш існуючий метод!)
@@ -2231,3 +2815,256 @@ QHttpServerResponse WebServer::handleGetStationWorkplaces(const QString& clientI
 
     return createJsonResponse(data, QHttpServerResponse::StatusCode::Ok);
 }
+
+QHttpServerResponse WebServer::handleGetClientWorkplaces(const QString& clientId, const QHttpServerRequest& request)
+{
+    User* user = authenticateRequest(request);
+    if (!user) {
+        return createJsonResponse(QJsonObject{{"error", "Unauthorized"}}, QHttpServerResponse::StatusCode::Unauthorized);
+    }
+    delete user;
+
+    const int terminalId = requestQuery(request).queryItemValue("terminal").toInt();
+    QJsonArray data = DbManager::instance().getWorkplacesByClient(clientId.toInt(), terminalId);
+    return createJsonResponse(data, QHttpServerResponse::StatusCode::Ok);
+}
+
+QHttpServerResponse WebServer::handlePostReachability(const QString& clientId, const QHttpServerRequest& request)
+{
+    User* user = authenticateRequest(request);
+    if (!user) {
+        return createJsonResponse(QJsonObject{{"error", "Unauthorized"}}, QHttpServerResponse::StatusCode::Unauthorized);
+    }
+    delete user;
+
+    QJsonParseError parseError;
+    QJsonDocument doc = QJsonDocument::fromJson(request.body(), &parseError);
+    if (parseError.error != QJsonParseError::NoError || !doc.isArray()) {
+        return createJsonResponse(QJsonObject{{"error", "Expected JSON array of results"}}, QHttpServerResponse::StatusCode::BadRequest);
+    }
+
+    // Приймаємо лише каси цього клієнта: інакше будь-хто міг би наповнювати кеш чужими ключами
+    const int client = clientId.toInt();
+    QSet<QString> ownWorkplaces;
+    const QJsonArray workplaces = DbManager::instance().getWorkplacesByClient(client, 0);
+    for (const QJsonValue& value : workplaces) {
+        const QJsonObject wp = value.toObject();
+        ownWorkplaces.insert(QString("%1/%2").arg(wp["terminal_id"].toInt()).arg(wp["workplace_id"].toInt()));
+    }
+
+    const AppParams& params = AppParams::instance();
+    const int maxEntries = qMax(1, params.getParam("Global", "ReachabilityMaxPerClient", 2000).toInt());
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+
+    // Кеш лише в пам'яті: це оперативний стан, а не історія
+    QHash<QString, ReachabilityEntry>& cache = m_reachabilityCache[client];
+    pruneReachability(&cache, nowMs);
+
+    int accepted = 0;
+    int rejected = 0;
+    for (const QJsonValue& value : doc.array()) {
+        const QJsonObject entry = value.toObject();
+        const QString key = QString("%1/%2").arg(entry["terminal_id"].toInt()).arg(entry["workplace_id"].toInt());
+        if (!ownWorkplaces.contains(key) || (!cache.contains(key) && cache.size() >= maxEntries)) {
+            ++rejected;
+            continue;
+        }
+
+        // Копіюємо лише відомі поля — довільні дані клієнта назад не віддаємо
+        QJsonObject result;
+        result["terminal_id"] = entry["terminal_id"].toInt();
+        result["workplace_id"] = entry["workplace_id"].toInt();
+        result["reachable"] = entry["reachable"].toBool();
+        result["rtt_ms"] = entry["rtt_ms"].toInt();
+        const QString method = entry["method"].toString();
+        result["method"] = method == "icmp" ? "icmp" : "tcp";
+        const QString error = entry["error"].toString();
+        if (!error.isEmpty()) result["error"] = error.left(256);
+        const QDateTime checkedAt = QDateTime::fromString(entry["checked_at"].toString(), Qt::ISODate);
+        result["checked_at"] = (checkedAt.isValid() ? checkedAt.toUTC() : QDateTime::currentDateTimeUtc()).toString(Qt::ISODate);
+
+        cache.insert(key, ReachabilityEntry{result, nowMs});
+        ++accepted;
+    }
+    if (cache.isEmpty()) m_reachabilityCache.remove(client);
+    if (rejected > 0) {
+        logWarning() << "Reachability: Rejected" << rejected << "results for client" << client
+                     << "(unknown workplace or per-client limit reached)";
+    }
+
+    return createJsonResponse(QJsonObject{{"accepted", accepted}, {"rejected", rejected}}, QHttpServerResponse::StatusCode::Ok);
+}
+
+QHttpServerResponse WebServer::handleGetReachability(const QString& clientId, const QHttpServerRequest& request)
+{
+    User* user = authenticateRequest(request);
+    if (!user) {
+        return createJsonResponse(QJsonObject{{"error", "Unauthorized"}}, QHttpServerResponse::StatusCode::Unauthorized);
+    }
+    delete user;
+
+    QJsonArray result;
+    auto cacheIt = m_reachabilityCache.find(clientId.toInt());
+    if (cacheIt != m_reachabilityCache.end()) {
+        pruneReachability(&cacheIt.value(), QDateTime::currentMSecsSinceEpoch());
+        for (auto it = cacheIt->constBegin(); it != cacheIt->constEnd(); ++it) {
+            result.append(it->result);
+        }
+        if (cacheIt->isEmpty()) m_reachabilityCache.erase(cacheIt);
+    }
+    return createJsonResponse(result, QHttpServerResponse::StatusCode::Ok);
+}
+
+void WebServer::pruneReachability(QHash<QString, ReachabilityEntry>* cache, qint64 nowMs) const
+{
+    const qint64 ttlMs = qMax(1, AppParams::instance().getParam("Global", "ReachabilityTtlSec", 86400).toInt()) * 1000LL;
+    for (auto it = cache->begin(); it != cache->end();) {
+        if (nowMs - it->receivedMs >= ttlMs) it = cache->erase(it);
+        else ++it;
+    }
+}
+
+QUrlQuery WebServer::requestQuery(const QHttpServerRequest &request) const
+{
+    return m_batchContext ? m_batchContext->query : QUrlQuery(request.url());
+}
+
+void WebServer::setupBatchRoutes()
+{
+    // Лише обробники, що читають з БД/пам'яті синхронно: поки виконується підзапит, цикл подій
+    // не крутиться, тож m_batchContext не "протече" в інший запит
+    m_batchRoutes = {
+        {"/api/users", [this](const QStringList&, const QHttpServerRequest& r) { return handleGetUsersRequest(r); }},
+        {"/api/users/<arg>", [this](const QStringList& a, const QHttpServerRequest& r) { return handleGetUserByIdRequest(a.at(0), r); }},
+        {"/api/roles", [this](const QStringList&, const QHttpServerRequest& r) { return handleGetRolesRequest(r); }},
+        {"/api/clients", [this](const QStringList&, const QHttpServerRequest& r) { return handleGetClientsRequest(r); }},
+        {"/api/clients/<arg>", [this](const QStringList& a, const QHttpServerRequest& r) { return handleGetClientByIdRequest(a.at(0), r); }},
+        {"/api/ip-gen-methods", [this](const QStringList&, const QHttpServerRequest& r) { return handleGetIpGenMethodsRequest(r); }},
+        {"/api/settings/<arg>", [this](const QStringList& a, const QHttpServerRequest& r) { return handleGetSettingsRequest(a.at(0), r); }},
+        {"/api/clients/<arg>/sync-status", [this](const QStringList& a, const QHttpServerRequest& r) { return handleGetSyncStatusRequest(a.at(0), r); }},
+        {"/api/objects", [this](const QStringList&, const QHttpServerRequest& r) { return handleGetObjectsRequest(r); }},
+        {"/api/regions-list", [this](const QStringList&, const QHttpServerRequest& r) { return handleGetRegionsListRequest(r); }},
+        {"/api/export-tasks", [this](const QStringList&, const QHttpServerRequest& r) { return handleGetAllExportTasksRequest(r); }},
+        {"/api/stations/search", [this](const QStringList&, const QHttpServerRequest& r) { return handleSearchStations(r); }},
+        {"/api/stations/catalog", [this](const QStringList&, const QHttpServerRequest& r) { return handleGetStationCatalog(r); }},
+        {"/api/reference/revision", [this](const QStringList&, const QHttpServerRequest& r) { return handleGetReferenceRevision(r); }},
+        {"/api/objects/info", [this](const QStringList&, const QHttpServerRequest& r) { return handleGetObjectInfo(r); }},
+        {"/api/clients/<arg>/station/<arg>/workplaces", [this](const QStringList& a, const QHttpServerRequest& r) { return handleGetStationWorkplaces(a.at(0), a.at(1), r); }},
+        {"/api/clients/<arg>/workplaces", [this](const QStringList& a, const QHttpServerRequest& r) { return handleGetClientWorkplaces(a.at(0), r); }},
+        {"/api/clients/<arg>/reachability", [this](const QStringList& a, const QHttpServerRequest& r) { return handleGetReachability(a.at(0), r); }},
+    };
+}
+
+QHttpServerResponse WebServer::handleBatchRequest(const QHttpServerRequest &request)
+{
+    logRequest(request);
+    User* user = authenticateRequest(request);
+    if (!user) {
+        return createJsonResponse(QJsonObject{{"error", "Unauthorized"}}, QHttpServerResponse::StatusCode::Unauthorized);
+    }
+    const std::unique_ptr<User> userGuard(user);
+
+    const QJsonDocument doc = QJsonDocument::fromJson(request.body());
+    const QJsonArray requests = doc.object().value("requests").toArray();
+    if (!doc.isObject() || requests.isEmpty()) {
+        return createJsonResponse(QJsonObject{{"error", "Expected {\"requests\": [...]}"}}, QHttpServerResponse::StatusCode::BadRequest);
+    }
+    if (requests.size() > m_batchMaxItems) {
+        return createJsonResponse(QJsonObject{{"error", QString("Too many requests in batch (max %1)").arg(m_batchMaxItems)}},
+                                  QHttpServerResponse::StatusCode::BadRequest);
+    }
+
+    static Histogram& batchSize = MetricsRegistry::instance().histogram(
+        "conduit_batch_size", "Sub-requests per /api/batch call.", {}, MetricsRegistry::sizeBuckets());
+    batchSize.observe(requests.size());
+
+    // Пакет займає один токен класу Light, а кожен підзапит платить у своєму класі,
+    // тож двадцять важких вибірок у пакеті коштують стільки ж, скільки двадцять окремих
+    RateLimiter& limiter = RateLimiter::instance();
+    const QString identity = rateLimitIdentity(request);
+
+    QJsonArray responses;
+    for (int i = 0; i < requests.size(); ++i) {
+        const QJsonObject item = requests.at(i).toObject();
+        const QJsonValue id = item.contains("id") ? item.value("id") : QJsonValue(QString::number(i));
+        const QString method = item.value("method").toString("GET").toUpper();
+        const QString path = QUrl(item.value("path").toString()).path();
+
+        // query — рядок "a=1&b=2" або об'єкт {"a": 1}
+        QUrlQuery query;
+        const QJsonValue queryValue = item.value("query");
+        if (queryValue.isString()) {
+            query.setQuery(queryValue.toString());
+        } else {
+            const QJsonObject queryObject = queryValue.toObject();
+            for (auto it = queryObject.constBegin(); it != queryObject.constEnd(); ++it) {
+                query.addQueryItem(it.key(), it.value().toVariant().toString());
+            }
+        }
+
+        QJsonObject result{{"id", id}};
+        if (method != "GET") {
+            result["status"] = 405;
+            result["body"] = QJsonObject{{"error", "Only GET requests can be batched"}};
+            responses.append(result);
+            continue;
+        }
+
+        // Шукаємо маршрут: сегменти збігаються, "<arg>" — будь-який непорожній сегмент
+        const BatchRoute* route = nullptr;
+        QStringList args;
+        for (const BatchRoute& candidate : std::as_const(m_batchRoutes)) {
+            if (RoutePattern::match(candidate.pattern, path, &args)) {
+                route = &candidate;
+                break;
+            }
+        }
+        if (!route) {
+            result["status"] = 404;
+            result["body"] = QJsonObject{{"error", "Route is not available in batch: " + path}};
+            responses.append(result);
+            continue;
+        }
+
+        const RateLimiter::RouteClass routeClass = RateLimiter::classify(route->pattern, method);
+        const RateLimiter::Decision decision = limiter.charge(identity, routeClass);
+        if (!decision.allowed) {
+            MetricsRegistry::instance().counter("conduit_http_rejected_total", "Requests rejected by rate limiting or load shedding.",
+                                                {{"class", RateLimiter::className(routeClass)}, {"reason", "rate"}}).inc();
+            result["status"] = 429;
+            result["retry_after"] = decision.retryAfterSec;
+            result["body"] = QJsonObject{{"error", "Too many requests, try again later"}};
+            responses.append(result);
+            continue;
+        }
+
+        const BatchContext context{user, query};
+        QHttpServerResponse response = [&] {
+            m_batchContext = &context;
+            const auto restore = qScopeGuard([this] { m_batchContext = nullptr; });
+            return route->handler(args, request);
+        }();
+
+        const QByteArray body = response.data();
+        result["status"] = static_cast<int>(response.statusCode());
+
+        // Умовний GET на рівні підзапиту: той самий ETag, що дав би окремий запит (applyConditionalGet)
+        if (response.statusCode() == QHttpServerResponse::StatusCode::Ok && response.mimeType() == "application/json") {
+            const QByteArray etag = ConditionalGet::etagFor(body);
+            result["etag"] = QString::fromLatin1(etag);
+            if (ConditionalGet::matches(item.value("if_none_match").toString().toLatin1(), etag)) {
+                result["status"] = 304;
+                responses.append(result);
+                continue;
+            }
+        }
+
+        const QJsonDocument bodyDoc = QJsonDocument::fromJson(body);
+        if (bodyDoc.isObject()) result["body"] = bodyDoc.object();
+        else if (bodyDoc.isArray()) result["body"] = bodyDoc.array();
+        else if (!body.isEmpty()) result["body"] = QString::fromUtf8(body);
+        responses.append(result);
+    }
+
+    return createJsonResponse(QJsonObject{{"responses", responses}}, QHttpServerResponse::StatusCode::Ok);
+}
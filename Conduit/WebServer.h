@@ -1,11 +1,20 @@
 #ifndef WEBSERVER_H
 #define WEBSERVER_H
 #include "Oracle/User.h"
+#include "TrackerIssueCache.h"
 #include <QObject>
 #include <QHttpServerResponse> // Додаємо, оскільки метод повертає цей тип
+#include <QHash>
+#include <QSet>
+#include <QVariantMap>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <QUrlQuery>
+#include <functional>
 
 class QHttpServer;
 class QHttpServerRequest;
+class QWebSocket;
 
 class WebServer : public QObject
 {
@@ -18,13 +27,51 @@ private:
     // Метод для налаштування всіх маршрутів
     void setupRoutes();
     void logRequest(const QHttpServerRequest &request); // Допоміжний метод для логування
+    // Виконує обробник маршруту в трасі запиту і записує метрики: кількість, код відповіді, час (route — шаблон маршруту)
+    QHttpServerResponse observeRoute(const QString &route, const QHttpServerRequest &request,
+                                     const std::function<QHttpServerResponse()> &handler);
+    // Ключ особи для RateLimiter — лише з заголовків і пам'яті, без звернення до БД (відмова має бути дешевою)
+    QString rateLimitIdentity(const QHttpServerRequest &request) const;
+    void rememberSession(const QByteArray &tokenHash);
+    // 429 / 503 з Retry-After для запиту, який RateLimiter не допустив
+    QHttpServerResponse createRejectedResponse(int retryAfterSec, bool overloaded);
+    // Після зміни глобальних налаштувань: оновити AppParams з БД і ліміти RateLimiter
+    void reloadRateLimits();
+    QHttpServerResponse handleMetricsRequest(const QHttpServerRequest &request);
+    QHttpServerResponse handleGetTracesRequest(const QHttpServerRequest &request);
     User* authenticateRequest(const QHttpServerRequest &request); // Перевіряє токен із запиту і повертає об'єкт User, якщо токен валідний
+    // Query-параметри запиту; всередині /api/batch — параметри поточного підзапиту
+    QUrlQuery requestQuery(const QHttpServerRequest &request) const;
+    User* authenticateHeaders(const QByteArray &authHeader, const QByteArray &botTokenHeader,
+                              const QByteArray &telegramIdHeader); // Та сама перевірка, але за готовими заголовками
+
+    // --- Push-канал подій синхронізації (WebSocket /api/events/sync) ---
+    void onNewWebSocketConnection();
+    void broadcastSyncEvent(const QJsonObject &event);
     // Замінюємо старий logResponse на нові методи-помічники
     QHttpServerResponse createTextResponse(const QByteArray &body,
                                            QHttpServerResponse::StatusCode statusCode);
     QHttpServerResponse createJsonResponse(const QJsonObject &body,
                                            QHttpServerResponse::StatusCode statusCode);
     QHttpServerResponse createJsonResponse(const QJsonArray &body, QHttpServerResponse::StatusCode statusCode);
+    /**
+     * @brief Параметри сторінки списку задач трекера: ?cursor=<зміщення>&limit=<розмір>.
+     * Розмір за замовчуванням — Global/TrackerPageSize (50), не більше TrackerMaxPageSize (100).
+     */
+    static void readPageRequest(const QHttpServerRequest &request, int *cursor, int *limit);
+    // Сторінка списку: масив у тілі (як і раніше) + X-Total-Count, X-Next-Cursor (якщо є наступна сторінка),
+    // Age (секунд від отримання з трекера) та X-Cache (HIT/MISS)
+    QHttpServerResponse createPageResponse(const TrackerIssueCache::Page &page);
+    // Довідкові дані з ReferenceResponseCache; build() — побудова при промаху (X-Cache: HIT/MISS)
+    QHttpServerResponse createReferenceResponse(const QString &key, const std::function<QJsonDocument()> &build);
+    /**
+     * @brief Умовний GET (ConditionalGet) для відповідей на GET-запити: ETag до JSON-відповідей 200
+     * і 304 Not Modified, якщо клієнт надіслав такий самий If-None-Match.
+     * Викликається для кожної відповіді через QHttpServer::afterRequest.
+     */
+    QHttpServerResponse applyConditionalGet(QHttpServerResponse &&response, const QHttpServerRequest &request);
+    // Стиснення тіла (ResponseCompressor, gzip / deflate) за Accept-Encoding; виконується після applyConditionalGet
+    QHttpServerResponse applyCompression(QHttpServerResponse &&response, const QHttpServerRequest &request);
     // Маршрут "/"
     QHttpServerResponse handleRootRequest(const QHttpServerRequest &request);
     // маршрут /status
@@ -141,14 +188,79 @@ private:
      */
     QHttpServerResponse handleSearchStations(const QHttpServerRequest& request);
 
+    /**
+     * @brief Довідник АЗС для локального пошуку.
+     * Маршрут: GET /api/stations/catalog?version=XXXX
+     * Якщо версія клієнта актуальна — повертає лише {"version", "unchanged": true}.
+     */
+    QHttpServerResponse handleGetStationCatalog(const QHttpServerRequest& request);
+
+    /**
+     * @brief Дешева перевірка актуальності локального кешу довідкових даних Gandalf.
+     * Маршрут: GET /api/reference/revision -> {"server_version", "revision"}
+     */
+    QHttpServerResponse handleGetReferenceRevision(const QHttpServerRequest& request);
+
     QHttpServerResponse handleGetObjectInfo(const QHttpServerRequest &request);
 
     // GET /api/clients/<clientId>/station/<terminalNo>/workplaces
     QHttpServerResponse handleGetStationWorkplaces(const QString& clientId, const QString& terminalNo, const QHttpServerRequest& request);
+
+    // GET /api/clients/<clientId>/workplaces[?terminal=N] — каси клієнта (для масового сканування)
+    QHttpServerResponse handleGetClientWorkplaces(const QString& clientId, const QHttpServerRequest& request);
+
+    /**
+     * @brief Остання відома доступність кас клієнта.
+     * POST /api/clients/<clientId>/reachability — Gandalf надсилає результати сканування
+     * GET  /api/clients/<clientId>/reachability — останній стан по кожному робочому місцю
+     * Зберігаються лише відомі поля і лише для кас цього клієнта. Налаштування (Global):
+     * ReachabilityTtlSec (86400) — скільки живе результат, ReachabilityMaxPerClient (2000).
+     */
+    QHttpServerResponse handlePostReachability(const QString& clientId, const QHttpServerRequest& request);
+    QHttpServerResponse handleGetReachability(const QString& clientId, const QHttpServerRequest& request);
+
+    /**
+     * @brief Пакет GET-запитів Gandalf одним HTTP-запитом.
+     * POST /api/batch {"requests": [{"id", "method": "GET", "path", "query", "if_none_match"}]}
+     * -> {"responses": [{"id", "status", "etag", "body"}]}. Автентифікація — один раз на пакет.
+     * Збіг if_none_match з ETag підзапиту дає status 304 без body; ліміт запитів —
+     * окремо для кожного підзапиту в його класі (status 429 і retry_after).
+     */
+    QHttpServerResponse handleBatchRequest(const QHttpServerRequest &request);
+    // Маршрути, доступні в пакеті (лише читання з БД, без очікування на трекери)
+    void setupBatchRoutes();
 private:
+    // Підзапит пакета: шаблон шляху ("<arg>" — будь-який сегмент) і обробник
+    struct BatchRoute {
+        QString pattern;
+        std::function<QHttpServerResponse(const QStringList &args, const QHttpServerRequest &request)> handler;
+    };
+    // Результат перевірки каси і час, коли Conduit його отримав (для ReachabilityTtlSec)
+    struct ReachabilityEntry {
+        QJsonObject result;
+        qint64 receivedMs = 0;
+    };
+    // Прибирає результати, старші за ReachabilityTtlSec
+    void pruneReachability(QHash<QString, ReachabilityEntry>* cache, qint64 nowMs) const;
+
+    // Стан підзапиту /api/batch, що виконується зараз (користувач і його query)
+    struct BatchContext {
+        const User* user;
+        QUrlQuery query;
+    };
+
     QHttpServer* m_httpServer;
     quint16 m_port;
     QString m_botApiKey;
+    QList<QWebSocket*> m_syncSubscribers; // Підписники на події синхронізації
+    // clientId -> ("terminalId/workplaceId" -> останній результат перевірки)
+    QHash<int, QHash<QString, ReachabilityEntry>> m_reachabilityCache;
+    TrackerIssueCache* m_trackerCache; // Списки задач Jira/Redmine користувачів
+    QList<BatchRoute> m_batchRoutes;
+    const BatchContext* m_batchContext = nullptr;
+    int m_batchMaxItems;
+    QSet<QByteArray> m_knownSessions; // SHA-256 токенів, що пройшли автентифікацію (для RateLimiter)
+    QVariantMap m_globalSettings;     // Global, з якими востаннє перечитано ліміти
 };
 
 #endif // WEBSERVER_H
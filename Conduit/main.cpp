@@ -11,6 +11,7 @@
 #include "Oracle/AppParams.h"
 #include "Oracle/ConfigManager.h"
 #include "Oracle/DbManager.h"
+#include "Oracle/DbEventListener.h"
 #include "WebServer.h"
 
 int main(int argc, char *argv[])
@@ -108,6 +109,11 @@ int main(int argc, char *argv[])
 
     reconfigureLoggerFilters();
 
+    // Події змін у БД від інших процесів (тригери з POST_EVENT) — для скидання кешів
+    if (params.getParam("Global", "DbEventsEnabled", true).toBool()) {
+        DbEventListener::instance().start();
+    }
+
     // Отримуємо порт з налаштувань бази даних, з резервним значенням 8080
     quint16 port = params.getParam(appName, "ServerPort", 8080).toUInt();
 
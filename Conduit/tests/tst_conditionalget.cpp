@@ -0,0 +1,114 @@
+#include "../ConditionalGet.h"
+
+#include <QHttpServerResponse>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QTest>
+
+class TestConditionalGet : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void etagIsSha1OfBody();
+    void matches_data();
+    void matches();
+
+    void addsEtagToJsonResponse();
+    void answersNotModifiedOnMatch();
+    void keepsBodyOnMismatch();
+    void leavesOtherResponsesAlone();
+};
+
+void TestConditionalGet::etagIsSha1OfBody()
+{
+    QCOMPARE(ConditionalGet::etagFor("abc"), QByteArray("\"a9993e364706816aba3e25717850c26c9cd0d89d\""));
+    QCOMPARE(ConditionalGet::etagFor("abc"), ConditionalGet::etagFor("abc"));
+    QVERIFY(ConditionalGet::etagFor("abc") != ConditionalGet::etagFor("abd"));
+}
+
+void TestConditionalGet::matches_data()
+{
+    QTest::addColumn<QByteArray>("ifNoneMatch");
+    QTest::addColumn<bool>("expected");
+
+    QTest::newRow("exact") << QByteArray("\"e1\"") << true;
+    QTest::newRow("weak") << QByteArray("W/\"e1\"") << true;
+    QTest::newRow("list") << QByteArray("\"e0\", W/\"e1\"") << true;
+    QTest::newRow("any") << QByteArray("*") << true;
+    QTest::newRow("other") << QByteArray("\"e2\"") << false;
+    QTest::newRow("unquoted") << QByteArray("e1") << false;
+    QTest::newRow("empty") << QByteArray() << false;
+}
+
+void TestConditionalGet::matches()
+{
+    QFETCH(QByteArray, ifNoneMatch);
+    QFETCH(bool, expected);
+    QCOMPARE(ConditionalGet::matches(ifNoneMatch, "\"e1\""), expected);
+}
+
+void TestConditionalGet::addsEtagToJsonResponse()
+{
+    QHttpServerResponse response(QJsonArray{1, 2, 3});
+    const QByteArray body = response.data();
+
+    const QHttpServerResponse result = ConditionalGet::apply(std::move(response), QByteArray());
+
+    QCOMPARE(result.statusCode(), QHttpServerResponse::StatusCode::Ok);
+    QCOMPARE(result.data(), body);
+    QCOMPARE(result.headers("ETag").value(0), ConditionalGet::etagFor(body));
+    QCOMPARE(result.headers("Cache-Control").value(0), QByteArray("no-cache"));
+}
+
+void TestConditionalGet::answersNotModifiedOnMatch()
+{
+    QHttpServerResponse response(QJsonArray{1, 2, 3});
+    response.setHeader("X-Total-Count", "42");
+    response.setHeader("X-Next-Cursor", "3");
+    response.setHeader("X-Request-ID", "req-1");
+    const QByteArray etag = ConditionalGet::etagFor(response.data());
+
+    // Клієнт отримав стиснуту відповідь зі слабким ETag і повертає його
+    const QHttpServerResponse result = ConditionalGet::apply(std::move(response), "W/" + etag);
+
+    QCOMPARE(result.statusCode(), QHttpServerResponse::StatusCode::NotModified);
+    QVERIFY(result.data().isEmpty());
+    QCOMPARE(result.headers("ETag").value(0), etag);
+    QCOMPARE(result.headers("Cache-Control").value(0), QByteArray("no-cache"));
+    // Заголовки сторінки не входять у тіло — 304 мусить їх нести
+    QCOMPARE(result.headers("X-Total-Count").value(0), QByteArray("42"));
+    QCOMPARE(result.headers("X-Next-Cursor").value(0), QByteArray("3"));
+    QCOMPARE(result.headers("X-Request-ID").value(0), QByteArray("req-1"));
+}
+
+void TestConditionalGet::keepsBodyOnMismatch()
+{
+    QHttpServerResponse response(QJsonObject{{"a", 1}});
+    const QByteArray body = response.data();
+
+    const QHttpServerResponse result = ConditionalGet::apply(std::move(response), "\"stale\"");
+
+    QCOMPARE(result.statusCode(), QHttpServerResponse::StatusCode::Ok);
+    QCOMPARE(result.data(), body);
+    QCOMPARE(result.headers("ETag").value(0), ConditionalGet::etagFor(body));
+}
+
+void TestConditionalGet::leavesOtherResponsesAlone()
+{
+    // Помилка з JSON-тілом: кешувати нічого
+    QHttpServerResponse error(QJsonObject{{"error", "Not found"}}, QHttpServerResponse::StatusCode::NotFound);
+    const QHttpServerResponse errorResult = ConditionalGet::apply(std::move(error), "*");
+    QCOMPARE(errorResult.statusCode(), QHttpServerResponse::StatusCode::NotFound);
+    QVERIFY(!errorResult.hasHeader("ETag"));
+
+    // Не JSON
+    QHttpServerResponse text(QByteArrayLiteral("text/plain"), QByteArrayLiteral("hello"));
+    const QHttpServerResponse textResult = ConditionalGet::apply(std::move(text), "*");
+    QCOMPARE(textResult.statusCode(), QHttpServerResponse::StatusCode::Ok);
+    QCOMPARE(textResult.data(), QByteArray("hello"));
+    QVERIFY(!textResult.hasHeader("ETag"));
+}
+
+QTEST_GUILESS_MAIN(TestConditionalGet)
+#include "tst_conditionalget.moc"
@@ -0,0 +1,241 @@
+#include "../RateLimiter.h"
+#include "Oracle/AppParams.h"
+
+#include <QTest>
+
+/**
+ * RateLimiter — singleton: init() повертає базові ліміти через AppParams і reload().
+ * Кошики переживають reload(), тож кожен тест бере свої особи.
+ */
+class TestRateLimiter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+
+    void burstThenRejects();
+    void retryAfterFollowsRate();
+    void identitiesAndClassesAreIndependent();
+    void refillsOverTime();
+    void limitsInFlightPerClassAndTotal();
+    void exemptIsAlwaysAllowed();
+    void disabledAllowsEverything();
+    void chargeDoesNotOccupyInFlight();
+    void reloadKeepsBucketsAndClampsBurst();
+    void classify_data();
+    void classify();
+    void prunesRefilledBuckets();
+
+private:
+    static void set(const QString& key, const QVariant& value);
+};
+
+void TestRateLimiter::set(const QString &key, const QVariant &value)
+{
+    AppParams::instance().setParam("Global", key, value);
+}
+
+void TestRateLimiter::init()
+{
+    set("RateLimitEnabled", true);
+    set("RateLimitLightPerMin", 60);   // 1 токен/с
+    set("RateLimitLightBurst", 3);
+    set("MaxInFlightLight", 0);
+    set("RateLimitHeavyPerMin", 6);    // 1 токен за 10 с
+    set("RateLimitHeavyBurst", 2);
+    set("MaxInFlightHeavy", 2);
+    set("MaxInFlightTotal", 3);
+    set("RateLimitPruneIntervalSec", 60);
+    RateLimiter::instance().reload();
+}
+
+void TestRateLimiter::burstThenRejects()
+{
+    RateLimiter& limiter = RateLimiter::instance();
+    for (int i = 0; i < 3; ++i) {
+        QVERIFY(limiter.admit("burst", RateLimiter::RouteClass::Light).allowed);
+        limiter.release(RateLimiter::RouteClass::Light);
+    }
+
+    const RateLimiter::Decision decision = limiter.admit("burst", RateLimiter::RouteClass::Light);
+    QVERIFY(!decision.allowed);
+    QVERIFY(!decision.overloaded); // 429, а не 503
+    QCOMPARE(decision.retryAfterSec, 1);
+}
+
+void TestRateLimiter::retryAfterFollowsRate()
+{
+    RateLimiter& limiter = RateLimiter::instance();
+    QVERIFY(limiter.charge("slow", RateLimiter::RouteClass::Heavy).allowed);
+    QVERIFY(limiter.charge("slow", RateLimiter::RouteClass::Heavy).allowed);
+
+    // 6 за хвилину — наступний токен через 10 с
+    const RateLimiter::Decision decision = limiter.charge("slow", RateLimiter::RouteClass::Heavy);
+    QVERIFY(!decision.allowed);
+    QCOMPARE(decision.retryAfterSec, 10);
+}
+
+void TestRateLimiter::identitiesAndClassesAreIndependent()
+{
+    RateLimiter& limiter = RateLimiter::instance();
+    for (int i = 0; i < 3; ++i) limiter.charge("alice", RateLimiter::RouteClass::Light);
+    QVERIFY(!limiter.charge("alice", RateLimiter::RouteClass::Light).allowed);
+
+    QVERIFY(limiter.charge("bob", RateLimiter::RouteClass::Light).allowed);
+    QVERIFY(limiter.charge("alice", RateLimiter::RouteClass::Heavy).allowed);
+}
+
+void TestRateLimiter::refillsOverTime()
+{
+    set("RateLimitLightPerMin", 600); // 1 токен за 100 мс
+    set("RateLimitLightBurst", 1);
+    RateLimiter& limiter = RateLimiter::instance();
+    limiter.reload();
+
+    QVERIFY(limiter.charge("refill", RateLimiter::RouteClass::Light).allowed);
+    QVERIFY(!limiter.charge("refill", RateLimiter::RouteClass::Light).allowed);
+
+    QTest::qWait(150);
+    QVERIFY(limiter.charge("refill", RateLimiter::RouteClass::Light).allowed);
+    QVERIFY(!limiter.charge("refill", RateLimiter::RouteClass::Light).allowed); // Не більше за burst
+}
+
+void TestRateLimiter::limitsInFlightPerClassAndTotal()
+{
+    RateLimiter& limiter = RateLimiter::instance();
+
+    // MaxInFlightHeavy = 2
+    QVERIFY(limiter.admit("heavy-1", RateLimiter::RouteClass::Heavy).allowed);
+    QVERIFY(limiter.admit("heavy-2", RateLimiter::RouteClass::Heavy).allowed);
+    const RateLimiter::Decision busy = limiter.admit("heavy-3", RateLimiter::RouteClass::Heavy);
+    QVERIFY(!busy.allowed);
+    QVERIFY(busy.overloaded);
+    QCOMPARE(busy.retryAfterSec, 1);
+
+    limiter.release(RateLimiter::RouteClass::Heavy);
+    QVERIFY(limiter.admit("heavy-3", RateLimiter::RouteClass::Heavy).allowed);
+
+    // MaxInFlightTotal = 3: два важкі вже в роботі, тож легкий проходить лише один
+    QVERIFY(limiter.admit("light-1", RateLimiter::RouteClass::Light).allowed);
+    const RateLimiter::Decision full = limiter.admit("light-2", RateLimiter::RouteClass::Light);
+    QVERIFY(!full.allowed);
+    QVERIFY(full.overloaded);
+
+    limiter.release(RateLimiter::RouteClass::Heavy);
+    limiter.release(RateLimiter::RouteClass::Heavy);
+    limiter.release(RateLimiter::RouteClass::Light);
+    QVERIFY(limiter.admit("light-2", RateLimiter::RouteClass::Light).allowed);
+    limiter.release(RateLimiter::RouteClass::Light);
+}
+
+void TestRateLimiter::exemptIsAlwaysAllowed()
+{
+    RateLimiter& limiter = RateLimiter::instance();
+    const int buckets = limiter.bucketCount();
+    for (int i = 0; i < 100; ++i) {
+        QVERIFY(limiter.admit("status", RateLimiter::RouteClass::Exempt).allowed);
+    }
+    QCOMPARE(limiter.bucketCount(), buckets);
+    QVERIFY(limiter.admit("status-light", RateLimiter::RouteClass::Light).allowed); // Місць "у роботі" не зайнято
+    limiter.release(RateLimiter::RouteClass::Light);
+}
+
+void TestRateLimiter::disabledAllowsEverything()
+{
+    set("RateLimitEnabled", false);
+    RateLimiter& limiter = RateLimiter::instance();
+    limiter.reload();
+    QVERIFY(!limiter.isEnabled());
+
+    for (int i = 0; i < 10; ++i) {
+        QVERIFY(limiter.admit("disabled", RateLimiter::RouteClass::Heavy).allowed);
+        QVERIFY(limiter.charge("disabled", RateLimiter::RouteClass::Heavy).allowed);
+    }
+    for (int i = 0; i < 10; ++i) limiter.release(RateLimiter::RouteClass::Heavy);
+}
+
+void TestRateLimiter::chargeDoesNotOccupyInFlight()
+{
+    RateLimiter& limiter = RateLimiter::instance();
+    for (int i = 0; i < 5; ++i) {
+        QVERIFY(limiter.charge(QString("batch-%1").arg(i), RateLimiter::RouteClass::Heavy).allowed);
+    }
+
+    // Після п'яти підзапитів усі три місця MaxInFlightTotal вільні
+    for (int i = 0; i < 3; ++i) {
+        QVERIFY(limiter.admit(QString("after-batch-%1").arg(i), RateLimiter::RouteClass::Light).allowed);
+    }
+    for (int i = 0; i < 3; ++i) limiter.release(RateLimiter::RouteClass::Light);
+}
+
+void TestRateLimiter::reloadKeepsBucketsAndClampsBurst()
+{
+    RateLimiter& limiter = RateLimiter::instance();
+    for (int i = 0; i < 3; ++i) limiter.charge("empty", RateLimiter::RouteClass::Light);
+    limiter.charge("partial", RateLimiter::RouteClass::Light); // Лишилось 2 токени
+    const int buckets = limiter.bucketCount();
+
+    // Та сама конфігурація: спорожнілий кошик не отримує новий burst
+    limiter.reload();
+    QCOMPARE(limiter.bucketCount(), buckets);
+    QVERIFY(!limiter.charge("empty", RateLimiter::RouteClass::Light).allowed);
+
+    // Менший burst обрізає запас
+    set("RateLimitLightBurst", 1);
+    limiter.reload();
+    QVERIFY(limiter.charge("partial", RateLimiter::RouteClass::Light).allowed);
+    QVERIFY(!limiter.charge("partial", RateLimiter::RouteClass::Light).allowed);
+}
+
+void TestRateLimiter::classify_data()
+{
+    QTest::addColumn<QString>("route");
+    QTest::addColumn<QString>("method");
+    QTest::addColumn<int>("expected");
+
+    QTest::newRow("root") << "/" << "GET" << int(RateLimiter::RouteClass::Exempt);
+    QTest::newRow("status") << "/status" << "GET" << int(RateLimiter::RouteClass::Exempt);
+    QTest::newRow("users") << "/api/users" << "GET" << int(RateLimiter::RouteClass::Light);
+    QTest::newRow("batch") << "/api/batch" << "POST" << int(RateLimiter::RouteClass::Light);
+    QTest::newRow("objects") << "/api/objects" << "GET" << int(RateLimiter::RouteClass::Heavy);
+    QTest::newRow("station data") << "/api/clients/<arg>/station/<arg>/tanks" << "GET" << int(RateLimiter::RouteClass::Heavy);
+    QTest::newRow("workplaces") << "/api/clients/<arg>/workplaces" << "GET" << int(RateLimiter::RouteClass::Heavy);
+    QTest::newRow("export list") << "/api/export-tasks" << "GET" << int(RateLimiter::RouteClass::Heavy);
+    QTest::newRow("export create") << "/api/export-tasks" << "POST" << int(RateLimiter::RouteClass::Light);
+    QTest::newRow("sync") << "/api/clients/<arg>/sync" << "POST" << int(RateLimiter::RouteClass::Sync);
+    QTest::newRow("sync status") << "/api/clients/<arg>/sync-status" << "GET" << int(RateLimiter::RouteClass::Light);
+    QTest::newRow("connection test") << "/api/connections/test" << "POST" << int(RateLimiter::RouteClass::Sync);
+    QTest::newRow("jira") << "/api/bot/jira/issues" << "GET" << int(RateLimiter::RouteClass::Tracker);
+    QTest::newRow("redmine") << "/api/bot/redmine/issues" << "POST" << int(RateLimiter::RouteClass::Tracker);
+}
+
+void TestRateLimiter::classify()
+{
+    QFETCH(QString, route);
+    QFETCH(QString, method);
+    QFETCH(int, expected);
+    QCOMPARE(int(RateLimiter::classify(route, method)), expected);
+}
+
+void TestRateLimiter::prunesRefilledBuckets()
+{
+    set("RateLimitLightPerMin", 600); // Кошик з burst 1 наповнюється за 100 мс
+    set("RateLimitLightBurst", 1);
+    set("RateLimitPruneIntervalSec", 0); // Прибирання на кожному зверненні
+    RateLimiter& limiter = RateLimiter::instance();
+    limiter.reload();
+    QTest::qWait(150); // Легкі кошики попередніх тестів теж устигають наповнитись
+
+    limiter.charge("idle", RateLimiter::RouteClass::Light);
+    const int buckets = limiter.bucketCount();
+    limiter.charge("busy", RateLimiter::RouteClass::Light);
+    QCOMPARE(limiter.bucketCount(), buckets + 1); // Щойно використаний кошик не прибирається
+
+    QTest::qWait(150);
+    limiter.charge("next", RateLimiter::RouteClass::Light);
+    QCOMPARE(limiter.bucketCount(), buckets); // "idle" і "busy" прибрано, "next" додано
+}
+
+QTEST_GUILESS_MAIN(TestRateLimiter)
+#include "tst_ratelimiter.moc"
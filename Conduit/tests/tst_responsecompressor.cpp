@@ -0,0 +1,220 @@
+#include "../ResponseCompressor.h"
+
+#include <QHttpServerResponse>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTest>
+#include <QtEndian>
+
+#ifdef CONDUIT_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace {
+
+#ifdef CONDUIT_HAVE_ZLIB
+const bool kHaveGzip = true;
+#else
+const bool kHaveGzip = false;
+#endif
+
+using Encoding = ResponseCompressor::Encoding;
+
+// Тіло, значно більше за CompressionMinBytes (1024) і добре стисливе
+QJsonArray largeArray()
+{
+    QJsonArray array;
+    for (int i = 0; i < 200; ++i) {
+        array.append(QJsonObject{{"id", i}, {"name", "Station"}, {"region", "Kyiv"}});
+    }
+    return array;
+}
+
+// Потік zlib ("deflate" у HTTP) -> дані; qUncompress чекає 4-байтовий префікс довжини
+QByteArray inflateDeflate(const QByteArray& compressed, qsizetype expectedSize)
+{
+    QByteArray prefixed(4, Qt::Uninitialized);
+    qToBigEndian(quint32(expectedSize), prefixed.data());
+    return qUncompress(prefixed + compressed);
+}
+
+#ifdef CONDUIT_HAVE_ZLIB
+QByteArray inflateGzip(const QByteArray& compressed, qsizetype expectedSize)
+{
+    QByteArray out(expectedSize, Qt::Uninitialized);
+    z_stream stream{};
+    if (inflateInit2(&stream, 15 + 16) != Z_OK) return QByteArray();
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(compressed.constData()));
+    stream.avail_in = uInt(compressed.size());
+    stream.next_out = reinterpret_cast<Bytef*>(out.data());
+    stream.avail_out = uInt(out.size());
+    const int result = inflate(&stream, Z_FINISH);
+    inflateEnd(&stream);
+    return result == Z_STREAM_END ? out.left(qsizetype(stream.total_out)) : QByteArray();
+}
+#endif
+
+}
+
+/**
+ * Налаштування за замовчуванням: CompressionLevel 6, CompressionMinBytes 1024.
+ */
+class TestResponseCompressor : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void negotiate_data();
+    void negotiate();
+    void compressibleTypes();
+    void deflateRoundTrip();
+    void gzipRoundTrip();
+
+    void compressesLargeJsonAndCarriesHeaders();
+    void keepsWeakEtagWeak();
+    void identityAddsVaryOnly();
+    void leavesSmallAndIncompressibleBodies();
+};
+
+void TestResponseCompressor::negotiate_data()
+{
+    QTest::addColumn<QByteArray>("acceptEncoding");
+    QTest::addColumn<int>("expected");
+
+    const int gzipOrIdentity = int(kHaveGzip ? Encoding::Gzip : Encoding::Identity);
+    const int gzipOrDeflate = int(kHaveGzip ? Encoding::Gzip : Encoding::Deflate);
+
+    QTest::newRow("empty") << QByteArray() << int(Encoding::Identity);
+    QTest::newRow("identity") << QByteArray("identity") << int(Encoding::Identity);
+    QTest::newRow("deflate") << QByteArray("deflate") << int(Encoding::Deflate);
+    QTest::newRow("gzip") << QByteArray("gzip") << gzipOrIdentity;
+    QTest::newRow("upper case") << QByteArray("GZIP") << gzipOrIdentity;
+    QTest::newRow("both") << QByteArray("gzip, deflate") << gzipOrDeflate;
+    QTest::newRow("gzip refused") << QByteArray("gzip;q=0, deflate") << int(Encoding::Deflate);
+    QTest::newRow("deflate preferred") << QByteArray("deflate;q=0.5, gzip;q=0.4") << int(Encoding::Deflate);
+    QTest::newRow("any") << QByteArray("*") << gzipOrDeflate;
+    QTest::newRow("any refused") << QByteArray("*;q=0") << int(Encoding::Identity);
+    QTest::newRow("all refused") << QByteArray("gzip;q=0, deflate;q=0") << int(Encoding::Identity);
+}
+
+void TestResponseCompressor::negotiate()
+{
+    QFETCH(QByteArray, acceptEncoding);
+    QFETCH(int, expected);
+    QCOMPARE(int(ResponseCompressor::instance().negotiate(acceptEncoding)), expected);
+}
+
+void TestResponseCompressor::compressibleTypes()
+{
+    QVERIFY(ResponseCompressor::isCompressibleType("application/json"));
+    QVERIFY(ResponseCompressor::isCompressibleType("application/json; charset=utf-8"));
+    QVERIFY(ResponseCompressor::isCompressibleType("text/plain"));
+    QVERIFY(!ResponseCompressor::isCompressibleType("image/png"));
+    QVERIFY(!ResponseCompressor::isCompressibleType("application/zip"));
+}
+
+void TestResponseCompressor::deflateRoundTrip()
+{
+    const QByteArray data = QJsonDocument(largeArray()).toJson(QJsonDocument::Compact);
+    const QByteArray compressed = ResponseCompressor::instance().compress(data, Encoding::Deflate);
+    QVERIFY(!compressed.isEmpty());
+    QVERIFY(compressed.size() < data.size());
+    QCOMPARE(inflateDeflate(compressed, data.size()), data);
+
+    // Контекст zlib перевикористовується: другий виклик дає той самий результат
+    QCOMPARE(ResponseCompressor::instance().compress(data, Encoding::Deflate), compressed);
+}
+
+void TestResponseCompressor::gzipRoundTrip()
+{
+#ifdef CONDUIT_HAVE_ZLIB
+    const QByteArray data = QJsonDocument(largeArray()).toJson(QJsonDocument::Compact);
+    const QByteArray compressed = ResponseCompressor::instance().compress(data, Encoding::Gzip);
+    QVERIFY(compressed.startsWith("\x1f\x8b"));
+    QCOMPARE(inflateGzip(compressed, data.size()), data);
+#else
+    QVERIFY(ResponseCompressor::instance().compress("data", Encoding::Gzip).isEmpty());
+    QSKIP("Built without zlib: gzip is not available");
+#endif
+}
+
+void TestResponseCompressor::compressesLargeJsonAndCarriesHeaders()
+{
+    QHttpServerResponse response(largeArray());
+    const QByteArray body = response.data();
+    response.setHeader("ETag", "\"abc\"");
+    response.setHeader("Cache-Control", "no-cache");
+    response.setHeader("X-Total-Count", "200");
+    response.setHeader("X-Next-Cursor", "50");
+    response.setHeader("X-Cache", "HIT");
+    response.setHeader("Age", "3");
+    response.setHeader("X-Request-ID", "req-7");
+
+    const QHttpServerResponse encoded = ResponseCompressor::instance().apply(std::move(response), "deflate");
+
+    QCOMPARE(encoded.statusCode(), QHttpServerResponse::StatusCode::Ok);
+    QCOMPARE(encoded.mimeType(), QByteArray("application/json"));
+    QCOMPARE(encoded.headers("Content-Encoding").value(0), QByteArray("deflate"));
+    QCOMPARE(inflateDeflate(encoded.data(), body.size()), body);
+
+    // Стиснута копія — нова відповідь: усе, що виставили маршрут і afterRequest, має дожити
+    QCOMPARE(encoded.headers("ETag").value(0), QByteArray("W/\"abc\""));
+    QCOMPARE(encoded.headers("Vary").value(0), QByteArray("Accept-Encoding"));
+    QCOMPARE(encoded.headers("Cache-Control").value(0), QByteArray("no-cache"));
+    QCOMPARE(encoded.headers("X-Total-Count").value(0), QByteArray("200"));
+    QCOMPARE(encoded.headers("X-Next-Cursor").value(0), QByteArray("50"));
+    QCOMPARE(encoded.headers("X-Cache").value(0), QByteArray("HIT"));
+    QCOMPARE(encoded.headers("Age").value(0), QByteArray("3"));
+    QCOMPARE(encoded.headers("X-Request-ID").value(0), QByteArray("req-7"));
+    QCOMPARE(encoded.headers("ETag").size(), 1);
+}
+
+void TestResponseCompressor::keepsWeakEtagWeak()
+{
+    QHttpServerResponse response(largeArray());
+    response.setHeader("ETag", "W/\"abc\"");
+
+    const QHttpServerResponse encoded = ResponseCompressor::instance().apply(std::move(response), "deflate");
+    QCOMPARE(encoded.headers("ETag").value(0), QByteArray("W/\"abc\""));
+}
+
+void TestResponseCompressor::identityAddsVaryOnly()
+{
+    QHttpServerResponse response(largeArray());
+    const QByteArray body = response.data();
+    response.setHeader("ETag", "\"abc\"");
+
+    const QHttpServerResponse result = ResponseCompressor::instance().apply(std::move(response), "identity");
+
+    QCOMPARE(result.data(), body);
+    QVERIFY(!result.hasHeader("Content-Encoding"));
+    QCOMPARE(result.headers("Vary").value(0), QByteArray("Accept-Encoding"));
+    QCOMPARE(result.headers("ETag").value(0), QByteArray("\"abc\""));
+}
+
+void TestResponseCompressor::leavesSmallAndIncompressibleBodies()
+{
+    ResponseCompressor& compressor = ResponseCompressor::instance();
+
+    QHttpServerResponse small(QJsonObject{{"ok", true}});
+    const QHttpServerResponse smallResult = compressor.apply(std::move(small), "gzip, deflate");
+    QVERIFY(!smallResult.hasHeader("Content-Encoding"));
+    QVERIFY(!smallResult.hasHeader("Vary"));
+
+    QHttpServerResponse image(QByteArrayLiteral("image/png"), QByteArray(4096, 'x'));
+    const QHttpServerResponse imageResult = compressor.apply(std::move(image), "gzip, deflate");
+    QVERIFY(!imageResult.hasHeader("Content-Encoding"));
+    QCOMPARE(imageResult.data().size(), 4096);
+
+    // Тіло, яке маршрут уже закодував сам, не стискається вдруге
+    QHttpServerResponse encoded(largeArray());
+    encoded.setHeader("Content-Encoding", "br");
+    const QByteArray body = encoded.data();
+    const QHttpServerResponse encodedResult = compressor.apply(std::move(encoded), "gzip, deflate");
+    QCOMPARE(encodedResult.headers("Content-Encoding").value(0), QByteArray("br"));
+    QCOMPARE(encodedResult.data(), body);
+}
+
+QTEST_GUILESS_MAIN(TestResponseCompressor)
+#include "tst_responsecompressor.moc"
@@ -0,0 +1,69 @@
+#include "../RoutePattern.h"
+
+#include <QTest>
+
+/**
+ * Зіставлення шляхів підзапитів /api/batch з шаблонами маршрутів.
+ */
+class TestRoutePattern : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void match_data();
+    void match();
+    void argsUntouchedOnMismatch();
+    void argsAreOptional();
+};
+
+void TestRoutePattern::match_data()
+{
+    QTest::addColumn<QString>("pattern");
+    QTest::addColumn<QString>("path");
+    QTest::addColumn<bool>("matches");
+    QTest::addColumn<QStringList>("args");
+
+    QTest::newRow("literal") << "/api/clients" << "/api/clients" << true << QStringList();
+    QTest::newRow("one arg") << "/api/clients/<arg>" << "/api/clients/5" << true << QStringList{"5"};
+    QTest::newRow("two args") << "/api/clients/<arg>/station/<arg>/workplaces"
+                              << "/api/clients/5/station/101/workplaces" << true << QStringList{"5", "101"};
+    QTest::newRow("trailing slash") << "/api/clients/<arg>" << "/api/clients/5/" << true << QStringList{"5"};
+    QTest::newRow("double slash") << "/api/clients/<arg>" << "/api//clients/5" << true << QStringList{"5"};
+    QTest::newRow("arg keeps text") << "/api/settings/<arg>" << "/api/settings/Gandalf" << true << QStringList{"Gandalf"};
+
+    QTest::newRow("too short") << "/api/clients/<arg>" << "/api/clients" << false << QStringList();
+    QTest::newRow("too long") << "/api/clients/<arg>" << "/api/clients/5/sync-status" << false << QStringList();
+    QTest::newRow("literal mismatch") << "/api/clients/<arg>/workplaces" << "/api/clients/5/reachability"
+                                      << false << QStringList();
+    QTest::newRow("case sensitive") << "/api/clients" << "/api/Clients" << false << QStringList();
+    QTest::newRow("empty path") << "/api/clients" << "" << false << QStringList();
+}
+
+void TestRoutePattern::match()
+{
+    QFETCH(QString, pattern);
+    QFETCH(QString, path);
+    QFETCH(bool, matches);
+    QFETCH(QStringList, args);
+
+    QStringList actual;
+    QCOMPARE(RoutePattern::match(pattern, path, &actual), matches);
+    if (matches) QCOMPARE(actual, args);
+}
+
+void TestRoutePattern::argsUntouchedOnMismatch()
+{
+    // Невдалий кандидат не затирає аргументи, знайдені раніше
+    QStringList args{"previous"};
+    QVERIFY(!RoutePattern::match("/api/clients/<arg>/sync-status", "/api/clients/5/workplaces", &args));
+    QCOMPARE(args, QStringList{"previous"});
+}
+
+void TestRoutePattern::argsAreOptional()
+{
+    QVERIFY(RoutePattern::match("/api/users/<arg>", "/api/users/3"));
+    QVERIFY(!RoutePattern::match("/api/users/<arg>", "/api/roles/3"));
+}
+
+QTEST_GUILESS_MAIN(TestRoutePattern)
+#include "tst_routepattern.moc"
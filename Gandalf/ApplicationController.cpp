@@ -5,6 +5,9 @@
 #include "Oracle/SessionManager.h"
 #include "Oracle/AppParams.h"
 #include "Oracle/User.h"
+#include "Clients/SyncEventStream.h"
+#include "Terminals/StationCatalog.h"
+#include "ReferenceDataCache.h"
 #include <QApplication>
 #include <QMessageBox>
 #include <QProcessEnvironment>
@@ -20,8 +23,6 @@ void ApplicationController::createConnections()
 {
     connect(&ApiClient::instance(), &ApiClient::loginSuccess, this, &ApplicationController::onLoginSuccess);
     connect(&ApiClient::instance(), &ApiClient::loginFailed, this, &ApplicationController::onLoginFailed);
-    connect(&ApiClient::instance(), &ApiClient::settingsFetched, this, &ApplicationController::onSettingsFetched);
-    connect(&ApiClient::instance(), &ApiClient::settingsFetchFailed, this, &ApplicationController::onSettingsFetchFailed);
 }
 
 void ApplicationController::start()
@@ -36,8 +37,18 @@ void ApplicationController::onLoginSuccess(User *user)
     logInfo() << "Login successful for user:" << user->fio();
     SessionManager::instance().setCurrentUser(user);
 
-    // Запускаємо завантаження налаштувань
-    ApiClient::instance().fetchSettings("Gandalf");
+    // Усі стартові запити йдуть паралельно, одразу після логіну.
+    // Першими — налаштування з локального кешу довідників: решта модулів читає їх при створенні.
+    ReferenceDataCache::instance().bootstrap();
+
+    // Підписуємось на push-події синхронізації (токен сесії вже є)
+    SyncEventStream::instance().start();
+
+    // Перевіряємо версію локального довідника АЗС (для пошуку без запитів до сервера)
+    StationCatalog::instance().start();
+
+    // Фонові перевірки головного вікна (автосинхронізація клієнтів)
+    m_mainWindow->startBackgroundTasks();
 
     m_mainWindow->show();
 }
@@ -57,17 +68,3 @@ void ApplicationController::onLoginFailed(const ApiError &error)
 
     qApp->quit(); // Закриваємо додаток
 }
-
-void ApplicationController::onSettingsFetched(const QVariantMap &settings)
-{
-    logInfo() << "Successfully loaded" << settings.count() << "settings for Gandalf.";
-    for (auto it = settings.constBegin(); it != settings.constEnd(); ++it) {
-        AppParams::instance().setParam("Gandalf", it.key(), it.value());
-    }
-}
-
-void ApplicationController::onSettingsFetchFailed(const ApiError &error)
-{
-    logCritical() << "Failed to fetch application settings:" << error.errorString;
-    // Тут можна теж показати QMessageBox, якщо налаштування критичні
-}
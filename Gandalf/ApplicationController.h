@@ -18,8 +18,6 @@ private slots:
     // Слоти для обробки сигналів від ApiClient
     void onLoginSuccess(User* user);
     void onLoginFailed(const ApiError& error);
-    void onSettingsFetched(const QVariantMap& settings);
-    void onSettingsFetchFailed(const ApiError& error);
 
 private:
     void createConnections();
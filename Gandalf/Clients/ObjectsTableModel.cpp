@@ -0,0 +1,348 @@
+#include "ObjectsTableModel.h"
+#include "Oracle/AppParams.h"
+#include "Oracle/Logger.h"
+
+#include <QJsonObject>
+#include <algorithm>
+
+namespace {
+// Сервер віддає прапорці то як bool, то як 0/1 — приймаємо обидва варіанти
+bool jsonFlag(const QJsonValue& value)
+{
+    return value.isBool() ? value.toBool() : value.toInt(0) == 1;
+}
+}
+
+ObjectsTableModel::ObjectsTableModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+    m_pageSize = qBound(50, AppParams::instance().getParam("Global", "ObjectsPageSize", 200).toInt(), 1000);
+
+    connect(&ApiClient::instance(), &ApiClient::objectsPageFetched, this, &ObjectsTableModel::onPageFetched);
+    connect(&ApiClient::instance(), &ApiClient::objectsFetchFailed, this, &ObjectsTableModel::onFetchFailed);
+}
+
+void ObjectsTableModel::setServerFilters(const QVariantMap &filters)
+{
+    beginResetModel();
+    clearStore();
+    m_serverFilters = filters;
+    m_hasMore = true;
+    m_fetchInFlight = false; // Відповідь на попередню вибірку буде відкинута в onPageFetched
+    endResetModel();
+
+    requestNextPage();
+}
+
+void ObjectsTableModel::setLocalFilter(const QString &search, int terminalId)
+{
+    if (search == m_search && terminalId == m_terminalFilter) return;
+
+    m_search = search;
+    m_terminalFilter = terminalId;
+    rebuildVisible();
+
+    // Локальний фільтр бачить лише завантажене — довантажуємо решту, щоб результат був повним
+    if (m_hasMore && (!m_search.isEmpty() || m_terminalFilter > 0)) {
+        requestNextPage();
+    }
+}
+
+int ObjectsTableModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_visible.size();
+}
+
+int ObjectsTableModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant ObjectsTableModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_visible.size()) return QVariant();
+
+    const int row = m_visible.at(index.row());
+
+    if (role == Qt::DisplayRole) {
+        switch (index.column()) {
+        case ColClient:     return m_clientNames.at(m_clientNameIdx.at(row));
+        case ColTerminalId: return QString::number(m_terminalId.at(row));
+        case ColName:       return m_name.at(row);
+        case ColAddress:    return m_address.at(row);
+        case ColRegion:     return m_regions.at(m_regionIdx.at(row));
+        default:            return QVariant();
+        }
+    }
+
+    if (role == Qt::CheckStateRole) {
+        if (index.column() == ColActive)
+            return (m_flags.at(row) & FlagActive) ? Qt::Checked : Qt::Unchecked;
+        if (index.column() == ColWork)
+            return (m_flags.at(row) & FlagWork) ? Qt::Checked : Qt::Unchecked;
+    }
+
+    if (role == Qt::UserRole) {
+        return m_clientId.at(row);
+    }
+
+    return QVariant();
+}
+
+QVariant ObjectsTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+
+    switch (section) {
+    case ColClient:     return "Клієнт";
+    case ColTerminalId: return "ID терміналу";
+    case ColName:       return "Назва АЗС";
+    case ColAddress:    return "Адреса";
+    case ColRegion:     return "Регіон";
+    case ColActive:     return "Активний";
+    case ColWork:       return "В роботі";
+    default:            return QVariant();
+    }
+}
+
+Qt::ItemFlags ObjectsTableModel::flags(const QModelIndex &index) const
+{
+    if (!index.isValid()) return Qt::NoItemFlags;
+    return Qt::ItemIsEnabled | Qt::ItemIsSelectable;
+}
+
+void ObjectsTableModel::sort(int column, Qt::SortOrder order)
+{
+    if (column == m_sortColumn && order == m_sortOrder) return;
+
+    relayout([this, column, order]() {
+        m_sortColumn = column;
+        m_sortOrder = order;
+        sortVisible(m_visible.begin());
+    });
+}
+
+bool ObjectsTableModel::canFetchMore(const QModelIndex &parent) const
+{
+    return !parent.isValid() && m_hasMore && !m_fetchInFlight;
+}
+
+void ObjectsTableModel::fetchMore(const QModelIndex &parent)
+{
+    if (parent.isValid()) return;
+    requestNextPage();
+}
+
+void ObjectsTableModel::onPageFetched(const QVariantMap &filters, int offset, const QJsonArray &objects, bool hasMore)
+{
+    // Сторінка іншої вибірки або вже завантажена — відкидаємо
+    if (filters != m_serverFilters || offset != loadedCount()) {
+        logDebug() << "ObjectsTableModel: Dropping stale page, offset" << offset;
+        return;
+    }
+
+    m_fetchInFlight = false;
+    m_hasMore = hasMore && !objects.isEmpty();
+
+    const int firstNewRow = loadedCount();
+    const int newSize = firstNewRow + objects.size();
+    m_terminalId.reserve(newSize);
+    m_clientId.reserve(newSize);
+    m_clientNameIdx.reserve(newSize);
+    m_regionIdx.reserve(newSize);
+    m_name.reserve(newSize);
+    m_address.reserve(newSize);
+    m_flags.reserve(newSize);
+
+    for (const QJsonValue& value : objects) {
+        const QJsonObject obj = value.toObject();
+        m_terminalId.append(obj["terminal_id"].toInt());
+        m_clientId.append(obj["client_id"].toInt());
+        m_clientNameIdx.append(intern(m_clientNames, m_clientNameLookup, obj["client_name"].toString()));
+        m_regionIdx.append(intern(m_regions, m_regionLookup, obj["region_name"].toString()));
+        m_name.append(obj["name"].toString());
+        m_address.append(obj["address"].toString());
+
+        quint8 flags = 0;
+        if (jsonFlag(obj["is_active"])) flags |= FlagActive;
+        if (jsonFlag(obj["is_work"])) flags |= FlagWork;
+        m_flags.append(flags);
+    }
+
+    appendVisible(firstNewRow);
+    emit pageLoaded(offset, objects.size());
+
+    if (m_hasMore && (!m_search.isEmpty() || m_terminalFilter > 0)) {
+        requestNextPage();
+    }
+}
+
+void ObjectsTableModel::onFetchFailed(const ApiError &error)
+{
+    Q_UNUSED(error);
+    // Дозволяємо повторну спробу при наступному прокручуванні
+    m_fetchInFlight = false;
+}
+
+void ObjectsTableModel::requestNextPage()
+{
+    if (m_fetchInFlight || !m_hasMore) return;
+
+    m_fetchInFlight = true;
+    ApiClient::instance().fetchObjectsPage(m_serverFilters, loadedCount(), m_pageSize);
+}
+
+void ObjectsTableModel::clearStore()
+{
+    m_terminalId.clear();
+    m_clientId.clear();
+    m_clientNameIdx.clear();
+    m_regionIdx.clear();
+    m_name.clear();
+    m_address.clear();
+    m_flags.clear();
+    m_clientNames.clear();
+    m_clientNameLookup.clear();
+    m_regions.clear();
+    m_regionLookup.clear();
+    m_visible.clear();
+}
+
+bool ObjectsTableModel::matchesLocalFilter(int row) const
+{
+    if (m_terminalFilter > 0 && m_terminalId.at(row) != m_terminalFilter) {
+        return false;
+    }
+    if (!m_search.isEmpty()
+        && !m_name.at(row).contains(m_search, Qt::CaseInsensitive)
+        && !m_address.at(row).contains(m_search, Qt::CaseInsensitive)) {
+        return false;
+    }
+    return true;
+}
+
+bool ObjectsTableModel::lessThan(int leftRow, int rightRow) const
+{
+    if (m_sortOrder == Qt::DescendingOrder) {
+        std::swap(leftRow, rightRow);
+    }
+
+    int cmp = 0;
+    switch (m_sortColumn) {
+    case ColClient:
+        cmp = QString::localeAwareCompare(m_clientNames.at(m_clientNameIdx.at(leftRow)),
+                                          m_clientNames.at(m_clientNameIdx.at(rightRow)));
+        break;
+    case ColTerminalId:
+        cmp = m_terminalId.at(leftRow) - m_terminalId.at(rightRow);
+        break;
+    case ColName:
+        cmp = QString::localeAwareCompare(m_name.at(leftRow), m_name.at(rightRow));
+        break;
+    case ColAddress:
+        cmp = QString::localeAwareCompare(m_address.at(leftRow), m_address.at(rightRow));
+        break;
+    case ColRegion:
+        cmp = QString::localeAwareCompare(m_regions.at(m_regionIdx.at(leftRow)),
+                                          m_regions.at(m_regionIdx.at(rightRow)));
+        break;
+    case ColActive:
+        cmp = (m_flags.at(leftRow) & FlagActive) - (m_flags.at(rightRow) & FlagActive);
+        break;
+    case ColWork:
+        cmp = (m_flags.at(leftRow) & FlagWork) - (m_flags.at(rightRow) & FlagWork);
+        break;
+    default:
+        break;
+    }
+
+    // За рівних значень — порядок сервера, щоб сортування було детермінованим
+    return cmp != 0 ? cmp < 0 : leftRow < rightRow;
+}
+
+void ObjectsTableModel::rebuildVisible()
+{
+    beginResetModel();
+    m_visible.clear();
+    for (int row = 0; row < loadedCount(); ++row) {
+        if (matchesLocalFilter(row)) m_visible.append(row);
+    }
+    sortVisible(m_visible.begin());
+    endResetModel();
+}
+
+void ObjectsTableModel::appendVisible(int firstNewRow)
+{
+    QVector<int> added;
+    for (int row = firstNewRow; row < loadedCount(); ++row) {
+        if (matchesLocalFilter(row)) added.append(row);
+    }
+    if (added.isEmpty()) return;
+
+    const int first = m_visible.size();
+    beginInsertRows(QModelIndex(), first, first + added.size() - 1);
+    m_visible.append(added);
+    endInsertRows();
+
+    // Без сортування нові рядки вже на своєму місці (порядок сервера).
+    // Інакше зливаємо відсортовану сторінку з уже відсортованою частиною.
+    if (m_sortColumn >= 0) {
+        relayout([this, first]() {
+            sortVisible(m_visible.begin() + first);
+        });
+    }
+}
+
+void ObjectsTableModel::sortVisible(QVector<int>::iterator middle)
+{
+    auto cmp = [this](int a, int b) { return lessThan(a, b); };
+    if (middle == m_visible.begin()) {
+        std::sort(m_visible.begin(), m_visible.end(), cmp);
+    } else {
+        std::sort(middle, m_visible.end(), cmp);
+        std::inplace_merge(m_visible.begin(), middle, m_visible.end(), cmp);
+    }
+}
+
+void ObjectsTableModel::relayout(const std::function<void()> &reorder)
+{
+    emit layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+
+    const QModelIndexList oldPersistent = persistentIndexList();
+    QVector<int> persistentRows;
+    persistentRows.reserve(oldPersistent.size());
+    for (const QModelIndex& idx : oldPersistent) {
+        persistentRows.append(m_visible.at(idx.row()));
+    }
+
+    reorder();
+
+    if (!oldPersistent.isEmpty()) {
+        QHash<int, int> position;
+        position.reserve(m_visible.size());
+        for (int i = 0; i < m_visible.size(); ++i) {
+            position.insert(m_visible.at(i), i);
+        }
+
+        QModelIndexList newPersistent;
+        newPersistent.reserve(oldPersistent.size());
+        for (int i = 0; i < oldPersistent.size(); ++i) {
+            newPersistent.append(index(position.value(persistentRows.at(i)), oldPersistent.at(i).column()));
+        }
+        changePersistentIndexList(oldPersistent, newPersistent);
+    }
+
+    emit layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+}
+
+int ObjectsTableModel::intern(QStringList &pool, QHash<QString, int> &lookup, const QString &value)
+{
+    auto it = lookup.constFind(value);
+    if (it != lookup.constEnd()) return it.value();
+
+    pool.append(value);
+    lookup.insert(value, pool.size() - 1);
+    return pool.size() - 1;
+}
@@ -0,0 +1,112 @@
+#ifndef OBJECTSTABLEMODEL_H
+#define OBJECTSTABLEMODEL_H
+
+#include "Oracle/ApiClient.h"
+
+#include <QAbstractTableModel>
+#include <QHash>
+#include <QJsonArray>
+#include <QStringList>
+#include <QVariantMap>
+#include <QVector>
+#include <functional>
+
+/**
+ * @brief Модель довідника об'єктів (АЗС) для ObjectsListDialog.
+ *
+ * Дані зберігаються по колонках (рядки клієнтів і регіонів інтерновані),
+ * сторінки підвантажуються з /api/objects через canFetchMore()/fetchMore().
+ * Фільтри клієнта/регіону йдуть на сервер (нова вибірка), пошук і ID терміналу
+ * перевіряються локально над уже завантаженими рядками. Сортування — перестановка
+ * індексів, самі дані не переміщуються.
+ */
+class ObjectsTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+public:
+    enum Column {
+        ColClient = 0,
+        ColTerminalId,
+        ColName,
+        ColAddress,
+        ColRegion,
+        ColActive,
+        ColWork,
+        ColumnCount
+    };
+
+    explicit ObjectsTableModel(QObject *parent = nullptr);
+
+    // Нова серверна вибірка: модель очищується і завантажує першу сторінку
+    void setServerFilters(const QVariantMap& filters);
+    // Локальний фільтр над завантаженими рядками (terminalId <= 0 — без фільтра)
+    void setLocalFilter(const QString& search, int terminalId);
+
+    int loadedCount() const { return m_terminalId.size(); }
+    bool hasMore() const { return m_hasMore; }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
+
+signals:
+    // Сторінка додана в модель (для підгонки ширини колонок після першої)
+    void pageLoaded(int offset, int rowsInPage);
+
+private slots:
+    void onPageFetched(const QVariantMap& filters, int offset, const QJsonArray& objects, bool hasMore);
+    void onFetchFailed(const ApiError& error);
+
+private:
+    enum RowFlag : quint8 {
+        FlagActive = 0x01,
+        FlagWork = 0x02
+    };
+
+    void requestNextPage();
+    void clearStore();
+    bool matchesLocalFilter(int row) const;
+    bool lessThan(int leftRow, int rightRow) const;
+    void rebuildVisible();
+    void appendVisible(int firstNewRow);
+    void sortVisible(QVector<int>::iterator middle);
+    // Зміна порядку m_visible без зміни кількості рядків (зберігає persistent-індекси)
+    void relayout(const std::function<void()>& reorder);
+    static int intern(QStringList& pool, QHash<QString, int>& lookup, const QString& value);
+
+private:
+    // --- Колонкове сховище завантажених рядків (індекс = порядок з сервера) ---
+    QVector<int> m_terminalId;
+    QVector<int> m_clientId;
+    QVector<int> m_clientNameIdx;
+    QVector<int> m_regionIdx;
+    QVector<QString> m_name;
+    QVector<QString> m_address;
+    QVector<quint8> m_flags;
+
+    QStringList m_clientNames;
+    QHash<QString, int> m_clientNameLookup;
+    QStringList m_regions;
+    QHash<QString, int> m_regionLookup;
+
+    // Рядки, що проходять локальний фільтр, у порядку відображення
+    QVector<int> m_visible;
+
+    QVariantMap m_serverFilters;
+    QString m_search;
+    int m_terminalFilter = 0;
+    int m_sortColumn = -1;
+    Qt::SortOrder m_sortOrder = Qt::AscendingOrder;
+
+    int m_pageSize;
+    bool m_hasMore = false;
+    bool m_fetchInFlight = false;
+};
+
+#endif // OBJECTSTABLEMODEL_H
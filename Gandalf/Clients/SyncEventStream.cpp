@@ -0,0 +1,81 @@
+#include "SyncEventStream.h"
+#include "Oracle/ApiClient.h"
+#include "Oracle/Logger.h"
+
+#include <QWebSocket>
+#include <QTimer>
+#include <QJsonDocument>
+#include <QNetworkRequest>
+
+namespace {
+// Пауза перед повторним підключенням, якщо канал упав
+constexpr int kReconnectIntervalMs = 5000;
+}
+
+SyncEventStream& SyncEventStream::instance()
+{
+    static SyncEventStream self;
+    return self;
+}
+
+SyncEventStream::SyncEventStream(QObject *parent)
+    : QObject(parent), m_started(false), m_connected(false)
+{
+    m_socket = new QWebSocket(QString(), QWebSocketProtocol::VersionLatest, this);
+    m_reconnectTimer = new QTimer(this);
+    m_reconnectTimer->setSingleShot(true);
+    m_reconnectTimer->setInterval(kReconnectIntervalMs);
+
+    connect(m_socket, &QWebSocket::connected, this, &SyncEventStream::onConnected);
+    connect(m_socket, &QWebSocket::disconnected, this, &SyncEventStream::onDisconnected);
+    connect(m_socket, &QWebSocket::textMessageReceived, this, &SyncEventStream::onTextMessageReceived);
+    connect(m_reconnectTimer, &QTimer::timeout, this, &SyncEventStream::openSocket);
+}
+
+void SyncEventStream::start()
+{
+    if (m_started) return;
+    m_started = true;
+    openSocket();
+}
+
+void SyncEventStream::openSocket()
+{
+    QNetworkRequest request = ApiClient::instance().createEventStreamRequest("/api/events/sync");
+    logDebug() << "SyncEventStream: Connecting to" << request.url().toString();
+    m_socket->open(request);
+}
+
+void SyncEventStream::onConnected()
+{
+    logInfo() << "SyncEventStream: Push channel connected. Polling is disabled.";
+    m_connected = true;
+    emit connectedChanged(true);
+}
+
+void SyncEventStream::onDisconnected()
+{
+    // disconnected приходить і тоді, коли підключення взагалі не вдалося
+    if (m_connected) {
+        logWarning() << "SyncEventStream: Push channel dropped:" << m_socket->closeReason()
+                     << ". Falling back to polling.";
+        m_connected = false;
+        emit connectedChanged(false);
+    }
+    m_reconnectTimer->start();
+}
+
+void SyncEventStream::onTextMessageReceived(const QString& message)
+{
+    const QJsonObject event = QJsonDocument::fromJson(message.toUtf8()).object();
+    if (event["type"].toString() == "db_changed") {
+        emit tableChanged(event["table"].toString());
+        return;
+    }
+    if (event["type"].toString() != "sync") return;
+
+    emit syncEventReceived(event["client_id"].toInt(),
+                           event["status"].toString(),
+                           event["message"].toString(),
+                           event);
+}
@@ -0,0 +1,48 @@
+#ifndef SYNCEVENTSTREAM_H
+#define SYNCEVENTSTREAM_H
+
+#include <QObject>
+#include <QJsonObject>
+
+class QWebSocket;
+class QTimer;
+
+/**
+ * @brief Підписка Gandalf на push-події синхронізації від Conduit (WebSocket /api/events/sync).
+ *
+ * Поки канал відкритий, SyncManager і діалоги оновлюються подіями.
+ * Якщо з'єднання падає — isConnected() == false, діалоги повертаються до опитування,
+ * а канал сам перепідключається.
+ */
+class SyncEventStream : public QObject
+{
+    Q_OBJECT
+public:
+    static SyncEventStream& instance();
+
+    // Відкриває канал (викликається після успішного логіну)
+    void start();
+    bool isConnected() const { return m_connected; }
+
+signals:
+    void connectedChanged(bool connected);
+    // status: QUEUED | RUNNING | SUCCESS | ERROR
+    void syncEventReceived(int clientId, const QString& status, const QString& message, const QJsonObject& event);
+    // Таблицю змінено в обхід Conduit (інший екземпляр, Exporter, SQL): "sync_status" | "export_tasks"
+    void tableChanged(const QString& table);
+
+private:
+    explicit SyncEventStream(QObject *parent = nullptr);
+
+    void openSocket();
+    void onConnected();
+    void onDisconnected();
+    void onTextMessageReceived(const QString& message);
+
+    QWebSocket* m_socket;
+    QTimer* m_reconnectTimer;
+    bool m_started;
+    bool m_connected;
+};
+
+#endif // SYNCEVENTSTREAM_H
@@ -1,6 +1,7 @@
 #include "SyncManager.h"
 #include "Oracle/ApiClient.h"
 #include "Oracle/Logger.h"
+#include "SyncEventStream.h"
 
 SyncManager& SyncManager::instance()
 {
@@ -13,6 +14,9 @@ SyncManager::SyncManager(QObject *parent) : QObject(parent), m_isBusy(false), m_
 {
     connect(&ApiClient::instance(), &ApiClient::clientSyncRequestFinished,
             this, &SyncManager::onApiSyncFinished);
+
+    connect(&SyncEventStream::instance(), &SyncEventStream::syncEventReceived, this,
+            [this](int clientId, const QString& status) { onSyncEvent(clientId, status); });
 }
 
 void SyncManager::queueClient(int clientId)
@@ -65,6 +69,13 @@ void SyncManager::onApiSyncFinished(int clientId, bool success, QString message)
     processNext();
 }
 
+void SyncManager::onSyncEvent(int clientId, const QString& status)
+{
+    if (status == "SUCCESS" || status == "ERROR" || status == "FAILED") {
+        markCompleted(clientId);
+    }
+}
+
 void SyncManager::markCompleted(int clientId)
 {
     if (m_trackedClients.contains(clientId)) {
@@ -31,6 +31,9 @@ private:
     // Слот для відповіді від ApiClient
     void onApiSyncFinished(int clientId, bool success, QString message);
 
+    // Push-подія від сервера: фіксуємо завершення без очікування опитування
+    void onSyncEvent(int clientId, const QString& status);
+
     void processNext();
 
     QQueue<int> m_queue;
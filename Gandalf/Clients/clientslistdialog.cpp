@@ -2,6 +2,8 @@
 #include "ui_clientslistdialog.h"
 #include "Oracle/ApiClient.h"
 #include "Oracle/criptpass.h"
+#include "SyncEventStream.h"
+#include "../ReferenceDataCache.h"
 
 #include "Oracle/SessionManager.h" // Для перевірки ролі
 #include "Oracle/User.h"           // Для об'єкта User
@@ -26,10 +28,10 @@ ClientsListDialog::ClientsListDialog(QWidget *parent)
     ui->setupUi(this);
     setWindowTitle("Довідник клієнтів");
     m_syncStatusTimer = new QTimer(this);
+    m_pendingIpGenMethodId = -1; // (ДОДАНО) Ініціалізуємо наш буфер
     createConnections();
-    loadInitialData(); // Запускаємо завантаження даних
+    loadInitialData(true); // Запускаємо завантаження даних
     createUI();
-    m_pendingIpGenMethodId = -1; // (ДОДАНО) Ініціалізуємо наш буфер
 }
 
 ClientsListDialog::~ClientsListDialog()
@@ -171,6 +173,14 @@ void ClientsListDialog::createConnections()
     connect(&ApiClient::instance(), &ApiClient::syncStatusFetched, this, &ClientsListDialog::onSyncStatusReceived);
     connect(m_syncStatusTimer, &QTimer::timeout, this, &ClientsListDialog::checkSyncStatus);
 
+    // Push-події: поки канал живий, таймер опитування не потрібен
+    connect(&SyncEventStream::instance(), &SyncEventStream::syncEventReceived, this,
+            [this](int clientId, const QString& status, const QString& message) {
+                onSyncEvent(clientId, status, message);
+            });
+    connect(&SyncEventStream::instance(), &SyncEventStream::connectedChanged,
+            this, &ClientsListDialog::onEventStreamConnectedChanged);
+
     connect(&ApiClient::instance(), &ApiClient::syncStatusFetchFailed, this, [this](int clientId, const ApiError& error){
         if (clientId == m_syncingClientId) {
             m_syncStatusTimer->stop();
@@ -209,8 +219,18 @@ void ClientsListDialog::createConnections()
 }
 
 
-void ClientsListDialog::loadInitialData()
+void ClientsListDialog::loadInitialData(bool allowCached)
 {
+    // Довідники вже є локально — показуємо одразу, як ніби прийшла відповідь сервера
+    const ReferenceDataCache& cache = ReferenceDataCache::instance();
+    if (allowCached && cache.hasClients() && cache.hasIpGenMethods()) {
+        QTimer::singleShot(0, this, [this]() {
+            onIpGenMethodsReceived(ReferenceDataCache::instance().ipGenMethods());
+            onClientsReceived(ReferenceDataCache::instance().clients());
+        });
+        return;
+    }
+
     ApiClient::instance().fetchAllClients();
     ApiClient::instance().fetchAllIpGenMethods();
 }
@@ -626,7 +646,10 @@ void ClientsListDialog::onSyncRequestAcknowledged(int clientId, bool success, co
     if (success) {
         m_syncingClientId = clientId;
         ui->pushButtonSync->setEnabled(true);
-        m_syncStatusTimer->start(2000);
+        // Опитуємо лише без push-каналу; інакше чекаємо подію SUCCESS/ERROR
+        if (!SyncEventStream::instance().isConnected()) {
+            m_syncStatusTimer->start(2000);
+        }
     } else {
         QMessageBox::critical(this, "Помилка запуску", details.errorString);
         ui->pushButtonSync->setChecked(false);
@@ -638,7 +661,7 @@ void ClientsListDialog::onSyncRequestAcknowledged(int clientId, bool success, co
 void ClientsListDialog::checkSyncStatus()
 {
     if (m_syncingClientId != -1) {
-        ApiClient::instance().fetchSyncStatus(m_syncingClientId);
+        ApiClient::instance().fetchSyncStatus(m_syncingClientId, RequestPriority::Background);
     }
 }
 
@@ -653,7 +676,7 @@ void ClientsListDialog::onSyncStatusReceived(int clientId, const QJsonObject& st
         ui->pushButtonSync->setChecked(false);
         ui->pushButtonSync->setText("Синхронізувати");
         QMessageBox::information(this, "Успіх", "Синхронізація успішно завершена.\n" + status["message"].toString());
-    } else if (currentStatus == "FAILED") {
+    } else if (currentStatus == "FAILED" || currentStatus == "ERROR") {
         m_syncStatusTimer->stop();
         m_syncingClientId = -1;
         ui->pushButtonSync->setChecked(false);
@@ -663,6 +686,32 @@ void ClientsListDialog::onSyncStatusReceived(int clientId, const QJsonObject& st
 }
 
 
+void ClientsListDialog::onSyncEvent(int clientId, const QString& status, const QString& message)
+{
+    if (clientId != m_syncingClientId) return;
+
+    if (status == "RUNNING" && !message.isEmpty()) {
+        ui->pushButtonSync->setToolTip(message); // Прогрес по завданнях
+        return;
+    }
+
+    // Завершальні події обробляємо так само, як відповідь опитування
+    onSyncStatusReceived(clientId, QJsonObject{{"status", status}, {"message", message}});
+}
+
+void ClientsListDialog::onEventStreamConnectedChanged(bool connected)
+{
+    if (m_syncingClientId == -1) return;
+
+    if (connected) {
+        m_syncStatusTimer->stop();
+        checkSyncStatus(); // Могли пропустити завершення, поки каналу не було
+    } else {
+        m_syncStatusTimer->start(2000);
+    }
+}
+
+
 // --- "ФАБРИКА КОНФІГУРАЦІЙ" ---
 
 void ClientsListDialog::on_pushButtonGenerateExporter_clicked()
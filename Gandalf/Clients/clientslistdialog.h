@@ -46,6 +46,8 @@ private slots:
     void checkSyncStatus();
     void onSyncStatusReceived(int clientId, const QJsonObject& status);
     void onSyncButtonToggled(bool checked);
+    void onSyncEvent(int clientId, const QString& status, const QString& message);
+    void onEventStreamConnectedChanged(bool connected);
 
     void on_pushButtonGenerateExporter_clicked();
     void onExportTasksFetched(const QJsonArray& tasks);
@@ -60,7 +62,8 @@ private:
     // Методи-помічники для налаштування
     void createConnections();
     void createUI();
-    void loadInitialData();
+    // allowCached — показати довідники з ReferenceDataCache замість запиту (відкриття діалогу)
+    void loadInitialData(bool allowCached = false);
     QJsonObject formToJson() const;
     void generateExporterPackage(const QJsonArray& tasks);
     QJsonObject gatherClientDataForConfig();
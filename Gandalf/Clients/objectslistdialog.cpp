@@ -1,9 +1,10 @@
 #include "objectslistdialog.h"
 #include "ui_objectslistdialog.h"
+#include "../ReferenceDataCache.h"
 #include <QMessageBox>
 #include <QJsonArray>
 #include <QJsonObject>
-#include <QStandardItemModel>
+#include <QHeaderView>
 #include <QTimer>
 
 ObjectsListDialog::ObjectsListDialog(QWidget *parent)
@@ -40,18 +41,27 @@ ObjectsListDialog::~ObjectsListDialog()
 
 void ObjectsListDialog::setupModel()
 {
-    // ... (код цього методу залишається без змін) ...
-    m_model = new QStandardItemModel(this);
-    m_model->setHorizontalHeaderLabels({
-        "Клієнт", "ID терміналу", "Назва АЗС", "Адреса", "Регіон",
-        "Активний", "В роботі"
-    });
+    m_model = new ObjectsTableModel(this);
     ui->tableViewObjects->setModel(m_model);
-    ui->tableViewObjects->hideColumn(3);
+    ui->tableViewObjects->hideColumn(ObjectsTableModel::ColAddress);
+
+    // Сортування виконує модель (перестановкою індексів). -1 — порядок сервера.
+    ui->tableViewObjects->horizontalHeader()->setSortIndicator(-1, Qt::AscendingOrder);
+    ui->tableViewObjects->setSortingEnabled(true);
 }
 
 void ObjectsListDialog::loadFiltersData()
 {
+    // Довідники для фільтрів беремо з локального кешу, якщо він уже є
+    const ReferenceDataCache& cache = ReferenceDataCache::instance();
+    if (cache.hasClients() && cache.hasRegions()) {
+        QTimer::singleShot(0, this, [this]() {
+            onClientsReceived(ReferenceDataCache::instance().clients());
+            onRegionsReceived(ReferenceDataCache::instance().regions());
+        });
+        return;
+    }
+
     // Перевикористовуємо існуючий метод для клієнтів
     ApiClient::instance().fetchAllClients();
     // Використовуємо новий метод для регіонів
@@ -95,7 +105,7 @@ void ObjectsListDialog::adjustComboWidth(QComboBox* combo)
 void ObjectsListDialog::createConnections()
 {
     // Відповіді від сервера
-    connect(&ApiClient::instance(), &ApiClient::objectsFetched, this, &ObjectsListDialog::onObjectsReceived);
+    connect(m_model, &ObjectsTableModel::pageLoaded, this, &ObjectsListDialog::onObjectsPageLoaded);
     connect(&ApiClient::instance(), &ApiClient::clientsFetched, this, &ObjectsListDialog::onClientsReceived);
     connect(&ApiClient::instance(), &ApiClient::regionsListFetched, this, &ObjectsListDialog::onRegionsReceived);
 
@@ -112,7 +122,7 @@ void ObjectsListDialog::createConnections()
     connect(ui->lineEditTerminalId, &QLineEdit::textChanged, m_searchDebounceTimer, QOverload<>::of(&QTimer::start));
     // Для пошуку використовуємо таймер
     connect(ui->lineEditSearch, &QLineEdit::textChanged, m_searchDebounceTimer, QOverload<>::of(&QTimer::start));
-    connect(m_searchDebounceTimer, &QTimer::timeout, this, &ObjectsListDialog::onFilterChanged);
+    connect(m_searchDebounceTimer, &QTimer::timeout, this, &ObjectsListDialog::onSearchChanged);
 }
 
 void ObjectsListDialog::onClientsReceived(const QJsonArray &clients)
@@ -151,56 +161,31 @@ void ObjectsListDialog::onFilterChanged()
         filters["region"] = region;
     }
 
-    // 3. Збираємо дані з lineEditSearch
-    QString searchText = ui->lineEditSearch->text().trimmed();
-    if (!searchText.isEmpty()) {
-        filters["search"] = searchText;
-    }
+    // 3. Нова вибірка: модель завантажує першу сторінку, решту — при прокручуванні
+    m_model->setServerFilters(filters);
+}
 
-    // 4. Збираємо дані з lineEditTerminalId (НОВИЙ КОД)
+void ObjectsListDialog::onSearchChanged()
+{
+    // Пошук і ID терміналу не перезапитують сервер — фільтруємо вже завантажене
+    int terminalId = 0;
     QString terminalIdText = ui->lineEditTerminalId->text().trimmed();
     if (!terminalIdText.isEmpty()) {
         bool ok;
-        int terminalId = terminalIdText.toInt(&ok);
-        if (ok) { // Додаємо фільтр, тільки якщо це дійсно число
-            filters["terminalId"] = terminalId;
+        int value = terminalIdText.toInt(&ok);
+        if (ok) { // Фільтр, тільки якщо це дійсно число
+            terminalId = value;
         }
     }
 
-    // 5. Викликаємо API з зібраними фільтрами
-    ApiClient::instance().fetchObjects(filters);
+    m_model->setLocalFilter(ui->lineEditSearch->text().trimmed(), terminalId);
 }
 
-void ObjectsListDialog::onObjectsReceived(const QJsonArray &objects)
+void ObjectsListDialog::onObjectsPageLoaded(int offset, int rowsInPage)
 {
-    // ... (код цього методу залишається без змін) ...
-    m_model->removeRows(0, m_model->rowCount());
-    for (const QJsonValue& value : objects) {
-        QJsonObject obj = value.toObject();
-        QList<QStandardItem*> rowItems;
-        rowItems.append(new QStandardItem(obj["client_name"].toString()));
-        rowItems.append(new QStandardItem(QString::number(obj["terminal_id"].toInt())));
-        rowItems.append(new QStandardItem(obj["name"].toString()));
-        rowItems.append(new QStandardItem(obj["address"].toString()));
-        rowItems.append(new QStandardItem(obj["region_name"].toString()));
-
-        bool isActive = (obj["is_active"].toInt(0) == 1);
-        bool isWork = (obj["is_work"].toInt(0) == 1);
-
-        auto itemIsActive = new QStandardItem();
-        itemIsActive->setCheckable(true);
-        itemIsActive->setCheckState(isActive ? Qt::Checked : Qt::Unchecked);
-        itemIsActive->setEditable(false);
-        itemIsActive->setFlags(Qt::ItemIsEnabled | Qt::ItemIsSelectable);
-        rowItems.append(itemIsActive);
-
-        auto itemIsWork = new QStandardItem();
-        itemIsWork->setCheckable(true);
-        itemIsWork->setCheckState(isWork ? Qt::Checked : Qt::Unchecked);
-        itemIsWork->setEditable(false);
-        rowItems.append(itemIsWork);
-        itemIsWork->setFlags(Qt::ItemIsEnabled | Qt::ItemIsSelectable);
-        m_model->appendRow(rowItems);
+    Q_UNUSED(rowsInPage);
+    // Підганяємо ширину лише по першій сторінці — далі це зайва робота на кожному прокручуванні
+    if (offset == 0) {
+        ui->tableViewObjects->resizeColumnsToContents();
     }
-    ui->tableViewObjects->resizeColumnsToContents();
 }
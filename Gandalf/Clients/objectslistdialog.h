@@ -2,9 +2,9 @@
 #define OBJECTSLISTDIALOG_H
 
 #include "Oracle/ApiClient.h"
+#include "ObjectsTableModel.h"
 
 #include <QDialog>
-#include <QStandardItemModel>
 #include <QJsonArray>
 #include <QComboBox>
 
@@ -20,14 +20,16 @@ public:
     explicit ObjectsListDialog(QWidget *parent = nullptr);
     ~ObjectsListDialog();
 private slots:
-    // Слот для обробки успішно завантажених даних
-    void onObjectsReceived(const QJsonArray& objects);
+    // Після першої сторінки підганяємо ширину колонок
+    void onObjectsPageLoaded(int offset, int rowsInPage);
     // Слоти для заповнення фільтрів
     void onClientsReceived(const QJsonArray& clients);
     void onRegionsReceived(const QStringList& regions);
 
-    // Слот, що реагує на зміну будь-якого фільтра
+    // Клієнт/регіон — нова вибірка з сервера
     void onFilterChanged();
+    // Пошук/ID терміналу — локальний фільтр над завантаженими рядками
+    void onSearchChanged();
 private:
     // Допоміжні методи для налаштування
     void setupModel();
@@ -36,7 +38,7 @@ private:
     void adjustComboWidth(QComboBox* combo);
 private:
     Ui::ObjectsListDialog *ui;
-    QStandardItemModel *m_model; // Модель для наших даних
+    ObjectsTableModel *m_model; // Модель для наших даних
     QTimer* m_searchDebounceTimer; // Таймер для пошуку
 };
 
@@ -2,6 +2,7 @@
 #include "ui_syncstatusdialog.h"
 
 #include "SyncManager.h"      // Логіка черги
+#include "SyncEventStream.h"  // Push-події синхронізації
 #include "Oracle/ApiClient.h" // Логіка мережі
 #include "Oracle/Logger.h"    // Логування
 
@@ -27,9 +28,14 @@ SyncStatusDialog::SyncStatusDialog(QWidget *parent)
     // --- ТАЙМЕР АВТООНОВЛЕННЯ ---
     m_refreshTimer = new QTimer(this);
     m_refreshTimer->setInterval(5000); // 5000 мс = 5 секунд
-    // Таймер просто викликає той самий метод, що і кнопка "Оновити"
-    connect(m_refreshTimer, &QTimer::timeout, this, &SyncStatusDialog::refreshClientList);
-    m_refreshTimer->start();
+    // Таймер робить те саме, що і кнопка "Оновити", але з фоновим пріоритетом
+    connect(m_refreshTimer, &QTimer::timeout, this, [this]() {
+        ApiClient::instance().fetchDashboardData(RequestPriority::Background);
+    });
+    // Опитування потрібне лише тоді, коли push-канал недоступний
+    if (!SyncEventStream::instance().isConnected()) {
+        m_refreshTimer->start();
+    }
     // -----------------------------
 
     // Запускаємо завантаження даних при відкритті вікна
@@ -62,6 +68,18 @@ void SyncStatusDialog::createConnections()
 
     connect(&ApiClient::instance(), &ApiClient::dashboardDataFetchFailed,
             this, &SyncStatusDialog::onDashboardDataFailed);
+
+    // 3. SyncEventStream -> Dialog (Push-події замість опитування)
+    connect(&SyncEventStream::instance(), &SyncEventStream::syncEventReceived,
+            this, &SyncStatusDialog::onSyncEvent);
+
+    connect(&SyncEventStream::instance(), &SyncEventStream::connectedChanged,
+            this, &SyncStatusDialog::onEventStreamConnectedChanged);
+
+    // Синхронізацію запустив інший екземпляр Conduit — його подій ми не отримуємо, перечитуємо дашборд
+    connect(&SyncEventStream::instance(), &SyncEventStream::tableChanged, this, [](const QString& table) {
+        if (table == "sync_status") ApiClient::instance().fetchDashboardData(RequestPriority::Background);
+    });
 }
 
 void SyncStatusDialog::setupTable()
@@ -137,6 +155,11 @@ void SyncStatusDialog::onDashboardDataLoaded(const QJsonArray& data)
         }
     }
 
+    updateBatchProgress();
+}
+
+void SyncStatusDialog::updateBatchProgress()
+{
     // --- НОВЕ: КЕРУЄМО ПРОГРЕС-БАРОМ ---
     int total = SyncManager::instance().getBatchTotal();
     int completed = SyncManager::instance().getBatchCompleted();
@@ -154,6 +177,41 @@ void SyncStatusDialog::onDashboardDataLoaded(const QJsonArray& data)
     }
 }
 
+void SyncStatusDialog::onSyncEvent(int clientId, const QString& status, const QString& message, const QJsonObject& event)
+{
+    if (!m_clientRowMap.contains(clientId)) return;
+    int row = m_clientRowMap[clientId];
+
+    // QUEUED та RUNNING (з прогресом по завданнях) відображаємо однаково — "виконується"
+    bool isFinished = (status == "SUCCESS" || status == "ERROR" || status == "FAILED");
+    QString visualStatus = isFinished ? status : "RUNNING";
+
+    QString lastDate;
+    if (isFinished) {
+        lastDate = event["timestamp"].toString();
+    } else if (QTableWidgetItem* dateItem = ui->tableWidget->item(row, 3)) {
+        lastDate = dateItem->text(); // Дата змінюється лише по завершенню
+    }
+
+    updateClientRow(row, lastDate, visualStatus, message);
+    if (QWidget *w = ui->tableWidget->cellWidget(row, 5)) {
+        w->setEnabled(isFinished);
+    }
+
+    // SyncManager уже зарахував завершення (markCompleted) — лише перемальовуємо прогрес
+    updateBatchProgress();
+}
+
+void SyncStatusDialog::onEventStreamConnectedChanged(bool connected)
+{
+    if (connected) {
+        m_refreshTimer->stop();
+        refreshClientList(); // Один раз звіряємося з базою, далі — лише події
+    } else {
+        m_refreshTimer->start(); // Канал упав — повертаємось до опитування
+    }
+}
+
 void SyncStatusDialog::onDashboardDataFailed(const ApiError& error)
 {
     QMessageBox::critical(this, "Помилка",
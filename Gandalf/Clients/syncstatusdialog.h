@@ -40,6 +40,10 @@ private slots:
     void onDashboardDataLoaded(const QJsonArray& data);
     void onDashboardDataFailed(const ApiError& error);
 
+    // --- Слоти від SyncEventStream (push-події від сервера) ---
+    void onSyncEvent(int clientId, const QString& status, const QString& message, const QJsonObject& event);
+    void onEventStreamConnectedChanged(bool connected);
+
 private:
     Ui::SyncStatusDialog *ui;
 
@@ -59,6 +63,9 @@ private:
 
     void updateClientRow(int row, const QString& lastDate, const QString& status, const QString& msg);
 
+    // Оновлює прогрес-бар за лічильниками SyncManager
+    void updateBatchProgress();
+
 };
 
 #endif // SYNCSTATUSDIALOG_H
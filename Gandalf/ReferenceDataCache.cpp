@@ -0,0 +1,266 @@
+#include "ReferenceDataCache.h"
+#include "Oracle/AppParams.h"
+#include "Oracle/Logger.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QUrlQuery>
+
+namespace {
+// Скільки відповідей чекає reloadAll: клієнти, ролі, методи IP, регіони, Global, Gandalf
+const int kReferenceParts = 6;
+}
+
+ReferenceDataCache& ReferenceDataCache::instance()
+{
+    static ReferenceDataCache self;
+    return self;
+}
+
+ReferenceDataCache::ReferenceDataCache(QObject *parent)
+    : QObject(parent)
+    , m_hasClients(false)
+    , m_hasRoles(false)
+    , m_hasIpGenMethods(false)
+    , m_hasRegions(false)
+    , m_hasSettings(false)
+    , m_outstanding(0)
+    , m_reloadFailed(false)
+{
+    ApiClient& api = ApiClient::instance();
+    connect(&api, &ApiClient::referenceRevisionFetched, this, &ReferenceDataCache::onRevisionFetched);
+    connect(&api, &ApiClient::referenceRevisionFetchFailed, this, &ReferenceDataCache::onRevisionFetchFailed);
+
+    // Відповіді слухаємо постійно: хто б не запитав довідник, кеш у пам'яті стає свіжішим.
+    // Лічильник reloadAll ці сигнали не чіпають — чужий запит під час перезавантаження його не зменшить
+    connect(&api, &ApiClient::clientsFetched, this, [this](const QJsonArray& clients) {
+        m_clients = clients;
+        m_hasClients = true;
+    });
+    connect(&api, &ApiClient::rolesFetched, this, [this](const QJsonArray& roles) {
+        m_roles = roles;
+        m_hasRoles = true;
+    });
+    connect(&api, &ApiClient::ipGenMethodsFetched, this, [this](const QJsonArray& methods) {
+        m_ipGenMethods = methods;
+        m_hasIpGenMethods = true;
+    });
+    connect(&api, &ApiClient::regionsListFetched, this, [this](const QStringList& regions) {
+        m_regions = regions;
+        m_hasRegions = true;
+    });
+    connect(&api, &ApiClient::scopedSettingsFetched, this, &ReferenceDataCache::onSettingsFetched);
+
+    loadFromDisk();
+}
+
+void ReferenceDataCache::bootstrap()
+{
+    // Налаштування з локальної копії — одразу, до першої відповіді сервера
+    if (m_hasSettings) {
+        applySettings("Global", m_globalSettings);
+        applySettings("Gandalf", m_gandalfSettings);
+    }
+
+    // Один дешевий запит вирішує, чи потрібно перезавантажувати довідники
+    ApiClient::instance().fetchReferenceRevision();
+}
+
+void ReferenceDataCache::onRevisionFetched(const QString &serverVersion, const QString &revision)
+{
+    if (isComplete() && serverVersion == m_serverVersion && revision == m_revision) {
+        logInfo() << "ReferenceDataCache: Local copy is up to date, revision" << revision;
+        emit ready();
+        return;
+    }
+
+    logInfo() << "ReferenceDataCache: Revision changed" << m_revision << "->" << revision << "- reloading.";
+    m_pendingServerVersion = serverVersion;
+    m_pendingRevision = revision;
+    reloadAll();
+}
+
+void ReferenceDataCache::onRevisionFetchFailed(const ApiError &error)
+{
+    if (isComplete()) {
+        logWarning() << "ReferenceDataCache: Revision check failed, using local copy:" << error.errorString;
+        emit ready();
+        return;
+    }
+
+    // Без ревізії: завантажуємо все, але зберігаємо з порожньою ревізією — наступний старт перевірить знову
+    m_pendingServerVersion.clear();
+    m_pendingRevision.clear();
+    reloadAll();
+}
+
+void ReferenceDataCache::reloadAll()
+{
+    if (m_outstanding > 0) return;
+
+    m_outstanding = kReferenceParts;
+    m_reloadFailed = false;
+
+    // Власні запити з власними колбеками: лічильник зменшують лише відповіді цього перезавантаження.
+    // Усі шість частин ідуть одним /api/batch
+    ApiClient& api = ApiClient::instance();
+    for (const QString& appName : {QStringLiteral("Global"), QStringLiteral("Gandalf")}) {
+        api.batchGet("/api/settings/" + appName, QUrlQuery(), [this, appName](const ApiError& error, const QJsonValue& body) {
+            if (partFailed(error, body.isObject())) return;
+            onSettingsFetched(appName, body.toObject().toVariantMap());
+            partLoaded();
+        });
+    }
+    api.batchGet("/api/clients", QUrlQuery(), [this](const ApiError& error, const QJsonValue& body) {
+        if (partFailed(error, body.isArray())) return;
+        m_clients = body.toArray();
+        m_hasClients = true;
+        partLoaded();
+    });
+    api.batchGet("/api/roles", QUrlQuery(), [this](const ApiError& error, const QJsonValue& body) {
+        if (partFailed(error, body.isArray())) return;
+        m_roles = body.toArray();
+        m_hasRoles = true;
+        partLoaded();
+    });
+    api.batchGet("/api/ip-gen-methods", QUrlQuery(), [this](const ApiError& error, const QJsonValue& body) {
+        if (partFailed(error, body.isArray())) return;
+        m_ipGenMethods = body.toArray();
+        m_hasIpGenMethods = true;
+        partLoaded();
+    });
+    api.batchGet("/api/regions-list", QUrlQuery(), [this](const ApiError& error, const QJsonValue& body) {
+        if (partFailed(error, body.toObject().value("regions").isArray())) return;
+        m_regions.clear();
+        for (const QJsonValue& region : body.toObject().value("regions").toArray()) {
+            m_regions.append(region.toString());
+        }
+        m_hasRegions = true;
+        partLoaded();
+    });
+}
+
+void ReferenceDataCache::onSettingsFetched(const QString &appName, const QVariantMap &settings)
+{
+    if (appName == "Global") {
+        m_globalSettings = settings;
+    } else if (appName == "Gandalf") {
+        m_gandalfSettings = settings;
+    } else {
+        return;
+    }
+    m_hasSettings = true;
+    applySettings(appName, settings);
+}
+
+bool ReferenceDataCache::partFailed(const ApiError &error, bool validBody)
+{
+    if (error.httpStatusCode == 200 && validBody) return false;
+
+    // Помилка частини не повинна підвісити reloadAll, але й не дає зберегти нову ревізію
+    logWarning() << "ReferenceDataCache: Reload part failed:" << error.httpStatusCode << error.errorString << error.requestUrl;
+    m_reloadFailed = true;
+    partLoaded();
+    return true;
+}
+
+void ReferenceDataCache::partLoaded()
+{
+    if (m_outstanding == 0 || --m_outstanding > 0) return;
+
+    if (m_reloadFailed) {
+        logWarning() << "ReferenceDataCache: Reload incomplete, local cache file left unchanged.";
+    } else {
+        m_serverVersion = m_pendingServerVersion;
+        m_revision = m_pendingRevision;
+        saveToDisk();
+        logInfo() << "ReferenceDataCache: Reloaded reference data, revision" << m_revision;
+    }
+    emit ready();
+}
+
+void ReferenceDataCache::applySettings(const QString &appName, const QVariantMap &settings)
+{
+    if (appName == "Global") {
+        AppParams::instance().setScopedParams("Global", settings);
+        return;
+    }
+    for (auto it = settings.constBegin(); it != settings.constEnd(); ++it) {
+        AppParams::instance().setParam(appName, it.key(), it.value());
+    }
+}
+
+bool ReferenceDataCache::isComplete() const
+{
+    return m_hasClients && m_hasRoles && m_hasIpGenMethods && m_hasRegions && m_hasSettings;
+}
+
+void ReferenceDataCache::loadFromDisk()
+{
+    QFile file(cacheFilePath());
+    if (!file.open(QIODevice::ReadOnly)) return;
+
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    if (!root.contains("revision")) {
+        logWarning() << "ReferenceDataCache: Local cache is corrupted, ignoring:" << file.fileName();
+        return;
+    }
+
+    m_serverVersion = root["server_version"].toString();
+    m_revision = root["revision"].toString();
+
+    m_clients = root["clients"].toArray();
+    m_roles = root["roles"].toArray();
+    m_ipGenMethods = root["ip_gen_methods"].toArray();
+    m_regions.clear();
+    for (const QJsonValue& region : root["regions"].toArray()) {
+        m_regions.append(region.toString());
+    }
+    const QJsonObject settings = root["settings"].toObject();
+    m_globalSettings = settings["Global"].toObject().toVariantMap();
+    m_gandalfSettings = settings["Gandalf"].toObject().toVariantMap();
+
+    m_hasClients = m_hasRoles = m_hasIpGenMethods = m_hasRegions = m_hasSettings = true;
+    logInfo() << "ReferenceDataCache: Loaded local copy, revision" << m_revision
+              << "(" << m_clients.size() << "clients," << m_regions.size() << "regions )";
+}
+
+void ReferenceDataCache::saveToDisk() const
+{
+    QDir().mkpath(QFileInfo(cacheFilePath()).absolutePath());
+
+    // QSaveFile — щоб обірваний запис не залишив пошкоджений кеш
+    QSaveFile file(cacheFilePath());
+    if (!file.open(QIODevice::WriteOnly)) {
+        logWarning() << "ReferenceDataCache: Cannot write local cache:" << file.errorString();
+        return;
+    }
+
+    QJsonObject settings;
+    settings["Global"] = QJsonObject::fromVariantMap(m_globalSettings);
+    settings["Gandalf"] = QJsonObject::fromVariantMap(m_gandalfSettings);
+
+    QJsonObject root;
+    root["server_version"] = m_serverVersion;
+    root["revision"] = m_revision;
+    root["clients"] = m_clients;
+    root["roles"] = m_roles;
+    root["ip_gen_methods"] = m_ipGenMethods;
+    root["regions"] = QJsonArray::fromStringList(m_regions);
+    root["settings"] = settings;
+
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    if (!file.commit()) {
+        logWarning() << "ReferenceDataCache: Cannot commit local cache:" << file.errorString();
+    }
+}
+
+QString ReferenceDataCache::cacheFilePath()
+{
+    return QCoreApplication::applicationDirPath() + "/Cache/reference_data.json";
+}
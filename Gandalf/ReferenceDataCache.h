@@ -0,0 +1,82 @@
+#ifndef REFERENCEDATACACHE_H
+#define REFERENCEDATACACHE_H
+
+#include "Oracle/ApiClient.h"
+
+#include <QObject>
+#include <QJsonArray>
+#include <QStringList>
+#include <QVariantMap>
+
+/**
+ * @brief Локальний кеш довідкових даних Gandalf: клієнти, ролі, регіони, методи генерації IP,
+ * налаштування груп Global і Gandalf.
+ *
+ * Кеш зберігається у файлі разом з версією сервера та ревізією довідників.
+ * На старті (bootstrap) дані з файлу застосовуються одразу, а паралельно одним дешевим
+ * запитом перевіряється ревізія; довідники перезавантажуються лише якщо вона змінилась.
+ * Діалоги беруть дані звідси й не ходять на сервер при кожному відкритті.
+ * Будь-яка відповідь сервера з цими даними (наприклад, після редагування клієнта) оновлює кеш у пам'яті.
+ */
+class ReferenceDataCache : public QObject
+{
+    Q_OBJECT
+public:
+    static ReferenceDataCache& instance();
+
+    // Застосовує локальну копію і паралельно перевіряє/оновлює її (викликається після логіну)
+    void bootstrap();
+
+    bool hasClients() const { return m_hasClients; }
+    bool hasRoles() const { return m_hasRoles; }
+    bool hasIpGenMethods() const { return m_hasIpGenMethods; }
+    bool hasRegions() const { return m_hasRegions; }
+
+    QJsonArray clients() const { return m_clients; }
+    QJsonArray roles() const { return m_roles; }
+    QJsonArray ipGenMethods() const { return m_ipGenMethods; }
+    QStringList regions() const { return m_regions; }
+
+signals:
+    // Довідники перевірені або перезавантажені
+    void ready();
+
+private:
+    explicit ReferenceDataCache(QObject *parent = nullptr);
+
+    void onRevisionFetched(const QString& serverVersion, const QString& revision);
+    void onRevisionFetchFailed(const ApiError& error);
+    void onSettingsFetched(const QString& appName, const QVariantMap& settings);
+    void reloadAll();
+    // true, якщо частина перезавантаження не вдалася (вже врахована в лічильнику)
+    bool partFailed(const ApiError& error, bool validBody);
+    void partLoaded();
+    void applySettings(const QString& appName, const QVariantMap& settings);
+
+    bool isComplete() const;
+    void loadFromDisk();
+    void saveToDisk() const;
+    static QString cacheFilePath();
+
+private:
+    QJsonArray m_clients;
+    QJsonArray m_roles;
+    QJsonArray m_ipGenMethods;
+    QStringList m_regions;
+    QVariantMap m_globalSettings;
+    QVariantMap m_gandalfSettings;
+    bool m_hasClients;
+    bool m_hasRoles;
+    bool m_hasIpGenMethods;
+    bool m_hasRegions;
+    bool m_hasSettings;
+
+    QString m_serverVersion;
+    QString m_revision;
+    QString m_pendingServerVersion; // Ревізія, під яку йде перезавантаження
+    QString m_pendingRevision;
+    int m_outstanding; // Скільки власних запитів reloadAll ще без відповіді
+    bool m_reloadFailed;
+};
+
+#endif // REFERENCEDATACACHE_H
@@ -3,6 +3,7 @@
 #include "ui_exporttasksdialog.h"
 #include "Oracle/ApiClient.h"
 #include "Oracle/Logger.h"
+#include "../Clients/SyncEventStream.h"
 
 #include <QStandardItemModel>
 #include <QMessageBox>
@@ -49,6 +50,11 @@ void ExportTasksDialog::createConnections()
     connect(&ApiClient::instance(), &ApiClient::exportTaskSaved, this, &ExportTasksDialog::onExportTaskSaved);
     connect(&ApiClient::instance(), &ApiClient::exportTaskSaveFailed, this, &ExportTasksDialog::onExportTaskSaveFailed);
 
+    // Завдання змінено в обхід цього вікна (інший користувач, Exporter) — перечитуємо список
+    connect(&SyncEventStream::instance(), &SyncEventStream::tableChanged, this, [this](const QString& table) {
+        if (table == "export_tasks") loadTasks();
+    });
+
 
 }
 
@@ -0,0 +1,274 @@
+#include "ReachabilityScanDialog.h"
+#include "Oracle/AppParams.h"
+#include "Oracle/Logger.h"
+
+#include <QTableWidget>
+#include <QHeaderView>
+#include <QLabel>
+#include <QPushButton>
+#include <QProgressBar>
+#include <QComboBox>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QJsonObject>
+#include <QDateTime>
+
+ReachabilityScanDialog::ReachabilityScanDialog(int clientId, int terminalId, const QString &title, QWidget *parent)
+    : QDialog(parent), m_clientId(clientId), m_terminalId(terminalId)
+{
+    setAttribute(Qt::WA_DeleteOnClose);
+    setupUi(title);
+
+    ApiClient& api = ApiClient::instance();
+    connect(&api, &ApiClient::clientWorkplacesReceived, this, &ReachabilityScanDialog::onWorkplacesReceived);
+    connect(&api, &ApiClient::clientWorkplacesFailed, this, &ReachabilityScanDialog::onWorkplacesFailed);
+    connect(&api, &ApiClient::reachabilityFetched, this, &ReachabilityScanDialog::onReachabilityFetched);
+
+    connect(&ReachabilityProbe::instance(), &ReachabilityProbe::probeFinished, this, &ReachabilityScanDialog::onProbeFinished);
+    connect(&ReachabilityProbe::instance(), &ReachabilityProbe::batchFinished, this, &ReachabilityScanDialog::onBatchFinished);
+
+    connect(m_btnRescan, &QPushButton::clicked, this, &ReachabilityScanDialog::startScan);
+    connect(m_btnStop, &QPushButton::clicked, this, &ReachabilityScanDialog::stopScan);
+
+    loadWorkplaces();
+}
+
+ReachabilityScanDialog::~ReachabilityScanDialog()
+{
+    // Діалог закрили посеред сканування — решта черги нікому не потрібна
+    ReachabilityProbe::instance().cancel(m_batchId);
+}
+
+void ReachabilityScanDialog::setupUi(const QString &title)
+{
+    setWindowTitle(title);
+    resize(760, 520);
+
+    auto mainLayout = new QVBoxLayout(this);
+
+    m_table = new QTableWidget(0, ColumnCount, this);
+    m_table->setHorizontalHeaderLabels({"АЗС", "Каса", "Адреса VNC", "Статус", "Відгук, мс", "Остання перевірка"});
+    m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_table->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_table->verticalHeader()->setVisible(false);
+    m_table->horizontalHeader()->setStretchLastSection(true);
+    mainLayout->addWidget(m_table);
+
+    m_progress = new QProgressBar(this);
+    m_progress->setTextVisible(true);
+    mainLayout->addWidget(m_progress);
+
+    auto bottomLayout = new QHBoxLayout();
+    m_summary = new QLabel("Завантаження списку кас...", this);
+    bottomLayout->addWidget(m_summary, 1);
+
+    m_method = new QComboBox(this);
+    m_method->addItem("VNC (TCP)", int(ProbeTarget::Method::Tcp));
+    m_method->addItem("Ping (ICMP)", int(ProbeTarget::Method::Icmp));
+    bottomLayout->addWidget(m_method);
+
+    m_btnStop = new QPushButton("Зупинити", this);
+    m_btnStop->setEnabled(false);
+    bottomLayout->addWidget(m_btnStop);
+
+    m_btnRescan = new QPushButton("Перевірити знову", this);
+    m_btnRescan->setEnabled(false);
+    bottomLayout->addWidget(m_btnRescan);
+
+    mainLayout->addLayout(bottomLayout);
+}
+
+void ReachabilityScanDialog::loadWorkplaces()
+{
+    // Окремий ендпоінт, а не /station/<id>/workplaces: його відповідь оновила б і картки відкритої вкладки
+    ApiClient::instance().fetchClientWorkplaces(m_clientId, qMax(0, m_terminalId));
+}
+
+void ReachabilityScanDialog::onWorkplacesReceived(int clientId, int terminalId, const QJsonArray &workplaces)
+{
+    if (clientId != m_clientId || terminalId != qMax(0, m_terminalId)) return;
+
+    if (workplaces.isEmpty()) {
+        showMessage("Немає кас для перевірки (або доступ лише через термінальний сервер клієнта).");
+        return;
+    }
+    populate(workplaces);
+}
+
+void ReachabilityScanDialog::onWorkplacesFailed(int clientId, int terminalId, const ApiError &error)
+{
+    if (clientId != m_clientId || terminalId != qMax(0, m_terminalId)) return;
+    showMessage("Не вдалося завантажити список кас: " + error.errorString);
+}
+
+void ReachabilityScanDialog::populate(const QJsonArray &workplaces)
+{
+    m_workplaces = workplaces;
+
+    m_table->setRowCount(workplaces.size());
+    for (int row = 0; row < workplaces.size(); ++row) {
+        const QJsonObject wp = workplaces.at(row).toObject();
+        const int port = wp["vnc_port"].toInt() > 0 ? wp["vnc_port"].toInt() : 5900;
+
+        auto terminalItem = new QTableWidgetItem();
+        terminalItem->setData(Qt::DisplayRole, wp["terminal_id"].toInt());
+        // Ключ рядка — для зіставлення з кешем Conduit
+        terminalItem->setData(Qt::UserRole, rowKey(wp["terminal_id"].toInt(), wp["workplace_id"].toInt()));
+        m_table->setItem(row, ColTerminal, terminalItem);
+
+        auto posItem = new QTableWidgetItem();
+        posItem->setData(Qt::DisplayRole, wp["pos_id"].toInt());
+        m_table->setItem(row, ColPos, posItem);
+
+        m_table->setItem(row, ColAddress, new QTableWidgetItem(QString("%1:%2").arg(wp["ip_address"].toString()).arg(port)));
+        m_table->setItem(row, ColStatus, new QTableWidgetItem("—"));
+        m_table->setItem(row, ColRtt, new QTableWidgetItem());
+        m_table->setItem(row, ColLastChecked, new QTableWidgetItem());
+    }
+    m_table->resizeColumnsToContents();
+
+    // Поки йде нове сканування, показуємо останній відомий стан з Conduit
+    ApiClient::instance().fetchReachability(m_clientId);
+    startScan();
+}
+
+void ReachabilityScanDialog::onReachabilityFetched(int clientId, const QJsonArray &entries)
+{
+    if (clientId != m_clientId) return;
+
+    QHash<QString, QJsonObject> byKey;
+    for (const QJsonValue& value : entries) {
+        const QJsonObject entry = value.toObject();
+        byKey.insert(rowKey(entry["terminal_id"].toInt(), entry["workplace_id"].toInt()), entry);
+    }
+
+    for (int row = 0; row < m_table->rowCount(); ++row) {
+        const QString key = m_table->item(row, ColTerminal)->data(Qt::UserRole).toString();
+        auto it = byKey.constFind(key);
+        if (it == byKey.constEnd()) continue;
+
+        const QJsonObject entry = it.value();
+        const QDateTime checkedAt = QDateTime::fromString(entry["checked_at"].toString(), Qt::ISODate).toLocalTime();
+        m_table->item(row, ColLastChecked)->setText(QString("%1 (%2)")
+                                                        .arg(checkedAt.toString("dd.MM HH:mm"))
+                                                        .arg(entry["reachable"].toBool() ? "доступна" : "недоступна"));
+    }
+}
+
+void ReachabilityScanDialog::startScan()
+{
+    if (m_workplaces.isEmpty()) return;
+
+    ReachabilityProbe::instance().cancel(m_batchId);
+
+    QList<ProbeTarget> targets;
+    targets.reserve(m_table->rowCount());
+    for (int row = 0; row < m_table->rowCount(); ++row) {
+        const QJsonObject wp = m_workplaces.at(row).toObject();
+
+        ProbeTarget target;
+        target.host = wp["ip_address"].toString();
+        target.port = quint16(wp["vnc_port"].toInt() > 0 ? wp["vnc_port"].toInt() : 5900);
+        target.method = ProbeTarget::Method(m_method->currentData().toInt());
+        target.tag = row;
+        targets.append(target);
+
+        m_table->item(row, ColStatus)->setText("Перевірка...");
+        m_table->item(row, ColStatus)->setBackground(QBrush());
+        m_table->item(row, ColRtt)->setText(QString());
+    }
+
+    m_done = 0;
+    m_reachable = 0;
+    m_report = QJsonArray();
+    m_progress->setRange(0, targets.size());
+    m_progress->setValue(0);
+    m_btnRescan->setEnabled(false);
+    m_btnStop->setEnabled(true);
+
+    int timeoutMs = AppParams::instance().getParam("Gandalf", "VncTimeoutMs", 1500).toInt();
+    if (timeoutMs <= 0) timeoutMs = 1500;
+
+    logInfo() << "ReachabilityScan: Client" << m_clientId << "terminal" << m_terminalId
+              << "- probing" << targets.size() << "workplaces.";
+    m_batchId = ReachabilityProbe::instance().probe(targets, timeoutMs);
+    updateSummary();
+}
+
+void ReachabilityScanDialog::stopScan()
+{
+    ReachabilityProbe::instance().cancel(m_batchId);
+    m_batchId = 0;
+    m_btnStop->setEnabled(false);
+    m_btnRescan->setEnabled(true);
+
+    // Частковий результат теж корисний для кешу
+    ApiClient::instance().reportReachability(m_clientId, m_report);
+    updateSummary();
+}
+
+void ReachabilityScanDialog::onProbeFinished(int batchId, const ProbeResult &result)
+{
+    if (batchId != m_batchId || m_batchId == 0) return;
+
+    const int row = result.target.tag;
+    if (row < 0 || row >= m_table->rowCount()) return;
+
+    ++m_done;
+    if (result.reachable) ++m_reachable;
+
+    QTableWidgetItem* statusItem = m_table->item(row, ColStatus);
+    statusItem->setText(result.reachable ? "Доступна" : "Недоступна");
+    statusItem->setToolTip(result.error);
+    statusItem->setBackground(result.reachable ? QColor("#e8f5e9") : QColor("#ffebee"));
+    m_table->item(row, ColRtt)->setText(result.reachable ? QString::number(result.rttMs) : QString());
+
+    const QJsonObject wp = m_workplaces.at(row).toObject();
+    QJsonObject entry;
+    entry["terminal_id"] = wp["terminal_id"].toInt();
+    entry["workplace_id"] = wp["workplace_id"].toInt();
+    entry["reachable"] = result.reachable;
+    entry["rtt_ms"] = result.rttMs;
+    entry["method"] = result.target.method == ProbeTarget::Method::Icmp ? "icmp" : "tcp";
+    entry["checked_at"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    m_report.append(entry);
+
+    m_progress->setValue(m_done);
+    updateSummary();
+}
+
+void ReachabilityScanDialog::onBatchFinished(int batchId)
+{
+    if (batchId != m_batchId || m_batchId == 0) return;
+
+    m_batchId = 0;
+    m_btnStop->setEnabled(false);
+    m_btnRescan->setEnabled(true);
+
+    ApiClient::instance().reportReachability(m_clientId, m_report);
+    updateSummary();
+}
+
+void ReachabilityScanDialog::showMessage(const QString &text)
+{
+    m_summary->setText(text);
+    m_progress->setVisible(false);
+    m_btnRescan->setEnabled(false);
+    m_btnStop->setEnabled(false);
+}
+
+void ReachabilityScanDialog::updateSummary()
+{
+    const int total = m_table->rowCount();
+    QString text = QString("Перевірено %1 з %2 · доступно: %3 · недоступно: %4")
+                       .arg(m_done).arg(total).arg(m_reachable).arg(m_done - m_reachable);
+    if (m_batchId == 0 && m_done < total) {
+        text += " · зупинено";
+    }
+    m_summary->setText(text);
+}
+
+QString ReachabilityScanDialog::rowKey(int terminalId, int workplaceId)
+{
+    return QString("%1/%2").arg(terminalId).arg(workplaceId);
+}
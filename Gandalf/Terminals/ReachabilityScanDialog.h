@@ -0,0 +1,78 @@
+#ifndef REACHABILITYSCANDIALOG_H
+#define REACHABILITYSCANDIALOG_H
+
+#include "Oracle/ApiClient.h"
+#include "Oracle/ReachabilityProbe.h"
+
+#include <QDialog>
+#include <QJsonArray>
+
+class QTableWidget;
+class QLabel;
+class QPushButton;
+class QProgressBar;
+class QComboBox;
+
+/**
+ * @brief Масова перевірка доступності VNC (або ping) усіх кас АЗС або всього клієнта.
+ *
+ * Перевірки виконує ReachabilityProbe (спільний ліміт паралельності), рядки таблиці
+ * оновлюються по мірі надходження результатів. Після завершення результати
+ * відправляються в кеш Conduit, а при відкритті показується останній відомий стан.
+ */
+class ReachabilityScanDialog : public QDialog
+{
+    Q_OBJECT
+public:
+    // terminalId <= 0 — сканувати всі АЗС клієнта
+    ReachabilityScanDialog(int clientId, int terminalId, const QString& title, QWidget *parent = nullptr);
+    ~ReachabilityScanDialog();
+
+private slots:
+    void onWorkplacesReceived(int clientId, int terminalId, const QJsonArray& workplaces);
+    void onWorkplacesFailed(int clientId, int terminalId, const ApiError& error);
+    void onReachabilityFetched(int clientId, const QJsonArray& entries);
+
+    void onProbeFinished(int batchId, const ProbeResult& result);
+    void onBatchFinished(int batchId);
+
+    void startScan();
+    void stopScan();
+
+private:
+    enum Column {
+        ColTerminal = 0,
+        ColPos,
+        ColAddress,
+        ColStatus,
+        ColRtt,
+        ColLastChecked,
+        ColumnCount
+    };
+
+    void setupUi(const QString& title);
+    void loadWorkplaces();
+    void populate(const QJsonArray& workplaces);
+    void showMessage(const QString& text);
+    void updateSummary();
+    static QString rowKey(int terminalId, int workplaceId);
+
+private:
+    int m_clientId;
+    int m_terminalId;
+
+    QTableWidget* m_table;
+    QLabel* m_summary;
+    QProgressBar* m_progress;
+    QPushButton* m_btnRescan;
+    QPushButton* m_btnStop;
+    QComboBox* m_method; // VNC (TCP) або ping (ICMP)
+
+    QJsonArray m_workplaces;
+    QJsonArray m_report; // Результати поточного сканування для кешу Conduit
+    int m_batchId = 0;
+    int m_done = 0;
+    int m_reachable = 0;
+};
+
+#endif // REACHABILITYSCANDIALOG_H
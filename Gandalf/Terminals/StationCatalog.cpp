@@ -0,0 +1,255 @@
+#include "StationCatalog.h"
+#include "Oracle/AppParams.h"
+#include "Oracle/Logger.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QSet>
+#include <QTimer>
+#include <algorithm>
+
+namespace {
+// Пріоритет статусу у видачі (як у легенді віджета пошуку)
+int statusRank(const StationStruct &s)
+{
+    if (s.isActive && s.isWork) return 1;
+    if (s.isActive && !s.isWork) return 2;
+    if (!s.isActive && !s.isWork) return 3;
+    return 4;
+}
+}
+
+StationCatalog& StationCatalog::instance()
+{
+    static StationCatalog self;
+    return self;
+}
+
+StationCatalog::StationCatalog(QObject *parent)
+    : QObject(parent), m_fetchInFlight(false)
+{
+    m_refreshTimer = new QTimer(this);
+    connect(m_refreshTimer, &QTimer::timeout, this, &StationCatalog::refresh);
+
+    connect(&ApiClient::instance(), &ApiClient::stationCatalogFetched, this, &StationCatalog::onCatalogFetched);
+    connect(&ApiClient::instance(), &ApiClient::stationCatalogUnchanged, this, &StationCatalog::onCatalogUnchanged);
+    connect(&ApiClient::instance(), &ApiClient::stationCatalogFetchFailed, this, &StationCatalog::onCatalogFetchFailed);
+
+    // Пошук працює одразу після старту, ще до відповіді сервера
+    loadFromDisk();
+}
+
+void StationCatalog::start()
+{
+    const int minutes = qMax(1, AppParams::instance().getParam("Global", "StationCatalogRefreshMinutes", 10).toInt());
+    m_refreshTimer->start(minutes * 60 * 1000);
+    refresh();
+}
+
+void StationCatalog::refresh()
+{
+    if (m_fetchInFlight) return;
+    m_fetchInFlight = true;
+    ApiClient::instance().fetchStationCatalog(m_version);
+}
+
+void StationCatalog::onCatalogFetched(const QString &version, const QJsonArray &stations)
+{
+    m_fetchInFlight = false;
+    m_version = version;
+    rebuild(stations);
+    saveToDisk(stations);
+    logInfo() << "StationCatalog: Updated to version" << version << "with" << m_stations.size() << "stations.";
+    emit catalogUpdated(m_stations.size());
+}
+
+void StationCatalog::onCatalogUnchanged(const QString &version)
+{
+    m_fetchInFlight = false;
+    logDebug() << "StationCatalog: Version" << version << "is up to date.";
+}
+
+void StationCatalog::onCatalogFetchFailed(const ApiError &error)
+{
+    m_fetchInFlight = false;
+    logWarning() << "StationCatalog: Refresh failed, keeping local copy:" << error.errorString;
+}
+
+QList<StationStruct> StationCatalog::search(const QString &text, int limit) const
+{
+    QList<StationStruct> results;
+    const QString needle = normalize(text);
+    if (needle.isEmpty() || m_stations.isEmpty()) return results;
+
+    QSet<int> seen;
+
+    // 1. Префікс Terminal ID. Точний збіг іде першим, бо він найменший у рядковому порядку.
+    bool isNumber = false;
+    needle.toInt(&isNumber);
+    if (isNumber) {
+        auto it = std::lower_bound(m_terminalKeys.cbegin(), m_terminalKeys.cend(), needle,
+                                   [](const QPair<QString, int> &key, const QString &value) {
+                                       return key.first < value;
+                                   });
+        for (; it != m_terminalKeys.cend() && it->first.startsWith(needle) && results.size() < limit; ++it) {
+            results.append(m_stations.at(it->second));
+            seen.insert(it->second);
+        }
+    }
+
+    // 2. Підрядок у назві/адресі/регіоні/клієнті
+    if (results.size() < limit) {
+        QVector<int> matches = textMatches(needle);
+        std::sort(matches.begin(), matches.end(), [this](int a, int b) {
+            const StationStruct &sa = m_stations.at(a);
+            const StationStruct &sb = m_stations.at(b);
+            const int rankA = statusRank(sa);
+            const int rankB = statusRank(sb);
+            return rankA != rankB ? rankA < rankB : sa.terminalId < sb.terminalId;
+        });
+        for (int idx : std::as_const(matches)) {
+            if (results.size() >= limit) break;
+            if (seen.contains(idx)) continue;
+            results.append(m_stations.at(idx));
+        }
+    }
+
+    return results;
+}
+
+QVector<int> StationCatalog::textMatches(const QString &needle) const
+{
+    QVector<int> matches;
+
+    // Для 1-2 символів триграм немає — довідник невеликий, перевіряємо напряму
+    if (needle.size() < 3) {
+        for (int i = 0; i < m_haystack.size(); ++i) {
+            if (m_haystack.at(i).contains(needle)) matches.append(i);
+        }
+        return matches;
+    }
+
+    // Збираємо posting-списки всіх триграм запиту; якщо хоч однієї немає — збігів немає
+    QVector<const QVector<int>*> lists;
+    for (int i = 0; i + 3 <= needle.size(); ++i) {
+        auto it = m_trigrams.constFind(trigramKey(needle.constData() + i));
+        if (it == m_trigrams.constEnd()) return matches;
+        lists.append(&it.value());
+    }
+
+    // Перетинаємо, починаючи з найкоротшого списку
+    std::sort(lists.begin(), lists.end(), [](const QVector<int> *a, const QVector<int> *b) {
+        return a->size() < b->size();
+    });
+    matches = *lists.first();
+    for (int i = 1; i < lists.size() && !matches.isEmpty(); ++i) {
+        QVector<int> narrowed;
+        std::set_intersection(matches.cbegin(), matches.cend(),
+                              lists.at(i)->cbegin(), lists.at(i)->cend(),
+                              std::back_inserter(narrowed));
+        matches.swap(narrowed);
+    }
+
+    // Триграми можуть бути в різних місцях рядка — остаточна перевірка підрядком
+    matches.erase(std::remove_if(matches.begin(), matches.end(), [this, &needle](int idx) {
+                      return !m_haystack.at(idx).contains(needle);
+                  }), matches.end());
+    return matches;
+}
+
+void StationCatalog::rebuild(const QJsonArray &stations)
+{
+    m_stations.clear();
+    m_terminalKeys.clear();
+    m_haystack.clear();
+    m_trigrams.clear();
+
+    m_stations.reserve(stations.size());
+    m_terminalKeys.reserve(stations.size());
+    m_haystack.reserve(stations.size());
+
+    for (const QJsonValue &val : stations) {
+        const QJsonObject obj = val.toObject();
+        StationStruct s;
+        s.objectId = obj["id"].toInt();
+        s.terminalId = obj["terminalId"].toInt();
+        s.clientName = obj["clientName"].toString();
+        s.address = obj["address"].toString();
+        s.name = obj["name"].toString();
+        s.regionName = obj["region"].toString();
+        s.isActive = obj["isActive"].toBool();
+        s.isWork = obj["isWork"].toBool();
+
+        const int idx = m_stations.size();
+        m_stations.append(s);
+        m_terminalKeys.append(qMakePair(QString::number(s.terminalId), idx));
+
+        // Поля розділені '\n', щоб триграми не склеювались через межу полів
+        const QString text = normalize(s.name) + '\n' + normalize(s.address) + '\n'
+                             + normalize(s.regionName) + '\n' + normalize(s.clientName);
+        m_haystack.append(text);
+
+        for (int i = 0; i + 3 <= text.size(); ++i) {
+            QVector<int> &postings = m_trigrams[trigramKey(text.constData() + i)];
+            // Індекси зростають, тож дубль може бути лише останнім елементом
+            if (postings.isEmpty() || postings.last() != idx) postings.append(idx);
+        }
+    }
+
+    std::sort(m_terminalKeys.begin(), m_terminalKeys.end());
+}
+
+void StationCatalog::loadFromDisk()
+{
+    QFile file(cacheFilePath());
+    if (!file.open(QIODevice::ReadOnly)) return;
+
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    if (!root.contains("stations")) {
+        logWarning() << "StationCatalog: Local cache is corrupted, ignoring:" << file.fileName();
+        return;
+    }
+
+    m_version = root["version"].toString();
+    rebuild(root["stations"].toArray());
+    logInfo() << "StationCatalog: Loaded" << m_stations.size() << "stations from local cache, version" << m_version;
+}
+
+void StationCatalog::saveToDisk(const QJsonArray &stations) const
+{
+    QDir().mkpath(QFileInfo(cacheFilePath()).absolutePath());
+
+    // QSaveFile — щоб обірваний запис не залишив пошкоджений кеш
+    QSaveFile file(cacheFilePath());
+    if (!file.open(QIODevice::WriteOnly)) {
+        logWarning() << "StationCatalog: Cannot write local cache:" << file.errorString();
+        return;
+    }
+    QJsonObject root;
+    root["version"] = m_version;
+    root["stations"] = stations;
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    if (!file.commit()) {
+        logWarning() << "StationCatalog: Cannot commit local cache:" << file.errorString();
+    }
+}
+
+QString StationCatalog::normalize(const QString &text)
+{
+    return text.simplified().toCaseFolded();
+}
+
+quint64 StationCatalog::trigramKey(const QChar *p)
+{
+    return (quint64(p[0].unicode()) << 32) | (quint64(p[1].unicode()) << 16) | quint64(p[2].unicode());
+}
+
+QString StationCatalog::cacheFilePath()
+{
+    return QCoreApplication::applicationDirPath() + "/Cache/station_catalog.json";
+}
@@ -0,0 +1,78 @@
+#ifndef STATIONCATALOG_H
+#define STATIONCATALOG_H
+
+#include "StationStruct.h"
+#include "Oracle/ApiClient.h"
+
+#include <QObject>
+#include <QHash>
+#include <QJsonArray>
+#include <QVector>
+
+class QTimer;
+
+/**
+ * @brief Локальний довідник АЗС для миттєвого пошуку в StationSearchWidget.
+ *
+ * Довідник зберігається у файлі поруч із програмою і оновлюється з Conduit
+ * за версією (/api/stations/catalog?version=...): якщо версія не змінилась,
+ * сервер повертає лише коротку відповідь.
+ *
+ * Індекси:
+ *  - префіксний за Terminal ID (відсортований масив рядків + бінарний пошук);
+ *  - триграмний за назвою, адресою, регіоном і клієнтом (перетин posting-списків).
+ */
+class StationCatalog : public QObject
+{
+    Q_OBJECT
+public:
+    static StationCatalog& instance();
+
+    // Запускає перевірку версії зараз і далі періодично (викликається після логіну)
+    void start();
+    void refresh();
+
+    bool isReady() const { return !m_stations.isEmpty(); }
+    int size() const { return m_stations.size(); }
+
+    /**
+     * @brief Пошук за префіксом Terminal ID та/або підрядком у назві, адресі, регіоні, клієнті.
+     * Спочатку — збіги за Terminal ID, далі текстові збіги (за статусом, потім за ID).
+     */
+    QList<StationStruct> search(const QString& text, int limit = 50) const;
+
+signals:
+    void catalogUpdated(int stationsCount);
+
+private slots:
+    void onCatalogFetched(const QString& version, const QJsonArray& stations);
+    void onCatalogUnchanged(const QString& version);
+    void onCatalogFetchFailed(const ApiError& error);
+
+private:
+    explicit StationCatalog(QObject *parent = nullptr);
+
+    void loadFromDisk();
+    void saveToDisk(const QJsonArray& stations) const;
+    void rebuild(const QJsonArray& stations);
+    QVector<int> textMatches(const QString& needle) const;
+
+    static QString normalize(const QString& text);
+    static quint64 trigramKey(const QChar* p);
+    static QString cacheFilePath();
+
+private:
+    QVector<StationStruct> m_stations;
+    QString m_version;
+
+    // Префіксний індекс: (Terminal ID у вигляді рядка, індекс у m_stations), відсортовано за рядком
+    QVector<QPair<QString, int>> m_terminalKeys;
+    // Нормалізований текст для перевірки збігу та триграмний індекс по ньому
+    QVector<QString> m_haystack;
+    QHash<quint64, QVector<int>> m_trigrams;
+
+    QTimer* m_refreshTimer;
+    bool m_fetchInFlight;
+};
+
+#endif // STATIONCATALOG_H
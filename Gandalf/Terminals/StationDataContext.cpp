@@ -3,20 +3,23 @@
 #include "Oracle/Logger.h"
 
 StationDataContext::StationDataContext(int objectId, QObject *parent)
-    : QObject(parent), m_objectId(objectId)
+    : QObject(parent), m_objectId(objectId), m_priority(RequestPriority::Interactive)
 {
+    // Група живе рівно стільки, скільки контекст (тобто вкладка АЗС)
+    m_requests = new ApiRequestGroup(this);
 }
 
-void StationDataContext::fetchGeneralInfo()
+void StationDataContext::fetchGeneralInfo(RequestPriority priority)
 {
     logInfo() << "DataContext: Fetching general info for Object ID:" << m_objectId;
+    m_priority = priority;
 
     // 1. ВИПРАВЛЕНО: Правильний сигнал від ApiClient
     // 2. ВИПРАВЛЕНО: Прибрано SingleShotConnection для надійності
     connect(&ApiClient::instance(), &ApiClient::objectGeneralInfoFetched,
             this, &StationDataContext::onApiDataReceived);
 
-    ApiClient::instance().fetchObjectGeneralInfo(m_objectId);
+    m_requests->add(ApiClient::instance().fetchObjectGeneralInfo(m_objectId, m_priority));
 }
 
 void StationDataContext::onApiDataReceived(int fetchedObjectId, const QJsonObject &data)
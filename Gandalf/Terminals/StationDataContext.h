@@ -1,6 +1,8 @@
 #ifndef STATIONDATACONTEXT_H
 #define STATIONDATACONTEXT_H
 
+#include "Oracle/ApiRequest.h"
+
 #include <QObject>
 #include <QJsonObject>
 #include <QString>
@@ -27,8 +29,17 @@ public:
 
     const GeneralInfo& getGeneralInfo() const { return m_generalInfo; }
 
-    // Метод для запуску завантаження даних з сервера
-    void fetchGeneralInfo();
+    // Метод для запуску завантаження даних з сервера.
+    // Normal — фонове оновлення вкладки, вже відмальованої зі StationSnapshotCache.
+    void fetchGeneralInfo(RequestPriority priority = RequestPriority::Interactive);
+    // Пріоритет, з яким вантажиться ця вкладка (для додаткових запитів)
+    RequestPriority priority() const { return m_priority; }
+
+    // Підставляє дані зі знімка кешу без запиту до сервера
+    void restore(const GeneralInfo& info) { m_generalInfo = info; }
+
+    // Усі запити цієї вкладки (скасовуються при закритті вкладки)
+    ApiRequestGroup* requests() const { return m_requests; }
 
 signals:
     // Сигнал: Дані успішно завантажені та готові до використання
@@ -43,6 +54,8 @@ private slots:
 private:
     int m_objectId;
     GeneralInfo m_generalInfo;
+    ApiRequestGroup* m_requests;
+    RequestPriority m_priority;
 };
 
 #endif // STATIONDATACONTEXT_H
@@ -1,4 +1,5 @@
 #include "StationSearchWidget.h"
+#include "StationCatalog.h"
 #include "Oracle/ApiClient.h"
 #include "Oracle/Logger.h"
 #include <QVBoxLayout>
@@ -78,7 +79,9 @@ void StationDelegate::paint(QPainter *painter, const QStyleOptionViewItem &optio
     QFont fTitle = opt.font;
     fTitle.setPixelSize(14);
     painter->setFont(fTitle);
-    painter->drawText(textR.adjusted(0, 5, 0, 0), Qt::AlignLeft | Qt::AlignTop, st.clientName);
+    // Назва АЗС є лише в результатах локального довідника
+    QString title = st.name.isEmpty() ? st.clientName : st.clientName + " — " + st.name;
+    painter->drawText(textR.adjusted(0, 5, 0, 0), Qt::AlignLeft | Qt::AlignTop, title);
 
     painter->setPen(QColor("#70757A"));
     QFont fAddr = opt.font;
@@ -126,10 +129,9 @@ StationSearchWidget::StationSearchWidget(QWidget *parent) : QWidget(parent) {
     // Б. Поле вводу (Центр)
     m_input = new QLineEdit(m_searchContainer);
     m_input->setFrame(false);
-    m_input->setPlaceholderText("Введіть Terminal ID...");
+    m_input->setPlaceholderText("Terminal ID, назва або адреса АЗС...");
     m_input->setClearButtonEnabled(true); // Хрестик від Qt
     m_input->installEventFilter(this);
-    m_input->setValidator(new QIntValidator(0, 999999, this));
 
     // В. Кнопка "Легенда" (Справа, окрема кнопка!)
     QToolButton *helpBtn = new QToolButton(m_searchContainer);
@@ -209,6 +211,7 @@ StationSearchWidget::StationSearchWidget(QWidget *parent) : QWidget(parent) {
     connect(m_input, &QLineEdit::returnPressed, this, &StationSearchWidget::onReturnPressed);
     connect(m_listView, &QListView::clicked, this, &StationSearchWidget::onListItemClicked);
     connect(&ApiClient::instance(), &ApiClient::stationSearchFinished, this, &StationSearchWidget::onSearchResults);
+    connect(&StationCatalog::instance(), &StationCatalog::catalogUpdated, this, &StationSearchWidget::onCatalogUpdated);
 }
 
 // --- ІНШІ МЕТОДИ КЛАСУ ---
@@ -321,9 +324,22 @@ void StationSearchWidget::updateStyles(bool listVisible, bool hasError) {
 
 void StationSearchWidget::onInputChanged(const QString &text) {
     updateStyles(false, false);
-    if (text.isEmpty()) {
+    if (text.trimmed().isEmpty()) {
         m_listView->setVisible(false);
         m_statusBar->setVisible(false);
+        return;
+    }
+
+    // Пошук "на льоту" — лише по локальному довіднику, без запитів до сервера
+    if (StationCatalog::instance().isReady()) {
+        showResults(StationCatalog::instance().search(text), false);
+    }
+}
+
+void StationSearchWidget::onCatalogUpdated() {
+    // Довідник оновився, поки користувач щось шукав — перераховуємо видачу
+    if (!m_input->text().trimmed().isEmpty() && m_listView->isVisible()) {
+        showResults(StationCatalog::instance().search(m_input->text()), false);
     }
 }
 
@@ -332,6 +348,22 @@ void StationSearchWidget::onReturnPressed() {
     if (text.isEmpty()) return;
     bool ok;
     int termId = text.toInt(&ok);
+
+    if (StationCatalog::instance().isReady()) {
+        QList<StationStruct> stations = StationCatalog::instance().search(text);
+        // Enter на повному Terminal ID відкриває саме цю АЗС, навіть якщо є довші ID з таким префіксом
+        if (ok) {
+            QList<StationStruct> exact;
+            for (const StationStruct &st : std::as_const(stations)) {
+                if (st.terminalId == termId) exact.append(st);
+            }
+            if (!exact.isEmpty()) stations = exact;
+        }
+        showResults(stations, true);
+        return;
+    }
+
+    // Довідник ще не завантажено — точний пошук на сервері
     if (ok) {
         logInfo() << "UI: Searching station ID:" << termId;
         ApiClient::instance().searchStation(termId);
@@ -343,15 +375,8 @@ void StationSearchWidget::onReturnPressed() {
 void StationSearchWidget::onSearchResults(const QList<StationStruct>& stations) {
     m_input->setFocus();
 
-    if (stations.isEmpty()) {
-        updateStyles(false, true);
-        m_listView->setVisible(false);
-        m_statusBar->setVisible(false);
-    } else if (stations.size() == 1) {
-        m_listView->setVisible(false);
-        m_statusBar->setVisible(false);
-        updateStyles(false, false);
-        emit objectSelected(stations.first().objectId);
+    if (stations.size() <= 1) {
+        showResults(stations, true);
     } else {
         // 1. Створюємо копію списку для сортування
         QList<StationStruct> sortedStations = stations;
@@ -378,14 +403,29 @@ void StationSearchWidget::onSearchResults(const QList<StationStruct>& stations)
         });
 
         // 3. Передаємо вже відсортований список
-        m_model->setStations(sortedStations);
+        showResults(sortedStations, true);
+    }
+}
+
+void StationSearchWidget::showResults(const QList<StationStruct>& stations, bool autoSelectSingle) {
+    if (stations.isEmpty()) {
+        updateStyles(false, true);
+        m_listView->setVisible(false);
+        m_statusBar->setVisible(false);
+    } else if (stations.size() == 1 && autoSelectSingle) {
+        m_listView->setVisible(false);
+        m_statusBar->setVisible(false);
+        updateStyles(false, false);
+        emit objectSelected(stations.first().objectId);
+    } else {
+        m_model->setStations(stations);
 
-        m_statusBar->setText(QString("ЗНАЙДЕНО РЕЗУЛЬТАТІВ: %1").arg(sortedStations.size()));
+        m_statusBar->setText(QString("ЗНАЙДЕНО РЕЗУЛЬТАТІВ: %1").arg(stations.size()));
         m_statusBar->setVisible(true);
 
         int rowHeight = 52;
         int maxRows = 5;
-        int listHeight = qMin(sortedStations.size() * rowHeight, rowHeight * maxRows);
+        int listHeight = qMin(stations.size() * rowHeight, rowHeight * maxRows);
 
         m_listView->setFixedHeight(listHeight);
         m_listView->setVisible(true);
@@ -49,6 +49,7 @@ private slots:
     void onInputChanged(const QString &text);
     void onReturnPressed();
     void onSearchResults(const QList<StationStruct>& stations);
+    void onCatalogUpdated();
     void onListItemClicked(const QModelIndex &index);
 
 private:
@@ -62,6 +63,8 @@ private:
     StationListModel *m_model;
 
     void updateStyles(bool listVisible, bool hasError = false);
+    // Показує результати; autoSelectSingle — одразу відкрити АЗС, якщо вона одна
+    void showResults(const QList<StationStruct>& stations, bool autoSelectSingle);
 };
 
 #endif // STATIONSEARCHWIDGET_H
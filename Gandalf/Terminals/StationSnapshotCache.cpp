@@ -0,0 +1,102 @@
+#include "StationSnapshotCache.h"
+#include "../Clients/SyncEventStream.h"
+#include "Oracle/AppParams.h"
+#include "Oracle/Logger.h"
+
+#include <QDateTime>
+
+StationSnapshotCache& StationSnapshotCache::instance()
+{
+    static StationSnapshotCache self;
+    return self;
+}
+
+StationSnapshotCache::StationSnapshotCache(QObject *parent)
+    : QObject(parent)
+{
+    m_capacity = qMax(1, AppParams::instance().getParam("Gandalf", "StationCacheSize", 20).toInt());
+    m_ttlMs = qMax(0, AppParams::instance().getParam("Gandalf", "StationCacheTtlSec", 120).toInt()) * 1000LL;
+
+    connect(&SyncEventStream::instance(), &SyncEventStream::syncEventReceived, this,
+            [this](int clientId, const QString& status, const QString&, const QJsonObject&) {
+                onSyncEvent(clientId, status);
+            });
+}
+
+StationSnapshotCache::Lookup StationSnapshotCache::lookup(int objectId, StationSnapshot *snapshot)
+{
+    auto it = m_entries.constFind(objectId);
+    if (it == m_entries.constEnd()) {
+        ++m_stats.misses;
+        emit statsChanged();
+        return Lookup::Miss;
+    }
+
+    if (snapshot) *snapshot = it.value();
+    touch(objectId);
+
+    const bool fresh = it->isComplete() && QDateTime::currentMSecsSinceEpoch() - it->updatedAtMs < m_ttlMs;
+    if (fresh) ++m_stats.freshHits;
+    else ++m_stats.staleHits;
+    emit statsChanged();
+
+    return fresh ? Lookup::Fresh : Lookup::Stale;
+}
+
+void StationSnapshotCache::putGeneralInfo(int objectId, const StationDataContext::GeneralInfo &info)
+{
+    StationSnapshot& snapshot = m_entries[objectId];
+    snapshot.info = info;
+    snapshot.updatedAtMs = QDateTime::currentMSecsSinceEpoch();
+    touch(objectId);
+    evictOverflow();
+    emit statsChanged();
+}
+
+void StationSnapshotCache::putPart(int objectId, Part part, const QJsonArray &data)
+{
+    // Масиви без загальної інформації не кешуємо: знімок без шапки не відмалювати
+    auto it = m_entries.find(objectId);
+    if (it == m_entries.end()) return;
+
+    switch (part) {
+    case Part::Rro:        it->rro = data;        it->hasRro = true;        break;
+    case Part::Tanks:      it->tanks = data;      it->hasTanks = true;      break;
+    case Part::Dispensers: it->dispensers = data; it->hasDispensers = true; break;
+    case Part::Workplaces: it->workplaces = data; it->hasWorkplaces = true; break;
+    }
+}
+
+StationSnapshotCache::Stats StationSnapshotCache::stats() const
+{
+    Stats stats = m_stats;
+    stats.size = m_entries.size();
+    stats.capacity = m_capacity;
+    return stats;
+}
+
+void StationSnapshotCache::touch(int objectId)
+{
+    m_lru.removeOne(objectId);
+    m_lru.prepend(objectId);
+}
+
+void StationSnapshotCache::evictOverflow()
+{
+    while (m_lru.size() > m_capacity) {
+        const int victim = m_lru.takeLast();
+        m_entries.remove(victim);
+        ++m_stats.evictions;
+        logDebug() << "StationSnapshotCache: Evicted object" << victim;
+    }
+}
+
+void StationSnapshotCache::onSyncEvent(int clientId, const QString &status)
+{
+    if (status != "SUCCESS") return;
+
+    // Дані клієнта в базі оновились — наступне відкриття його АЗС має перезапитати сервер
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+        if (it->info.clientId == clientId) it->updatedAtMs = 0;
+    }
+}
@@ -0,0 +1,101 @@
+#ifndef STATIONSNAPSHOTCACHE_H
+#define STATIONSNAPSHOTCACHE_H
+
+#include "StationDataContext.h"
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QJsonArray>
+
+/**
+ * @brief Знімок даних вкладки АЗС: загальна інформація та масиви РРО/резервуарів/ПРК/кас.
+ */
+struct StationSnapshot {
+    StationDataContext::GeneralInfo info;
+    QJsonArray rro;
+    QJsonArray tanks;
+    QJsonArray dispensers;
+    QJsonArray workplaces;
+    bool hasRro = false;
+    bool hasTanks = false;
+    bool hasDispensers = false;
+    bool hasWorkplaces = false;
+    qint64 updatedAtMs = 0; // Час останнього оновлення загальної інформації
+
+    // Усі масиви отримано (вкладку могли закрити до того, як вони прийшли)
+    bool isComplete() const { return hasRro && hasTanks && hasDispensers && hasWorkplaces; }
+};
+
+/**
+ * @brief LRU-кеш знімків нещодавно відкритих АЗС (stale-while-revalidate).
+ *
+ * Повторне відкриття АЗС одразу малює знімок з кешу. Якщо знімок старший за TTL —
+ * паралельно йде фонове оновлення (умовне: ApiClient сам шле If-None-Match),
+ * і вкладка перемальовується, коли прийдуть свіжі дані.
+ * Успішна синхронізація клієнта (SyncEventStream) робить знімки його АЗС застарілими.
+ * Неповний знімок (частину масивів скасовано закриттям вкладки) завжди вважається застарілим,
+ * інакше відсутні частини не довантажились би до кінця TTL.
+ *
+ * Налаштування (Gandalf): StationCacheSize (20), StationCacheTtlSec (120).
+ */
+class StationSnapshotCache : public QObject
+{
+    Q_OBJECT
+public:
+    enum class Lookup {
+        Miss,
+        Fresh,
+        Stale
+    };
+
+    enum class Part {
+        Rro,
+        Tanks,
+        Dispensers,
+        Workplaces
+    };
+
+    struct Stats {
+        int size = 0;
+        int capacity = 0;
+        quint64 freshHits = 0;
+        quint64 staleHits = 0;
+        quint64 misses = 0;
+        quint64 evictions = 0;
+
+        double hitRate() const {
+            const quint64 total = freshHits + staleHits + misses;
+            return total ? 100.0 * (freshHits + staleHits) / total : 0.0;
+        }
+    };
+
+    static StationSnapshotCache& instance();
+
+    // Шукає знімок і робить його найсвіжішим у LRU; рахується в статистиці
+    Lookup lookup(int objectId, StationSnapshot* snapshot);
+
+    void putGeneralInfo(int objectId, const StationDataContext::GeneralInfo& info);
+    void putPart(int objectId, Part part, const QJsonArray& data);
+
+    Stats stats() const;
+
+signals:
+    void statsChanged();
+
+private:
+    explicit StationSnapshotCache(QObject *parent = nullptr);
+
+    void touch(int objectId);
+    void evictOverflow();
+    void onSyncEvent(int clientId, const QString& status);
+
+private:
+    QHash<int, StationSnapshot> m_entries;
+    QList<int> m_lru; // Початок — найсвіжіше використаний objectId
+    int m_capacity;
+    qint64 m_ttlMs;
+    Stats m_stats;
+};
+
+#endif // STATIONSNAPSHOTCACHE_H
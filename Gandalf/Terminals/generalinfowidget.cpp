@@ -4,6 +4,7 @@
 #include "poscardwidget.h"
 #include "workplacewidget.h"
 #include "workplacedata.h"
+#include "ReachabilityScanDialog.h"
 
 #include <QHeaderView>
 
@@ -187,6 +188,23 @@ void GeneralInfoWidget::onFrameContextMenu(const QPoint &pos)
         connect(actOpenMap, &QAction::triggered, this, &GeneralInfoWidget::openMapInBrowser);
     }
 
+    // 4. Масова перевірка доступності кас
+    if (m_lastInfo.clientId > 0) {
+        menu.addSeparator();
+        QAction *actScanStation = menu.addAction("📡 Перевірити доступність усіх кас АЗС");
+        connect(actScanStation, &QAction::triggered, this, [this](){
+            auto dlg = new ReachabilityScanDialog(m_lastInfo.clientId, m_lastInfo.terminalId,
+                                                  QString("Доступність кас: АЗС %1").arg(m_lastInfo.terminalId), this);
+            dlg->show();
+        });
+        QAction *actScanClient = menu.addAction("📡 Перевірити доступність усіх кас клієнта");
+        connect(actScanClient, &QAction::triggered, this, [this](){
+            auto dlg = new ReachabilityScanDialog(m_lastInfo.clientId, 0,
+                                                  QString("Доступність кас: %1").arg(m_lastInfo.clientName), this);
+            dlg->show();
+        });
+    }
+
     // Відображаємо меню в точці кліку
     menu.exec(ui->frameTitle->mapToGlobal(pos));
 }
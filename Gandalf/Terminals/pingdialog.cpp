@@ -18,10 +18,11 @@ PingDialog::PingDialog(WorkplaceData *wk, QWidget *parent) :
     modelPing = new PingModel(this);
 
     connect(modelPing, &PingModel::signalSendOutPing, this, &PingDialog::slotGetPingString);
+    connect(modelPing, &PingModel::signalStatsUpdated, this, &PingDialog::slotStatsUpdated);
 
     createUI();
 
-    // Запускаємо процес (передаємо строку напряму)
+    // Запускаємо сесію спільного пінгера (передаємо строку напряму)
     modelPing->start_command(curWorplace->getIpAdr());
 }
 
@@ -46,6 +47,19 @@ void PingDialog::slotGetPingString(const QString& pStr)
     ui->plainTextEditPing->appendPlainText(pStr);
 }
 
+void PingDialog::slotStatsUpdated(const PingStats& stats)
+{
+    QString text = QString("Останні %1 запитів: отримано %2 · втрати %3%")
+                       .arg(stats.sent).arg(stats.received).arg(stats.lossPercent, 0, 'f', 0);
+    if (stats.received > 0) {
+        text += QString("\nmin/avg/max/p95 = %1/%2/%3/%4 мс · jitter %5 мс")
+                    .arg(stats.minMs, 0, 'f', 1).arg(stats.avgMs, 0, 'f', 1)
+                    .arg(stats.maxMs, 0, 'f', 1).arg(stats.p95Ms, 0, 'f', 1)
+                    .arg(stats.jitterMs, 0, 'f', 1);
+    }
+    ui->labelStats->setText(text);
+}
+
 void PingDialog::on_toolButtonCopyHost_clicked()
 {
     QClipboard *clipboard = QGuiApplication::clipboard();
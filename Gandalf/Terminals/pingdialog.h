@@ -20,6 +20,7 @@ public:
 
 private slots:
     void slotGetPingString(const QString& output); // Змінили на QString
+    void slotStatsUpdated(const PingStats& stats);
     void on_toolButtonCopyHost_clicked();
     void on_buttonBox_rejected();
 
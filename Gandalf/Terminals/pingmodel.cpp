@@ -1,21 +1,13 @@
 #include "pingmodel.h"
-#include <QDebug>
-#include <QTextCodec>
+#include "Oracle/AppParams.h"
 
 PingModel::PingModel(QObject *parent) :
-    QObject(parent), running(false)
+    QObject(parent), m_sessionId(0), running(false)
 {
-    ping = new QProcess(this);
-
-    // Об'єднуємо канали, щоб бачити і помилки, і стандартний вивід
-    ping->setProcessChannelMode(QProcess::MergedChannels);
-
-    // Слухаємо дані
-    connect(ping, &QProcess::readyReadStandardOutput, this, &PingModel::readResult);
-
-    // Відслідковуємо завершення
-    connect(ping, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
-            this, [this](){ running = false; });
+    IcmpPinger& pinger = IcmpPinger::instance();
+    connect(&pinger, &IcmpPinger::sessionStarted, this, &PingModel::onSessionStarted);
+    connect(&pinger, &IcmpPinger::sampleReady, this, &PingModel::onSampleReady);
+    connect(&pinger, &IcmpPinger::sessionFailed, this, &PingModel::onSessionFailed);
 }
 
 PingModel::~PingModel(){
@@ -25,54 +17,62 @@ PingModel::~PingModel(){
 void PingModel::start_command(const QString& host){
     stop_command(); // На випадок, якщо вже був запущений
 
-    if(ping){
-        QStringList args;
-#ifdef Q_OS_WIN
-        args << "-t" << host; // Безкінечний пінг для Windows
-#else
-        args << host;         // Для Linux/Mac
-#endif
+    const int intervalMs = AppParams::instance().getParam("Gandalf", "PingIntervalMs", 1000).toInt();
+    const int timeoutMs = AppParams::instance().getParam("Gandalf", "PingTimeoutMs", 1000).toInt();
 
-        ping->start("ping", args);
-        running = true;
-    }
+    m_host = host;
+    m_sessionId = IcmpPinger::instance().startSession(host, intervalMs, timeoutMs);
+    running = true;
 }
 
 void PingModel::stop_command()
 {
-    if (ping->state() == QProcess::Running) {
-        ping->terminate();
-        if (!ping->waitForFinished(2000)) {
-            ping->kill();
-        }
+    if (m_sessionId != 0) {
+        IcmpPinger::instance().stopSession(m_sessionId);
+        m_sessionId = 0;
     }
     running = false;
 }
 
-void PingModel::readResult(){
-    // Читаємо ВСІ доступні рядки в циклі
-    while (ping->canReadLine()) {
-        QByteArray output = ping->readLine();
+bool PingModel::is_running() const {
+    return running;
+}
 
-        QString pStr;
-#ifdef Q_OS_WIN
-        // Для Windows використовуємо CP866 (кодування консолі за замовчуванням)
-        QTextCodec *codec = QTextCodec::codecForName("CP866");
-        if (codec) {
-            pStr = codec->toUnicode(output);
-        } else {
-            pStr = QString::fromLocal8Bit(output);
-        }
-#else
-        // Для Linux/Mac консоль зазвичай в UTF-8
-        pStr = QString::fromUtf8(output);
-#endif
+PingStats PingModel::stats() const
+{
+    return IcmpPinger::instance().stats(m_sessionId);
+}
+
+void PingModel::onSessionStarted(int sessionId, const QHostAddress& address)
+{
+    if (sessionId != m_sessionId) return;
 
-        // Відправляємо сигнал в UI
-        emit signalSendOutPing(pStr.trimmed());
+    QString line = QString("Обмін пакетами з %1").arg(m_host);
+    if (address.toString() != m_host) line += QString(" [%1]").arg(address.toString());
+    emit signalSendOutPing(line + ":");
+}
+
+void PingModel::onSampleReady(int sessionId, const PingSample& sample)
+{
+    if (sessionId != m_sessionId) return;
+
+    QString line;
+    if (sample.lost) {
+        line = QString("seq=%1: %2").arg(sample.seq).arg(sample.error);
+    } else {
+        line = QString("Відповідь від %1: seq=%2 час=%3 мс").arg(m_host).arg(sample.seq).arg(sample.rttMs, 0, 'f', 1);
+        if (sample.ttl >= 0) line += QString(" TTL=%1").arg(sample.ttl);
     }
+
+    emit signalSendOutPing(line);
+    emit signalStatsUpdated(stats());
 }
 
-bool PingModel::is_running() const {
-    return running;
+void PingModel::onSessionFailed(int sessionId, const QString& error)
+{
+    if (sessionId != m_sessionId) return;
+
+    m_sessionId = 0;
+    running = false;
+    emit signalSendOutPing("Помилка: " + error);
 }
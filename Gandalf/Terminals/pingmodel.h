@@ -1,9 +1,16 @@
 #ifndef PINGMODEL_H
 #define PINGMODEL_H
 
+#include "Oracle/IcmpPinger.h"
+
 #include <QObject>
-#include <QProcess>
 
+/**
+ * @brief Адаптер вікна пінгу над спільним IcmpPinger.
+ *
+ * Окремого процесу ping більше немає: модель лише тримає свою сесію пінгера
+ * і перетворює структуровані семпли на рядки для консолі та агрегати для статусу.
+ */
 class PingModel : public QObject
 {
     Q_OBJECT
@@ -16,15 +23,22 @@ public:
     void stop_command();
     bool is_running() const;
 
+    PingStats stats() const;
+
 signals:
-    // Відправляємо вже готовий рядок, щоб не мучити UI кодуваннями
+    // Відправляємо вже готовий рядок, щоб не мучити UI форматуванням
     void signalSendOutPing(const QString& output);
+    // Агрегати по ковзному вікну, після кожного семпла
+    void signalStatsUpdated(const PingStats& stats);
 
 private slots:
-    void readResult();
+    void onSessionStarted(int sessionId, const QHostAddress& address);
+    void onSampleReady(int sessionId, const PingSample& sample);
+    void onSessionFailed(int sessionId, const QString& error);
 
 private:
-    QProcess *ping;
+    QString m_host;
+    int m_sessionId;
     bool running;
 };
 
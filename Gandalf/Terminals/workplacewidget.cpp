@@ -4,8 +4,8 @@
 #include "pingdialog.h"
 #include "Oracle/AppParams.h"
 #include "Oracle/Logger.h"
+#include "Oracle/ReachabilityProbe.h"
 
-#include <QTimer>
 #include <QProcess>
 #include <QMessageBox>
 #include <QFileInfo>
@@ -18,10 +18,15 @@ WorkplaceWidget::WorkplaceWidget(QWidget *parent) :
 
     // Фіксуємо висоту, щоб картки не розтягувалися по вертикалі
     this->setFixedHeight(80);
+
+    connect(&ReachabilityProbe::instance(), &ReachabilityProbe::probeFinished,
+            this, &WorkplaceWidget::onProbeFinished);
 }
 
 WorkplaceWidget::~WorkplaceWidget()
 {
+    // Картку закрили до завершення перевірки — звільняємо слот у рушії
+    ReachabilityProbe::instance().cancel(m_probeBatchId);
     delete ui;
 }
 
@@ -72,71 +77,46 @@ void WorkplaceWidget::checkVncStatus()
     ui->labelStatus->setToolTip("Перевірка доступності VNC...");
     ui->frameCard->setStyleSheet("QFrame#frameCard { background-color: #ffffff; border: 1px solid #c0c0c0; border-radius: 5px; }");
 
-    QTcpSocket *socket = new QTcpSocket(this);
-
     int port = m_data.getPortVNC(); // Перевірте назву методу!
     if (port <= 0) port = 5900;
 
-    QTimer *timer = new QTimer(this);
-    timer->setSingleShot(true);
-
-    // --- ОБ'ЄДНАНИЙ ОБРОБНИК ПОМИЛКИ ТА ТАЙМАУТУ ---
-    auto handleFailure = [this, socket, timer]() {
-        if (ui->toolButtonRefresh->isEnabled()) return;
-
-        if (timer->isActive()) timer->stop();
-
-        ui->labelStatus->setPixmap(QPixmap(":/res/Images/offline_network_icon.png"));
-        ui->labelStatus->setToolTip("VNC сервер НЕ доступний!");
-        ui->frameCard->setStyleSheet("QFrame#frameCard { background-color: #ffebee; border: 2px solid #ef9a9a; border-radius: 5px; }");
-
-        ui->toolButtonRefresh->setEnabled(true);
+    int timeoutMs = AppParams::instance().getParam("Gandalf", "VncTimeoutMs", 1500).toInt();
+    if (timeoutMs <= 0) timeoutMs = 1500;
 
-        // ЗАЛИШАЄМО КНОПКУ ВИМКНЕНОЮ ТА ЗМІНЮЄМО ПІДКАЗКУ
-        ui->toolButtonVNC->setEnabled(false);
-        ui->toolButtonVNC->setToolTip("Підключення неможливе: VNC сервер недоступний");
+    // --- 2. ЗАПУСК через спільний рушій (загальний ліміт паралельних перевірок на весь Gandalf) ---
+    ProbeTarget target;
+    target.host = m_data.getIpAdr();
+    target.port = quint16(port);
 
-        socket->abort();
-        socket->deleteLater();
-        timer->deleteLater();
-    };
+    ReachabilityProbe::instance().cancel(m_probeBatchId);
+    m_probeBatchId = ReachabilityProbe::instance().probe({target}, timeoutMs);
+}
 
-    // --- 2. ОБРОБНИК УСПІХУ ---
-    connect(socket, &QTcpSocket::connected, this, [this, socket, timer]() {
-        if (ui->toolButtonRefresh->isEnabled()) return;
+void WorkplaceWidget::onProbeFinished(int batchId, const ProbeResult &result)
+{
+    if (batchId != m_probeBatchId) return;
+    m_probeBatchId = 0;
 
-        if (timer->isActive()) timer->stop();
+    ui->toolButtonRefresh->setEnabled(true);
 
+    if (result.reachable) {
         ui->labelStatus->setPixmap(QPixmap(":/res/Images/online_network_icon.png"));
-        ui->labelStatus->setToolTip(QString("VNC сервер ДОСТУПНИЙ (Порт: %1)").arg(socket->peerPort()));
+        ui->labelStatus->setToolTip(QString("VNC сервер ДОСТУПНИЙ (Порт: %1, %2 мс)")
+                                        .arg(result.target.port).arg(result.rttMs));
         ui->frameCard->setStyleSheet("QFrame#frameCard { background-color: #f8fff8; border: 2px solid #8fbc8f; border-radius: 5px; }");
 
-        ui->toolButtonRefresh->setEnabled(true);
-
         // ВМИКАЄМО КНОПКУ ТА СТАВИМО СТАНДАРТНУ ПІДКАЗКУ
         ui->toolButtonVNC->setEnabled(true);
         ui->toolButtonVNC->setToolTip("Підключитися через VNC");
+    } else {
+        ui->labelStatus->setPixmap(QPixmap(":/res/Images/offline_network_icon.png"));
+        ui->labelStatus->setToolTip("VNC сервер НЕ доступний!");
+        ui->frameCard->setStyleSheet("QFrame#frameCard { background-color: #ffebee; border: 2px solid #ef9a9a; border-radius: 5px; }");
 
-        socket->disconnectFromHost();
-        socket->deleteLater();
-        timer->deleteLater();
-    });
-
-    // --- 3. ПІДКЛЮЧАЄМО СИГНАЛИ ---
-#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
-    connect(socket, &QTcpSocket::errorOccurred, this, [handleFailure](QAbstractSocket::SocketError) { handleFailure(); });
-#else
-    connect(socket, QOverload<QAbstractSocket::SocketError>::of(&QAbstractSocket::error), this, [handleFailure](QAbstractSocket::SocketError) { handleFailure(); });
-#endif
-
-    connect(timer, &QTimer::timeout, this, handleFailure);
-
-    // --- 4. ЗАПУСК ---
-    int timeoutMs = AppParams::instance().getParam("Gandalf", "VncTimeoutMs", 1500).toInt();
-    if (timeoutMs <= 0) timeoutMs = 1500;
-
-    timer->start(timeoutMs);
-    socket->connectToHost(m_data.getIpAdr(), port);
+        // ЗАЛИШАЄМО КНОПКУ ВИМКНЕНОЮ ТА ЗМІНЮЄМО ПІДКАЗКУ
+        ui->toolButtonVNC->setEnabled(false);
+        ui->toolButtonVNC->setToolTip("Підключення неможливе: VNC сервер недоступний");
+    }
 }
 
 void WorkplaceWidget::on_toolButtonVNC_clicked()
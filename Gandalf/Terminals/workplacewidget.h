@@ -2,9 +2,9 @@
 #define WORKPLACEWIDGET_H
 
 #include <QWidget>
-#include <QTcpSocket>
 
 #include "workplacedata.h" // Додаємо цей інклуд
+#include "Oracle/ReachabilityProbe.h"
 
 namespace Ui {
 class WorkplaceWidget;
@@ -34,11 +34,14 @@ private slots:
     void on_toolButtonRefresh_clicked();
     void on_toolButtonVNC_clicked();
 
+    void onProbeFinished(int batchId, const ProbeResult& result);
+
 private:
     void checkVncStatus();
 private:
     Ui::WorkplaceWidget *ui;
     WorkplaceData m_data; // Зберігаємо дані каси тут
+    int m_probeBatchId = 0; // Поточна перевірка VNC у ReachabilityProbe (0 — немає)
 };
 
 #endif // WORKPLACEWIDGET_H
@@ -4,7 +4,9 @@
 #include "Oracle/SessionManager.h"
 #include "Oracle/User.h"
 #include "Oracle/criptpass.h"
+#include "../ReferenceDataCache.h"
 #include <QMessageBox>
+#include <QTimer>
 
 UserEditDialog::UserEditDialog(int userId, QWidget *parent) :
     QDialog(parent),
@@ -40,9 +42,15 @@ UserEditDialog::UserEditDialog(int userId, QWidget *parent) :
     connect(&ApiClient::instance(), &ApiClient::userUpdateSuccess, this, &UserEditDialog::accept);
     connect(&ApiClient::instance(), &ApiClient::userUpdateFailed, this, &UserEditDialog::onUpdateFailed);
 
-    // Запускаємо обидва запити
+    // Запускаємо обидва запити (ролі — лише якщо їх немає в локальному кеші)
     ApiClient::instance().fetchUserById(m_userId);
-    ApiClient::instance().fetchAllRoles();
+    if (ReferenceDataCache::instance().hasRoles()) {
+        QTimer::singleShot(0, this, [this]() {
+            onAllRolesReceived(ReferenceDataCache::instance().roles());
+        });
+    } else {
+        ApiClient::instance().fetchAllRoles();
+    }
 }
 
 UserEditDialog::~UserEditDialog()
@@ -16,6 +16,7 @@
 #include "Terminals/StationSearchWidget.h"
 #include "Terminals/StationDataContext.h"
 #include "Terminals/generalinfowidget.h"
+#include "Terminals/StationSnapshotCache.h"
 
 
 
@@ -23,10 +24,12 @@
 #include <QTimer>
 #include <QDateTime>
 #include <QVBoxLayout>
+#include <QLabel>
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::MainWindow)
+    , m_debugPanel(nullptr)
 {
     ui->setupUi(this);
 
@@ -40,8 +43,7 @@ MainWindow::MainWindow(QWidget *parent)
     // 3. Ініціалізація компонентів UI
     setupStationSearch();
 
-    // 4. Запуск фонових задач
-    startStartupTimers();
+    // Фонові задачі запускає ApplicationController після логіну (startBackgroundTasks)
 
     setupUI();
     createConnections();
@@ -117,6 +119,32 @@ void MainWindow::setupUI()
     )";
 
     ui->tabWidgetMain->setStyleSheet(style);
+
+    setupDebugPanel();
+}
+
+void MainWindow::setupDebugPanel()
+{
+    if (!AppParams::instance().getParam("Gandalf", "ShowDebugPanel", false).toBool()) return;
+
+    m_debugPanel = new QLabel(this);
+    m_debugPanel->setStyleSheet("color: #5f6368;");
+    ui->statusbar->addPermanentWidget(m_debugPanel);
+
+    connect(&StationSnapshotCache::instance(), &StationSnapshotCache::statsChanged,
+            this, &MainWindow::updateDebugPanel);
+    updateDebugPanel();
+}
+
+void MainWindow::updateDebugPanel()
+{
+    if (!m_debugPanel) return;
+
+    const StationSnapshotCache::Stats stats = StationSnapshotCache::instance().stats();
+    m_debugPanel->setText(QString("Кеш АЗС: %1/%2 · влучань %3% (свіжих %4, застарілих %5, промахів %6)")
+                              .arg(stats.size).arg(stats.capacity)
+                              .arg(stats.hitRate(), 0, 'f', 0)
+                              .arg(stats.freshHits).arg(stats.staleHits).arg(stats.misses));
 }
 
 void MainWindow::createConnections()
@@ -155,13 +183,11 @@ void MainWindow::setupStationSearch()
     }
 }
 
-void MainWindow::startStartupTimers()
+void MainWindow::startBackgroundTasks()
 {
-    // Запускаємо перевірку синхронізації через 1 секунду
-    QTimer::singleShot(1000, this, &MainWindow::checkAutoSyncNeeded);
-
-    // Запускаємо оновлення глобальних налаштувань через 2 секунди
-    QTimer::singleShot(2000, this, &MainWindow::fetchGlobalSettings);
+    // Без затримок: сесія вже є, а запит іде паралельно з рештою стартових.
+    // Global налаштування тепер завантажує ReferenceDataCache.
+    checkAutoSyncNeeded();
 }
 
 void MainWindow::on_actionUsers_triggered()
@@ -171,41 +197,6 @@ void MainWindow::on_actionUsers_triggered()
 }
 
 
-void MainWindow::fetchGlobalSettings()
-{
-    logInfo() << "Fetching Global application settings from API...";
-
-    // 1. Підписуємося на сигнали відповіді
-    connect(&ApiClient::instance(), &ApiClient::settingsFetched,
-            this, &MainWindow::onGlobalSettingsFetched,
-            Qt::SingleShotConnection); // Використовуємо SingleShot, бо нам потрібно отримати дані один раз
-
-    connect(&ApiClient::instance(), &ApiClient::settingsFetchFailed,
-            this, &MainWindow::onGlobalSettingsFetchFailed,
-            Qt::SingleShotConnection);
-
-    // 2. Робимо API-запит для групи "Global"
-    ApiClient::instance().fetchSettings("Global");
-}
-
-void MainWindow::onGlobalSettingsFetched(const QVariantMap& settingsMap)
-{
-    logInfo() << "Successfully fetched Global settings.";
-
-    // !!! КЛЮЧОВИЙ МОМЕНТ: Кешування даних у AppParams
-    AppParams::instance().setScopedParams("Global", settingsMap);
-
-    // Оскільки налаштування оновлено, якщо діалог налаштувань відкрито,
-    // ви можете оновити його, викликавши його loadSettings() (потрібен доступ до екземпляра).
-    // Або, якщо він не відкритий, він просто завантажить правильні дані, коли його відкриють.
-}
-
-void MainWindow::onGlobalSettingsFetchFailed(const ApiError& error)
-{
-    logCritical() << "Failed to fetch Global settings. Error:" << error.errorString;
-    // Тут можна додати логіку для оповіщення користувача, якщо це критично
-}
-
 void MainWindow::on_actionClients_triggered()
 {
     ClientsListDialog dlg(this);
@@ -262,8 +253,9 @@ void MainWindow::checkAutoSyncNeeded()
             this, &MainWindow::onDashboardDataForAutoSync,
             Qt::SingleShotConnection);
 
-    // Робимо запит до API (той самий, що і для діалогу)
-    ApiClient::instance().fetchDashboardData();
+    // Робимо запит до API (той самий, що і для діалогу). Це фонова перевірка —
+    // вона не повинна випереджати запити відкритих вкладок.
+    ApiClient::instance().fetchDashboardData(RequestPriority::Background);
 }
 
 void MainWindow::onDashboardDataForAutoSync(const QJsonArray& data)
@@ -334,27 +326,61 @@ void MainWindow::onStationSelected(int objectId)
         return;
     }
 
-    // 2. Створення UI (Вкладки)
+    // 2. Шукаємо знімок у кеші нещодавно відкритих АЗС
+    StationSnapshot snapshot;
+    const StationSnapshotCache::Lookup cached = StationSnapshotCache::instance().lookup(objectId, &snapshot);
+
+    // 3. Створення UI (Вкладки)
     GeneralInfoWidget *infoWidget = new GeneralInfoWidget();
     infoWidget->setProperty("stationId", objectId);
 
-    // 3. Додавання вкладки на форму з тимчасовим статусом
+    // 4. Додавання вкладки на форму з тимчасовим статусом
     int newIndex = ui->tabWidgetMain->addTab(infoWidget, QString("Завантаження %1...").arg(objectId));
     ui->tabWidgetMain->setTabIcon(newIndex, drawStatusIcon(false, false));
     ui->tabWidgetMain->setCurrentIndex(newIndex);
 
-    // 4. Створення контексту та підключення (infoWidget стає Parent-ом!)
+    // 5. Створення контексту та підключення (infoWidget стає Parent-ом!)
     StationDataContext *context = new StationDataContext(objectId, infoWidget);
     connect(context, &StationDataContext::generalInfoReady, this, &MainWindow::onStationGeneralInfoReady);
 
-    // 5. Запуск завантаження
-    context->fetchGeneralInfo();
+    // 6. Stale-while-revalidate: знімок малюємо одразу, сервер питаємо лише якщо він застарів
+    if (cached != StationSnapshotCache::Lookup::Miss) {
+        renderStationSnapshot(infoWidget, context, snapshot);
+    }
+    if (cached == StationSnapshotCache::Lookup::Fresh) {
+        logInfo() << "MainWindow: Station" << objectId << "rendered from fresh cache snapshot.";
+        return;
+    }
+
+    // 7. Запуск завантаження. Вкладка вже з даними — оновлюємо без поспіху.
+    context->fetchGeneralInfo(cached == StationSnapshotCache::Lookup::Stale ? RequestPriority::Normal
+                                                                            : RequestPriority::Interactive);
+}
+
+void MainWindow::renderStationSnapshot(GeneralInfoWidget *infoWidget, StationDataContext *context, const StationSnapshot &snapshot)
+{
+    context->restore(snapshot.info);
+
+    infoWidget->setProperty("terminalId", snapshot.info.terminalId);
+    infoWidget->setProperty("clientId", snapshot.info.clientId);
+    infoWidget->updateData(snapshot.info);
+    updateStationTabAppearance(infoWidget, snapshot.info);
+
+    if (snapshot.hasRro) infoWidget->updateRROData(snapshot.rro);
+    if (snapshot.hasTanks) infoWidget->updateTanksData(snapshot.tanks);
+    if (snapshot.hasDispensers) infoWidget->updateDispensersData(snapshot.dispensers);
+    if (snapshot.hasWorkplaces) infoWidget->updateWorkplacesData(snapshot.workplaces);
 }
 
 void MainWindow::onTabCloseRequested(int index)
 {
     QWidget *targetWidget = ui->tabWidgetMain->widget(index);
     if (targetWidget) {
+        // Одразу перериваємо запити вкладки: їхні відповіді вже нікому не потрібні
+        if (StationDataContext *context = targetWidget->findChild<StationDataContext*>()) {
+            context->requests()->cancelAll();
+        }
+
         // deleteLater безпечно видалить віджет і всі його діти (в т.ч. StationDataContext)
         targetWidget->deleteLater();
         ui->tabWidgetMain->removeTab(index);
@@ -377,6 +403,11 @@ int MainWindow::findTabIndexByStationId(int objectId)
     return -1; // Не знайдено
 }
 
+int MainWindow::stationIdOf(QWidget *tabWidget)
+{
+    return tabWidget ? tabWidget->property("stationId").toInt() : 0;
+}
+
 QIcon MainWindow::drawStatusIcon(bool isActive, bool isWork)
 {
     QColor color;
@@ -417,6 +448,7 @@ void MainWindow::onStationPosDataReceived(const QJsonArray& data, int clientId,
         {
             logInfo() << "MainWindow: Routing RRO data to tab with terminal:" << terminalId;
             infoWidget->updateRROData(data);
+            StationSnapshotCache::instance().putPart(stationIdOf(infoWidget), StationSnapshotCache::Part::Rro, data);
             break;
         }
     }
@@ -439,6 +471,7 @@ void MainWindow::onStationTanksDataReceived(const QJsonArray& data, int clientId
         {
             logInfo() << "MainWindow: Routing Tanks data to tab with terminal:" << terminalId;
             infoWidget->updateTanksData(data);
+            StationSnapshotCache::instance().putPart(stationIdOf(infoWidget), StationSnapshotCache::Part::Tanks, data);
             break;
         }
     }
@@ -466,25 +499,29 @@ void MainWindow::onStationGeneralInfoReady()
     // 5. Оновлюємо вигляд вкладки (іконка, заголовок)
     updateStationTabAppearance(infoWidget, info);
 
-    // 6. Запускаємо завантаження всіх додаткових даних (РРО, резервуари тощо)
-    fetchAdditionalStationData(info);
+    // 6. Запам'ятовуємо знімок для наступного відкриття цієї АЗС
+    StationSnapshotCache::instance().putGeneralInfo(context->getObjectId(), info);
+
+    // 7. Запускаємо завантаження всіх додаткових даних (РРО, резервуари тощо)
+    fetchAdditionalStationData(info, context->requests(), context->priority());
 
     //infoWidget->createTestWorkplaces();
 }
 
 // --- МЕТОД: Централізоване місце для додаткових запитів ---
-void MainWindow::fetchAdditionalStationData(const StationDataContext::GeneralInfo& info)
+void MainWindow::fetchAdditionalStationData(const StationDataContext::GeneralInfo& info, ApiRequestGroup* requests,
+                                            RequestPriority priority)
 {
     logInfo() << "MainWindow: Fetching additional data for terminal:" << info.terminalId;
 
-    // Сюди буде неймовірно просто додавати нові фічі
-    ApiClient::instance().fetchStationPosData(info.clientId, info.terminalId);
-    ApiClient::instance().fetchStationTanks(info.clientId, info.terminalId);
-
-    // Наприклад, наступний крок:
-    ApiClient::instance().fetchStationDispensers(info.clientId, info.terminalId);
-
-    ApiClient::instance().fetchStationWorkplaces(info.clientId, info.terminalId);
+    // Зазвичай користувач чекає на ці дані прямо зараз — Interactive;
+    // для вкладки, відмальованої з кешу, це фонове оновлення — Normal.
+    // Дескриптори йдуть у групу вкладки, щоб закриття вкладки перервало запити.
+    ApiClient& api = ApiClient::instance();
+    requests->add(api.fetchStationPosData(info.clientId, info.terminalId, 0, priority));
+    requests->add(api.fetchStationTanks(info.clientId, info.terminalId, 0, priority));
+    requests->add(api.fetchStationDispensers(info.clientId, info.terminalId, 0, priority));
+    requests->add(api.fetchStationWorkplaces(info.clientId, info.terminalId, 0, priority));
 }
 
 // --- МЕТОД: Ізольована логіка малювання вкладки ---
@@ -523,6 +560,7 @@ void MainWindow::onStationDispensersDataReceived(const QJsonArray& data, int cli
 
             // ПЕРЕДАЄМО ДАНІ У ВІДЖЕТ!
             infoWidget->updateDispensersData(data);
+            StationSnapshotCache::instance().putPart(stationIdOf(infoWidget), StationSnapshotCache::Part::Dispensers, data);
             break;
         }
     }
@@ -539,6 +577,7 @@ void MainWindow::onStationWorkplacesDataReceived(const QJsonArray& data, int cli
             infoWidget->property("clientId").toInt() == clientId)
         {
             infoWidget->updateWorkplacesData(data); // Цей метод ми зараз створимо
+            StationSnapshotCache::instance().putPart(stationIdOf(infoWidget), StationSnapshotCache::Part::Workplaces, data);
             break;
         }
     }
@@ -9,6 +9,9 @@
 #include <QPainter>
 
 class StationSearchWidget;
+class GeneralInfoWidget;
+class QLabel;
+struct StationSnapshot;
 
 QT_BEGIN_NAMESPACE
 namespace Ui {
@@ -23,6 +26,11 @@ class MainWindow : public QMainWindow
 public:
     MainWindow(QWidget *parent = nullptr);
     ~MainWindow();
+    /**
+     * @brief Запускає фонові задачі головного вікна (викликається одразу після логіну)
+     */
+    void startBackgroundTasks();
+
 public slots:
     // Слот, який викликає віджет пошуку
     void onStationSelected(int objectId);
@@ -40,11 +48,6 @@ private slots:
     void on_actionOpenSyncMonitor_triggered();
     void onDashboardDataForAutoSync(const QJsonArray& data);
 
-    // Нові слоти для завантаження Global налаштувань
-    void fetchGlobalSettings();
-    void onGlobalSettingsFetched(const QVariantMap& settingsMap);
-    void onGlobalSettingsFetchFailed(const ApiError& error);
-
     // Слот для закриття вкладки (натискання на хрестик)
     void onTabCloseRequested(int index);
 
@@ -71,10 +74,6 @@ private:
      */
     void setupStationSearch();
 
-    /**
-     * @brief Запускає таймери та фонові задачі після старту
-     */
-    void startStartupTimers();
     QIcon drawStatusIcon(bool isActive, bool isWork);
 
     // --- Методи ініціалізації ---
@@ -85,7 +84,16 @@ private:
     // Перевіряє, чи вже відкрита вкладка з таким ID (повертає індекс або -1)
     int findTabIndexByStationId(int objectId);
     // Відправляє всі додаткові запити (РРО, Резервуари, Колонки)
-    void fetchAdditionalStationData(const StationDataContext::GeneralInfo& info);
+    void fetchAdditionalStationData(const StationDataContext::GeneralInfo& info, ApiRequestGroup* requests,
+                                    RequestPriority priority);
+    // Миттєво малює вкладку зі знімка StationSnapshotCache
+    void renderStationSnapshot(GeneralInfoWidget* infoWidget, StationDataContext* context, const StationSnapshot& snapshot);
+    // objectId вкладки, якій адресовано дані (для кешу), або 0
+    static int stationIdOf(QWidget* tabWidget);
+
+    // Панель налагодження в статус-барі (Gandalf/ShowDebugPanel)
+    void setupDebugPanel();
+    void updateDebugPanel();
 
     // Оновлює візуальну частину самої вкладки (Назва, Іконка)
     void updateStationTabAppearance(QWidget* tabWidget, const StationDataContext::GeneralInfo& info);
@@ -96,5 +104,6 @@ private:
     Ui::MainWindow *ui;
     int m_syncPeriodDays;
     StationSearchWidget *m_searchWidget;
+    QLabel *m_debugPanel;
 };
 #endif // MAINWINDOW_H
@@ -0,0 +1,152 @@
+#include "../Terminals/StationSnapshotCache.h"
+#include "../Clients/SyncEventStream.h"
+#include "Oracle/AppParams.h"
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QSignalSpy>
+#include <QTest>
+
+/**
+ * Кеш — singleton, тож розмір (3) і TTL (1 с) задаються до першого instance(),
+ * а кожен тест працює зі своїми objectId.
+ */
+class TestStationSnapshotCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void missForUnknownStation();
+    void partsWithoutGeneralInfoAreIgnored();
+    void incompleteSnapshotIsStale();
+    void expiresAfterTtl();
+    void syncSuccessMarksClientStale();
+    void evictsLeastRecentlyUsed();
+
+private:
+    static StationDataContext::GeneralInfo info(int clientId, int terminalId);
+    static void putComplete(int objectId, int clientId);
+};
+
+void TestStationSnapshotCache::initTestCase()
+{
+    AppParams::instance().setParam("Gandalf", "StationCacheSize", 3);
+    AppParams::instance().setParam("Gandalf", "StationCacheTtlSec", 1);
+    QCOMPARE(StationSnapshotCache::instance().stats().capacity, 3);
+}
+
+StationDataContext::GeneralInfo TestStationSnapshotCache::info(int clientId, int terminalId)
+{
+    StationDataContext::GeneralInfo info;
+    info.clientId = clientId;
+    info.terminalId = terminalId;
+    info.address = QString("Station %1").arg(terminalId);
+    return info;
+}
+
+void TestStationSnapshotCache::putComplete(int objectId, int clientId)
+{
+    StationSnapshotCache& cache = StationSnapshotCache::instance();
+    cache.putGeneralInfo(objectId, info(clientId, objectId));
+    const QJsonArray data{QJsonObject{{"id", 1}}};
+    cache.putPart(objectId, StationSnapshotCache::Part::Rro, data);
+    cache.putPart(objectId, StationSnapshotCache::Part::Tanks, data);
+    cache.putPart(objectId, StationSnapshotCache::Part::Dispensers, data);
+    cache.putPart(objectId, StationSnapshotCache::Part::Workplaces, data);
+}
+
+void TestStationSnapshotCache::missForUnknownStation()
+{
+    StationSnapshotCache& cache = StationSnapshotCache::instance();
+    const quint64 misses = cache.stats().misses;
+
+    QCOMPARE(cache.lookup(100, nullptr), StationSnapshotCache::Lookup::Miss);
+    QCOMPARE(cache.stats().misses, misses + 1);
+}
+
+void TestStationSnapshotCache::partsWithoutGeneralInfoAreIgnored()
+{
+    StationSnapshotCache& cache = StationSnapshotCache::instance();
+    cache.putPart(101, StationSnapshotCache::Part::Tanks, QJsonArray{1});
+    QCOMPARE(cache.lookup(101, nullptr), StationSnapshotCache::Lookup::Miss);
+}
+
+void TestStationSnapshotCache::incompleteSnapshotIsStale()
+{
+    StationSnapshotCache& cache = StationSnapshotCache::instance();
+    cache.putGeneralInfo(102, info(5, 102));
+
+    // Вкладку закрили до того, як прийшли масиви: знімок свіжий за часом, але неповний
+    StationSnapshot snapshot;
+    QCOMPARE(cache.lookup(102, &snapshot), StationSnapshotCache::Lookup::Stale);
+    QCOMPARE(snapshot.info.terminalId, 102);
+    QVERIFY(!snapshot.isComplete());
+
+    cache.putPart(102, StationSnapshotCache::Part::Rro, QJsonArray{1});
+    cache.putPart(102, StationSnapshotCache::Part::Tanks, QJsonArray{2});
+    cache.putPart(102, StationSnapshotCache::Part::Dispensers, QJsonArray{3});
+    QCOMPARE(cache.lookup(102, nullptr), StationSnapshotCache::Lookup::Stale);
+
+    cache.putPart(102, StationSnapshotCache::Part::Workplaces, QJsonArray{4});
+    QCOMPARE(cache.lookup(102, &snapshot), StationSnapshotCache::Lookup::Fresh);
+    QVERIFY(snapshot.isComplete());
+    QCOMPARE(snapshot.tanks, QJsonArray{2});
+}
+
+void TestStationSnapshotCache::expiresAfterTtl()
+{
+    StationSnapshotCache& cache = StationSnapshotCache::instance();
+    putComplete(103, 5);
+    QCOMPARE(cache.lookup(103, nullptr), StationSnapshotCache::Lookup::Fresh);
+
+    QTest::qWait(1100);
+    QCOMPARE(cache.lookup(103, nullptr), StationSnapshotCache::Lookup::Stale);
+
+    // Фонове оновлення шапки робить знімок знову свіжим; масиви лишаються
+    cache.putGeneralInfo(103, info(5, 103));
+    StationSnapshot snapshot;
+    QCOMPARE(cache.lookup(103, &snapshot), StationSnapshotCache::Lookup::Fresh);
+    QVERIFY(snapshot.isComplete());
+}
+
+void TestStationSnapshotCache::syncSuccessMarksClientStale()
+{
+    StationSnapshotCache& cache = StationSnapshotCache::instance();
+    putComplete(104, 7);
+    putComplete(105, 8);
+
+    SyncEventStream& events = SyncEventStream::instance();
+    emit events.syncEventReceived(7, "RUNNING", QString(), QJsonObject());
+    QCOMPARE(cache.lookup(104, nullptr), StationSnapshotCache::Lookup::Fresh);
+
+    emit events.syncEventReceived(7, "SUCCESS", QString(), QJsonObject());
+    QCOMPARE(cache.lookup(104, nullptr), StationSnapshotCache::Lookup::Stale);
+    QCOMPARE(cache.lookup(105, nullptr), StationSnapshotCache::Lookup::Fresh);
+}
+
+void TestStationSnapshotCache::evictsLeastRecentlyUsed()
+{
+    StationSnapshotCache& cache = StationSnapshotCache::instance();
+    QSignalSpy statsChanged(&cache, &StationSnapshotCache::statsChanged);
+    putComplete(106, 9);
+    putComplete(107, 9);
+    putComplete(108, 9);
+    const quint64 evictions = cache.stats().evictions;
+
+    // 106 щойно відкривали — витісняється 107
+    QCOMPARE(cache.lookup(106, nullptr), StationSnapshotCache::Lookup::Fresh);
+    putComplete(109, 9);
+
+    QCOMPARE(cache.stats().size, 3);
+    QCOMPARE(cache.stats().evictions, evictions + 1);
+    QCOMPARE(cache.lookup(107, nullptr), StationSnapshotCache::Lookup::Miss);
+    QCOMPARE(cache.lookup(106, nullptr), StationSnapshotCache::Lookup::Fresh);
+    QCOMPARE(cache.lookup(108, nullptr), StationSnapshotCache::Lookup::Fresh);
+    QCOMPARE(cache.lookup(109, nullptr), StationSnapshotCache::Lookup::Fresh);
+    QVERIFY(statsChanged.count() > 0);
+}
+
+QTEST_GUILESS_MAIN(TestStationSnapshotCache)
+#include "tst_stationsnapshotcache.moc"
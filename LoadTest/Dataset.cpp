@@ -0,0 +1,261 @@
+#include "Dataset.h"
+#include "Oracle/Logger.h"
+
+#include <QDate>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QRandomGenerator>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+
+#include <iterator>
+
+namespace {
+
+const char* const kRegions[] = {
+    "Київська", "Львівська", "Одеська", "Харківська", "Дніпропетровська",
+    "Вінницька", "Полтавська", "Черкаська", "Житомирська", "Волинська"
+};
+
+const char* const kStreets[] = {
+    "вул. Шевченка", "просп. Незалежності", "вул. Франка", "Окружна дорога", "вул. Соборна", "траса М-06"
+};
+
+struct FuelInfo {
+    int id;
+    const char* shortName;
+    const char* name;
+};
+
+const FuelInfo kFuels[] = {
+    {1, "А-92", "Бензин А-92"},
+    {2, "А-95", "Бензин А-95"},
+    {3, "ДП",   "Дизельне паливо"},
+    {4, "ГАЗ",  "Скраплений газ"}
+};
+
+bool exec(QSqlQuery& query, QString* error)
+{
+    if (query.exec()) return true;
+    *error = query.lastError().text();
+    return false;
+}
+
+}
+
+Dataset Dataset::generate(quint32 seed, int clientCount, int stationsPerClient)
+{
+    QRandomGenerator random(seed);
+    Dataset dataset;
+    dataset.seed = seed;
+
+    for (int c = 0; c < clientCount; ++c) {
+        Client client;
+        client.clientId = c + 1;
+        client.name = QString("LoadTest %1-%2").arg(seed).arg(c + 1);
+
+        // Розмір мережі коливається навколо заданого: у житті клієнти не однакові
+        const int stations = qMax(1, stationsPerClient / 2 + random.bounded(stationsPerClient + 1));
+        for (int s = 0; s < stations; ++s) {
+            Station station;
+            station.terminalId = 100 + s;
+            station.name = QString("АЗС №%1").arg(station.terminalId);
+            station.region = QString::fromUtf8(kRegions[random.bounded(int(std::size(kRegions)))]);
+            station.address = QString("%1, %2").arg(QString::fromUtf8(kStreets[random.bounded(int(std::size(kStreets)))]))
+                                  .arg(1 + random.bounded(200));
+            station.posCount = 1 + random.bounded(4);
+            station.tankCount = 2 + random.bounded(5);
+            client.stations.append(station);
+        }
+        dataset.clients.append(client);
+    }
+    return dataset;
+}
+
+bool Dataset::load(const QString &path, Dataset *dataset, QString *error)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        *error = file.errorString();
+        return false;
+    }
+    QJsonParseError parseError;
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+    if (!doc.isObject()) {
+        *error = parseError.errorString();
+        return false;
+    }
+    *dataset = fromJson(doc.object());
+    if (dataset->stationCount() == 0) {
+        *error = "Dataset has no stations";
+        return false;
+    }
+    return true;
+}
+
+bool Dataset::save(const QString &path, QString *error) const
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        *error = file.errorString();
+        return false;
+    }
+    file.write(QJsonDocument(toJson()).toJson(QJsonDocument::Indented));
+    return true;
+}
+
+bool Dataset::writeToDatabase(QString *error)
+{
+    error->clear();
+    QSqlDatabase db = QSqlDatabase::database();
+    if (!db.isOpen()) {
+        *error = "Database connection is not open";
+        return false;
+    }
+    if (!db.transaction()) {
+        *error = db.lastError().text();
+        return false;
+    }
+
+    QSqlQuery findClient(db);
+    findClient.prepare("SELECT CLIENT_ID FROM CLIENTS WHERE CLIENT_NAME = :name");
+    QSqlQuery insertClient(db);
+    // Як у DbManager::createClient: IP_GEN_METHOD_ID = 1, інакше FOREIGN KEY
+    insertClient.prepare("INSERT INTO CLIENTS (CLIENT_NAME, SYNC_METHOD, IP_GEN_METHOD_ID) "
+                         "VALUES (:name, 'DIRECT', 1) RETURNING CLIENT_ID");
+    QSqlQuery upsertObject(db);
+    upsertObject.prepare("UPDATE OR INSERT INTO OBJECTS (CLIENT_ID, TERMINAL_ID, NAME, ADDRESS, IS_ACTIVE, IS_WORK, PHONE, REGION_NAME) "
+                         "VALUES (:clientId, :termId, :name, :address, 1, 1, :phone, :region) "
+                         "MATCHING (CLIENT_ID, TERMINAL_ID)");
+    QSqlQuery upsertPos(db);
+    upsertPos.prepare("UPDATE OR INSERT INTO POS_DATA (CLIENT_ID, TERMINAL_ID, POS_ID, MANUFACTURER, MODEL, "
+                      "POSVERSION, MUKVERSION, FACTORYNUMBER, TAXNUMBER, DATREG) "
+                      "VALUES (:clientId, :termId, :posId, 'LoadTest', 'LT-1', '1.0', '1.0', :factory, :tax, :datreg) "
+                      "MATCHING (CLIENT_ID, TERMINAL_ID, POS_ID)");
+    QSqlQuery upsertTank(db);
+    upsertTank.prepare("UPDATE OR INSERT INTO TANKS_DATA (CLIENT_ID, TERMINAL_ID, TANK_ID, FUEL_ID, SHORTNAME, NAME, "
+                       "MAXVALUE, MINVALUE, DEADMAX, DEADMIN, TUBEAMOUNT, IS_SYNC_ACTIVE) "
+                       "VALUES (:clientId, :termId, :tankId, :fuelId, :shortName, :name, 20000, 500, 19500, 300, 150, 1) "
+                       "MATCHING (CLIENT_ID, TERMINAL_ID, TANK_ID)");
+
+    for (Client& client : clients) {
+        findClient.bindValue(":name", client.name);
+        if (!exec(findClient, error)) break;
+        if (findClient.next()) {
+            client.clientId = findClient.value(0).toInt();
+        } else {
+            insertClient.bindValue(":name", client.name);
+            if (!exec(insertClient, error)) break;
+            if (!insertClient.next()) {
+                *error = "INSERT INTO CLIENTS returned no CLIENT_ID";
+                break;
+            }
+            client.clientId = insertClient.value(0).toInt();
+        }
+        findClient.finish();
+        insertClient.finish();
+
+        for (const Station& station : client.stations) {
+            upsertObject.bindValue(":clientId", client.clientId);
+            upsertObject.bindValue(":termId", station.terminalId);
+            upsertObject.bindValue(":name", station.name);
+            upsertObject.bindValue(":address", station.address);
+            upsertObject.bindValue(":phone", QString("+380440000%1").arg(station.terminalId));
+            upsertObject.bindValue(":region", station.region);
+            if (!exec(upsertObject, error)) break;
+
+            for (int pos = 1; pos <= station.posCount; ++pos) {
+                upsertPos.bindValue(":clientId", client.clientId);
+                upsertPos.bindValue(":termId", station.terminalId);
+                upsertPos.bindValue(":posId", pos);
+                upsertPos.bindValue(":factory", QString("LT%1%2%3").arg(client.clientId).arg(station.terminalId).arg(pos));
+                upsertPos.bindValue(":tax", QString("30%1%2").arg(station.terminalId).arg(pos));
+                upsertPos.bindValue(":datreg", QDate(2020, 1, 1));
+                if (!exec(upsertPos, error)) break;
+            }
+            if (!error->isEmpty()) break;
+            for (int tank = 1; tank <= station.tankCount; ++tank) {
+                const FuelInfo& fuel = kFuels[(tank - 1) % int(std::size(kFuels))];
+                upsertTank.bindValue(":clientId", client.clientId);
+                upsertTank.bindValue(":termId", station.terminalId);
+                upsertTank.bindValue(":tankId", tank);
+                upsertTank.bindValue(":fuelId", fuel.id);
+                upsertTank.bindValue(":shortName", QString::fromUtf8(fuel.shortName));
+                upsertTank.bindValue(":name", QString::fromUtf8(fuel.name));
+                if (!exec(upsertTank, error)) break;
+            }
+            if (!error->isEmpty()) break;
+        }
+        if (!error->isEmpty()) break;
+    }
+
+    if (!error->isEmpty()) {
+        logCritical() << "Dataset: Failed to write synthetic data:" << *error;
+        db.rollback();
+        return false;
+    }
+    if (!db.commit()) {
+        *error = db.lastError().text();
+        return false;
+    }
+    logInfo() << "Dataset: Written" << clients.size() << "clients and" << stationCount() << "stations.";
+    return true;
+}
+
+QJsonObject Dataset::toJson() const
+{
+    QJsonArray clientsJson;
+    for (const Client& client : clients) {
+        QJsonArray stationsJson;
+        for (const Station& station : client.stations) {
+            stationsJson.append(QJsonObject{
+                {"terminal_id", station.terminalId},
+                {"name", station.name},
+                {"address", station.address},
+                {"region", station.region},
+                {"pos_count", station.posCount},
+                {"tank_count", station.tankCount}
+            });
+        }
+        clientsJson.append(QJsonObject{
+            {"client_id", client.clientId},
+            {"name", client.name},
+            {"stations", stationsJson}
+        });
+    }
+    return QJsonObject{{"seed", qint64(seed)}, {"clients", clientsJson}};
+}
+
+Dataset Dataset::fromJson(const QJsonObject &json)
+{
+    Dataset dataset;
+    dataset.seed = quint32(json["seed"].toInteger());
+    for (const QJsonValue& clientValue : json["clients"].toArray()) {
+        const QJsonObject clientJson = clientValue.toObject();
+        Client client;
+        client.clientId = clientJson["client_id"].toInt();
+        client.name = clientJson["name"].toString();
+        for (const QJsonValue& stationValue : clientJson["stations"].toArray()) {
+            const QJsonObject stationJson = stationValue.toObject();
+            Station station;
+            station.terminalId = stationJson["terminal_id"].toInt();
+            station.name = stationJson["name"].toString();
+            station.address = stationJson["address"].toString();
+            station.region = stationJson["region"].toString();
+            station.posCount = stationJson["pos_count"].toInt();
+            station.tankCount = stationJson["tank_count"].toInt();
+            client.stations.append(station);
+        }
+        dataset.clients.append(client);
+    }
+    return dataset;
+}
+
+int Dataset::stationCount() const
+{
+    int count = 0;
+    for (const Client& client : clients) count += client.stations.size();
+    return count;
+}
@@ -0,0 +1,54 @@
+#ifndef DATASET_H
+#define DATASET_H
+
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+
+/**
+ * @brief Синтетичний набір даних для навантажувального тестування: клієнти, їхні АЗС,
+ * каси (POS_DATA) і резервуари (TANKS_DATA).
+ *
+ * Набір повністю визначається зерном (seed) і розмірами: той самий seed дає ті самі назви,
+ * регіони й кількості, тож прогони на різних машинах і версіях Conduit порівнянні.
+ * Набір зберігається у JSON — з нього LoadRunner бере цілі запитів, а StubServer — відповіді.
+ */
+class Dataset
+{
+public:
+    struct Station {
+        int terminalId = 0;
+        QString name;
+        QString address;
+        QString region;
+        int posCount = 0;
+        int tankCount = 0;
+    };
+
+    struct Client {
+        int clientId = 0;   // Після writeToDatabase — справжній CLIENT_ID з БД
+        QString name;
+        QList<Station> stations;
+    };
+
+    static Dataset generate(quint32 seed, int clientCount, int stationsPerClient);
+
+    static bool load(const QString& path, Dataset* dataset, QString* error);
+    bool save(const QString& path, QString* error) const;
+
+    /**
+     * @brief Записує набір у БД з'єднання DbManager (UPDATE OR INSERT — повторний запуск не дублює).
+     * Клієнти шукаються за назвою; clientId оновлюються справжніми ідентифікаторами.
+     */
+    bool writeToDatabase(QString* error);
+
+    QJsonObject toJson() const;
+    static Dataset fromJson(const QJsonObject& json);
+
+    int stationCount() const;
+
+    quint32 seed = 0;
+    QList<Client> clients;
+};
+
+#endif // DATASET_H
@@ -0,0 +1,437 @@
+#include "LoadRunner.h"
+#include "Oracle/Logger.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QTextStream>
+#include <QtMath>
+
+#include <algorithm>
+
+namespace {
+
+LoadRunner::Auth authFromString(const QString& value)
+{
+    if (value == "bot") return LoadRunner::Auth::Bot;
+    if (value == "none") return LoadRunner::Auth::None;
+    return LoadRunner::Auth::Session;
+}
+
+// 429 — ліміт особи; 503 — лише скидання навантаження RateLimiter (з Retry-After і його повідомленням),
+// а не будь-яка 503 (напр. недоступна БД), яка є справжньою помилкою
+bool isThrottled(QNetworkReply* reply, int status, const QByteArray& body)
+{
+    if (status == 429) return true;
+    if (status != 503 || !reply->hasRawHeader("Retry-After")) return false;
+    return QJsonDocument::fromJson(body).object().value("error").toString() == "Server is overloaded, try again later";
+}
+
+}
+
+// ===================================================================
+// Суміш сценаріїв
+// ===================================================================
+
+QList<LoadRunner::Scenario> LoadRunner::defaultMix()
+{
+    return {
+        {"login", 5, {
+            {"login", "POST", "/api/login", R"({"login": "{login}"})", Auth::None}
+        }},
+        {"objects", 25, {
+            {"objects.by_client", "GET", "/api/objects?clientId={client}", {}, Auth::Session},
+            {"objects.by_region", "GET", "/api/objects?region={region}&limit=100", {}, Auth::Session}
+        }},
+        // Картка АЗС у Gandalf: каси, резервуари, ТРК і робочі місця одна за одною
+        {"station_details", 25, {
+            {"station.pos", "GET", "/api/clients/{client}/station/{terminal}/pos", {}, Auth::Session},
+            {"station.tanks", "GET", "/api/clients/{client}/station/{terminal}/tanks", {}, Auth::Session},
+            {"station.dispensers", "GET", "/api/clients/{client}/station/{terminal}/dispensers", {}, Auth::Session},
+            {"station.workplaces", "GET", "/api/clients/{client}/station/{terminal}/workplaces", {}, Auth::Session}
+        }},
+        {"dashboard", 15, {
+            {"dashboard", "GET", "/api/dashboard", {}, Auth::Session}
+        }},
+        // Isengard: статус користувача, список АЗС клієнта, деталі АЗС
+        {"bot_station", 30, {
+            {"bot.me", "POST", "/api/bot/me", R"({"telegram_id": "{telegram}"})", Auth::Bot},
+            {"bot.stations", "GET", "/api/bot/clients/{client}/stations", {}, Auth::Bot},
+            {"bot.station", "GET", "/api/bot/clients/{client}/station/{terminal}", {}, Auth::Bot}
+        }}
+    };
+}
+
+bool LoadRunner::loadMix(const QString &path, QList<Scenario> *mix, QString *error)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        *error = file.errorString();
+        return false;
+    }
+    QJsonParseError parseError;
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+    if (!doc.isObject()) {
+        *error = parseError.errorString();
+        return false;
+    }
+
+    mix->clear();
+    for (const QJsonValue& scenarioValue : doc.object()["scenarios"].toArray()) {
+        const QJsonObject scenarioJson = scenarioValue.toObject();
+        Scenario scenario;
+        scenario.name = scenarioJson["name"].toString();
+        scenario.weight = scenarioJson["weight"].toInt(1);
+        for (const QJsonValue& stepValue : scenarioJson["steps"].toArray()) {
+            const QJsonObject stepJson = stepValue.toObject();
+            Step step;
+            step.name = stepJson["name"].toString(scenario.name);
+            step.method = stepJson["method"].toString("GET").toUpper().toLatin1();
+            step.path = stepJson["path"].toString();
+            if (stepJson["body"].isObject()) {
+                step.body = QJsonDocument(stepJson["body"].toObject()).toJson(QJsonDocument::Compact);
+            } else {
+                step.body = stepJson["body"].toString().toUtf8();
+            }
+            step.auth = authFromString(stepJson["auth"].toString("session"));
+            if (step.path.isEmpty()) {
+                *error = QString("Step '%1' of scenario '%2' has no path").arg(step.name, scenario.name);
+                return false;
+            }
+            scenario.steps.append(step);
+        }
+        if (scenario.name.isEmpty() || scenario.weight <= 0 || scenario.steps.isEmpty()) {
+            *error = QString("Scenario '%1' needs a name, a positive weight and at least one step").arg(scenario.name);
+            return false;
+        }
+        mix->append(scenario);
+    }
+    if (mix->isEmpty()) {
+        *error = "Mix has no scenarios";
+        return false;
+    }
+    return true;
+}
+
+// ===================================================================
+// Прогін
+// ===================================================================
+
+LoadRunner::LoadRunner(const Options &options, const QList<Scenario> &mix, const Dataset &dataset, QObject *parent)
+    : QObject(parent)
+    , m_options(options)
+    , m_dataset(dataset)
+{
+    for (const Scenario& scenario : mix) {
+        const bool usesBot = std::any_of(scenario.steps.begin(), scenario.steps.end(),
+                                         [](const Step& step) { return step.auth == Auth::Bot; });
+        if (usesBot && m_options.botKey.isEmpty()) {
+            logWarning() << "LoadRunner: Scenario" << scenario.name << "needs --bot-key; skipped.";
+            continue;
+        }
+        m_mix.append(scenario);
+        m_totalWeight += scenario.weight;
+    }
+
+    for (const Dataset::Client& client : m_dataset.clients) {
+        for (const Dataset::Station& station : client.stations) {
+            m_targets.append({&client, &station});
+        }
+    }
+
+    for (int i = 0; i < m_options.virtualUsers; ++i) {
+        VirtualUser* user = new VirtualUser;
+        user->index = i;
+        user->network = new QNetworkAccessManager(this);
+        user->random = QRandomGenerator(m_options.seed + quint32(i));
+        // Залишок від ділення дістається першим користувачам — разом рівно totalRequests
+        user->requestBudget = m_options.totalRequests / m_options.virtualUsers
+                            + (i < m_options.totalRequests % m_options.virtualUsers ? 1 : 0);
+        m_users.append(user);
+    }
+}
+
+LoadRunner::~LoadRunner()
+{
+    qDeleteAll(m_users);
+}
+
+bool LoadRunner::needsSession() const
+{
+    for (const Scenario& scenario : m_mix) {
+        for (const Step& step : scenario.steps) {
+            if (step.auth == Auth::Session) return true;
+        }
+    }
+    return false;
+}
+
+void LoadRunner::start()
+{
+    if (m_mix.isEmpty() || m_targets.isEmpty() || m_users.isEmpty()) {
+        logCritical() << "LoadRunner: Nothing to run (empty mix, dataset or no virtual users).";
+        emit finished();
+        return;
+    }
+
+    logInfo() << "LoadRunner: Starting" << m_users.size() << "virtual users against" << m_options.baseUrl.toString();
+    m_running = true;
+    m_runTimer.start();
+    const bool login = needsSession();
+    for (VirtualUser* user : std::as_const(m_users)) {
+        if (login) loginVirtualUser(user);
+        else startScenario(user);
+    }
+}
+
+void LoadRunner::loginVirtualUser(VirtualUser *user)
+{
+    QNetworkRequest request(m_options.baseUrl.resolved(QUrl("/api/login")));
+    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    request.setTransferTimeout(m_options.timeoutMs);
+
+    const QByteArray body = QJsonDocument(QJsonObject{{"login", m_options.login}}).toJson(QJsonDocument::Compact);
+    QNetworkReply* reply = user->network->post(request, body);
+    connect(reply, &QNetworkReply::finished, this, [this, user, reply]() {
+        reply->deleteLater();
+        const QJsonObject json = QJsonDocument::fromJson(reply->readAll()).object();
+        user->sessionToken = json["token"].toString().toUtf8();
+        if (reply->error() != QNetworkReply::NoError || user->sessionToken.isEmpty()) {
+            logCritical() << "LoadRunner: Virtual user" << user->index << "failed to log in as"
+                          << m_options.login << ":" << reply->errorString();
+            onUserIdle();
+            return;
+        }
+        startScenario(user);
+    });
+}
+
+void LoadRunner::startScenario(VirtualUser *user)
+{
+    if (shouldStop(user)) {
+        onUserIdle();
+        return;
+    }
+
+    int pick = int(user->random.bounded(quint32(m_totalWeight)));
+    user->scenario = &m_mix.constLast();
+    for (const Scenario& scenario : std::as_const(m_mix)) {
+        if (pick < scenario.weight) {
+            user->scenario = &scenario;
+            break;
+        }
+        pick -= scenario.weight;
+    }
+
+    const auto& target = m_targets.at(int(user->random.bounded(quint32(m_targets.size()))));
+    user->client = target.first;
+    user->station = target.second;
+    user->stepIndex = 0;
+    user->scenarioFailed = false;
+    user->scenarioTimer.start();
+    sendStep(user);
+}
+
+void LoadRunner::sendStep(VirtualUser *user)
+{
+    if (shouldStop(user)) {
+        onUserIdle();
+        return;
+    }
+
+    const Step& step = user->scenario->steps.at(user->stepIndex);
+    QNetworkRequest request(m_options.baseUrl.resolved(QUrl(expand(step.path, user))));
+    request.setTransferTimeout(m_options.timeoutMs);
+    // Повільні запити прогону легко знайти в /api/debug/traces
+    request.setRawHeader("X-Request-ID", QString("lt-%1-%2-%3").arg(m_options.seed).arg(user->index)
+                                             .arg(++user->requestCounter).toLatin1());
+    if (step.auth == Auth::Session) {
+        request.setRawHeader("Authorization", "Bearer " + user->sessionToken);
+    } else if (step.auth == Auth::Bot) {
+        request.setRawHeader("X-Bot-Token", m_options.botKey);
+        if (!m_options.telegramId.isEmpty()) request.setRawHeader("X-Telegram-ID", m_options.telegramId);
+    }
+
+    QByteArray body;
+    if (!step.body.isEmpty()) {
+        body = expand(QString::fromUtf8(step.body), user).toUtf8();
+        request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    }
+
+    ++m_issued;
+    QElapsedTimer timer;
+    timer.start();
+    QNetworkReply* reply = user->network->sendCustomRequest(request, step.method, body);
+    connect(reply, &QNetworkReply::finished, this, [this, user, reply, timer]() {
+        onStepFinished(user, reply, timer.nsecsElapsed());
+    });
+}
+
+void LoadRunner::onStepFinished(VirtualUser *user, QNetworkReply *reply, qint64 elapsedNs)
+{
+    reply->deleteLater();
+    const QByteArray body = reply->readAll(); // Тіло входить у виміряний час; потрібне лише для розбору 503
+
+    const Step& step = user->scenario->steps.at(user->stepIndex);
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    const double latencyMs = elapsedNs / 1e6;
+
+    Stats& stepStats = m_byStep[step.name];
+    if (isThrottled(reply, status, body)) {
+        ++stepStats.throttled;
+        ++m_total.throttled;
+        user->scenarioFailed = true;
+    } else {
+        // Швидкі відмови обмежувача не змішуємо з латентністю справжньої роботи
+        stepStats.latenciesMs.append(latencyMs);
+        m_total.latenciesMs.append(latencyMs);
+        if (reply->error() != QNetworkReply::NoError || status == 0 || status >= 400) {
+            ++stepStats.errors;
+            ++m_total.errors;
+            user->scenarioFailed = true;
+            logDebug() << "LoadRunner:" << step.name << "failed with status" << status << ":" << reply->errorString();
+        }
+    }
+
+    if (++user->stepIndex < user->scenario->steps.size()) {
+        sendStep(user);
+        return;
+    }
+
+    Stats& scenarioStats = m_byScenario[user->scenario->name];
+    scenarioStats.latenciesMs.append(user->scenarioTimer.nsecsElapsed() / 1e6);
+    if (user->scenarioFailed) ++scenarioStats.errors;
+    startScenario(user);
+}
+
+bool LoadRunner::shouldStop(const VirtualUser *user) const
+{
+    if (!m_running) return true;
+    if (m_options.totalRequests > 0) return user->requestCounter >= user->requestBudget;
+    return m_runTimer.elapsed() >= qint64(m_options.durationSec) * 1000;
+}
+
+void LoadRunner::onUserIdle()
+{
+    if (++m_idleUsers < m_users.size()) return;
+
+    m_elapsedSec = m_runTimer.nsecsElapsed() / 1e9;
+    m_running = false;
+    logInfo() << "LoadRunner: Finished," << m_issued << "requests in" << m_elapsedSec << "s.";
+    emit finished();
+}
+
+QString LoadRunner::expand(const QString &text, const VirtualUser *user) const
+{
+    QString result = text;
+    result.replace("{client}", QString::number(user->client->clientId));
+    result.replace("{terminal}", QString::number(user->station->terminalId));
+    result.replace("{region}", QString::fromLatin1(QUrl::toPercentEncoding(user->station->region)));
+    result.replace("{login}", m_options.login);
+    result.replace("{telegram}", QString::fromLatin1(m_options.telegramId));
+    return result;
+}
+
+// ===================================================================
+// Звіт
+// ===================================================================
+
+double LoadRunner::percentile(const QVector<double> &sorted, double p)
+{
+    if (sorted.isEmpty()) return 0;
+    // Nearest-rank: найменше значення, не менше за яке p% вимірів
+    const int rank = qBound(1, qCeil(p / 100.0 * sorted.size()), int(sorted.size()));
+    return sorted.at(rank - 1);
+}
+
+QJsonObject LoadRunner::statsToJson(const Stats &stats, double elapsedSec)
+{
+    QVector<double> sorted = stats.latenciesMs;
+    std::sort(sorted.begin(), sorted.end());
+
+    const int requests = int(sorted.size()) + stats.throttled;
+    double sum = 0;
+    for (double value : std::as_const(sorted)) sum += value;
+
+    return QJsonObject{
+        {"requests", requests},
+        {"errors", stats.errors},
+        {"throttled", stats.throttled},
+        {"error_rate", requests > 0 ? double(stats.errors) / requests : 0.0},
+        {"throughput_rps", elapsedSec > 0 ? requests / elapsedSec : 0.0},
+        {"mean_ms", sorted.isEmpty() ? 0.0 : sum / sorted.size()},
+        {"p50_ms", percentile(sorted, 50)},
+        {"p95_ms", percentile(sorted, 95)},
+        {"p99_ms", percentile(sorted, 99)},
+        {"max_ms", sorted.isEmpty() ? 0.0 : sorted.constLast()}
+    };
+}
+
+QJsonObject LoadRunner::report() const
+{
+    QJsonObject scenarios;
+    for (auto it = m_byScenario.constBegin(); it != m_byScenario.constEnd(); ++it) {
+        scenarios[it.key()] = statsToJson(it.value(), m_elapsedSec);
+    }
+    QJsonObject steps;
+    for (auto it = m_byStep.constBegin(); it != m_byStep.constEnd(); ++it) {
+        steps[it.key()] = statsToJson(it.value(), m_elapsedSec);
+    }
+
+    return QJsonObject{
+        {"options", QJsonObject{
+            {"url", m_options.baseUrl.toString()},
+            {"virtual_users", m_options.virtualUsers},
+            {"duration_sec", m_options.durationSec},
+            {"total_requests", m_options.totalRequests},
+            {"seed", qint64(m_options.seed)},
+            {"dataset_seed", qint64(m_dataset.seed)},
+            {"stations", int(m_targets.size())}
+        }},
+        {"elapsed_sec", m_elapsedSec},
+        {"total", statsToJson(m_total, m_elapsedSec)},
+        {"scenarios", scenarios},
+        {"steps", steps}
+    };
+}
+
+QString LoadRunner::formatReport() const
+{
+    QString text;
+    QTextStream out(&text);
+
+    const auto row = [&out](const QString& name, const QJsonObject& stats) {
+        out << QString("%1 %2 %3 %4 %5 %6 %7 %8\n")
+                   .arg(name, -26)
+                   .arg(stats["requests"].toInt(), 9)
+                   .arg(stats["throughput_rps"].toDouble(), 9, 'f', 1)
+                   .arg(stats["error_rate"].toDouble() * 100, 7, 'f', 2)
+                   .arg(stats["throttled"].toInt(), 9)
+                   .arg(stats["p50_ms"].toDouble(), 9, 'f', 1)
+                   .arg(stats["p95_ms"].toDouble(), 9, 'f', 1)
+                   .arg(stats["p99_ms"].toDouble(), 9, 'f', 1);
+    };
+    const QString header = QString("%1 %2 %3 %4 %5 %6 %7 %8\n")
+                               .arg("", -26).arg("requests", 9).arg("req/s", 9).arg("err %", 7)
+                               .arg("throttled", 9).arg("p50 ms", 9).arg("p95 ms", 9).arg("p99 ms", 9);
+
+    const QJsonObject json = report();
+    out << QString("Elapsed %1 s, %2 virtual users, seed %3, dataset seed %4, %5 stations\n\n")
+               .arg(m_elapsedSec, 0, 'f', 1).arg(m_options.virtualUsers).arg(m_options.seed)
+               .arg(m_dataset.seed).arg(m_targets.size());
+
+    out << "Scenarios\n" << header;
+    const QJsonObject scenarios = json["scenarios"].toObject();
+    for (auto it = scenarios.constBegin(); it != scenarios.constEnd(); ++it) row(it.key(), it.value().toObject());
+
+    out << "\nSteps\n" << header;
+    const QJsonObject steps = json["steps"].toObject();
+    for (auto it = steps.constBegin(); it != steps.constEnd(); ++it) row(it.key(), it.value().toObject());
+
+    out << '\n';
+    row("TOTAL", json["total"].toObject());
+    return text;
+}
@@ -0,0 +1,134 @@
+#ifndef LOADRUNNER_H
+#define LOADRUNNER_H
+
+#include "Dataset.h"
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QMap>
+#include <QObject>
+#include <QPair>
+#include <QRandomGenerator>
+#include <QUrl>
+#include <QVector>
+
+class QNetworkAccessManager;
+class QNetworkReply;
+
+/**
+ * @brief Генератор навантаження на Conduit: віртуальні користувачі виконують сценарії,
+ * обрані зі зваженої суміші, і вимірюють кожен HTTP-запит.
+ *
+ * Сценарій — послідовність кроків (як Gandalf при відкритті картки АЗС робить кілька запитів
+ * поспіль). У шляхах кроків підставляються {client}, {terminal}, {region} з набору даних, {login} і {telegram}.
+ * Вибір сценарію та АЗС визначається зерном: віртуальний користувач i бере QRandomGenerator(seed + i),
+ * тож у режимі фіксованої кількості запитів (--requests) послідовність запитів відтворюється.
+ *
+ * Кожен віртуальний користувач має свій QNetworkAccessManager — окреме з'єднання, як окремий Gandalf;
+ * спільний менеджер обмежив би паралельність шістьма з'єднаннями на хост.
+ */
+class LoadRunner : public QObject
+{
+    Q_OBJECT
+public:
+    // Як автентифікувати крок: сесія Gandalf, бот (X-Bot-Token + X-Telegram-ID), без автентифікації
+    enum class Auth { Session, Bot, None };
+
+    struct Step {
+        QString name;
+        QByteArray method = "GET";
+        QString path;
+        QByteArray body;
+        Auth auth = Auth::Session;
+    };
+
+    struct Scenario {
+        QString name;
+        int weight = 1;
+        QList<Step> steps;
+    };
+
+    struct Options {
+        QUrl baseUrl;
+        int virtualUsers = 10;
+        int durationSec = 60;
+        int totalRequests = 0;    // > 0 — зупинитися після стількох запитів (замість durationSec), порівну на користувача
+        quint32 seed = 1;
+        int timeoutMs = 30000;
+        QString login;
+        QByteArray botKey;
+        QByteArray telegramId;
+    };
+
+    // Суміш за замовчуванням: вхід, список АЗС, повна картка АЗС, дашборд, запити бота
+    static QList<Scenario> defaultMix();
+    // Суміш з JSON: {"scenarios": [{"name", "weight", "steps": [{"name", "method", "path", "body", "auth"}]}]}
+    static bool loadMix(const QString& path, QList<Scenario>* mix, QString* error);
+
+    LoadRunner(const Options& options, const QList<Scenario>& mix, const Dataset& dataset, QObject* parent = nullptr);
+    ~LoadRunner() override;
+
+    void start();
+
+    // Підсумок: пропускна здатність, p50/p95/p99, частка помилок — загалом, по сценаріях і кроках
+    QJsonObject report() const;
+    QString formatReport() const;
+
+signals:
+    void finished();
+
+private:
+    struct Stats {
+        QVector<double> latenciesMs;
+        int errors = 0;      // Помилки мережі, тайм-аути та відповіді 4xx/5xx (крім 429)
+        int throttled = 0;   // 429/503 від обмежувача навантаження Conduit
+    };
+
+    struct VirtualUser {
+        int index = 0;
+        QNetworkAccessManager* network = nullptr;
+        QRandomGenerator random;
+        QByteArray sessionToken;
+        const Scenario* scenario = nullptr;
+        int stepIndex = 0;
+        const Dataset::Client* client = nullptr;
+        const Dataset::Station* station = nullptr;
+        QElapsedTimer scenarioTimer;
+        bool scenarioFailed = false;
+        int requestCounter = 0;
+        // Частка --requests цього користувача: з фіксованим бюджетом кожен користувач іде своєю
+        // послідовністю до кінця, і прогін відтворюється незалежно від порядку відповідей
+        int requestBudget = 0;
+    };
+
+    bool needsSession() const;
+    void loginVirtualUser(VirtualUser* user);
+    void startScenario(VirtualUser* user);
+    void sendStep(VirtualUser* user);
+    void onStepFinished(VirtualUser* user, QNetworkReply* reply, qint64 elapsedNs);
+    bool shouldStop(const VirtualUser* user) const;
+    void onUserIdle();
+    QString expand(const QString& text, const VirtualUser* user) const;
+
+    static QJsonObject statsToJson(const Stats& stats, double elapsedSec);
+    static double percentile(const QVector<double>& sorted, double p);
+
+private:
+    Options m_options;
+    QList<Scenario> m_mix;
+    Dataset m_dataset;
+    QVector<QPair<const Dataset::Client*, const Dataset::Station*>> m_targets; // Усі АЗС набору — цілі запитів
+    int m_totalWeight = 0;
+    QList<VirtualUser*> m_users;
+    QElapsedTimer m_runTimer;
+    double m_elapsedSec = 0;
+    int m_issued = 0;
+    int m_idleUsers = 0;
+    bool m_running = false;
+
+    Stats m_total;
+    QMap<QString, Stats> m_byScenario;
+    QMap<QString, Stats> m_byStep;
+};
+
+#endif // LOADRUNNER_H
@@ -0,0 +1,168 @@
+#include "StubServer.h"
+#include "Oracle/Logger.h"
+
+#include <QHostAddress>
+#include <QHttpServer>
+#include <QHttpServerRequest>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QUrlQuery>
+
+StubServer::StubServer(const Dataset &dataset, QObject *parent)
+    : QObject(parent)
+    , m_httpServer(new QHttpServer(this))
+    , m_dataset(dataset)
+{
+    setupRoutes();
+}
+
+quint16 StubServer::listen(quint16 port)
+{
+    const quint16 actualPort = m_httpServer->listen(QHostAddress::LocalHost, port);
+    if (actualPort) logInfo() << "StubServer: Listening on http://127.0.0.1:" << actualPort;
+    else logCritical() << "StubServer: Failed to listen on port" << port;
+    return actualPort;
+}
+
+void StubServer::setupRoutes()
+{
+    m_httpServer->route("/api/login", QHttpServerRequest::Method::Post, [](const QHttpServerRequest &request) {
+        const QString login = QJsonDocument::fromJson(request.body()).object()["login"].toString();
+        return QHttpServerResponse(QJsonObject{
+            {"token", "stub-token"},
+            {"user", QJsonObject{{"id", 1}, {"login", login}, {"is_active", true}}}
+        });
+    });
+
+    m_httpServer->route("/api/objects", QHttpServerRequest::Method::Get, [this](const QHttpServerRequest &request) {
+        const QUrlQuery query(request.url());
+        const int clientId = query.queryItemValue("clientId").toInt();
+        const QString region = query.queryItemValue("region", QUrl::FullyDecoded);
+        const int limit = query.hasQueryItem("limit") ? qBound(1, query.queryItemValue("limit").toInt(), 1000) : -1;
+
+        QJsonArray objects;
+        for (const Dataset::Client& client : std::as_const(m_dataset.clients)) {
+            if (clientId > 0 && client.clientId != clientId) continue;
+            for (const Dataset::Station& station : client.stations) {
+                if (!region.isEmpty() && station.region != region) continue;
+                if (limit > 0 && objects.size() >= limit) break;
+                objects.append(stationToJson(client, station));
+            }
+        }
+        return QHttpServerResponse(objects);
+    });
+
+    m_httpServer->route("/api/dashboard", QHttpServerRequest::Method::Get, [this](const QHttpServerRequest &) {
+        QJsonArray clients;
+        for (const Dataset::Client& client : std::as_const(m_dataset.clients)) {
+            clients.append(QJsonObject{
+                {"client_id", client.clientId},
+                {"client_name", client.name},
+                {"sync_method", "DIRECT"},
+                {"last_sync_date", ""},
+                {"status", "SUCCESS"},
+                {"message", QString("Stations: %1").arg(client.stations.size())}
+            });
+        }
+        return QHttpServerResponse(clients);
+    });
+
+    m_httpServer->route("/api/clients/<arg>/station/<arg>/pos", QHttpServerRequest::Method::Get,
+                        [this](const QString &clientId, const QString &terminalNo, const QHttpServerRequest &) {
+                            const Dataset::Station* station = findStation(clientId, terminalNo);
+                            if (!station) return notFound();
+                            QJsonArray pos;
+                            for (int i = 1; i <= station->posCount; ++i) {
+                                pos.append(QJsonObject{
+                                    {"pos_id", i}, {"manufacturer", "LoadTest"}, {"model", "LT-1"},
+                                    {"version", "1.0"}, {"muk_version", "1.0"},
+                                    {"factory_number", QString("LT%1%2").arg(terminalNo).arg(i)},
+                                    {"tax_number", QString("30%1%2").arg(terminalNo).arg(i)},
+                                    {"reg_date", "01.01.2020"}
+                                });
+                            }
+                            return QHttpServerResponse(pos);
+                        });
+
+    m_httpServer->route("/api/clients/<arg>/station/<arg>/tanks", QHttpServerRequest::Method::Get,
+                        [this](const QString &clientId, const QString &terminalNo, const QHttpServerRequest &) {
+                            const Dataset::Station* station = findStation(clientId, terminalNo);
+                            if (!station) return notFound();
+                            QJsonArray tanks;
+                            for (int i = 1; i <= station->tankCount; ++i) {
+                                tanks.append(QJsonObject{
+                                    {"tank_id", i}, {"fuel_id", (i - 1) % 4 + 1}, {"fuel_shortname", "А-95"},
+                                    {"fuel_name", "Бензин А-95"}, {"max_vol", 20000}, {"min_vol", 500},
+                                    {"dead_max", 19500}, {"dead_min", 300}, {"tube_vol", 150}
+                                });
+                            }
+                            return QHttpServerResponse(tanks);
+                        });
+
+    // ТРК і робочі місця набір не генерує — порожні списки, як у АЗС без синхронізованого обладнання
+    m_httpServer->route("/api/clients/<arg>/station/<arg>/dispensers", QHttpServerRequest::Method::Get,
+                        [this](const QString &clientId, const QString &terminalNo, const QHttpServerRequest &) {
+                            return findStation(clientId, terminalNo) ? QHttpServerResponse(QJsonArray()) : notFound();
+                        });
+    m_httpServer->route("/api/clients/<arg>/station/<arg>/workplaces", QHttpServerRequest::Method::Get,
+                        [this](const QString &clientId, const QString &terminalNo, const QHttpServerRequest &) {
+                            return findStation(clientId, terminalNo) ? QHttpServerResponse(QJsonArray()) : notFound();
+                        });
+
+    m_httpServer->route("/api/bot/me", QHttpServerRequest::Method::Post, [](const QHttpServerRequest &) {
+        return QHttpServerResponse(QJsonObject{{"status", "active"}, {"user", QJsonObject{{"id", 1}, {"login", "stub"}}}});
+    });
+
+    m_httpServer->route("/api/bot/clients/<arg>/stations", QHttpServerRequest::Method::Get,
+                        [this](const QString &clientId, const QHttpServerRequest &) {
+                            QJsonArray stations;
+                            for (const Dataset::Client& client : std::as_const(m_dataset.clients)) {
+                                if (QString::number(client.clientId) != clientId) continue;
+                                for (const Dataset::Station& station : client.stations) {
+                                    stations.append(stationToJson(client, station));
+                                }
+                            }
+                            return QHttpServerResponse(stations);
+                        });
+
+    m_httpServer->route("/api/bot/clients/<arg>/station/<arg>", QHttpServerRequest::Method::Get,
+                        [this](const QString &clientId, const QString &terminalNo, const QHttpServerRequest &) {
+                            const Dataset::Client* client = nullptr;
+                            const Dataset::Station* station = findStation(clientId, terminalNo, &client);
+                            return station ? QHttpServerResponse(stationToJson(*client, *station)) : notFound();
+                        });
+}
+
+const Dataset::Station *StubServer::findStation(const QString &clientId, const QString &terminalNo, const Dataset::Client **client) const
+{
+    const int id = clientId.toInt();
+    const int terminal = terminalNo.toInt();
+    for (const Dataset::Client& candidate : m_dataset.clients) {
+        if (candidate.clientId != id) continue;
+        for (const Dataset::Station& station : candidate.stations) {
+            if (station.terminalId != terminal) continue;
+            if (client) *client = &candidate;
+            return &station;
+        }
+    }
+    return nullptr;
+}
+
+QJsonObject StubServer::stationToJson(const Dataset::Client &client, const Dataset::Station &station)
+{
+    return QJsonObject{
+        {"client_id", client.clientId},
+        {"client_name", client.name},
+        {"terminal_id", station.terminalId},
+        {"name", station.name},
+        {"address", station.address},
+        {"region_name", station.region},
+        {"is_active", true},
+        {"is_work", true}
+    };
+}
+
+QHttpServerResponse StubServer::notFound()
+{
+    return QHttpServerResponse(QJsonObject{{"error", "Station not found"}}, QHttpServerResponse::StatusCode::NotFound);
+}
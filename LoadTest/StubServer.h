@@ -0,0 +1,38 @@
+#ifndef STUBSERVER_H
+#define STUBSERVER_H
+
+#include "Dataset.h"
+
+#include <QHttpServerResponse>
+#include <QObject>
+
+class QHttpServer;
+
+/**
+ * @brief Замінник Conduit для прогонів без Firebird: ті самі маршрути суміші за замовчуванням,
+ * відповіді будуються з набору даних у пам'яті.
+ *
+ * Потрібен, щоб перевірити сам генератор і зняти базову лінію (накладні витрати HTTP і клієнта)
+ * на машині, де немає локальної БД. Числа проти заглушки не порівнюються з числами проти Conduit.
+ */
+class StubServer : public QObject
+{
+    Q_OBJECT
+public:
+    StubServer(const Dataset& dataset, QObject* parent = nullptr);
+
+    // Порт, на якому слухає сервер; 0 — не вдалося
+    quint16 listen(quint16 port);
+
+private:
+    void setupRoutes();
+    const Dataset::Station* findStation(const QString& clientId, const QString& terminalNo, const Dataset::Client** client = nullptr) const;
+    static QJsonObject stationToJson(const Dataset::Client& client, const Dataset::Station& station);
+    static QHttpServerResponse notFound();
+
+private:
+    QHttpServer* m_httpServer;
+    Dataset m_dataset;
+};
+
+#endif // STUBSERVER_H
@@ -0,0 +1,158 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QCommandLineOption>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QTextStream>
+#include <QTimer>
+
+#include "Oracle/Logger.h"
+#include "Oracle/ConfigManager.h"
+#include "Oracle/DbManager.h"
+#include "Dataset.h"
+#include "LoadRunner.h"
+#include "StubServer.h"
+
+/**
+ * Навантажувальне тестування Conduit. Команди:
+ *   generate — синтетичний набір даних у JSON (лише за seed і розмірами)
+ *   seed     — те саме + запис у локальний Firebird (Config/config.json, як у Conduit)
+ *   stub     — замінник Conduit на основі набору, для прогонів без БД
+ *   run      — прогін зваженої суміші сценаріїв і звіт: req/s, p50/p95/p99, помилки
+ *
+ * Типовий порядок: LoadTest seed --seed 42; Conduit; LoadTest run --seed 42 --login <користувач> --requests 20000
+ */
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    QCoreApplication::setApplicationName("LoadTest");
+    QCoreApplication::setApplicationVersion("1.0");
+
+    const QString appName = QFileInfo(QCoreApplication::applicationFilePath()).baseName();
+    preInitLogger(appName);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Conduit load-testing harness");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument("command", "generate | seed | stub | run");
+
+    QCommandLineOption datasetOption("dataset", "Dataset JSON file.", "file", "loadtest-dataset.json");
+    QCommandLineOption seedOption("seed", "Random seed for the dataset and the request sequence.", "n", "1");
+    QCommandLineOption clientsOption("clients", "Number of synthetic clients.", "n", "20");
+    QCommandLineOption stationsOption("stations", "Average number of stations per client.", "n", "25");
+    QCommandLineOption urlOption("url", "Conduit base URL.", "url", "http://127.0.0.1:8080");
+    QCommandLineOption usersOption("users", "Concurrent virtual users.", "n", "10");
+    QCommandLineOption durationOption("duration", "Run duration in seconds.", "sec", "60");
+    QCommandLineOption requestsOption("requests", "Stop after this many requests (overrides --duration).", "n", "0");
+    QCommandLineOption timeoutOption("timeout-ms", "Per-request timeout.", "ms", "30000");
+    QCommandLineOption loginOption("login", "User login for Gandalf session scenarios.", "login");
+    QCommandLineOption botKeyOption("bot-key", "Bot API key for Isengard scenarios.", "key");
+    QCommandLineOption telegramOption("telegram-id", "Telegram ID of a linked user for Isengard scenarios.", "id");
+    QCommandLineOption mixOption("mix", "Scenario mix JSON (default: built-in mix).", "file");
+    QCommandLineOption reportOption("report", "Write the JSON report to this file.", "file");
+    QCommandLineOption portOption("port", "Stub server port.", "port", "8089");
+    parser.addOptions({datasetOption, seedOption, clientsOption, stationsOption, urlOption, usersOption,
+                       durationOption, requestsOption, timeoutOption, loginOption, botKeyOption, telegramOption,
+                       mixOption, reportOption, portOption});
+    parser.process(a);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+    const QString command = parser.positionalArguments().value(0);
+    const quint32 seed = parser.value(seedOption).toUInt();
+    const QString datasetPath = parser.value(datasetOption);
+    QString error;
+
+    // --- generate / seed ---
+    if (command == "generate" || command == "seed") {
+        Dataset dataset = Dataset::generate(seed, qMax(1, parser.value(clientsOption).toInt()),
+                                            qMax(1, parser.value(stationsOption).toInt()));
+        if (command == "seed") {
+            ConfigManager configManager;
+            if (!configManager.load()) {
+                err << "Configuration file not found. Run Conduit --config next to this executable first." << Qt::endl;
+                return 1;
+            }
+            if (!DbManager::instance().connect(configManager)) {
+                err << "Database connection failed: " << DbManager::instance().lastError() << Qt::endl;
+                return 1;
+            }
+            if (!dataset.writeToDatabase(&error)) {
+                err << "Failed to seed the database: " << error << Qt::endl;
+                return 1;
+            }
+        }
+        if (!dataset.save(datasetPath, &error)) {
+            err << "Failed to save the dataset: " << error << Qt::endl;
+            return 1;
+        }
+        out << "Dataset with " << dataset.clients.size() << " clients and " << dataset.stationCount()
+            << " stations saved to " << datasetPath << Qt::endl;
+        return 0;
+    }
+
+    if (command != "stub" && command != "run") {
+        parser.showHelp(1);
+    }
+
+    Dataset dataset;
+    if (!Dataset::load(datasetPath, &dataset, &error)) {
+        err << "Failed to load the dataset " << datasetPath << ": " << error
+            << " (create it with 'generate' or 'seed')" << Qt::endl;
+        return 1;
+    }
+
+    // --- stub ---
+    if (command == "stub") {
+        StubServer stub(dataset);
+        if (!stub.listen(quint16(parser.value(portOption).toUInt()))) return 1;
+        return a.exec();
+    }
+
+    // --- run ---
+    QList<LoadRunner::Scenario> mix = LoadRunner::defaultMix();
+    if (parser.isSet(mixOption) && !LoadRunner::loadMix(parser.value(mixOption), &mix, &error)) {
+        err << "Failed to load the mix: " << error << Qt::endl;
+        return 1;
+    }
+
+    if (!parser.isSet(loginOption)) {
+        for (const LoadRunner::Scenario& scenario : std::as_const(mix)) {
+            for (const LoadRunner::Step& step : scenario.steps) {
+                if (step.auth == LoadRunner::Auth::Session) {
+                    err << "Scenario '" << scenario.name << "' needs a Gandalf session: pass --login." << Qt::endl;
+                    return 1;
+                }
+            }
+        }
+    }
+
+    LoadRunner::Options options;
+    options.baseUrl = QUrl(parser.value(urlOption));
+    options.virtualUsers = qMax(1, parser.value(usersOption).toInt());
+    options.durationSec = qMax(1, parser.value(durationOption).toInt());
+    options.totalRequests = qMax(0, parser.value(requestsOption).toInt());
+    options.seed = seed;
+    options.timeoutMs = qMax(100, parser.value(timeoutOption).toInt());
+    options.login = parser.value(loginOption);
+    options.botKey = parser.value(botKeyOption).toUtf8();
+    options.telegramId = parser.value(telegramOption).toUtf8();
+
+    LoadRunner runner(options, mix, dataset);
+    QObject::connect(&runner, &LoadRunner::finished, &a, [&]() {
+        out << runner.formatReport() << Qt::endl;
+        if (parser.isSet(reportOption)) {
+            QFile file(parser.value(reportOption));
+            if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+                file.write(QJsonDocument(runner.report()).toJson(QJsonDocument::Indented));
+            } else {
+                err << "Failed to write the report: " << file.errorString() << Qt::endl;
+            }
+        }
+        a.quit();
+    }, Qt::QueuedConnection);
+    QTimer::singleShot(0, &runner, &LoadRunner::start);
+    return a.exec();
+}
@@ -2,6 +2,7 @@
 #include "AppParams.h"
 #include "User.h"
 #include "Logger.h"
+#include "Tracing.h"
 #include <QNetworkAccessManager>
 #include <QNetworkRequest>
 #include <QNetworkReply>
@@ -11,6 +12,18 @@
 #include <QUrl>
 #include <QUrlQuery>
 #include <QFileInfo>
+#include <QThreadPool>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QTimer>
+#include <utility>
+
+namespace {
+// Верхня межа кешу валідаторів (кількість різних GET-запитів)
+constexpr int kMaxValidatorEntries = 256;
+// Затримка GUI-потоку, після якої пишемо попередження в лог
+constexpr qint64 kUiStallWarningMs = 50;
+}
 
 ApiError parseReply(QNetworkReply* reply)
 {
@@ -21,9 +34,19 @@ ApiError parseReply(QNetworkReply* reply)
     }
 
     error.requestUrl = reply->request().url().toString();
+    // Conduit повертає той самий ID, що ми надіслали (або власний, якщо запит ішов без нього)
+    error.requestId = QString::fromLatin1(reply->hasRawHeader("X-Request-ID") ? reply->rawHeader("X-Request-ID")
+                                                                              : reply->request().rawHeader("X-Request-ID"));
     error.httpStatusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
     error.responseBody = reply->readAll(); // Читаємо тіло відповіді ОДИН РАЗ
 
+    // 304 Not Modified: тіло підставляє кеш валідаторів ApiClient (див. ApiClient::sendGet)
+    const QVariant cachedBody = reply->property("cachedBody");
+    if (error.httpStatusCode == 304 && cachedBody.isValid()) {
+        error.httpStatusCode = 200;
+        error.responseBody = cachedBody.toByteArray();
+    }
+
     if (reply->error() != QNetworkReply::NoError) {
         // Мережева помилка (немає з'єднання, таймаут і т.д.)
         error.errorString = "Network error: " + reply->errorString();
@@ -53,6 +76,10 @@ ApiError parseReply(QNetworkReply* reply)
         error.errorString = QString("Request failed with status code %1.").arg(error.httpStatusCode);
     }
 
+    if (!error.errorString.isEmpty() && !error.requestId.isEmpty()) {
+        logWarning() << "ApiClient: Request" << error.requestId << "to" << error.requestUrl << "failed:" << error.errorString;
+    }
+
     return error;
 }
 
@@ -81,6 +108,10 @@ QNetworkRequest ApiClient::createAuthenticatedRequest(const QUrl &url)
 
     // Встановлення загальних заголовків
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    // Accept-Encoding навмисно не задаємо: QNetworkAccessManager сам просить gzip/deflate
+    // і прозоро розпаковує відповідь (заданий вручну заголовок цю розпаковку вимикає)
+    // ID запиту для зіставлення з трасою Conduit (GET /api/debug/traces)
+    request.setRawHeader("X-Request-ID", Tracer::newRequestId().toLatin1());
 
     // 1. АУТЕНТИФІКАЦІЯ КОРИСТУВАЧА (Bearer Token)
     if (!m_authToken.isEmpty()) {
@@ -104,6 +135,325 @@ void ApiClient::setBotApiKey(const QString& key)
     m_botApiKey = key;
 }
 
+QNetworkRequest ApiClient::createEventStreamRequest(const QString& path)
+{
+    QUrl url(m_serverUrl + path);
+    url.setScheme(url.scheme() == "https" ? "wss" : "ws");
+    return createAuthenticatedRequest(url);
+}
+
+QString ApiClient::inFlightKey(const QByteArray& verb, const QNetworkRequest& request, const QString& context) const
+{
+    // Ідентичність запиту: хто питає (токени) + що саме питає (URL)
+    return QString::fromLatin1(verb) + '|'
+           + request.url().toString(QUrl::FullyEncoded) + '|'
+           + QString::fromUtf8(request.rawHeader("Authorization")) + '|'
+           + QString::fromUtf8(request.rawHeader("X-Bot-Token")) + '|'
+           + QString::fromUtf8(request.rawHeader("X-Telegram-ID")) + '|'
+           + context;
+}
+
+QNetworkReply* ApiClient::sendGet(const QNetworkRequest& request, const QString& context, ApiRequestHandle* handle)
+{
+    const QString key = inFlightKey("GET", request, context);
+
+    if (QNetworkReply* pending = m_inFlight.value(key)) {
+        logDebug() << "ApiClient: Coalescing duplicate GET" << request.url().toString();
+        if (handle) {
+            // Ще один власник спільного reply: перерветься, лише коли відпустять усі
+            pending->setProperty("waiters", pending->property("waiters").toInt() + 1);
+            *handle = ApiRequestHandle(pending);
+        }
+        return nullptr;
+    }
+
+    // Якщо маємо збережену відповідь — просимо сервер віддати 304 замість тіла
+    QNetworkRequest conditionalRequest(request);
+    const auto cached = m_validatorCache.constFind(key);
+    if (cached != m_validatorCache.constEnd()) {
+        conditionalRequest.setRawHeader("If-None-Match", cached->etag);
+    }
+
+    QNetworkReply* reply = m_networkManager->get(conditionalRequest);
+    m_inFlight.insert(key, reply);
+
+    // Порядковий номер дозволяє відкинути результат, якщо за ним уже прийшов новіший запит
+    const quint64 serial = ++m_requestSerial;
+    m_latestSerial.insert(key, serial);
+    reply->setProperty("requestKey", key);
+    reply->setProperty("requestSerial", serial);
+    reply->setProperty("waiters", 1);
+    if (handle) {
+        *handle = ApiRequestHandle(reply);
+    }
+
+    // Підключаємо ДО обробника викликача: якщо обробник одразу повторить запит,
+    // він уже не "приклеїться" до завершеного reply, а кеш валідаторів уже оновлено.
+    connect(reply, &QNetworkReply::finished, this, [this, key, reply]() {
+        if (m_inFlight.value(key) == reply) {
+            m_inFlight.remove(key);
+        }
+        applyValidatorCache(key, reply);
+    });
+    connect(reply, &QObject::destroyed, this, [this, key, reply, serial]() {
+        if (m_inFlight.value(key) == reply) {
+            m_inFlight.remove(key);
+        }
+        // Відповіді без асинхронного розбору (малі тіла, помилки) теж не лишають ключ назавжди
+        if (m_latestSerial.value(key) == serial) {
+            m_latestSerial.remove(key);
+        }
+    });
+
+    return reply;
+}
+
+void ApiClient::applyValidatorCache(const QString& key, QNetworkReply* reply)
+{
+    if (reply->error() != QNetworkReply::NoError) return;
+
+    const int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+
+    if (statusCode == 304) {
+        const auto cached = m_validatorCache.constFind(key);
+        if (cached != m_validatorCache.constEnd()) {
+            reply->setProperty("cachedBody", cached->body);
+        } else {
+            logWarning() << "ApiClient: 304 received but no cached body for" << reply->request().url().toString();
+        }
+        return;
+    }
+
+    if (statusCode != 200) return;
+
+    const QByteArray etag = reply->rawHeader("ETag");
+    if (etag.isEmpty()) {
+        m_validatorCache.remove(key);
+        return;
+    }
+
+    if (!m_validatorCache.contains(key) && m_validatorCache.size() >= kMaxValidatorEntries) {
+        m_validatorCache.erase(m_validatorCache.begin());
+    }
+    // peek() не забирає дані з reply — обробник викликача прочитає їх як зазвичай
+    m_validatorCache.insert(key, {etag, reply->peek(reply->bytesAvailable())});
+}
+
+void ApiClient::decodeJson(QNetworkReply* reply, const QByteArray& body,
+                           const std::function<void(const QJsonDocument&)>& onDecoded)
+{
+    const QString url = reply->request().url().toString();
+    const int thresholdBytes = AppParams::instance().getParam("Global", "JsonAsyncDecodeThresholdKb", 64).toInt() * 1024;
+
+    // Малі тіла дешевше розібрати одразу, ніж гнати через пул потоків
+    if (body.size() < thresholdBytes) {
+        QElapsedTimer timer;
+        timer.start();
+        onDecoded(QJsonDocument::fromJson(body));
+        m_decodeStats.syncDecodes++;
+        recordUiStall(url, timer.elapsed());
+        reply->deleteLater();
+        return;
+    }
+
+    QPointer<QNetworkReply> guard(reply);
+    const QString key = reply->property("requestKey").toString();
+    const quint64 serial = reply->property("requestSerial").toULongLong();
+
+    QThreadPool::globalInstance()->start([this, guard, body, key, serial, url, onDecoded]() {
+        const QJsonDocument doc = QJsonDocument::fromJson(body);
+
+        // Назад у GUI-потік (ApiClient живе там)
+        QMetaObject::invokeMethod(this, [this, guard, doc, key, serial, url, onDecoded]() {
+            const bool cancelled = !guard || guard->property("cancelled").toBool();
+            const bool obsolete = !key.isEmpty() && m_latestSerial.value(key) != serial;
+            // Останній запит за цим ключем завершено (або скасовано) — номер більше не потрібен
+            if (!obsolete && !key.isEmpty()) {
+                m_latestSerial.remove(key);
+            }
+            if (cancelled || obsolete) {
+                m_decodeStats.droppedResults++;
+                logDebug() << "ApiClient: Dropping decoded result for" << url
+                           << (cancelled ? "(cancelled)" : "(obsolete)");
+                if (guard) guard->deleteLater();
+                return;
+            }
+
+            QElapsedTimer timer;
+            timer.start();
+            onDecoded(doc);
+            m_decodeStats.asyncDecodes++;
+            recordUiStall(url, timer.elapsed());
+            guard->deleteLater();
+        }, Qt::QueuedConnection);
+    });
+}
+
+void ApiClient::recordUiStall(const QString& url, qint64 elapsedMs)
+{
+    m_decodeStats.uiStallTotalMs += elapsedMs;
+    m_decodeStats.uiStallMaxMs = qMax(m_decodeStats.uiStallMaxMs, elapsedMs);
+    if (elapsedMs >= kUiStallWarningMs) {
+        logWarning() << "ApiClient: GUI thread stalled for" << elapsedMs << "ms handling" << url;
+    }
+}
+
+void ApiClient::batchGet(const QString& path, const QUrlQuery& query, const BatchCallback& callback)
+{
+    if (m_pendingBatch.isEmpty()) {
+        QTimer::singleShot(0, this, &ApiClient::flushBatch);
+    }
+
+    const QString queryString = query.toString(QUrl::FullyEncoded);
+    for (BatchItem& item : m_pendingBatch) {
+        if (item.path == path && item.query.toString(QUrl::FullyEncoded) == queryString) {
+            item.callbacks.append(callback);
+            return;
+        }
+    }
+    m_pendingBatch.append({path, query, {callback}});
+}
+
+void ApiClient::flushBatch()
+{
+    const QList<BatchItem> items = std::exchange(m_pendingBatch, {});
+    if (items.isEmpty()) return;
+
+    // Один запит — без обгортки пакета, звичайним GET (об'єднання і кеш валідаторів)
+    if (items.size() == 1) {
+        sendBatchItem(items.first());
+        return;
+    }
+
+    // Ключ кешу валідаторів — той самий, що в окремого GET: ETag спільний для обох шляхів
+    QStringList keys;
+    QJsonArray requests;
+    for (int i = 0; i < items.size(); ++i) {
+        const QString key = inFlightKey("GET", createAuthenticatedRequest(batchItemUrl(items.at(i))), QString());
+        keys.append(key);
+        QJsonObject request{
+            {"id", QString::number(i)},
+            {"method", "GET"},
+            {"path", items.at(i).path},
+            {"query", items.at(i).query.toString(QUrl::FullyEncoded)}
+        };
+        const auto cached = m_validatorCache.constFind(key);
+        if (cached != m_validatorCache.constEnd()) {
+            request["if_none_match"] = QString::fromLatin1(cached->etag);
+        }
+        requests.append(request);
+    }
+    logDebug() << "ApiClient: Sending" << items.size() << "requests as one /api/batch";
+
+    QNetworkRequest request = createAuthenticatedRequest(QUrl(m_serverUrl + "/api/batch"));
+    QNetworkReply* reply = m_networkManager->post(request, QJsonDocument(QJsonObject{{"requests", requests}}).toJson(QJsonDocument::Compact));
+    connect(reply, &QNetworkReply::finished, this, [this, reply, items, keys]() {
+        const ApiError batchError = parseReply(reply);
+        if (!batchError.errorString.isEmpty()) {
+            // Весь пакет не вдався — та сама помилка для кожного запиту
+            for (const BatchItem& item : items) deliverBatchItem(item, batchError, QJsonValue());
+            reply->deleteLater();
+            return;
+        }
+
+        decodeJson(reply, batchError.responseBody, [this, items, keys, batchError](const QJsonDocument& doc) {
+            QHash<QString, QJsonObject> responses;
+            for (const QJsonValue& value : doc.object().value("responses").toArray()) {
+                responses.insert(value.toObject().value("id").toString(), value.toObject());
+            }
+
+            for (int i = 0; i < items.size(); ++i) {
+                const QJsonObject response = responses.value(QString::number(i));
+                ApiError error;
+                error.requestUrl = batchItemUrl(items.at(i)).toString();
+                error.requestId = batchError.requestId;
+                if (response.isEmpty()) {
+                    error.errorString = "Invalid response from server: missing batch item.";
+                    deliverBatchItem(items.at(i), error, QJsonValue());
+                    continue;
+                }
+
+                error.httpStatusCode = response.value("status").toInt();
+                QJsonValue body = response.value("body");
+                const QByteArray etag = response.value("etag").toString().toLatin1();
+                if (error.httpStatusCode == 304) {
+                    // Дані не змінились — тіло з кешу валідаторів, як для окремого GET
+                    const auto cached = m_validatorCache.constFind(keys.at(i));
+                    if (cached == m_validatorCache.constEnd()) {
+                        logWarning() << "ApiClient: 304 received but no cached body for" << error.requestUrl;
+                        error.errorString = "Invalid response from server: 304 without a cached body.";
+                        deliverBatchItem(items.at(i), error, QJsonValue());
+                        continue;
+                    }
+                    error.httpStatusCode = 200;
+                    body = jsonBodyValue(QJsonDocument::fromJson(cached->body));
+                } else if (error.httpStatusCode == 200 && !etag.isEmpty()) {
+                    if (!m_validatorCache.contains(keys.at(i)) && m_validatorCache.size() >= kMaxValidatorEntries) {
+                        m_validatorCache.erase(m_validatorCache.begin());
+                    }
+                    const QJsonDocument bodyDoc = body.isArray() ? QJsonDocument(body.toArray()) : QJsonDocument(body.toObject());
+                    m_validatorCache.insert(keys.at(i), {etag, bodyDoc.toJson(QJsonDocument::Compact)});
+                } else if (error.httpStatusCode >= 400) {
+                    error.errorString = body.toObject().value("error").toString(
+                        QString("Request failed with status code %1.").arg(error.httpStatusCode));
+                }
+                deliverBatchItem(items.at(i), error, body);
+            }
+        });
+    });
+}
+
+void ApiClient::sendBatchItem(const BatchItem& item)
+{
+    const QNetworkRequest request = createAuthenticatedRequest(batchItemUrl(item));
+    QNetworkReply* reply = sendGet(request);
+    if (!reply) {
+        // Такий самий GET уже в польоті. Його тіло прочитає власник reply, тож результат беремо
+        // з кешу валідаторів, який sendGet оновлює раніше за будь-який інший обробник
+        const QString key = inFlightKey("GET", request, QString());
+        QNetworkReply* pending = m_inFlight.value(key);
+        connect(pending, &QNetworkReply::finished, this, [this, pending, key, item]() {
+            const int statusCode = pending->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+            const auto cached = m_validatorCache.constFind(key);
+            if (pending->error() != QNetworkReply::NoError || (statusCode != 200 && statusCode != 304)
+                || cached == m_validatorCache.constEnd()) {
+                // Нема чим поділитися (помилка або відповідь без ETag) — окремий запит
+                sendBatchItem(item);
+                return;
+            }
+            ApiError error;
+            error.requestUrl = pending->request().url().toString();
+            error.httpStatusCode = 200;
+            deliverBatchItem(item, error, jsonBodyValue(QJsonDocument::fromJson(cached->body)));
+        });
+        return;
+    }
+
+    connect(reply, &QNetworkReply::finished, this, [this, reply, item]() {
+        const ApiError error = parseReply(reply);
+        decodeJson(reply, error.responseBody, [item, error](const QJsonDocument& doc) {
+            deliverBatchItem(item, error, jsonBodyValue(doc));
+        });
+    });
+}
+
+QUrl ApiClient::batchItemUrl(const BatchItem& item) const
+{
+    QUrl url(m_serverUrl + item.path);
+    url.setQuery(item.query);
+    return url;
+}
+
+void ApiClient::deliverBatchItem(const BatchItem& item, const ApiError& error, const QJsonValue& body)
+{
+    for (const BatchCallback& callback : item.callbacks) callback(error, body);
+}
+
+QJsonValue ApiClient::jsonBodyValue(const QJsonDocument& doc)
+{
+    return doc.isArray() ? QJsonValue(doc.array()) : QJsonValue(doc.object());
+}
+
 void ApiClient::login(const QString& username)
 {
     QJsonObject json;
@@ -136,6 +486,8 @@ void ApiClient::onLoginReplyFinished()
         QJsonObject responseObj = QJsonDocument::fromJson(reply->readAll()).object();
         if (responseObj.contains("token")) {
             m_authToken = responseObj["token"].toString();
+            m_validatorCache.clear(); // Нова сесія — старі відповіді нам не належать
+            m_latestSerial.clear();
         }
         User* user = User::fromJson(responseObj["user"].toObject());
         if (user) {
@@ -151,7 +503,8 @@ void ApiClient::onLoginReplyFinished()
 void ApiClient::fetchAllUsers()
 {
     QNetworkRequest request = createAuthenticatedRequest(QUrl(m_serverUrl + "/api/users"));
-    QNetworkReply* reply = m_networkManager->get(request);
+    QNetworkReply* reply = sendGet(request);
+    if (!reply) return; // Ідентичний запит уже виконується
     connect(reply, &QNetworkReply::finished, this, &ApiClient::onUsersReplyFinished);
 }
 
@@ -160,26 +513,23 @@ void ApiClient::onUsersReplyFinished()
     QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
     if (!reply) return;
 
-    ApiError error;
-    error.requestUrl = reply->request().url().toString();
-    error.httpStatusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    ApiError error = parseReply(reply); // parseReply також підставляє тіло для 304
 
-    if (reply->error() != QNetworkReply::NoError) {
-        error.errorString = "Network error: " + reply->errorString();
-        emit usersFetchFailed(error);
-    } else if (error.httpStatusCode != 200) {
-        QJsonObject jsonObj = QJsonDocument::fromJson(reply->readAll()).object();
-        error.errorString = jsonObj["error"].toString("Unknown server error");
-        emit usersFetchFailed(error);
-    } else {
-        QJsonDocument doc = QJsonDocument::fromJson(reply->readAll());
-        if (doc.isArray()) {
-            emit usersFetched(doc.array());
-        } else {
-            error.errorString = "Invalid response from server: expected a JSON array.";
-            emit usersFetchFailed(error);
-        }
+    if (reply->error() == QNetworkReply::NoError && error.httpStatusCode == 200)
+    {
+        // Великі тіла розбираються поза GUI-потоком; reply звільняє decodeJson
+        decodeJson(reply, error.responseBody, [this, error](const QJsonDocument& doc) mutable {
+            if (doc.isArray()) {
+                emit usersFetched(doc.array());
+            } else {
+                error.errorString = "Invalid response from server: expected a JSON array.";
+                emit usersFetchFailed(error);
+            }
+        });
+        return;
     }
+
+    emit usersFetchFailed(error);
     reply->deleteLater();
 }
 void ApiClient::fetchUserById(int userId)
@@ -187,7 +537,8 @@ void ApiClient::fetchUserById(int userId)
     QString url = m_serverUrl + QString("/api/users/%1").arg(userId);
     // Створюємо запит з аутентифікацією
     QNetworkRequest request = createAuthenticatedRequest(QUrl(url));
-    QNetworkReply* reply = m_networkManager->get(request);
+    QNetworkReply* reply = sendGet(request);
+    if (!reply) return; // Ідентичний запит уже виконується
     connect(reply, &QNetworkReply::finished, this, &ApiClient::onUserDetailsReplyFinished);
 }
 
@@ -222,7 +573,8 @@ void ApiClient::onUserDetailsReplyFinished()
 void ApiClient::fetchAllRoles()
 {
     QNetworkRequest request(QUrl(m_serverUrl + "/api/roles"));
-    QNetworkReply* reply = m_networkManager->get(request);
+    QNetworkReply* reply = sendGet(request);
+    if (!reply) return; // Ідентичний запит уже виконується
     connect(reply, &QNetworkReply::finished, this, &ApiClient::onRolesReplyFinished);
 }
 
@@ -231,19 +583,11 @@ void ApiClient::onRolesReplyFinished()
     QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
     if (!reply) return;
 
-    ApiError error;
-    error.requestUrl = reply->request().url().toString();
-    error.httpStatusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    ApiError error = parseReply(reply); // parseReply також підставляє тіло для 304
 
-    if (reply->error() != QNetworkReply::NoError) {
-        error.errorString = "Network error: " + reply->errorString();
-        emit rolesFetchFailed(error);
-    } else if (error.httpStatusCode != 200) {
-        QJsonObject jsonObj = QJsonDocument::fromJson(reply->readAll()).object();
-        error.errorString = jsonObj["error"].toString("Unknown server error");
-        emit rolesFetchFailed(error);
-    } else {
-        QJsonDocument doc = QJsonDocument::fromJson(reply->readAll());
+    if (reply->error() == QNetworkReply::NoError && error.httpStatusCode == 200)
+    {
+        QJsonDocument doc = QJsonDocument::fromJson(error.responseBody);
         if (doc.isArray()) {
             emit rolesFetched(doc.array());
         } else {
@@ -251,6 +595,10 @@ void ApiClient::onRolesReplyFinished()
             emit rolesFetchFailed(error);
         }
     }
+    else
+    {
+        emit rolesFetchFailed(error);
+    }
     reply->deleteLater();
 }
 
@@ -302,49 +650,18 @@ void ApiClient::onUserUpdateReplyFinished()
 
 void ApiClient::fetchAllClients()
 {
-    QNetworkRequest request = createAuthenticatedRequest(QUrl(m_serverUrl + "/api/clients"));
-    QNetworkReply* reply = m_networkManager->get(request);
-    connect(reply, &QNetworkReply::finished, this, &ApiClient::onClientsReplyFinished);
-}
-
-void ApiClient::onClientsReplyFinished()
-{
-    QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
-    if (!reply) return;
-
-    // 1 & 2: Створюємо об'єкт помилки та заповнюємо базові дані
-    ApiError error;
-    error.requestUrl = reply->request().url().toString();
-    error.httpStatusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
-
-    // Перевіряємо на успіх (відсутність мережевих помилок І статус-код 200 ОК)
-    if (reply->error() == QNetworkReply::NoError && error.httpStatusCode == 200)
-    {
-        QJsonDocument doc = QJsonDocument::fromJson(reply->readAll());
-        if (doc.isArray()) {
-            // 4. Успіх: тіло відповіді - це масив, як і очікувалося
-            emit clientsFetched(doc.array());
-        } else {
-            // 3. Помилка: сервер повернув 200 ОК, але тіло відповіді - не масив
-            error.errorString = "Invalid response from server: expected a JSON array.";
+    // Довідники при відкритті діалогів запитуються разом — вони підуть одним /api/batch
+    batchGet("/api/clients", QUrlQuery(), [this](const ApiError& error, const QJsonValue& body) {
+        if (error.httpStatusCode != 200) {
             emit clientsFetchFailed(error);
-        }
-    }
-    else
-    {
-        // 3. Помилка: або мережева, або від сервера
-        if (reply->error() != QNetworkReply::NoError) {
-            // Мережева помилка
-            error.errorString = "Network error: " + reply->errorString();
+        } else if (!body.isArray()) {
+            ApiError invalid = error;
+            invalid.errorString = "Invalid response from server: expected a JSON array.";
+            emit clientsFetchFailed(invalid);
         } else {
-            // Помилка, яку повернув сервер (напр. 401, 404, 500)
-            QJsonObject jsonObj = QJsonDocument::fromJson(reply->readAll()).object();
-            error.errorString = jsonObj["error"].toString("Unknown server error");
+            emit clientsFetched(body.toArray());
         }
-        emit clientsFetchFailed(error);
-    }
-
-    reply->deleteLater();
+    });
 }
 
 void ApiClient::createClient(const QJsonObject& clientData)
@@ -401,7 +718,8 @@ void ApiClient::onCreateClientReplyFinished()
 void ApiClient::fetchClientById(int clientId)
 {
     QNetworkRequest request = createAuthenticatedRequest(QUrl(m_serverUrl + QString("/api/clients/%1").arg(clientId)));
-    QNetworkReply* reply = m_networkManager->get(request);
+    QNetworkReply* reply = sendGet(request);
+    if (!reply) return; // Ідентичний запит уже виконується
     connect(reply, &QNetworkReply::finished, this, &ApiClient::onClientDetailsReplyFinished);
 }
 
@@ -410,81 +728,40 @@ void ApiClient::onClientDetailsReplyFinished()
     QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
     if (!reply) return;
 
-    // 1 & 2: Створюємо об'єкт помилки та заповнюємо базові дані
-    ApiError error;
-    error.requestUrl = reply->request().url().toString();
-    error.httpStatusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    ApiError error = parseReply(reply); // parseReply також підставляє тіло для 304
 
-    // Перевіряємо на успіх (відсутність мережевих помилок І статус-код 200 ОК)
     if (reply->error() == QNetworkReply::NoError && error.httpStatusCode == 200)
     {
-        QJsonDocument doc = QJsonDocument::fromJson(reply->readAll());
+        QJsonDocument doc = QJsonDocument::fromJson(error.responseBody);
         if (doc.isObject()) {
-            // 4. Успіх: тіло відповіді - це об'єкт, як і очікувалося
             emit clientDetailsFetched(doc.object());
         } else {
-            // 3. Помилка: сервер повернув 200 ОК, але тіло відповіді - не об'єкт
             error.errorString = "Invalid response from server: expected a JSON object.";
             emit clientDetailsFetchFailed(error);
         }
     }
     else
     {
-        // 3. Помилка: або мережева, або від сервера
-        if (reply->error() != QNetworkReply::NoError) {
-            // Мережева помилка
-            error.errorString = "Network error: " + reply->errorString();
-        } else {
-            // Помилка, яку повернув сервер (напр. 401, 404, 500)
-            QJsonObject jsonObj = QJsonDocument::fromJson(reply->readAll()).object();
-            error.errorString = jsonObj["error"].toString("Unknown server error");
-        }
         emit clientDetailsFetchFailed(error);
     }
-
     reply->deleteLater();
 }
 
 void ApiClient::fetchAllIpGenMethods()
 {
-    QNetworkRequest request = createAuthenticatedRequest(QUrl(m_serverUrl + "/api/ip-gen-methods"));
-    QNetworkReply* reply = m_networkManager->get(request);
-    connect(reply, &QNetworkReply::finished, this, &ApiClient::onIpGenMethodsReplyFinished);
-}
-
-void ApiClient::onIpGenMethodsReplyFinished()
-{
-    QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
-    if (!reply) return;
-
-    ApiError error;
-    error.requestUrl = reply->request().url().toString();
-    error.httpStatusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
-
-    if (reply->error() == QNetworkReply::NoError && error.httpStatusCode == 200)
-    {
-        QJsonDocument doc = QJsonDocument::fromJson(reply->readAll());
-        if (doc.isArray()) {
-            emit ipGenMethodsFetched(doc.array());
-        } else {
-            error.errorString = "Invalid response from server: expected a JSON array.";
+    batchGet("/api/ip-gen-methods", QUrlQuery(), [this](const ApiError& error, const QJsonValue& body) {
+        if (error.httpStatusCode != 200) {
             emit ipGenMethodsFetchFailed(error);
-        }
-    }
-    else
-    {
-        if (reply->error() != QNetworkReply::NoError) {
-            error.errorString = "Network error: " + reply->errorString();
+        } else if (!body.isArray()) {
+            ApiError invalid = error;
+            invalid.errorString = "Invalid response from server: expected a JSON array.";
+            emit ipGenMethodsFetchFailed(invalid);
         } else {
-            QJsonObject jsonObj = QJsonDocument::fromJson(reply->readAll()).object();
-            error.errorString = jsonObj["error"].toString("Unknown server error");
+            emit ipGenMethodsFetched(body.toArray());
         }
-        emit ipGenMethodsFetchFailed(error);
-    }
-    reply->deleteLater();
+    });
 }
 
-
 void ApiClient::testDbConnection(const QJsonObject& config)
 {
     QNetworkRequest request = createAuthenticatedRequest(QUrl(m_serverUrl + "/api/connections/test"));
@@ -586,7 +863,8 @@ void ApiClient::fetchSettings(const QString& appName)
     // !!! ВИКОРИСТОВУЄМО ОНОВЛЕНИЙ createAuthenticatedRequest !!!
     QNetworkRequest request = createAuthenticatedRequest(url);
 
-    QNetworkReply* reply = m_networkManager->get(request);
+    QNetworkReply* reply = sendGet(request);
+    if (!reply) return; // Ідентичний запит уже виконується
 
     // !!! НАСЛІДУВАННЯ ШАБЛОНУ: ВСТАНОВЛЕННЯ ВЛАСТИВОСТЕЙ НА REPLY !!!
     reply->setProperty("appName", appName);
@@ -607,16 +885,15 @@ void ApiClient::onSettingsReplyFinished()
     QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
     if (!reply) return;
 
-    ApiError error;
-    error.requestUrl = reply->request().url().toString();
-    error.httpStatusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    ApiError error = parseReply(reply); // parseReply також підставляє тіло для 304
 
     if (reply->error() == QNetworkReply::NoError && error.httpStatusCode == 200)
     {
-        QJsonDocument doc = QJsonDocument::fromJson(reply->readAll());
+        QJsonDocument doc = QJsonDocument::fromJson(error.responseBody);
         if (doc.isObject()) {
-            // Успіх: конвертуємо JSON-об'єкт в QVariantMap і відправляємо
-            emit settingsFetched(doc.object().toVariantMap());
+            const QVariantMap settings = doc.object().toVariantMap();
+            emit scopedSettingsFetched(reply->property("appName").toString(), settings);
+            emit settingsFetched(settings);
         } else {
             error.errorString = "Invalid response from server: expected a JSON object.";
             emit settingsFetchFailed(error);
@@ -624,12 +901,6 @@ void ApiClient::onSettingsReplyFinished()
     }
     else
     {
-        if (reply->error() != QNetworkReply::NoError) {
-            error.errorString = "Network error: " + reply->errorString();
-        } else {
-            QJsonObject jsonObj = QJsonDocument::fromJson(reply->readAll()).object();
-            error.errorString = jsonObj["error"].toString("Unknown server error");
-        }
         emit settingsFetchFailed(error);
     }
     reply->deleteLater();
@@ -703,12 +974,14 @@ void ApiClient::onSyncReplyFinished()
 }
 
 
-void ApiClient::fetchSyncStatus(int clientId)
+void ApiClient::fetchSyncStatus(int clientId, RequestPriority priority)
 {
     QString url = m_serverUrl + QString("/api/clients/%1/sync-status").arg(clientId);
     QNetworkRequest request = createAuthenticatedRequest(QUrl(url));
+    request.setPriority(toNetworkPriority(priority));
 
-    QNetworkReply* reply = m_networkManager->get(request);
+    QNetworkReply* reply = sendGet(request);
+    if (!reply) return; // Ідентичний запит уже виконується
     reply->setProperty("clientId", clientId); // Зберігаємо ID для слота
     connect(reply, &QNetworkReply::finished, this, &ApiClient::onSyncStatusReplyFinished);
 }
@@ -744,7 +1017,8 @@ void ApiClient::fetchObjects(const QVariantMap &filters)
     }
 
     QNetworkRequest request = createAuthenticatedRequest(url);
-    QNetworkReply* reply = m_networkManager->get(request);
+    QNetworkReply* reply = sendGet(request);
+    if (!reply) return; // Ідентичний запит уже виконується
     connect(reply, &QNetworkReply::finished, this, &ApiClient::onObjectsReplyFinished);
 }
 
@@ -755,50 +1029,88 @@ void ApiClient::onObjectsReplyFinished()
 
     ApiError error = parseReply(reply);
     if (reply->error() == QNetworkReply::NoError) {
-        QJsonDocument doc = QJsonDocument::fromJson(error.responseBody);
-        if (doc.isObject() && doc.object().contains("objects")) {
-            emit objectsFetched(doc.object()["objects"].toArray());
-        } else {
-            error.errorString = "Invalid response from server: 'objects' array not found.";
-            emit objectsFetchFailed(error);
-        }
-    } else {
-        emit objectsFetchFailed(error);
+        // Список об'єктів — найбільша відповідь API, розбираємо поза GUI-потоком
+        decodeJson(reply, error.responseBody, [this, error](const QJsonDocument& doc) mutable {
+            if (doc.isObject() && doc.object().contains("objects")) {
+                emit objectsFetched(doc.object()["objects"].toArray());
+            } else {
+                error.errorString = "Invalid response from server: 'objects' array not found.";
+                emit objectsFetchFailed(error);
+            }
+        });
+        return;
     }
+
+    emit objectsFetchFailed(error);
     reply->deleteLater();
 }
 
-void ApiClient::fetchRegionsList()
+void ApiClient::fetchObjectsPage(const QVariantMap &filters, int offset, int limit)
 {
-    QNetworkRequest request = createAuthenticatedRequest(QUrl(m_serverUrl + "/api/regions-list"));
-    QNetworkReply* reply = m_networkManager->get(request);
-    connect(reply, &QNetworkReply::finished, this, &ApiClient::onRegionsListReplyFinished);
+    QUrl url(m_serverUrl + "/api/objects");
+    QUrlQuery query;
+    for (auto it = filters.constBegin(); it != filters.constEnd(); ++it) {
+        query.addQueryItem(it.key(), it.value().toString());
+    }
+    query.addQueryItem("offset", QString::number(offset));
+    query.addQueryItem("limit", QString::number(limit));
+    url.setQuery(query);
+
+    QNetworkRequest request = createAuthenticatedRequest(url);
+    QNetworkReply* reply = sendGet(request);
+    if (!reply) return; // Ідентичний запит уже виконується
+    reply->setProperty("filters", filters);
+    reply->setProperty("offset", offset);
+    connect(reply, &QNetworkReply::finished, this, &ApiClient::onObjectsPageReplyFinished);
 }
 
-void ApiClient::onRegionsListReplyFinished()
+void ApiClient::onObjectsPageReplyFinished()
 {
     QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
     if (!reply) return;
 
     ApiError error = parseReply(reply);
     if (reply->error() == QNetworkReply::NoError) {
-        QJsonDocument doc = QJsonDocument::fromJson(error.responseBody);
-        if (doc.isObject() && doc.object().contains("regions")) {
-            QStringList regions;
-            for (const auto& val : doc.object()["regions"].toArray()) {
-                regions.append(val.toString());
+        const QVariantMap filters = reply->property("filters").toMap();
+        const int offset = reply->property("offset").toInt();
+        decodeJson(reply, error.responseBody, [this, error, filters, offset](const QJsonDocument& doc) mutable {
+            if (doc.isObject() && doc.object().contains("objects")) {
+                const QJsonObject root = doc.object();
+                emit objectsPageFetched(filters, offset, root["objects"].toArray(), root["has_more"].toBool());
+            } else {
+                error.errorString = "Invalid response from server: 'objects' array not found.";
+                emit objectsFetchFailed(error);
             }
-            emit regionsListFetched(regions);
-        } else {
-            error.errorString = "Invalid response from server: 'regions' array not found.";
-            emit regionsListFetchFailed(error);
-        }
-    } else {
-        emit regionsListFetchFailed(error);
+        });
+        return;
     }
+
+    emit objectsFetchFailed(error);
     reply->deleteLater();
 }
 
+void ApiClient::fetchRegionsList()
+{
+    batchGet("/api/regions-list", QUrlQuery(), [this](const ApiError& error, const QJsonValue& body) {
+        if (error.httpStatusCode != 200) {
+            emit regionsListFetchFailed(error);
+            return;
+        }
+        const QJsonObject object = body.toObject();
+        if (!object.contains("regions")) {
+            ApiError invalid = error;
+            invalid.errorString = "Invalid response from server: 'regions' array not found.";
+            emit regionsListFetchFailed(invalid);
+            return;
+        }
+        QStringList regions;
+        for (const auto& val : object["regions"].toArray()) {
+            regions.append(val.toString());
+        }
+        emit regionsListFetched(regions);
+    });
+}
+
 
 void ApiClient::setServerUrl(const QString& url)
 {
@@ -1069,6 +1381,7 @@ QNetworkRequest ApiClient::createBotRequest(const QUrl &url, qint64 telegramId)
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
     // Додаємо два наші нові заголовки
     request.setRawHeader("X-Bot-Token", m_botApiKey.toUtf8());
+    request.setRawHeader("X-Request-ID", Tracer::newRequestId().toLatin1());
     request.setRawHeader("X-Telegram-ID", QByteArray::number(telegramId));
     return request;
 }
@@ -1084,6 +1397,7 @@ QNetworkRequest ApiClient::createBotRequest(const QUrl &url)
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
     // Додаємо один заголовок
     request.setRawHeader("X-Bot-Token", m_botApiKey.toUtf8());
+    request.setRawHeader("X-Request-ID", Tracer::newRequestId().toLatin1());
     return request;
 }
 
@@ -1416,7 +1730,8 @@ void ApiClient::fetchExportTasks()
     logInfo() << "Fetching export tasks list...";
     // Створюємо запит з аутентифікацією
     QNetworkRequest request = createAuthenticatedRequest(QUrl(m_serverUrl + "/api/export-tasks"));
-    QNetworkReply* reply = m_networkManager->get(request);
+    QNetworkReply* reply = sendGet(request);
+    if (!reply) return; // Ідентичний запит уже виконується
     connect(reply, &QNetworkReply::finished, this, &ApiClient::onExportTasksReplyFinished);
 }
 
@@ -1429,28 +1744,24 @@ void ApiClient::onExportTasksReplyFinished()
     QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
     if (!reply) return;
 
-    ApiError error = parseReply(reply); // Використовуємо наш універсальний парсер помилок
+    ApiError error = parseReply(reply); // parseReply також підставляє тіло для 304
 
-    // Перевіряємо, чи все пройшло успішно (HTTP 200 OK)
     if (reply->error() == QNetworkReply::NoError && error.httpStatusCode == 200)
     {
-        QJsonDocument doc = QJsonDocument::fromJson(error.responseBody);
-        if (doc.isArray()) {
-            // Успіх: відправляємо сигнал з масивом завдань
-            logInfo() << "Successfully fetched" << doc.array().count() << "export tasks.";
-            emit exportTasksFetched(doc.array());
-        } else {
-            // Помилка: сервер повернув не масив
-            logWarning() << "Failed to fetch export tasks: expected a JSON array.";
-            error.errorString = "Invalid response from server: expected a JSON array of tasks.";
-            emit exportTasksFetchFailed(error);
-        }
-    } else {
-        // Мережева помилка або помилка сервера (4xx, 5xx)
-        logWarning() << "Failed to fetch export tasks:" << error.errorString;
-        emit exportTasksFetchFailed(error);
+        // Великі тіла розбираються поза GUI-потоком; reply звільняє decodeJson
+        decodeJson(reply, error.responseBody, [this, error](const QJsonDocument& doc) mutable {
+            if (doc.isArray()) {
+                logInfo() << "Successfully fetched" << doc.array().count() << "export tasks.";
+                emit exportTasksFetched(doc.array());
+            } else {
+                error.errorString = "Invalid response from server: expected a JSON array of tasks.";
+                emit exportTasksFetchFailed(error);
+            }
+        });
+        return;
     }
 
+    emit exportTasksFetchFailed(error);
     reply->deleteLater();
 }
 
@@ -1526,21 +1837,24 @@ void ApiClient::onAllExportTasksReplyFinished()
     QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
     if (!reply) return;
 
-    ApiError error = parseReply(reply);
+    ApiError error = parseReply(reply); // parseReply також підставляє тіло для 304
 
     if (reply->error() == QNetworkReply::NoError && error.httpStatusCode == 200)
     {
-        QJsonDocument doc = QJsonDocument::fromJson(error.responseBody);
-        if (doc.isArray()) {
-            logInfo() << "Successfully fetched" << doc.array().count() << "export tasks for list view.";
-            emit exportTasksFetched(doc.array());
-        } else {
-            error.errorString = "Invalid response from server: expected a JSON array of tasks.";
-            emit exportTasksFetchFailed(error);
-        }
-    } else {
-        emit exportTasksFetchFailed(error);
+        // Великі тіла розбираються поза GUI-потоком; reply звільняє decodeJson
+        decodeJson(reply, error.responseBody, [this, error](const QJsonDocument& doc) mutable {
+            if (doc.isArray()) {
+                logInfo() << "Successfully fetched" << doc.array().count() << "export tasks for list view.";
+                emit exportTasksFetched(doc.array());
+            } else {
+                error.errorString = "Invalid response from server: expected a JSON array of tasks.";
+                emit exportTasksFetchFailed(error);
+            }
+        });
+        return;
     }
+
+    emit exportTasksFetchFailed(error);
     reply->deleteLater();
 }
 
@@ -1597,7 +1911,7 @@ void ApiClient::onExportTaskSaveReplyFinished()
 
 // --- DASHBOARD API ---
 
-void ApiClient::fetchDashboardData()
+void ApiClient::fetchDashboardData(RequestPriority priority)
 {
     // 1. Формуємо URL (використовуємо вашу змінну m_serverUrl)
     QUrl url(m_serverUrl + "/api/dashboard");
@@ -1605,9 +1919,11 @@ void ApiClient::fetchDashboardData()
     // 2. Створюємо АВТОРИЗОВАНИЙ запит
     // (createAuthenticatedRequest додає заголовок Authorization: Bearer <token>)
     QNetworkRequest request = createAuthenticatedRequest(url);
+    request.setPriority(toNetworkPriority(priority)); // Таймери моніторингу йдуть як Background
 
-    // 3. Відправляємо GET
-    QNetworkReply* reply = m_networkManager->get(request);
+    // 3. Відправляємо GET (дублікати, що вже "в польоті", об'єднуються)
+    QNetworkReply* reply = sendGet(request);
+    if (!reply) return; // Ідентичний запит уже виконується
 
     // 4. Підключаємо обробник
     connect(reply, &QNetworkReply::finished, this, &ApiClient::onDashboardDataReplyFinished);
@@ -1618,24 +1934,23 @@ void ApiClient::onDashboardDataReplyFinished()
     QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
     if (!reply) return;
 
-    // Використовуємо вашу існуючу функцію розбору відповіді
-    ApiError error = parseReply(reply);
+    ApiError error = parseReply(reply); // parseReply також підставляє тіло для 304
 
     if (reply->error() == QNetworkReply::NoError && error.httpStatusCode == 200)
     {
-        QJsonDocument doc = QJsonDocument::fromJson(error.responseBody);
-
-        // Перевіряємо, чи прийшов масив (бо дашборд повертає список)
-        if (doc.isArray()) {
-            emit dashboardDataFetched(doc.array());
-        } else {
-            error.errorString = "Invalid response from server: expected a JSON array.";
-            emit dashboardDataFetchFailed(error);
-        }
-    } else {
-        emit dashboardDataFetchFailed(error);
+        // Великі тіла розбираються поза GUI-потоком; reply звільняє decodeJson
+        decodeJson(reply, error.responseBody, [this, error](const QJsonDocument& doc) mutable {
+            if (doc.isArray()) {
+                emit dashboardDataFetched(doc.array());
+            } else {
+                error.errorString = "Invalid response from server: expected a JSON array.";
+                emit dashboardDataFetchFailed(error);
+            }
+        });
+        return;
     }
 
+    emit dashboardDataFetchFailed(error);
     reply->deleteLater();
 }
 
@@ -1671,7 +1986,7 @@ void ApiClient::syncClient(int clientId)
     });
 }
 
-void ApiClient::fetchStationPosData(int clientId, int terminalId, qint64 telegramId)
+ApiRequestHandle ApiClient::fetchStationPosData(int clientId, int terminalId, qint64 telegramId, RequestPriority priority)
 {
     // 1. Формуємо URL до нашого нового маршруту
     QString urlStr = QString("%1/api/clients/%2/station/%3/pos")
@@ -1691,9 +2006,12 @@ void ApiClient::fetchStationPosData(int clientId, int terminalId, qint64 telegra
         // Використовуємо хелпер для Bearer Token
         request = createAuthenticatedRequest(url);
     }
+    request.setPriority(toNetworkPriority(priority));
 
-    // 3. Відправляємо запит
-    QNetworkReply* reply = m_networkManager->get(request);
+    // 3. Відправляємо запит (telegramId — частина ключа, бо в Gandalf його немає в заголовках)
+    ApiRequestHandle handle;
+    QNetworkReply* reply = sendGet(request, QString::number(telegramId), &handle);
+    if (!reply) return handle; // Ідентичний запит уже виконується
 
     // 4. Зберігаємо контекст (щоб знати, кому відповідати)
     reply->setProperty("telegramId", telegramId);
@@ -1701,6 +2019,7 @@ void ApiClient::fetchStationPosData(int clientId, int terminalId, qint64 telegra
     reply->setProperty("terminalId", terminalId);
 
     connect(reply, &QNetworkReply::finished, this, &ApiClient::onStationPosDataReplyFinished);
+    return handle;
 }
 
 void ApiClient::onStationPosDataReplyFinished()
@@ -1733,7 +2052,7 @@ void ApiClient::onStationPosDataReplyFinished()
 }
 
 
-void ApiClient::fetchStationTanks(int clientId, int terminalId, qint64 telegramId)
+ApiRequestHandle ApiClient::fetchStationTanks(int clientId, int terminalId, qint64 telegramId, RequestPriority priority)
 {
     // 1. Формуємо URL: /api/clients/ID/station/ID/tanks
     QString urlStr = QString("%1/api/clients/%2/station/%3/tanks")
@@ -1750,8 +2069,11 @@ void ApiClient::fetchStationTanks(int clientId, int terminalId, qint64 telegramI
     } else {
         request = createAuthenticatedRequest(url);
     }
+    request.setPriority(toNetworkPriority(priority));
 
-    QNetworkReply* reply = m_networkManager->get(request);
+    ApiRequestHandle handle;
+    QNetworkReply* reply = sendGet(request, QString::number(telegramId), &handle);
+    if (!reply) return handle; // Ідентичний запит уже виконується
 
     // 3. Контекст
     reply->setProperty("telegramId", telegramId);
@@ -1759,6 +2081,7 @@ void ApiClient::fetchStationTanks(int clientId, int terminalId, qint64 telegramI
     reply->setProperty("terminalId", terminalId);
 
     connect(reply, &QNetworkReply::finished, this, &ApiClient::onStationTanksReplyFinished);
+    return handle;
 }
 
 void ApiClient::onStationTanksReplyFinished()
@@ -2247,13 +2570,16 @@ void ApiClient::searchStation(int terminalId)
     logInfo() << "ApiClient: Searching station for Terminal ID:" << terminalId;
 
     // 3. Відправляємо запит
-    QNetworkReply *reply = m_networkManager->get(request);
+    QNetworkReply *reply = sendGet(request);
+    if (!reply) return; // Ідентичний запит уже виконується
 
     // 4. Обробляємо відповідь
     connect(reply, &QNetworkReply::finished, this, [this, reply, terminalId]() {
+        // parseReply читає тіло один раз і підставляє збережене тіло для 304
+        ApiError error = parseReply(reply);
         if (reply->error() == QNetworkReply::NoError) {
             QList<StationStruct> results;
-            QByteArray responseData = reply->readAll();
+            const QByteArray& responseData = error.responseBody;
             QJsonDocument doc = QJsonDocument::fromJson(responseData);
 
             if (doc.isArray()) {
@@ -2279,8 +2605,6 @@ void ApiClient::searchStation(int terminalId)
 
             emit stationSearchFinished(results);
         } else {
-            // Використовуємо вашу функцію parseReply
-            ApiError error = parseReply(reply);
             logCritical() << "ApiClient: Station search failed."
                           << "Status:" << error.httpStatusCode
                           << "Error:" << error.errorString;
@@ -2293,30 +2617,100 @@ void ApiClient::searchStation(int terminalId)
 }
 
 
-void ApiClient::fetchObjectGeneralInfo(int objectId)
+void ApiClient::fetchStationCatalog(const QString &knownVersion)
+{
+    QUrl url(m_serverUrl + "/api/stations/catalog");
+    if (!knownVersion.isEmpty()) {
+        QUrlQuery query;
+        query.addQueryItem("version", knownVersion);
+        url.setQuery(query);
+    }
+
+    QNetworkRequest request = createAuthenticatedRequest(url);
+    // Довідник потрібен для пошуку, але користувач на нього не чекає
+    request.setPriority(toNetworkPriority(RequestPriority::Background));
+    QNetworkReply* reply = sendGet(request);
+    if (!reply) return; // Ідентичний запит уже виконується
+
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+        ApiError error = parseReply(reply);
+        if (reply->error() != QNetworkReply::NoError) {
+            logWarning() << "ApiClient: Station catalog fetch failed:" << error.errorString;
+            emit stationCatalogFetchFailed(error);
+            reply->deleteLater();
+            return;
+        }
+
+        // Повний довідник — тисячі записів, розбираємо поза GUI-потоком
+        decodeJson(reply, error.responseBody, [this, error](const QJsonDocument& doc) mutable {
+            const QJsonObject root = doc.object();
+            const QString version = root["version"].toString();
+            if (root["unchanged"].toBool()) {
+                emit stationCatalogUnchanged(version);
+            } else if (root.contains("stations")) {
+                emit stationCatalogFetched(version, root["stations"].toArray());
+            } else {
+                error.errorString = "Invalid response from server: 'stations' array not found.";
+                emit stationCatalogFetchFailed(error);
+            }
+        });
+    });
+}
+
+void ApiClient::fetchReferenceRevision()
+{
+    QNetworkRequest request = createAuthenticatedRequest(QUrl(m_serverUrl + "/api/reference/revision"));
+    // Від відповіді залежить, чи вантажити довідники заново — першим у черзі
+    request.setPriority(toNetworkPriority(RequestPriority::Interactive));
+    QNetworkReply* reply = sendGet(request);
+    if (!reply) return; // Ідентичний запит уже виконується
+
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+        ApiError error = parseReply(reply);
+        if (reply->error() == QNetworkReply::NoError) {
+            const QJsonObject root = QJsonDocument::fromJson(error.responseBody).object();
+            if (root.contains("revision")) {
+                emit referenceRevisionFetched(root["server_version"].toString(), root["revision"].toString());
+            } else {
+                error.errorString = "Invalid response from server: 'revision' not found.";
+                emit referenceRevisionFetchFailed(error);
+            }
+        } else {
+            emit referenceRevisionFetchFailed(error);
+        }
+        reply->deleteLater();
+    });
+}
+
+
+ApiRequestHandle ApiClient::fetchObjectGeneralInfo(int objectId, RequestPriority priority)
 {
     QString endpoint = QString("/api/objects/info?id=%1").arg(objectId);
     QNetworkRequest request = createAuthenticatedRequest(QUrl(m_serverUrl + endpoint));
+    request.setPriority(toNetworkPriority(priority));
 
-    QNetworkReply* reply = m_networkManager->get(request);
+    ApiRequestHandle handle;
+    QNetworkReply* reply = sendGet(request, QString(), &handle);
+    if (!reply) return handle; // Ідентичний запит уже виконується
 
     connect(reply, &QNetworkReply::finished, this, [this, reply, objectId]() {
+        ApiError error = parseReply(reply);
         if (reply->error() == QNetworkReply::NoError) {
-            QJsonDocument doc = QJsonDocument::fromJson(reply->readAll());
+            QJsonDocument doc = QJsonDocument::fromJson(error.responseBody);
             if (doc.isObject()) {
                 logInfo() << "ApiClient: Fetched general info for object" << objectId;
                 emit objectGeneralInfoFetched(objectId, doc.object());
             }
         } else {
-            ApiError error = parseReply(reply);
             logCritical() << "ApiClient: Failed to fetch general info for object" << objectId
                           << "Error:" << error.errorString;
         }
         reply->deleteLater();
     });
+    return handle;
 }
 
-void ApiClient::fetchStationDispensers(int clientId, int terminalId, qint64 telegramId)
+ApiRequestHandle ApiClient::fetchStationDispensers(int clientId, int terminalId, qint64 telegramId, RequestPriority priority)
 {
     QString urlStr = QString("%1/api/clients/%2/station/%3/dispensers")
     .arg(m_serverUrl)
@@ -2331,8 +2725,11 @@ void ApiClient::fetchStationDispensers(int clientId, int terminalId, qint64 tele
     } else {
         request = createAuthenticatedRequest(url);   // Якщо це Gandalf
     }
+    request.setPriority(toNetworkPriority(priority));
 
-    QNetworkReply* reply = m_networkManager->get(request);
+    ApiRequestHandle handle;
+    QNetworkReply* reply = sendGet(request, QString::number(telegramId), &handle);
+    if (!reply) return handle; // Ідентичний запит уже виконується
 
     // Використовуємо лямбду для обробки відповіді
     connect(reply, &QNetworkReply::finished, this, [this, reply, clientId, terminalId, telegramId]() {
@@ -2355,10 +2752,11 @@ void ApiClient::fetchStationDispensers(int clientId, int terminalId, qint64 tele
 
         reply->deleteLater();
     });
+    return handle;
 }
 
 
-void ApiClient::fetchStationWorkplaces(int clientId, int terminalId, qint64 telegramId)
+ApiRequestHandle ApiClient::fetchStationWorkplaces(int clientId, int terminalId, qint64 telegramId, RequestPriority priority)
 {
     QString urlStr = QString("%1/api/clients/%2/station/%3/workplaces")
     .arg(m_serverUrl).arg(clientId).arg(terminalId);
@@ -2370,13 +2768,75 @@ void ApiClient::fetchStationWorkplaces(int clientId, int terminalId, qint64 tele
     } else {
         request = createAuthenticatedRequest(url);
     }
+    request.setPriority(toNetworkPriority(priority));
 
-    QNetworkReply* reply = m_networkManager->get(request);
+    ApiRequestHandle handle;
+    QNetworkReply* reply = sendGet(request, QString::number(telegramId), &handle);
+    if (!reply) return handle; // Ідентичний запит уже виконується
     reply->setProperty("telegramId", telegramId);
     reply->setProperty("clientId", clientId);
     reply->setProperty("terminalId", terminalId);
 
     connect(reply, &QNetworkReply::finished, this, &ApiClient::onStationWorkplacesReplyFinished);
+    return handle;
+}
+
+void ApiClient::fetchClientWorkplaces(int clientId, int terminalId)
+{
+    QUrl url(m_serverUrl + QString("/api/clients/%1/workplaces").arg(clientId));
+    if (terminalId > 0) {
+        QUrlQuery query;
+        query.addQueryItem("terminal", QString::number(terminalId));
+        url.setQuery(query);
+    }
+    QNetworkRequest request = createAuthenticatedRequest(url);
+    QNetworkReply* reply = sendGet(request);
+    if (!reply) return; // Ідентичний запит уже виконується
+
+    connect(reply, &QNetworkReply::finished, this, [this, reply, clientId, terminalId]() {
+        ApiError error = parseReply(reply);
+        if (reply->error() == QNetworkReply::NoError) {
+            emit clientWorkplacesReceived(clientId, terminalId, QJsonDocument::fromJson(error.responseBody).array());
+        } else {
+            emit clientWorkplacesFailed(clientId, terminalId, error);
+        }
+        reply->deleteLater();
+    });
+}
+
+void ApiClient::fetchReachability(int clientId)
+{
+    QUrl url(m_serverUrl + QString("/api/clients/%1/reachability").arg(clientId));
+    QNetworkRequest request = createAuthenticatedRequest(url);
+    QNetworkReply* reply = sendGet(request);
+    if (!reply) return; // Ідентичний запит уже виконується
+
+    connect(reply, &QNetworkReply::finished, this, [this, reply, clientId]() {
+        ApiError error = parseReply(reply);
+        if (reply->error() == QNetworkReply::NoError) {
+            emit reachabilityFetched(clientId, QJsonDocument::fromJson(error.responseBody).array());
+        } else {
+            logWarning() << "ApiClient: Failed to fetch reachability cache:" << error.errorString;
+        }
+        reply->deleteLater();
+    });
+}
+
+void ApiClient::reportReachability(int clientId, const QJsonArray &results)
+{
+    if (results.isEmpty()) return;
+
+    QUrl url(m_serverUrl + QString("/api/clients/%1/reachability").arg(clientId));
+    QNetworkRequest request = createAuthenticatedRequest(url);
+    request.setPriority(toNetworkPriority(RequestPriority::Background));
+    QNetworkReply* reply = m_networkManager->post(request, QJsonDocument(results).toJson(QJsonDocument::Compact));
+
+    connect(reply, &QNetworkReply::finished, this, [reply]() {
+        if (reply->error() != QNetworkReply::NoError) {
+            logWarning() << "ApiClient: Failed to report reachability:" << reply->errorString();
+        }
+        reply->deleteLater();
+    });
 }
 
 void ApiClient::onStationWorkplacesReplyFinished()
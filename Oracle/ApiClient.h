@@ -3,14 +3,19 @@
 
 
 #include "StationStruct.h"
+#include "ApiRequest.h"
 
 #include <QObject>
 #include <QString>
 #include <QJsonArray>
 #include <QJsonObject>
+#include <QJsonDocument>
 #include <QHttpMultiPart>
 #include <QHttpPart>
 #include <QFile>
+#include <QHash>
+#include <QUrlQuery>
+#include <functional>
 
 class QNetworkAccessManager;
 class QNetworkReply;
@@ -23,11 +28,21 @@ struct ApiError {
     QString requestUrl;             // URL, на який йшов запит
     QString errorString;            // Текстовий опис помилки
     QByteArray responseBody;        // Тіло відповіді від сервера (може містити JSON з деталями)
+    QString requestId;              // X-Request-ID: за ним запит шукається в логах і трасах Conduit
 };
 Q_DECLARE_METATYPE(ApiError)
 
 ApiError parseReply(QNetworkReply* reply);
 
+// Статистика декодування JSON у GUI-потоці (для діагностики "фризів")
+struct JsonDecodeStats {
+    int syncDecodes = 0;        // Розібрано прямо в GUI-потоці (малі тіла)
+    int asyncDecodes = 0;       // Розібрано у фоновому потоці (великі тіла)
+    int droppedResults = 0;     // Результати скасованих / застарілих запитів
+    qint64 uiStallTotalMs = 0;  // Сумарний час, який GUI-потік провів у розборі + обробці сигналу
+    qint64 uiStallMaxMs = 0;    // Найдовша окрема затримка
+};
+
 class ApiClient : public QObject
 {
     Q_OBJECT
@@ -35,6 +50,14 @@ public:
     static ApiClient& instance();
     // --- НОВИЙ СЕТТЕР ДЛЯ БОТА ---
     void setBotApiKey(const QString& key);
+    /**
+     * @brief Формує авторизований запит для WebSocket-каналу подій (ws:// або wss://).
+     * @param path Шлях на сервері, напр. "/api/events/sync".
+     */
+    QNetworkRequest createEventStreamRequest(const QString& path);
+
+    // Статистика декодування JSON / затримок GUI-потоку
+    JsonDecodeStats decodeStats() const { return m_decodeStats; }
     // Методи для виклику API
     void login(const QString& username);
     void fetchAllUsers();
@@ -50,9 +73,19 @@ public:
     void fetchSettings(const QString& appName);
     void updateSettings(const QString& appName, const QVariantMap& settings);
     void syncClientObjects(int clientId);
-    void fetchSyncStatus(int clientId);
+    void fetchSyncStatus(int clientId, RequestPriority priority = RequestPriority::Normal);
     void fetchObjects(const QVariantMap& filters = {});
+    // Посторінкове завантаження: limit рядків, починаючи з offset
+    void fetchObjectsPage(const QVariantMap& filters, int offset, int limit);
     void fetchRegionsList();
+
+    // Відповідь одного запиту пакета: статус (error.httpStatusCode), текст помилки для 4xx/5xx і тіло
+    using BatchCallback = std::function<void(const ApiError& error, const QJsonValue& body)>;
+    /**
+     * @brief Пакетний GET: запити, поставлені за один прохід циклу подій, ідуть одним POST /api/batch.
+     * Однакові запити в пакеті об'єднуються; якщо запит у пакеті один — це звичайний GET.
+     */
+    void batchGet(const QString& path, const QUrlQuery& query, const BatchCallback& callback);
     // метод для встановлення URL:
     void setServerUrl(const QString& url);
     // метод для реєстрації:
@@ -82,17 +115,20 @@ public:
     void saveExportTask(const QJsonObject& taskData); // Використовується як для створення (ID=-1), так і для оновлення
 
     // Запит даних для моніторингу
-    void fetchDashboardData();
+    void fetchDashboardData(RequestPriority priority = RequestPriority::Normal);
 
     // Команда на запуск синхронізації
     void syncClient(int clientId);
 
     // Запит на отримання даних РРО (POS)
     // telegramId = 0 за замовчуванням (для Gandalf)
-    void fetchStationPosData(int clientId, int terminalId, qint64 telegramId = 0);
+    // Повертає дескриптор, яким вкладка може скасувати запит
+    ApiRequestHandle fetchStationPosData(int clientId, int terminalId, qint64 telegramId = 0,
+                                         RequestPriority priority = RequestPriority::Normal);
 
     // Запит на отримання резервуарів
-    void fetchStationTanks(int clientId, int terminalId, qint64 telegramId = 0);
+    ApiRequestHandle fetchStationTanks(int clientId, int terminalId, qint64 telegramId = 0,
+                                       RequestPriority priority = RequestPriority::Normal);
 
     void fetchDispenserConfig(int clientId, int terminalId, qint64 telegramId = 0);
 
@@ -148,12 +184,29 @@ public:
  */
     void searchStation(int terminalId);
 
-    void fetchObjectGeneralInfo(int objectId);
+    /**
+     * @brief Завантажує довідник АЗС для локального пошуку.
+     * @param knownVersion Версія, яка вже є локально (сервер відповість "unchanged", якщо вона актуальна)
+     */
+    void fetchStationCatalog(const QString& knownVersion);
+    // Версія сервера та ревізія довідкових даних (для валідації локального кешу Gandalf)
+    void fetchReferenceRevision();
+
+    ApiRequestHandle fetchObjectGeneralInfo(int objectId, RequestPriority priority = RequestPriority::Normal);
 
     // Запит конфігурації ПРК (колонок)
-    void fetchStationDispensers(int clientId, int terminalId, qint64 telegramId = 0);
+    ApiRequestHandle fetchStationDispensers(int clientId, int terminalId, qint64 telegramId = 0,
+                                            RequestPriority priority = RequestPriority::Normal);
+
+    ApiRequestHandle fetchStationWorkplaces(int clientId, int terminalId, qint64 telegramId = 0,
+                                            RequestPriority priority = RequestPriority::Normal);
 
-    void fetchStationWorkplaces(int clientId, int terminalId, qint64 telegramId = 0);
+    // Каси клієнта для масової перевірки доступності (terminalId > 0 — лише однієї АЗС)
+    void fetchClientWorkplaces(int clientId, int terminalId = 0);
+    // Останній відомий стан доступності кас клієнта (кеш Conduit)
+    void fetchReachability(int clientId);
+    // Надсилає результати сканування в кеш Conduit (відповідь не очікуємо)
+    void reportReachability(int clientId, const QJsonArray& results);
 
 signals:
     // Сигнали для логіну
@@ -198,6 +251,8 @@ signals:
 
     // Додайте в signals секцію
     void settingsFetched(const QVariantMap& settings);
+    // Те саме з назвою групи — для паралельних запитів кількох груп налаштувань
+    void scopedSettingsFetched(const QString& appName, const QVariantMap& settings);
     void settingsFetchFailed(const ApiError& error);
 
     void settingsUpdateSuccess();
@@ -209,6 +264,8 @@ signals:
     void syncStatusFetchFailed(int clientId, const ApiError& error);
 
     void objectsFetched(const QJsonArray& objects);
+    // filters — ті самі, що були передані у fetchObjectsPage (щоб відкинути застарілі сторінки)
+    void objectsPageFetched(const QVariantMap& filters, int offset, const QJsonArray& objects, bool hasMore);
     void objectsFetchFailed(const ApiError& error);
 
     void regionsListFetched(const QStringList& regions);
@@ -318,6 +375,13 @@ signals:
  */
     void stationSearchFinished(const QList<StationStruct>& stations);
 
+    void stationCatalogFetched(const QString& version, const QJsonArray& stations);
+    void stationCatalogUnchanged(const QString& version);
+    void stationCatalogFetchFailed(const ApiError& error);
+
+    void referenceRevisionFetched(const QString& serverVersion, const QString& revision);
+    void referenceRevisionFetchFailed(const ApiError& error);
+
     void objectGeneralInfoFetched(int objectId, const QJsonObject &data);
 
     // Сигнал, який випускається, коли прийшли дані про ПРК
@@ -327,6 +391,10 @@ signals:
     void stationWorkplacesReceived(const QJsonArray& data, int clientId, int terminalId, qint64 telegramId);
     void stationWorkplacesFailed(const ApiError& error, int clientId, int terminalId, qint64 telegramId);
 
+    void clientWorkplacesReceived(int clientId, int terminalId, const QJsonArray& workplaces);
+    void clientWorkplacesFailed(int clientId, int terminalId, const ApiError& error);
+    void reachabilityFetched(int clientId, const QJsonArray& entries);
+
 
 
 private slots:
@@ -335,10 +403,8 @@ private slots:
     void onUserDetailsReplyFinished();
     void onRolesReplyFinished();
     void onUserUpdateReplyFinished();
-    void onClientsReplyFinished();
     void onCreateClientReplyFinished();
     void onClientDetailsReplyFinished();
-    void onIpGenMethodsReplyFinished();
     void onConnectionTestReplyFinished();
     void onClientUpdateReplyFinished();
     void onSettingsReplyFinished();
@@ -346,7 +412,7 @@ private slots:
     void onSyncReplyFinished();
     void onSyncStatusReplyFinished();
     void onObjectsReplyFinished();
-    void onRegionsListReplyFinished();
+    void onObjectsPageReplyFinished();
     void onBotRegisterReplyFinished();
     void onBotRequestsReplyFinished();
     void onBotRequestRejectReplyFinished();
@@ -404,8 +470,66 @@ private:
 
     QNetworkRequest createAuthenticatedRequest(const QUrl &url);
 
+    /**
+     * @brief Відправляє GET-запит з об'єднанням ідентичних запитів "у польоті".
+     * Ключ запиту: метод + URL + ідентичність (Authorization, X-Bot-Token, X-Telegram-ID)
+     * + додатковий контекст, який не потрапляє в заголовки (напр. telegramId у Gandalf).
+     * @return Новий reply, або nullptr, якщо такий самий запит уже виконується.
+     * У цьому випадку викликач просто виходить: результат отримають усі підписники
+     * через той самий broadcast-сигнал, а JSON буде розібрано лише один раз.
+     * @param handle Якщо задано — отримує дескриптор скасування (і для нового, і для спільного reply).
+     */
+    QNetworkReply* sendGet(const QNetworkRequest& request, const QString& context = QString(),
+                           ApiRequestHandle* handle = nullptr);
+    QString inFlightKey(const QByteArray& verb, const QNetworkRequest& request, const QString& context) const;
+
+    /**
+     * @brief Оновлює кеш валідаторів після завершення GET-запиту.
+     * 200 + ETag — зберігає тіло відповіді; 304 — кладе збережене тіло у властивість
+     * reply "cachedBody", звідки його забирає parseReply().
+     */
+    void applyValidatorCache(const QString& key, QNetworkReply* reply);
+
+    /**
+     * @brief Етап декодування JSON. Тіла, більші за поріг (Global/JsonAsyncDecodeThresholdKb),
+     * розбираються у QThreadPool, а результат повертається в GUI-потік через чергу подій.
+     * Результат відкидається, якщо reply вже видалено, позначено "cancelled",
+     * або для того самого ключа запиту вже відправлено новіший запит.
+     * Після onDecoded reply звільняється тут (deleteLater) — викликач цього не робить.
+     */
+    void decodeJson(QNetworkReply* reply, const QByteArray& body,
+                    const std::function<void(const QJsonDocument&)>& onDecoded);
+    void recordUiStall(const QString& url, qint64 elapsedMs);
+
+    struct BatchItem {
+        QString path;
+        QUrlQuery query;
+        QList<BatchCallback> callbacks;
+    };
+    // Відправляє накопичений пакет (QTimer::singleShot(0) з batchGet)
+    void flushBatch();
+    // Пакет з одного запиту — звичайний sendGet (об'єднання з таким самим запитом у польоті, ETag)
+    void sendBatchItem(const BatchItem& item);
+    QUrl batchItemUrl(const BatchItem& item) const;
+    static void deliverBatchItem(const BatchItem& item, const ApiError& error, const QJsonValue& body);
+    static QJsonValue jsonBodyValue(const QJsonDocument& doc);
+
 
     QNetworkAccessManager* m_networkManager;
+    QHash<QString, QNetworkReply*> m_inFlight; // Ключ запиту -> reply, що ще виконується
+    QHash<QString, quint64> m_latestSerial;    // Ключ запиту -> номер останнього запиту, поки той не завершився
+    quint64 m_requestSerial = 0;
+    JsonDecodeStats m_decodeStats;
+
+    // Кеш для умовних GET (If-None-Match / 304)
+    struct CachedValidator {
+        QByteArray etag;
+        QByteArray body;
+    };
+    QHash<QString, CachedValidator> m_validatorCache;
+
+    // Запити batchGet, що чекають на кінець поточного проходу циклу подій
+    QList<BatchItem> m_pendingBatch;
     QString m_serverUrl;
     QString m_authToken;
     QString m_botApiKey;
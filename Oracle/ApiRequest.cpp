@@ -0,0 +1,71 @@
+#include "ApiRequest.h"
+#include "Logger.h"
+#include <QNetworkReply>
+
+QNetworkRequest::Priority toNetworkPriority(RequestPriority priority)
+{
+    switch (priority) {
+    case RequestPriority::Interactive: return QNetworkRequest::HighPriority;
+    case RequestPriority::Background:  return QNetworkRequest::LowPriority;
+    case RequestPriority::Normal:      break;
+    }
+    return QNetworkRequest::NormalPriority;
+}
+
+ApiRequestHandle::ApiRequestHandle(QNetworkReply* reply)
+    : m_reply(reply), m_released(std::make_shared<bool>(false))
+{
+}
+
+bool ApiRequestHandle::isRunning() const
+{
+    return m_reply && m_reply->isRunning() && !*m_released;
+}
+
+void ApiRequestHandle::cancel()
+{
+    if (!m_reply || *m_released) return;
+    *m_released = true;
+
+    // Reply може ділитися між кількома викликачами (див. ApiClient::sendGet)
+    const int waiters = m_reply->property("waiters").toInt() - 1;
+    m_reply->setProperty("waiters", waiters);
+    if (waiters > 0) return;
+
+    if (!m_reply->isFinished()) {
+        logDebug() << "ApiRequest: Cancelling" << m_reply->request().url().toString();
+    }
+
+    // Позначаємо та від'єднуємо обробники, щоб abort() не породив сигналів про помилку.
+    // Реєстр "у польоті" очиститься через сигнал destroyed.
+    m_reply->setProperty("cancelled", true);
+    QObject::disconnect(m_reply, &QNetworkReply::finished, nullptr, nullptr);
+    m_reply->abort();
+    m_reply->deleteLater();
+}
+
+ApiRequestGroup::ApiRequestGroup(QObject* parent) : QObject(parent)
+{
+}
+
+ApiRequestGroup::~ApiRequestGroup()
+{
+    cancelAll();
+}
+
+void ApiRequestGroup::add(const ApiRequestHandle& handle)
+{
+    if (!handle.isValid()) return;
+
+    // Прибираємо вже завершені, щоб група не росла безмежно
+    m_handles.removeIf([](const ApiRequestHandle& h) { return !h.isValid(); });
+    m_handles.append(handle);
+}
+
+void ApiRequestGroup::cancelAll()
+{
+    for (ApiRequestHandle& handle : m_handles) {
+        handle.cancel();
+    }
+    m_handles.clear();
+}
@@ -0,0 +1,66 @@
+#ifndef APIREQUEST_H
+#define APIREQUEST_H
+
+#include <QObject>
+#include <QPointer>
+#include <QList>
+#include <QNetworkRequest>
+#include <memory>
+
+class QNetworkReply;
+
+/**
+ * @brief Пріоритет запиту до API.
+ * Interactive — те, на що користувач чекає прямо зараз (відкрита вкладка АЗС);
+ * Background — періодичні оновлення (таймери моніторингу, автосинхронізація).
+ */
+enum class RequestPriority {
+    Interactive,
+    Normal,
+    Background
+};
+
+// Відображення на пріоритет черги QNetworkAccessManager
+QNetworkRequest::Priority toNetworkPriority(RequestPriority priority);
+
+/**
+ * @brief Дескриптор запиту, який можна скасувати.
+ *
+ * Кілька однакових запитів можуть ділити один reply (об'єднання в ApiClient::sendGet),
+ * тому cancel() лише "відпускає" свою частку: reply переривається, коли його
+ * відпустили всі власники. Скасований reply не доходить до обробників ApiClient.
+ */
+class ApiRequestHandle
+{
+public:
+    ApiRequestHandle() = default;
+    explicit ApiRequestHandle(QNetworkReply* reply);
+
+    bool isValid() const { return !m_reply.isNull(); }
+    bool isRunning() const;
+    void cancel();
+
+private:
+    QPointer<QNetworkReply> m_reply;
+    std::shared_ptr<bool> m_released; // Спільний для копій дескриптора: відпускаємо лише раз
+};
+
+/**
+ * @brief Група запитів, прив'язана до часу життя віджета (parent).
+ * При знищенні батька (напр. закриття вкладки АЗС) усі незавершені запити скасовуються.
+ */
+class ApiRequestGroup : public QObject
+{
+    Q_OBJECT
+public:
+    explicit ApiRequestGroup(QObject* parent = nullptr);
+    ~ApiRequestGroup() override;
+
+    void add(const ApiRequestHandle& handle);
+    void cancelAll();
+
+private:
+    QList<ApiRequestHandle> m_handles;
+};
+
+#endif // APIREQUEST_H
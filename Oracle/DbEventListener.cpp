@@ -0,0 +1,251 @@
+#include "DbEventListener.h"
+#include "AppParams.h"
+#include "Logger.h"
+#include "Metrics.h"
+
+#include <QSqlError>
+#include <QSqlQuery>
+
+namespace {
+
+const char* const kConnectionName = "db_events";
+
+struct EventInfo {
+    DbEventListener::Table table;
+    const char* tableName;
+    const char* eventName;
+};
+
+const EventInfo kEvents[] = {
+    {DbEventListener::Users,       "USERS",        "WT_USERS_CHANGED"},
+    {DbEventListener::Clients,     "CLIENTS",      "WT_CLIENTS_CHANGED"},
+    {DbEventListener::Objects,     "OBJECTS",      "WT_OBJECTS_CHANGED"},
+    {DbEventListener::SyncStatus,  "SYNC_STATUS",  "WT_SYNC_STATUS_CHANGED"},
+    {DbEventListener::ExportTasks, "EXPORT_TASKS", "WT_EXPORT_TASKS_CHANGED"},
+    {DbEventListener::Settings,    "APP_SETTINGS", "WT_APP_SETTINGS_CHANGED"},
+};
+
+DbEventListener::Tables allTables()
+{
+    DbEventListener::Tables tables;
+    for (const EventInfo& info : kEvents) tables |= info.table;
+    return tables;
+}
+
+}
+
+DbEventListener& DbEventListener::instance()
+{
+    static DbEventListener self;
+    return self;
+}
+
+DbEventListener::DbEventListener(QObject *parent)
+    : QObject(parent)
+{
+    m_coalesceTimer.setSingleShot(true);
+    m_coalesceTimer.setInterval(qMax(0, AppParams::instance().getParam("Global", "DbEventsCoalesceMs", 250).toInt()));
+    connect(&m_coalesceTimer, &QTimer::timeout, this, &DbEventListener::flush);
+
+    m_checkTimer.setInterval(qMax(5, AppParams::instance().getParam("Global", "DbEventsCheckSec", 60).toInt()) * 1000);
+    connect(&m_checkTimer, &QTimer::timeout, this, &DbEventListener::checkConnection);
+}
+
+DbEventListener::~DbEventListener()
+{
+    closeConnection();
+}
+
+QStringList DbEventListener::triggerDdl()
+{
+    QStringList ddl;
+    for (const EventInfo& info : kEvents) {
+        ddl << QString("CREATE OR ALTER TRIGGER WT_%1_EVENTS FOR %1 ACTIVE AFTER INSERT OR UPDATE OR DELETE POSITION 100 "
+                       "AS BEGIN POST_EVENT '%2'; END")
+                   .arg(QString::fromLatin1(info.tableName), QString::fromLatin1(info.eventName));
+    }
+    return ddl;
+}
+
+bool DbEventListener::openConnection()
+{
+    if (!QSqlDatabase::contains(kConnectionName)) {
+        if (!QSqlDatabase::contains(QSqlDatabase::defaultConnection)) {
+            logWarning() << "DbEventListener: Main database connection is not configured.";
+            return false;
+        }
+        // Ті самі параметри, що й у DbManager, але окреме з'єднання
+        m_db = QSqlDatabase::cloneDatabase(QSqlDatabase::defaultConnection, kConnectionName);
+    } else if (!m_db.isValid()) {
+        m_db = QSqlDatabase::database(kConnectionName, false);
+    }
+
+    if (!m_db.isOpen() && !m_db.open()) {
+        logWarning() << "DbEventListener: Failed to open events connection:" << m_db.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+void DbEventListener::closeConnection()
+{
+    m_listening = false;
+    if (!m_db.isValid()) return;
+
+    if (m_db.isOpen()) {
+        QSqlDriver* driver = m_db.driver();
+        for (const QString& name : driver->subscribedToNotifications()) {
+            driver->unsubscribeFromNotification(name);
+        }
+        m_db.close();
+    }
+}
+
+bool DbEventListener::start()
+{
+    if (m_listening) return true;
+    m_checkTimer.start();
+
+    if (!openConnection()) {
+        m_wasInterrupted = true;
+        return false;
+    }
+
+    QSqlDriver* driver = m_db.driver();
+    if (!driver->hasFeature(QSqlDriver::EventNotifications)) {
+        logWarning() << "DbEventListener: SQL driver does not support event notifications; listener disabled.";
+        m_checkTimer.stop();
+        closeConnection();
+        return false;
+    }
+
+    if (AppParams::instance().getParam("Global", "DbEventsInstallTriggers", false).toBool()) {
+        installTriggers();
+    } else if (!m_triggersChecked) {
+        m_triggersChecked = true;
+        warnMissingTriggers();
+    }
+
+    connect(driver, &QSqlDriver::notification, this, &DbEventListener::onNotification, Qt::UniqueConnection);
+    for (const EventInfo& info : kEvents) {
+        if (!driver->subscribeToNotification(QString::fromLatin1(info.eventName))) {
+            logWarning() << "DbEventListener: Failed to subscribe to" << info.eventName << ":" << driver->lastError().text();
+            closeConnection();
+            m_wasInterrupted = true;
+            return false;
+        }
+    }
+
+    m_listening = true;
+    logInfo() << "DbEventListener: Listening for database change events.";
+
+    // Поки підписки не було, зміни могли пройти непоміченими
+    if (m_wasInterrupted) {
+        m_wasInterrupted = false;
+        markChanged(allTables());
+    }
+    return true;
+}
+
+void DbEventListener::stop()
+{
+    m_checkTimer.stop();
+    m_coalesceTimer.stop();
+    m_pending = {};
+    closeConnection();
+}
+
+bool DbEventListener::installTriggers()
+{
+    if (!openConnection()) return false;
+
+    bool ok = true;
+    QSqlQuery query(m_db);
+    for (const QString& ddl : triggerDdl()) {
+        if (!query.exec(ddl)) {
+            logCritical() << "DbEventListener: Failed to install trigger:" << query.lastError().text();
+            ok = false;
+        }
+    }
+    if (ok) logInfo() << "DbEventListener: Change-event triggers are installed.";
+    return ok;
+}
+
+void DbEventListener::warnMissingTriggers()
+{
+    // Без тригерів підписка мовчить: кеші житимуть лише за TTL, і ніщо про це не скаже
+    QSqlQuery query(m_db);
+    if (!query.exec("SELECT TRIM(RDB$TRIGGER_NAME) FROM RDB$TRIGGERS "
+                    "WHERE RDB$TRIGGER_NAME STARTING WITH 'WT_' AND RDB$TRIGGER_INACTIVE = 0")) {
+        logWarning() << "DbEventListener: Cannot check change-event triggers:" << query.lastError().text();
+        return;
+    }
+    QStringList installed;
+    while (query.next()) installed << query.value(0).toString();
+
+    QStringList missing;
+    for (const EventInfo& info : kEvents) {
+        if (!installed.contains(QString("WT_%1_EVENTS").arg(QString::fromLatin1(info.tableName)))) {
+            missing << QString::fromLatin1(info.tableName);
+        }
+    }
+    if (!missing.isEmpty()) {
+        logWarning() << "DbEventListener: Change-event triggers are missing for" << missing.join(", ")
+                     << "- changes made outside this server will not reach the caches."
+                     << "Set Global/DbEventsInstallTriggers=true or apply DbEventListener::triggerDdl().";
+    }
+}
+
+void DbEventListener::onNotification(const QString &name, QSqlDriver::NotificationSource source, const QVariant &payload)
+{
+    Q_UNUSED(source);
+    Q_UNUSED(payload);
+
+    for (const EventInfo& info : kEvents) {
+        if (name == QLatin1String(info.eventName)) {
+            MetricsRegistry::instance().counter("oracle_db_events_total", "Database change events received by table.",
+                                                {{"table", QString::fromLatin1(info.tableName)}}).inc();
+            markChanged(info.table);
+            return;
+        }
+    }
+}
+
+void DbEventListener::markChanged(Tables tables)
+{
+    m_pending |= tables;
+    // Вікно відкривається першою подією і не подовжується: потік подій не відкладає сигнал безкінечно
+    if (!m_coalesceTimer.isActive()) m_coalesceTimer.start();
+}
+
+void DbEventListener::flush()
+{
+    const Tables tables = m_pending;
+    m_pending = {};
+    if (!tables) return;
+
+    logDebug() << "DbEventListener: Tables changed:" << tables;
+    if (tables.testFlag(Users)) emit usersChanged();
+    if (tables.testFlag(Clients)) emit clientsChanged();
+    if (tables.testFlag(Objects)) emit objectsChanged();
+    if (tables.testFlag(SyncStatus)) emit syncStatusChanged();
+    if (tables.testFlag(ExportTasks)) emit exportTasksChanged();
+    if (tables.testFlag(Settings)) emit settingsChanged();
+    emit tablesChanged(tables);
+}
+
+void DbEventListener::checkConnection()
+{
+    if (!m_listening) {
+        start();
+        return;
+    }
+
+    QSqlQuery ping(m_db);
+    if (!ping.exec("SELECT 1 FROM RDB$DATABASE")) {
+        logWarning() << "DbEventListener: Events connection lost:" << ping.lastError().text() << "- reconnecting.";
+        closeConnection();
+        m_wasInterrupted = true;
+        start();
+    }
+}
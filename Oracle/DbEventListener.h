@@ -0,0 +1,91 @@
+#ifndef DBEVENTLISTENER_H
+#define DBEVENTLISTENER_H
+
+#include <QObject>
+#include <QSqlDatabase>
+#include <QSqlDriver>
+#include <QStringList>
+#include <QTimer>
+
+/**
+ * @brief Слухач подій Firebird (POST_EVENT): зміни в USERS, CLIENTS, OBJECTS, SYNC_STATUS,
+ * EXPORT_TASKS та APP_SETTINGS, зроблені будь-ким — іншим екземпляром Conduit, Exporter, ручним SQL.
+ *
+ * Тригери (triggerDdl()) після кожного INSERT/UPDATE/DELETE викликають POST_EVENT 'WT_<TABLE>_CHANGED';
+ * Firebird доставляє подію після коміту. Слухач тримає окреме з'єднання (клон з'єднання DbManager),
+ * щоб не займати основне, і перетворює події на типізовані сигнали.
+ *
+ * Події одного типу за вікно коалесценції зливаються в один сигнал: масовий імпорт OBJECTS
+ * дає одне скидання кешу, а не тисячі. Якщо з'єднання втрачено, слухач перепідключається і
+ * надсилає сигнали для всіх таблиць — події за час розриву могли загубитися.
+ *
+ * Налаштування (Global): DbEventsCoalesceMs (250), DbEventsCheckSec (60) — перевірка з'єднання
+ * та повторна спроба підписки, DbEventsInstallTriggers (false) — створити тригери при старті;
+ * інакше при старті перевіряється, що тригери є, і для відсутніх пишеться попередження.
+ */
+class DbEventListener : public QObject
+{
+    Q_OBJECT
+public:
+    enum Table {
+        Users       = 0x01,
+        Clients     = 0x02,
+        Objects     = 0x04,
+        SyncStatus  = 0x08,
+        ExportTasks = 0x10,
+        Settings    = 0x20
+    };
+    Q_DECLARE_FLAGS(Tables, Table)
+
+    static DbEventListener& instance();
+
+    // Підписується на події; false — не вдалося (буде повторна спроба за таймером)
+    bool start();
+    void stop();
+    bool isListening() const { return m_listening; }
+
+    // CREATE OR ALTER TRIGGER ... POST_EVENT для кожної таблиці (ідемпотентні)
+    static QStringList triggerDdl();
+    bool installTriggers();
+    // Попередження в лог, якщо тригерів WT_<TABLE>_EVENTS немає або вони вимкнені
+    void warnMissingTriggers();
+
+signals:
+    void usersChanged();
+    void clientsChanged();
+    void objectsChanged();
+    void syncStatusChanged();
+    void exportTasksChanged();
+    void settingsChanged();
+    // Усі таблиці, що змінились за вікно коалесценції (після типізованих сигналів)
+    void tablesChanged(DbEventListener::Tables tables);
+
+private slots:
+    void onNotification(const QString& name, QSqlDriver::NotificationSource source, const QVariant& payload);
+    void flush();
+    void checkConnection();
+
+private:
+    explicit DbEventListener(QObject* parent = nullptr);
+    ~DbEventListener() override;
+
+    DbEventListener(const DbEventListener&) = delete;
+    DbEventListener& operator=(const DbEventListener&) = delete;
+
+    bool openConnection();
+    void closeConnection();
+    void markChanged(Tables tables);
+
+private:
+    QSqlDatabase m_db;
+    QTimer m_coalesceTimer;
+    QTimer m_checkTimer;
+    Tables m_pending;
+    bool m_listening = false;
+    bool m_wasInterrupted = false; // Підписка була втрачена — після відновлення скидаємо все
+    bool m_triggersChecked = false; // Наявність тригерів перевіряємо один раз (start() повторюється при реконекті)
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(DbEventListener::Tables)
+
+#endif // DBEVENTLISTENER_H
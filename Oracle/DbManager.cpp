@@ -3,7 +3,12 @@
 #include "Logger.h"
 #include "User.h"
 #include "criptpass.h"
+#include "SecretCache.h"
 #include "WorkplaceGeneratorFactory.h"
+#include "SyncEventBus.h"
+#include "Metrics.h"
+#include "Tracing.h"
+#include "ReferenceResponseCache.h"
 
 #include <QSqlError>
 #include <QSqlQuery>
@@ -16,6 +21,46 @@
 #include <QJsonDocument>
 #include <QSqlRecord>
 #include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QScopeGuard>
+
+namespace {
+
+// Час виконання методу DbManager: oracle_db_query_duration_seconds{method}
+Histogram& dbQueryHistogram(const char* method)
+{
+    return MetricsRegistry::instance().histogram("oracle_db_query_duration_seconds",
+                                                 "Duration of DbManager calls by method.",
+                                                 {{"method", QString::fromLatin1(method)}});
+}
+
+// Виклик методу DbManager: метрика часу + відрізок db.<method> у трасі запиту
+class DbCallScope
+{
+public:
+    explicit DbCallScope(const char* method) : m_timer(dbQueryHistogram(method)), m_span("db", method) {}
+
+private:
+    MetricsTimer m_timer;
+    TraceSpan m_span;
+};
+
+// Очікування на m_dbMutex (з'єднання одне, тож це і є "черга" до БД)
+Histogram& dbLockWaitHistogram()
+{
+    static Histogram& histogram = MetricsRegistry::instance().histogram(
+        "oracle_db_lock_wait_seconds", "Time spent waiting for the shared database connection.");
+    return histogram;
+}
+
+// Рядки, записані синхронізацією в таблицю: oracle_sync_table_rows_total{table}
+void countSyncedRows(const QString& table, qsizetype rows)
+{
+    MetricsRegistry::instance().counter("oracle_sync_table_rows_total", "Rows written by client sync by table.",
+                                        {{"table", table}}).inc(quint64(rows));
+}
+
+}
 
 
 DbManager& DbManager::instance()
@@ -25,6 +70,9 @@ DbManager& DbManager::instance()
 }
 
 DbManager::DbManager()
+    : m_catalogRevision(0)
+    , m_catalogEpoch(QString::number(QDateTime::currentMSecsSinceEpoch(), 36))
+    , m_referenceRevision(0)
 {
     // QSqlDatabase::addDatabase() створює з'єднання з унікальним іменем
     // Ми будемо використовувати з'єднання за замовчуванням
@@ -73,6 +121,7 @@ QString DbManager::lastError() const
 // Додайте цю функцію в кінець файлу DbManager.cpp
 QVariantMap DbManager::loadSettings(const QString& appName)
 {
+    DbCallScope dbCall(__func__);
     QVariantMap settings;
     if (!isConnected()) {
         logCritical() << "Cannot load app settings: no database connection.";
@@ -101,6 +150,7 @@ QVariantMap DbManager::loadSettings(const QString& appName)
 
 int DbManager::getOrCreateUser(const QString& login, bool& ok)
 {
+    DbCallScope dbCall(__func__);
     ok = false;
     if (!isConnected()) {
         logCritical() << "Cannot get/create user: no DB connection";
@@ -125,6 +175,7 @@ int DbManager::getOrCreateUser(const QString& login, bool& ok)
 
 User* DbManager::loadUser(int userId)
 {
+    DbCallScope dbCall(__func__);
     if (!isConnected()) {
         logCritical() << "Cannot load user: no DB connection";
         return nullptr;
@@ -182,6 +233,7 @@ User* DbManager::loadUser(int userId)
 
 QList<User*> DbManager::loadAllUsers()
 {
+    DbCallScope dbCall(__func__);
     QList<User*> userList;
     if (!isConnected()) return userList;
 
@@ -206,6 +258,7 @@ QList<User*> DbManager::loadAllUsers()
 
 QList<QVariantMap> DbManager::loadAllRoles()
 {
+    DbCallScope dbCall(__func__);
     QList<QVariantMap> roles;
     if (!isConnected()) {
         logCritical() << "Cannot load roles: no database connection.";
@@ -232,6 +285,7 @@ QList<QVariantMap> DbManager::loadAllRoles()
 
 bool DbManager::updateUser(int userId, const QJsonObject& userData)
 {
+    DbCallScope dbCall(__func__);
     if (!isConnected()) {
         logCritical() << "Cannot update user: no DB connection";
         return false;
@@ -308,12 +362,15 @@ bool DbManager::updateUser(int userId, const QJsonObject& userData)
         return false;
     }
 
+    // Токени Jira/Redmine могли змінитись — старі розшифровані копії більше не потрібні
+    SecretCache::instance().invalidateOwner(SecretCache::userOwner(userId));
     return true;
 }
 
 
 bool DbManager::saveSession(int userId, const QByteArray& tokenHash, const QDateTime& expiresAt)
 {
+    DbCallScope dbCall(__func__);
     if (!isConnected()) return false;
 
     QSqlQuery query(m_db);
@@ -332,6 +389,7 @@ bool DbManager::saveSession(int userId, const QByteArray& tokenHash, const QDate
 
 int DbManager::findUserIdByToken(const QByteArray& tokenHash)
 {
+    DbCallScope dbCall(__func__);
     if (!isConnected()) return -1;
 
     QSqlQuery query(m_db);
@@ -353,6 +411,7 @@ int DbManager::findUserIdByToken(const QByteArray& tokenHash)
 
 QList<QVariantMap> DbManager::loadAllClients()
 {
+    DbCallScope dbCall(__func__);
     QList<QVariantMap> clients;
     if (!isConnected()) return clients;
 
@@ -379,6 +438,7 @@ QList<QVariantMap> DbManager::loadAllClients()
 // Повертає ID нового клієнта або -1 в разі помилки
 int DbManager::createClient(const QString& clientName)
 {
+    DbCallScope dbCall(__func__);
     if (!isConnected()) return -1;
 
     QSqlQuery query(m_db);
@@ -401,11 +461,14 @@ int DbManager::createClient(const QString& clientName)
 
     int newClientId = query.value(0).toInt();
     logInfo() << "Created new client '" << clientName << "' with ID:" << newClientId;
+    m_referenceRevision.fetchAndAddRelaxed(1);
+    ReferenceResponseCache::instance().invalidate(ReferenceResponseCache::Clients);
     return newClientId;
 }
 
 QJsonObject DbManager::loadClientDetails(int clientId)
 {
+    DbCallScope dbCall(__func__);
     QJsonObject clientDetails;
     QSqlQuery query(m_db);
 
@@ -500,6 +563,7 @@ QJsonObject DbManager::loadClientDetails(int clientId)
 
 QList<QVariantMap> DbManager::loadAllIpGenMethods()
 {
+    DbCallScope dbCall(__func__);
     QList<QVariantMap> methods;
     if (!isConnected()) return methods;
 
@@ -556,6 +620,7 @@ bool DbManager::testConnection(const QJsonObject& config, QString& error)
 
 bool DbManager::updateClient(int clientId, const QJsonObject& clientData)
 {
+    DbCallScope dbCall(__func__);
     // 1. Починаємо транзакцію
     if (!m_db.transaction()) {
         qCritical() << "Failed to start transaction for updating client" << clientId;
@@ -725,6 +790,10 @@ bool DbManager::updateClient(int clientId, const QJsonObject& clientData)
             success = false;
         } else {
             qInfo() << "Successfully updated ALL data for client ID:" << clientId;
+            m_catalogRevision.fetchAndAddRelaxed(1); // Назва клієнта входить у довідник АЗС
+            m_referenceRevision.fetchAndAddRelaxed(1);
+            ReferenceResponseCache::instance().invalidate(ReferenceResponseCache::Clients);
+            SecretCache::instance().invalidateOwner(SecretCache::clientOwner(clientId)); // Паролі БД/VNC могли змінитись
         }
     }
 
@@ -738,6 +807,7 @@ bool DbManager::updateClient(int clientId, const QJsonObject& clientData)
 
 bool DbManager::saveSettings(const QString& appName, const QVariantMap& settings)
 {
+    DbCallScope dbCall(__func__);
     if (!isConnected()) {
         logCritical() << "Cannot save settings: no DB connection";
         return false;
@@ -771,168 +841,20 @@ bool DbManager::saveSettings(const QString& appName, const QVariantMap& settings
         m_db.rollback();
         return false;
     }
+    m_referenceRevision.fetchAndAddRelaxed(1);
+    ReferenceResponseCache::instance().invalidate(ReferenceResponseCache::settingsKey(appName));
     return true;
 }
 
-// ===================================================================
-// РЕАЛІЗАЦІЯ СТРАТЕГІЇ "ПРЯМЕ ПІДКЛЮЧЕННЯ"
-// ===================================================================
-QVariantMap DbManager::syncViaDirectConnection(int clientId, const QJsonObject& clientDetails)
-{
-    logInfo() << "Executing DIRECT sync strategy for client" << clientId;
-
-    if (!clientDetails.contains("config_direct")) {
-        return {{"error", "Direct connection configuration is missing for the client."}};
-    }
-    QJsonObject dbConfig = clientDetails["config_direct"].toObject();
-
-    // Імена для тимчасових, потокобезпечних з'єднань
-    const QString clientConnName = "client_sync_conn_" + QUuid::createUuid().toString();
-    const QString localConnName = "local_sync_conn_" + QUuid::createUuid().toString();
-
-    // Використовуємо блок {}, щоб гарантувати, що об'єкти QSqlDatabase
-    // будуть знищені до виклику removeDatabase
-    {
-        // === 1. Створюємо тимчасове з'єднання до БД клієнта ===
-        QSqlDatabase clientDb = QSqlDatabase::addDatabase("QIBASE", clientConnName);
-        clientDb.setHostName(dbConfig["db_host"].toString());
-        clientDb.setPort(dbConfig["db_port"].toInt());
-        clientDb.setDatabaseName(dbConfig["db_path"].toString());
-        clientDb.setUserName(dbConfig["db_user"].toString());
-        clientDb.setPassword(CriptPass::instance().decriptPass(dbConfig["db_password"].toString()));
-
-        if (!clientDb.open()) {
-            QString error = clientDb.lastError().text();
-            QSqlDatabase::removeDatabase(clientConnName);
-            return {{"error", "Failed to connect to client database: " + error}};
-        }
-
-        // === 2. Створюємо тимчасове з'єднання до НАШОЇ БД ===
-        QSqlDatabase localDb = QSqlDatabase::cloneDatabase(m_db, localConnName);
-        if (!localDb.open()) {
-            QString error = localDb.lastError().text();
-            clientDb.close();
-            QSqlDatabase::removeDatabase(clientConnName);
-            QSqlDatabase::removeDatabase(localConnName);
-            return {{"error", "Failed to open a thread-local connection to the main database: " + error}};
-        }
-
-        // === 3. ВИКОНУЄМО ВАШ ФІНАЛЬНИЙ ЗАПИТ ===
-        QSqlQuery getObjectsQuery(clientDb);
-        getObjectsQuery.prepare("SELECT "
-                                "    t.TERMINAL_ID, "
-                                "    (select o.name from terminals o where o.terminal_id = t.owner_id) as REGION_NAME, "
-                                "    t.NAME, "
-                                "    t.ADRESS, " // Використовуємо ADRESS з бази клієнта
-                                "    t.PHONE, "
-                                "    t.LATITUDE, "
-                                "    t.LONGITUDE, "
-                                "    t.ISACTIVE, " // Використовуємо ISACTIVE
-                                "    t.ISWORK "    // Використовуємо ISWORK
-                                "FROM "
-                                "    terminals t "
-                                "WHERE "
-                                "    t.TERMINAL_ID BETWEEN :minTermId AND :maxTermId "
-                                "ORDER BY "
-                                "    t.TERMINAL_ID");
-
-        getObjectsQuery.bindValue(":minTermId", clientDetails["term_id_min"].toInt());
-        getObjectsQuery.bindValue(":maxTermId", clientDetails["term_id_max"].toInt());
-
-        if (!getObjectsQuery.exec()) {
-            QString error = getObjectsQuery.lastError().text();
-            localDb.close(); clientDb.close();
-            QSqlDatabase::removeDatabase(localConnName); QSqlDatabase::removeDatabase(clientConnName);
-            return {{"error", "Failed to query objects from client database: " + error}};
-        }
-
-        // === 4. ОБРОБЛЯЄМО РЕЗУЛЬТАТИ ===
-        if (!localDb.transaction()) {
-            localDb.close(); clientDb.close();
-            QSqlDatabase::removeDatabase(localConnName); QSqlDatabase::removeDatabase(clientConnName);
-            return {{"error", "Failed to start transaction."}};
-        }
-
-        QSqlQuery syncQuery(localDb);
-        syncQuery.prepare("UPDATE OR INSERT INTO OBJECTS (CLIENT_ID, TERMINAL_ID, NAME, ADDRESS, IS_ACTIVE, IS_WORK, PHONE, REGION_NAME, LATITUDE, LONGITUDE) "
-                          "VALUES (:clientId, :termId, :name, :address, :isActive, :isWork, :phone, :region, :lat, :lon) "
-                          "MATCHING (CLIENT_ID, TERMINAL_ID)");
-        int processedCount = 0;
-        while (getObjectsQuery.next()) {
-            syncQuery.bindValue(":clientId", clientId);
-            syncQuery.bindValue(":termId", getObjectsQuery.value("TERMINAL_ID"));
-            syncQuery.bindValue(":name", getObjectsQuery.value("NAME"));
-            syncQuery.bindValue(":address", getObjectsQuery.value("ADRESS")); // Читаємо ADRESS
-            bool isActive = (getObjectsQuery.value("ISACTIVE").toString().trimmed() == "T");
-            bool isWork = (getObjectsQuery.value("ISWORK").toString().trimmed() == "T");
-            // Новий діагностичний лог
-            logInfo() << "Raw ISACTIVE: '" << getObjectsQuery.value("ISACTIVE").toString()
-                      << "', Raw ISWORK: '" << getObjectsQuery.value("ISWORK").toString() << "'";
-            syncQuery.bindValue(":isActive", isActive);
-            syncQuery.bindValue(":isWork", isWork);
-            syncQuery.bindValue(":phone", getObjectsQuery.value("PHONE"));
-            syncQuery.bindValue(":region", getObjectsQuery.value("REGION_NAME"));
-            syncQuery.bindValue(":lat", getObjectsQuery.value("LATITUDE"));
-            syncQuery.bindValue(":lon", getObjectsQuery.value("LONGITUDE"));
-
-            if (!syncQuery.exec()) {
-                QString error = syncQuery.lastError().text();
-                localDb.rollback();
-                localDb.close(); clientDb.close();
-                QSqlDatabase::removeDatabase(localConnName); QSqlDatabase::removeDatabase(clientConnName);
-                return {{"error", "Failed to sync object: " + error}};
-            }
-            processedCount++;
-        }
-
-// === ЗАМІНЮЄМО БЛОК ОНОВЛЕННЯ СТАТУСУ ===
-    QSqlQuery finalStatusQuery(localDb);
-    QString finalStatus;
-    QString finalMessage;
-
-    // Визначаємо фінальний статус на основі результату коміту
-    if (localDb.commit()) {
-        finalStatus = "SUCCESS";
-        finalMessage = QString("Synchronized %1 objects.").arg(processedCount);
-        logInfo() << "Successfully synchronized" << processedCount << "objects for client ID" << clientId;
-    } else {
-        finalStatus = "FAILED";
-        finalMessage = "Failed to commit transaction: " + localDb.lastError().text();
-        localDb.rollback();
-        logCritical() << finalMessage;
-    }
-
-    finalStatusQuery.prepare("UPDATE SYNC_STATUS SET LAST_SYNC_DATE = CURRENT_TIMESTAMP, "
-                             "LAST_SYNC_STATUS = :status, LAST_SYNC_MESSAGE = :message "
-                             "WHERE CLIENT_ID = :clientId");
-    finalStatusQuery.bindValue(":status", finalStatus);
-    finalStatusQuery.bindValue(":message", finalMessage);
-    finalStatusQuery.bindValue(":clientId", clientId);
-
-    if (!finalStatusQuery.exec()) {
-        logCritical() << "FATAL: Could not write final sync status for client" << clientId << ":" << finalStatusQuery.lastError().text();
-    }
-
-    // === КОРЕКТНЕ ЗАВЕРШЕННЯ ===
-    clientDb.close();
-    localDb.close();
-    QSqlDatabase::removeDatabase(clientConnName);
-    QSqlDatabase::removeDatabase(localConnName);
-
-    if (finalStatus == "SUCCESS") {
-         return {{"status", "success"}, {"processed_count", processedCount}};
-    } else {
-        return {{"error", finalMessage}};
-    }
-}
-}
-
 // ===================================================================
 // ГОЛОВНИЙ МЕТОД-"ДИСПЕТЧЕР"
 // ===================================================================
 QVariantMap DbManager::syncClientObjects(int clientId)
 {
+    QElapsedTimer lockWait;
+    lockWait.start();
     QMutexLocker locker(&m_dbMutex);
+    dbLockWaitHistogram().observe(lockWait.nsecsElapsed() / 1e9);
 
     // --- 1. Оновлюємо статус на "PENDING" (Виконується) ---
     QSqlQuery statusQuery(m_db);
@@ -960,13 +882,16 @@ QVariantMap DbManager::syncClientObjects(int clientId)
                      .arg(clientId).arg(syncMethod);
 
     // --- 3. Викликаємо відповідну стратегію ---
+    QElapsedTimer syncTimer;
+    syncTimer.start();
+    QVariantMap result;
     if (syncMethod == "DIRECT") {
         // !!! ТУТ ЗМІНА: Викликаємо наш новий реалізований метод !!!
-        return syncViaDirect(clientId, clientDetails);
+        result = syncViaDirect(clientId, clientDetails);
     } else if (syncMethod == "PALANTIR") {
-        return syncViaPalantir(clientId, clientDetails); // Заглушка або існуючий метод
+        result = syncViaPalantir(clientId, clientDetails); // Заглушка або існуючий метод
     } else if (syncMethod == "FILE") {
-        return syncViaFile(clientId, clientDetails);
+        result = syncViaFile(clientId, clientDetails);
     } else {
         QString errorMsg = QString("Unknown synchronization method '%1'").arg(syncMethod);
         statusQuery.prepare("UPDATE SYNC_STATUS SET LAST_SYNC_STATUS = 'FAILED', "
@@ -976,6 +901,22 @@ QVariantMap DbManager::syncClientObjects(int clientId)
         statusQuery.exec();
         return {{"error", errorMsg}};
     }
+
+    // Синхронізація могла записати OBJECTS (навіть частково) — список регіонів будується з них
+    ReferenceResponseCache::instance().invalidate(ReferenceResponseCache::Regions);
+    m_catalogRevision.fetchAndAddRelaxed(1); // Довідник АЗС Gandalf теж будується з OBJECTS
+    m_referenceRevision.fetchAndAddRelaxed(1); // Ревізія довідників Gandalf (/api/reference/revision) включає регіони
+
+    // --- 4. Метрики завдання синхронізації ---
+    MetricsRegistry& metrics = MetricsRegistry::instance();
+    const MetricLabels methodLabel = {{"method", syncMethod}};
+    metrics.histogram("oracle_sync_duration_seconds", "Duration of client sync jobs.", methodLabel,
+                      {1, 5, 15, 30, 60, 120, 300, 600, 1800}).observe(syncTimer.nsecsElapsed() / 1e9);
+    metrics.counter("oracle_sync_jobs_total", "Client sync jobs by method and result.",
+                    {{"method", syncMethod}, {"result", result.contains("error") ? "error" : "success"}}).inc();
+    metrics.histogram("oracle_sync_rows", "Rows processed per client sync job.", methodLabel,
+                      MetricsRegistry::sizeBuckets()).observe(result.value("processed_count").toDouble());
+    return result;
 }
 
 // 2. Заглушка для "PALANTIR"
@@ -1181,6 +1122,7 @@ QVariantMap DbManager::syncViaFile(int clientId, const QJsonObject& clientDetail
                 break; // Вихід з циклу при першій помилці
             }
             totalProcessed += data.count();
+            SyncEventBus::instance().publishTaskProgress(clientId, jsonFileName, targetTable, data.count(), totalProcessed);
         } else {
             logWarning() << "Unknown file (no task found in DB):" << jsonFileName;
         }
@@ -1224,6 +1166,7 @@ QVariantMap DbManager::syncViaFile(int clientId, const QJsonObject& clientDetail
 
 QVariantMap DbManager::getSyncStatus(int clientId)
 {
+    DbCallScope dbCall(__func__);
     QSqlQuery query(m_db);
     query.prepare("SELECT LAST_SYNC_DATE, LAST_SYNC_STATUS, LAST_SYNC_MESSAGE "
                   "FROM SYNC_STATUS WHERE CLIENT_ID = :clientId");
@@ -1242,6 +1185,7 @@ QVariantMap DbManager::getSyncStatus(int clientId)
 
 QList<QVariantMap> DbManager::getObjects(const QVariantMap &filters)
 {
+    DbCallScope dbCall(__func__);
     QList<QVariantMap> objects;
     QString queryString = "SELECT o.*, c.CLIENT_NAME "
                           "FROM OBJECTS o "
@@ -1283,8 +1227,16 @@ QList<QVariantMap> DbManager::getObjects(const QVariantMap &filters)
     if (!whereConditions.isEmpty()) {
         queryString += " WHERE " + whereConditions.join(" AND ");
     }
+    // (CLIENT_ID, TERMINAL_ID) унікальні, тому порядок стабільний між сторінками
     queryString += " ORDER BY o.CLIENT_ID, o.TERMINAL_ID";
 
+    // Посторінкова вибірка (Firebird: ROWS m TO n, нумерація з 1)
+    if (filters.contains("limit")) {
+        const int offset = qMax(0, filters.value("offset").toInt());
+        const int limit = qMax(1, filters["limit"].toInt());
+        queryString += QString(" ROWS %1 TO %2").arg(offset + 1).arg(offset + limit);
+    }
+
     logDebug() << "Executing SQL:" << queryString;
     logDebug() << "With BIND values:" << bindValues;
 
@@ -1319,6 +1271,7 @@ QList<QVariantMap> DbManager::getObjects(const QVariantMap &filters)
 
 QStringList DbManager::getUniqueRegionsList()
 {
+    DbCallScope dbCall(__func__);
     QStringList regions;
     QSqlQuery query("SELECT DISTINCT REGION_NAME FROM OBJECTS WHERE REGION_NAME IS NOT NULL AND REGION_NAME <> '' ORDER BY REGION_NAME", m_db);
     if (!query.exec()) {
@@ -1340,6 +1293,7 @@ QStringList DbManager::getUniqueRegionsList()
  */
 QJsonObject DbManager::registerBotUser(const QJsonObject &userData)
 {
+    DbCallScope dbCall(__func__);
     // 1. Отримуємо дані з JSON
     qint64 telegramId = userData["telegram_id"].toVariant().toLongLong();
     if (telegramId == 0) {
@@ -1387,6 +1341,7 @@ QJsonObject DbManager::registerBotUser(const QJsonObject &userData)
  */
 QJsonArray DbManager::getPendingBotRequests()
 {
+    DbCallScope dbCall(__func__);
     QJsonArray requestsArray;
     QSqlQuery query(m_db);
 
@@ -1423,6 +1378,7 @@ QJsonArray DbManager::getPendingBotRequests()
  */
 bool DbManager::rejectBotRequest(int requestId)
 {
+    DbCallScope dbCall(__func__);
     QSqlQuery query(m_db);
     query.prepare("UPDATE BOT_PENDING_REQUESTS SET STATUS = 'REJECTED' "
                   "WHERE REQUEST_ID = :request_id AND STATUS = 'PENDING'");
@@ -1451,6 +1407,7 @@ bool DbManager::rejectBotRequest(int requestId)
  */
 bool DbManager::approveBotRequest(int requestId, const QString& login)
 {
+    DbCallScope dbCall(__func__);
     if (!isConnected()) {
         logCritical() << "Cannot approve bot request: no DB connection";
         return false;
@@ -1517,6 +1474,7 @@ bool DbManager::approveBotRequest(int requestId, const QString& login)
  */
 bool DbManager::linkBotRequest(int requestId, int existingUserId)
 {
+    DbCallScope dbCall(__func__);
     if (!isConnected()) {
         logCritical() << "Cannot link bot request: no DB connection";
         return false;
@@ -1576,6 +1534,7 @@ bool DbManager::linkBotRequest(int requestId, int existingUserId)
  */
 QJsonObject DbManager::getBotUserStatus(qint64 telegramId)
 {
+    DbCallScope dbCall(__func__);
     if (!isConnected()) {
         logCritical() << "Cannot get bot user status: no DB connection";
         return {{"status", "ERROR"}, {"message", "Database connection failed"}};
@@ -1670,6 +1629,7 @@ QJsonObject DbManager::getBotUserStatus(qint64 telegramId)
  */
 int DbManager::findUserIdByTelegramId(qint64 telegramId)
 {
+    DbCallScope dbCall(__func__);
     if (!isConnected() || telegramId == 0) return -1;
 
     QSqlQuery query(m_db);
@@ -1708,6 +1668,7 @@ int DbManager::findUserIdByTelegramId(qint64 telegramId)
  */
 QJsonArray DbManager::getActiveBotUsers()
 {
+    DbCallScope dbCall(__func__);
     QJsonArray usersArray;
     if (!isConnected()) return usersArray;
 
@@ -1756,6 +1717,7 @@ QJsonArray DbManager::getActiveBotUsers()
  */
 QJsonArray DbManager::getStationsForClient(int userId, int clientId)
 {
+    DbCallScope dbCall(__func__);
     QJsonArray stationsArray;
     if (!isConnected()) return stationsArray;
 
@@ -1803,6 +1765,7 @@ QJsonArray DbManager::getStationsForClient(int userId, int clientId)
  */
 QJsonObject DbManager::getStationDetails(int userId, int clientId, const QString& terminalNo)
 {
+    DbCallScope dbCall(__func__);
     if (!isConnected()) return {{"error", "Database not connected"}};
 
     QSqlQuery query(m_db);
@@ -1850,6 +1813,7 @@ QJsonObject DbManager::getStationDetails(int userId, int clientId, const QString
  */
 QList<QVariantMap> DbManager::loadAllExportTasks()
 {
+    DbCallScope dbCall(__func__);
     QList<QVariantMap> tasks;
     QSqlQuery query(m_db);
 
@@ -1901,6 +1865,7 @@ QList<QVariantMap> DbManager::loadAllExportTasks()
  */
 QJsonObject DbManager::loadExportTaskById(int taskId)
 {
+    DbCallScope dbCall(__func__);
     QJsonObject task;
     QSqlQuery query(m_db);
 
@@ -1930,6 +1895,7 @@ QJsonObject DbManager::loadExportTaskById(int taskId)
  */
 int DbManager::createExportTask(const QJsonObject& taskData)
 {
+    DbCallScope dbCall(__func__);
     QSqlQuery query(m_db);
 
     query.prepare("INSERT INTO EXPORT_TASKS ("
@@ -1974,6 +1940,7 @@ int DbManager::createExportTask(const QJsonObject& taskData)
  */
 bool DbManager::updateExportTask(int taskId, const QJsonObject& taskData)
 {
+    DbCallScope dbCall(__func__);
     logInfo() << "Test call update data";
 
     QSqlQuery query(m_db);
@@ -2011,6 +1978,7 @@ bool DbManager::updateExportTask(int taskId, const QJsonObject& taskData)
 
 QPair<QString, QString> DbManager::getExportTaskInfo(const QString& jsonFileName)
 {
+    DbCallScope dbCall(__func__);
     QString sqlFileName = jsonFileName;
     sqlFileName.replace(".json", ".sql", Qt::CaseInsensitive);
 
@@ -2162,6 +2130,7 @@ bool DbManager::processGenericSync(int clientId, const QString& tableName, const
     }
 
     logInfo() << "Successfully synced" << data.count() << "records into" << tableName << "with strategy" << deleteStrategy;
+    countSyncedRows(tableName, data.count());
     return true;
 }
 
@@ -2196,6 +2165,8 @@ bool DbManager::processWorkplacesSync(int clientId, const QString& deleteStrateg
 
     // --- ЗМІНЕНО ТУТ: Блок 3 ---
     QString rawVncPass = ""; // Зберігатимемо ЧИСТИЙ базовий пароль
+    // cryptVNCPass приймає лише QString — копію з SecureBuffer затираємо на будь-якому виході
+    const auto wipeVncPass = qScopeGuard([&rawVncPass] { SecureBuffer::wipe(rawVncPass); });
     int vncPort = 5900;
 
     QSqlQuery vncQuery(m_db);
@@ -2208,7 +2179,7 @@ bool DbManager::processWorkplacesSync(int clientId, const QString& deleteStrateg
 
         // Одразу розшифровуємо базовий пароль, щоб далі "солити" його номером АЗС
         if (!encryptedBasePass.isEmpty()) {
-            rawVncPass = CriptPass::instance().decriptPass(encryptedBasePass);
+            rawVncPass = SecretCache::instance().acquire(encryptedBasePass, SecretCache::clientOwner(clientId))->toString();
         }
         logInfo() << "Loaded VNC config for client" << clientId << "| Port:" << vncPort;
     } else {
@@ -2274,6 +2245,7 @@ bool DbManager::processWorkplacesSync(int clientId, const QString& deleteStrateg
     }
 
     logInfo() << "Successfully synced" << data.count() << "WORKPLACES for client" << clientId;
+    countSyncedRows("WORKPLACES", data.count());
     return true;
 }
 
@@ -2305,8 +2277,12 @@ QVariantMap DbManager::syncViaDirect(int clientId, const QJsonObject& clientDeta
         clientDb.setDatabaseName(directConfig["db_path"].toString());
         clientDb.setPort(directConfig["db_port"].toInt());
         clientDb.setUserName(directConfig["db_user"].toString());
-        // Використовуємо QMutexLocker, тому що DbManager::instance() може бути викликаний в іншому потоці
-        clientDb.setPassword(CriptPass::instance().decriptPass(directConfig["db_password"].toString()));
+        // QSqlDatabase приймає пароль лише як QString і тримає свою копію до removeDatabase;
+        // власну копію відпускаємо одразу (wipe затирає її, якщо буфер ніхто не поділяє)
+        QString dbPassword = SecretCache::instance().acquire(directConfig["db_password"].toString(),
+                                                             SecretCache::clientOwner(clientId))->toString();
+        clientDb.setPassword(dbPassword);
+        SecureBuffer::wipe(dbPassword);
 
         if (!clientDb.open()) {
             QString err = clientDb.lastError().text();
@@ -2396,6 +2372,7 @@ QVariantMap DbManager::syncViaDirect(int clientId, const QJsonObject& clientDeta
             }
             totalProcessed += dataArray.count();
             logInfo() << "Imported" << dataArray.count() << "rows into" << targetTable;
+            SyncEventBus::instance().publishTaskProgress(clientId, taskName, targetTable, dataArray.count(), totalProcessed);
         }
 
         clientDb.close();
@@ -2434,6 +2411,7 @@ QVariantMap DbManager::syncViaDirect(int clientId, const QJsonObject& clientDeta
 }
 QJsonArray DbManager::getDashboardData()
 {
+    DbCallScope dbCall(__func__);
     QJsonArray result;
     QSqlQuery query(m_db);
 
@@ -2486,6 +2464,7 @@ QJsonArray DbManager::getDashboardData()
 
 QJsonArray DbManager::getPosDataByTerminal(int clientId, int terminalId)
 {
+    DbCallScope dbCall(__func__);
     QJsonArray results;
     QSqlQuery query(m_db);
 
@@ -2531,6 +2510,7 @@ QJsonArray DbManager::getPosDataByTerminal(int clientId, int terminalId)
 
 QJsonArray DbManager::getTanksByTerminal(int clientId, int terminalId)
 {
+    DbCallScope dbCall(__func__);
     QJsonArray results;
     QSqlQuery query(m_db);
 
@@ -2577,6 +2557,7 @@ QJsonArray DbManager::getTanksByTerminal(int clientId, int terminalId)
  */
 QJsonArray DbManager::getDispenserConfigByTerminal(int clientId, int terminalId)
 {
+    DbCallScope dbCall(__func__);
     // QMap для тимчасового зберігання та групування:
     // Ключ: DISPENSER_ID, Значення: Об'єкт ТРК з масивом пістолетів
     QMap<int, QJsonObject> dispensersMap;
@@ -2673,6 +2654,7 @@ QJsonArray DbManager::getDispenserConfigByTerminal(int clientId, int terminalId)
  */
 bool DbManager::updateRedmineUserId(int localUserId, int redmineId)
 {
+    DbCallScope dbCall(__func__);
     if (!isConnected()) {
         logCritical() << "Cannot update Redmine ID: no DB connection";
         return false;
@@ -2694,6 +2676,7 @@ bool DbManager::updateRedmineUserId(int localUserId, int redmineId)
 
 QJsonArray DbManager::searchStationsByTerminal(int terminalId)
 {
+    DbCallScope dbCall(__func__);
     QJsonArray result;
     if (!isConnected()) return result;
 
@@ -2732,8 +2715,62 @@ QJsonArray DbManager::searchStationsByTerminal(int terminalId)
 }
 
 
+QJsonArray DbManager::getStationCatalog()
+{
+    DbCallScope dbCall(__func__);
+    QJsonArray result;
+    if (!isConnected()) return result;
+
+    QSqlQuery query(m_db);
+    query.setForwardOnly(true);
+    query.prepare(R"(
+        SELECT O.OBJECT_ID, O.TERMINAL_ID, O.NAME, O.ADDRESS, O.REGION_NAME,
+               O.IS_ACTIVE, O.IS_WORK, C.CLIENT_NAME
+        FROM OBJECTS O
+        LEFT JOIN CLIENTS C ON O.CLIENT_ID = C.CLIENT_ID
+        ORDER BY O.TERMINAL_ID
+    )");
+
+    if (!query.exec()) {
+        logCritical() << "Station catalog query failed:" << query.lastError().text();
+        return result;
+    }
+
+    while (query.next()) {
+        QJsonObject obj;
+        obj["id"] = query.value("OBJECT_ID").toInt();
+        obj["terminalId"] = query.value("TERMINAL_ID").toInt();
+        obj["name"] = query.value("NAME").toString();
+        obj["address"] = query.value("ADDRESS").toString();
+        obj["region"] = query.value("REGION_NAME").toString();
+        obj["clientName"] = query.value("CLIENT_NAME").toString();
+        obj["isActive"] = query.value("IS_ACTIVE").toBool();
+        obj["isWork"] = query.value("IS_WORK").toBool();
+        result.append(obj);
+    }
+    return result;
+}
+
+QString DbManager::stationCatalogVersion() const
+{
+    return m_catalogEpoch + "-" + QString::number(m_catalogRevision.loadRelaxed());
+}
+
+QString DbManager::referenceDataRevision() const
+{
+    return m_catalogEpoch + "-" + QString::number(m_referenceRevision.loadRelaxed());
+}
+
+void DbManager::markExternalChange(bool stationCatalog, bool referenceData)
+{
+    if (stationCatalog) m_catalogRevision.fetchAndAddRelaxed(1);
+    if (referenceData) m_referenceRevision.fetchAndAddRelaxed(1);
+}
+
+
 QJsonObject DbManager::getObjectInfo(int objectId)
 {
+    DbCallScope dbCall(__func__);
     QJsonObject result;
     if (!isConnected()) return result;
 
@@ -2772,9 +2809,13 @@ QJsonObject DbManager::getObjectInfo(int objectId)
 
 bool DbManager::setSyncStatus(int clientId, const QString& status, const QString& message)
 {
+    DbCallScope dbCall(__func__);
     // Блокуємо м'ютекс, бо цей метод буде викликатися з головного потоку сервера,
     // поки інші потоки можуть працювати з базою
+    QElapsedTimer lockWait;
+    lockWait.start();
     QMutexLocker locker(&m_dbMutex);
+    dbLockWaitHistogram().observe(lockWait.nsecsElapsed() / 1e9);
 
     if (!isConnected()) return false;
 
@@ -2797,6 +2838,7 @@ bool DbManager::setSyncStatus(int clientId, const QString& status, const QString
 
 QJsonArray DbManager::getWorkplacesByTerminal(int clientId, int terminalId)
 {
+    DbCallScope dbCall(__func__);
     // --- 0. ПЕРЕВІРКА НАЛАШТУВАНЬ VNC (Чи дозволено пряме підключення) ---
     QSqlQuery vncQuery(m_db);
     vncQuery.prepare("SELECT IS_TERMINAL_ONLY FROM CLIENT_VNC_SETTINGS WHERE CLIENT_ID = ?");
@@ -2846,3 +2888,54 @@ QJsonArray DbManager::getWorkplacesByTerminal(int clientId, int terminalId)
     // 4. Передаємо всі параметри в генератор
     return generator->generate(clientId, objectId, terminalId);
 }
+
+QJsonArray DbManager::getWorkplacesByClient(int clientId, int terminalId)
+{
+    DbCallScope dbCall(__func__);
+    QJsonArray result;
+    if (!isConnected()) return result;
+
+    // Термінальний доступ — каси напряму недосяжні, перевіряти нічого
+    QSqlQuery vncQuery(m_db);
+    vncQuery.prepare("SELECT IS_TERMINAL_ONLY FROM CLIENT_VNC_SETTINGS WHERE CLIENT_ID = ?");
+    vncQuery.addBindValue(clientId);
+    if (vncQuery.exec() && vncQuery.next() && vncQuery.value(0).toBool()) {
+        logInfo() << "DbManager: Client" << clientId << "is terminal-only. No workplaces to scan.";
+        return result;
+    }
+
+    // Один запит на всього клієнта замість генератора на кожну АЗС
+    QSqlQuery query(m_db);
+    query.setForwardOnly(true);
+    QString sql = "SELECT W.WORKPLACE_ID, W.VERSION_TYPE, W.POS_ID, W.IPADR, W.PORTVNC, O.TERMINAL_ID "
+                  "FROM WORKPLACES W "
+                  "JOIN OBJECTS O ON O.OBJECT_ID = W.OBJECT_ID "
+                  "WHERE O.CLIENT_ID = ? ";
+    if (terminalId > 0) {
+        sql += "AND O.TERMINAL_ID = ? ";
+    }
+    sql += "ORDER BY O.TERMINAL_ID, W.POS_ID";
+
+    query.prepare(sql);
+    query.addBindValue(clientId);
+    if (terminalId > 0) {
+        query.addBindValue(terminalId);
+    }
+
+    if (!query.exec()) {
+        logCritical() << "Failed to fetch workplaces for client" << clientId << ":" << query.lastError().text();
+        return result;
+    }
+
+    while (query.next()) {
+        QJsonObject wp;
+        wp["workplace_id"] = query.value("WORKPLACE_ID").toInt();
+        wp["version_type"] = query.value("VERSION_TYPE").toInt();
+        wp["pos_id"] = query.value("POS_ID").toInt();
+        wp["ip_address"] = query.value("IPADR").toString();
+        wp["vnc_port"] = query.value("PORTVNC").toInt();
+        wp["terminal_id"] = query.value("TERMINAL_ID").toInt();
+        result.append(wp);
+    }
+    return result;
+}
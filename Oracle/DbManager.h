@@ -7,6 +7,7 @@
 #include <QDateTime>
 #include <QJsonArray>
 #include <QMutex>
+#include <QAtomicInteger>
 
 
 class ConfigManager;
@@ -95,6 +96,21 @@ public:
 
     QJsonArray searchStationsByTerminal(int terminalId);
 
+    // Повний довідник АЗС для локального пошуку в Gandalf (компактні поля)
+    QJsonArray getStationCatalog();
+    /**
+     * @brief Версія довідника АЗС: змінюється при кожному записі в OBJECTS/CLIENTS через сервер.
+     * Клієнт порівнює її зі своєю і завантажує довідник лише за потреби.
+     */
+    QString stationCatalogVersion() const;
+    /**
+     * @brief Ревізія довідкових даних Gandalf (клієнти, регіони, налаштування):
+     * змінюється при кожному записі в них через сервер. Ролі та методи генерації IP через API не змінюються.
+     */
+    QString referenceDataRevision() const;
+    // Дані змінено в обхід сервера (інший процес, ручний SQL — див. DbEventListener): нові версії
+    void markExternalChange(bool stationCatalog, bool referenceData);
+
     // Отримання загальної інформації про конкретну АЗС
     QJsonObject getObjectInfo(int objectId);
     // Метод для примусового встановлення статусу синхронізації
@@ -103,12 +119,15 @@ public:
     // Отримання робочих місць для АЗС
     QJsonArray getWorkplacesByTerminal(int clientId, int terminalId);
 
+    // Робочі місця клієнта (лише адресні поля — для масової перевірки доступності).
+    // terminalId > 0 — лише однієї АЗС
+    QJsonArray getWorkplacesByClient(int clientId, int terminalId = 0);
+
 private:
     DbManager(); // Конструктор тепер приватний
     ~DbManager();
 
     // --- Методи-стратегії для синхронізації ---
-    QVariantMap syncViaDirectConnection(int clientId, const QJsonObject& clientDetails);
     QVariantMap syncViaPalantir(int clientId, const QJsonObject& clientDetails);
     QVariantMap syncViaFile(int clientId, const QJsonObject& clientDetails);
 
@@ -130,5 +149,11 @@ private:
     QSqlDatabase m_db;
     QString m_lastError;
     QMutex m_dbMutex;
+
+    // Лічильник змін довідника АЗС + мітка запуску (щоб версії не повторювались після рестарту)
+    QAtomicInteger<quint64> m_catalogRevision;
+    QString m_catalogEpoch;
+    // Те саме для довідкових даних (мітка запуску спільна)
+    QAtomicInteger<quint64> m_referenceRevision;
 };
 #endif // DBMANAGER_H
@@ -0,0 +1,478 @@
+#include "IcmpPinger.h"
+#include "AppParams.h"
+#include "Logger.h"
+
+#include <QCoreApplication>
+#include <QHostInfo>
+#include <QTimer>
+#include <QtEndian>
+#include <algorithm>
+#include <cmath>
+
+#ifdef Q_OS_WIN
+#include <QWinEventNotifier>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <windows.h>
+#include <winternl.h>  // IO_STATUS_BLOCK для розміру буфера IcmpSendEcho2
+#include <iphlpapi.h>
+#include <icmpapi.h>
+#else
+#include <QSocketNotifier>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace {
+// Такий самий корисний вантаж, як у системного ping у Windows
+const char kPayload[] = "abcdefghijklmnopqrstuvwabcdefghi";
+const int kPayloadSize = int(sizeof(kPayload)) - 1;
+
+#ifndef Q_OS_WIN
+const quint8 kIcmpEchoReply = 0;
+const quint8 kIcmpEchoRequest = 8;
+
+// Контрольна сума Інтернету (RFC 1071)
+quint16 internetChecksum(const uchar *data, int size)
+{
+    quint32 sum = 0;
+    for (int i = 0; i + 1 < size; i += 2) {
+        sum += (quint32(data[i]) << 8) | data[i + 1];
+    }
+    if (size % 2) sum += quint32(data[size - 1]) << 8;
+    while (sum >> 16) sum = (sum & 0xffff) + (sum >> 16);
+    return quint16(~sum);
+}
+#else
+QString icmpStatusText(DWORD status)
+{
+    switch (status) {
+    case IP_REQ_TIMED_OUT: return "Перевищено інтервал очікування";
+    case IP_DEST_HOST_UNREACHABLE: return "Хост недосяжний";
+    case IP_DEST_NET_UNREACHABLE: return "Мережа недосяжна";
+    case IP_DEST_PORT_UNREACHABLE: return "Порт недосяжний";
+    case IP_TTL_EXPIRED_TRANSIT: return "Закінчився TTL у дорозі";
+    case IP_BAD_DESTINATION: return "Неправильна адреса призначення";
+    default: return QString("Помилка ICMP %1").arg(status);
+    }
+}
+#endif
+}
+
+IcmpPinger& IcmpPinger::instance()
+{
+    static IcmpPinger self;
+    return self;
+}
+
+IcmpPinger::IcmpPinger(QObject *parent)
+    : QObject(parent), m_nextSessionId(1), m_nextWireSeq(1)
+#ifdef Q_OS_WIN
+    , m_icmpHandle(INVALID_HANDLE_VALUE)
+#else
+    , m_fd(-1), m_rawSocket(false), m_identifier(0), m_notifier(nullptr)
+#endif
+{
+    qRegisterMetaType<PingSample>("PingSample");
+    qRegisterMetaType<PingStats>("PingStats");
+
+    m_windowSize = qMax(2, AppParams::instance().getParam("Global", "PingWindowSize", 100).toInt());
+
+    m_scheduler = new QTimer(this);
+    m_scheduler->setSingleShot(true);
+    m_scheduler->setTimerType(Qt::PreciseTimer);
+    connect(m_scheduler, &QTimer::timeout, this, &IcmpPinger::tick);
+
+    m_clock.start();
+}
+
+IcmpPinger::~IcmpPinger()
+{
+    closeSocket();
+}
+
+bool IcmpPinger::isAvailable() const
+{
+#ifdef Q_OS_WIN
+    return m_icmpHandle != INVALID_HANDLE_VALUE && m_icmpHandle != nullptr;
+#else
+    return m_fd >= 0;
+#endif
+}
+
+void IcmpPinger::openSocket()
+{
+    if (isAvailable()) return;
+
+#ifdef Q_OS_WIN
+    m_icmpHandle = IcmpCreateFile();
+    if (m_icmpHandle == INVALID_HANDLE_VALUE) {
+        m_lastError = QString("IcmpCreateFile: помилка %1").arg(GetLastError());
+        logCritical() << "IcmpPinger:" << m_lastError;
+        return;
+    }
+#else
+    // Спершу непривілейований ping-сокет: ядро саме підставляє ідентифікатор і фільтрує чужі відповіді
+    m_fd = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_ICMP);
+    m_rawSocket = false;
+    if (m_fd < 0) {
+        m_fd = ::socket(AF_INET, SOCK_RAW, IPPROTO_ICMP);
+        m_rawSocket = true;
+    }
+    if (m_fd < 0) {
+        m_lastError = QString("Немає дозволу на ICMP-сокет: %1").arg(QString::fromLocal8Bit(std::strerror(errno)));
+        logCritical() << "IcmpPinger:" << m_lastError;
+        return;
+    }
+
+    ::fcntl(m_fd, F_SETFL, ::fcntl(m_fd, F_GETFL, 0) | O_NONBLOCK);
+    m_identifier = quint16(QCoreApplication::applicationPid() & 0xffff);
+
+    m_notifier = new QSocketNotifier(m_fd, QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &IcmpPinger::readReplies);
+#endif
+
+    m_lastError.clear();
+    logInfo() << "IcmpPinger: ICMP socket opened"
+#ifndef Q_OS_WIN
+              << (m_rawSocket ? "(raw)." : "(datagram).")
+#endif
+        ;
+}
+
+void IcmpPinger::closeSocket()
+{
+#ifdef Q_OS_WIN
+    // Незавершені IcmpSendEcho2 ще пишуть у свої буфери — хендли подій закриваємо після закриття ICMP-хендла
+    if (isAvailable()) {
+        IcmpCloseHandle(m_icmpHandle);
+        m_icmpHandle = INVALID_HANDLE_VALUE;
+    }
+    for (const Pending& pending : std::as_const(m_pending)) {
+        delete pending.notifier;
+        if (pending.event) CloseHandle(pending.event);
+    }
+#else
+    delete m_notifier;
+    m_notifier = nullptr;
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+#endif
+    m_pending.clear();
+}
+
+int IcmpPinger::startSession(const QString &host, int intervalMs, int timeoutMs)
+{
+    const int sessionId = m_nextSessionId++;
+
+    openSocket();
+    if (!isAvailable()) {
+        const QString error = m_lastError;
+        QTimer::singleShot(0, this, [this, sessionId, error]() { emit sessionFailed(sessionId, error); });
+        return sessionId;
+    }
+
+    Session session;
+    session.host = host.trimmed();
+    session.intervalMs = intervalMs > 0 ? intervalMs : 1000;
+    session.timeoutMs = timeoutMs > 0 ? timeoutMs : 1000;
+    session.window.reserve(m_windowSize);
+    m_sessions.insert(sessionId, session);
+
+    // IP-адресу (звичайний випадок для кас) резолвити не треба
+    QHostAddress literal;
+    if (literal.setAddress(session.host)) {
+        QTimer::singleShot(0, this, [this, sessionId, literal]() {
+            onHostResolved(sessionId, {literal}, QString());
+        });
+    } else {
+        QHostInfo::lookupHost(session.host, this, [this, sessionId](const QHostInfo& info) {
+            onHostResolved(sessionId, info.addresses(),
+                           info.error() == QHostInfo::NoError ? QString() : info.errorString());
+        });
+    }
+
+    logDebug() << "IcmpPinger: Session" << sessionId << "started for" << session.host;
+    return sessionId;
+}
+
+void IcmpPinger::stopSession(int sessionId)
+{
+    // Запити в дорозі не чіпаємо: на Windows ОС ще пише в їхні буфери.
+    // Їхні відповіді (або таймаути) просто не знайдуть сесію і будуть відкинуті.
+    if (m_sessions.remove(sessionId)) {
+        logDebug() << "IcmpPinger: Session" << sessionId << "stopped.";
+        reschedule();
+    }
+}
+
+void IcmpPinger::onHostResolved(int sessionId, const QList<QHostAddress> &addresses, const QString &error)
+{
+    auto it = m_sessions.find(sessionId);
+    if (it == m_sessions.end()) return;
+
+    QHostAddress address;
+    for (const QHostAddress& candidate : addresses) {
+        if (candidate.protocol() == QAbstractSocket::IPv4Protocol) {
+            address = candidate;
+            break;
+        }
+    }
+
+    if (address.isNull()) {
+        const QString reason = error.isEmpty() ? QString("Немає IPv4-адреси для %1").arg(it->host) : error;
+        logWarning() << "IcmpPinger: Session" << sessionId << "-" << reason;
+        m_sessions.erase(it);
+        emit sessionFailed(sessionId, reason);
+        return;
+    }
+
+    it->address = address;
+    it->nextSendAt = m_clock.elapsed();
+    emit sessionStarted(sessionId, address);
+    tick();
+}
+
+void IcmpPinger::tick()
+{
+    const qint64 now = m_clock.elapsed();
+
+#ifndef Q_OS_WIN
+    // На Windows таймаут відпрацьовує сам IcmpSendEcho2, тут — наш
+    QList<quint16> expired;
+    for (auto it = m_pending.cbegin(); it != m_pending.cend(); ++it) {
+        if (it->deadline <= now) expired.append(it.key());
+    }
+    for (quint16 wireSeq : std::as_const(expired)) {
+        completePending(wireSeq, true, -1, -1, "Перевищено інтервал очікування");
+    }
+#endif
+
+    for (auto it = m_sessions.begin(); it != m_sessions.end(); ++it) {
+        Session& session = it.value();
+        if (session.address.isNull() || session.nextSendAt > now) continue;
+
+        sendEcho(it.key(), session);
+        // Якщо цикл подій пригальмував, не надолужуємо пачкою запитів
+        session.nextSendAt = qMax(session.nextSendAt + session.intervalMs, now + 1);
+    }
+
+    reschedule();
+}
+
+void IcmpPinger::reschedule()
+{
+    qint64 next = -1;
+    auto consider = [&next](qint64 at) { if (next < 0 || at < next) next = at; };
+
+    for (const Session& session : std::as_const(m_sessions)) {
+        if (!session.address.isNull()) consider(session.nextSendAt);
+    }
+#ifndef Q_OS_WIN
+    for (const Pending& pending : std::as_const(m_pending)) {
+        consider(pending.deadline);
+    }
+#endif
+
+    if (next < 0) {
+        m_scheduler->stop();
+        return;
+    }
+    m_scheduler->start(int(qMax<qint64>(0, next - m_clock.elapsed())));
+}
+
+void IcmpPinger::sendEcho(int sessionId, Session &session)
+{
+    // Номер у пакеті унікальний в межах пінгера — по ньому і зіставляємо відповідь
+    quint16 wireSeq = m_nextWireSeq++;
+    while (m_pending.contains(wireSeq) || wireSeq == 0) wireSeq = m_nextWireSeq++;
+
+    Pending& pending = m_pending[wireSeq];
+    pending.sessionId = sessionId;
+    pending.seq = session.nextSeq++;
+    pending.address = session.address.toIPv4Address();
+    pending.sentAt = m_clock.nsecsElapsed();
+    pending.deadline = m_clock.elapsed() + session.timeoutMs;
+
+#ifdef Q_OS_WIN
+    pending.event = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+    pending.replyBuffer.resize(int(sizeof(ICMP_ECHO_REPLY)) + kPayloadSize + 8 + int(sizeof(IO_STATUS_BLOCK)));
+    pending.notifier = new QWinEventNotifier(pending.event, this);
+    connect(pending.notifier, &QWinEventNotifier::activated, this, [this, wireSeq]() {
+        onEchoCompleted(wireSeq);
+    });
+
+    const DWORD result = IcmpSendEcho2(m_icmpHandle, pending.event, nullptr, nullptr,
+                                       qToBigEndian(pending.address),
+                                       const_cast<char*>(kPayload), WORD(kPayloadSize), nullptr,
+                                       pending.replyBuffer.data(), DWORD(pending.replyBuffer.size()),
+                                       DWORD(session.timeoutMs));
+    const DWORD lastError = GetLastError();
+    if (result == 0 && lastError != ERROR_IO_PENDING) {
+        completePending(wireSeq, true, -1, -1, QString("IcmpSendEcho2: помилка %1").arg(lastError));
+    }
+#else
+    uchar packet[8 + kPayloadSize];
+    packet[0] = kIcmpEchoRequest;
+    packet[1] = 0;
+    qToBigEndian<quint16>(0, packet + 2);
+    qToBigEndian<quint16>(m_identifier, packet + 4);
+    qToBigEndian<quint16>(wireSeq, packet + 6);
+    std::memcpy(packet + 8, kPayload, kPayloadSize);
+    qToBigEndian<quint16>(internetChecksum(packet, int(sizeof(packet))), packet + 2);
+
+    sockaddr_in dest;
+    std::memset(&dest, 0, sizeof(dest));
+    dest.sin_family = AF_INET;
+    dest.sin_addr.s_addr = qToBigEndian(pending.address);
+
+    if (::sendto(m_fd, packet, sizeof(packet), 0, reinterpret_cast<sockaddr*>(&dest), sizeof(dest)) < 0) {
+        completePending(wireSeq, true, -1, -1, QString::fromLocal8Bit(std::strerror(errno)));
+    }
+#endif
+}
+
+#ifdef Q_OS_WIN
+void IcmpPinger::onEchoCompleted(quint16 wireSeq)
+{
+    auto it = m_pending.find(wireSeq);
+    if (it == m_pending.end()) return;
+
+    const DWORD count = IcmpParseReplies(it->replyBuffer.data(), DWORD(it->replyBuffer.size()));
+    if (count == 0) {
+        completePending(wireSeq, true, -1, -1, icmpStatusText(GetLastError()));
+        return;
+    }
+
+    const auto* reply = reinterpret_cast<const ICMP_ECHO_REPLY*>(it->replyBuffer.constData());
+    if (reply->Status != IP_SUCCESS) {
+        completePending(wireSeq, true, -1, -1, icmpStatusText(reply->Status));
+        return;
+    }
+
+    // RoundTripTime має мілісекундну роздільність; для "<1 мс" беремо власний вимір
+    double rttMs = reply->RoundTripTime;
+    if (rttMs < 1) rttMs = (m_clock.nsecsElapsed() - it->sentAt) / 1e6;
+    completePending(wireSeq, false, rttMs, reply->Options.Ttl, QString());
+}
+#else
+void IcmpPinger::readReplies()
+{
+    uchar buffer[1500];
+    for (;;) {
+        sockaddr_in from;
+        socklen_t fromLen = sizeof(from);
+        const ssize_t received = ::recvfrom(m_fd, buffer, sizeof(buffer), 0,
+                                            reinterpret_cast<sockaddr*>(&from), &fromLen);
+        if (received <= 0) break; // EAGAIN — все вичитано
+
+        const qint64 receivedAt = m_clock.nsecsElapsed();
+        const uchar* icmp = buffer;
+        int size = int(received);
+        int ttl = -1;
+
+        // Сирий сокет віддає пакет разом з IP-заголовком
+        if (m_rawSocket) {
+            const int headerSize = (buffer[0] & 0x0f) * 4;
+            if (size < headerSize + 8) continue;
+            ttl = buffer[8];
+            icmp += headerSize;
+            size -= headerSize;
+        }
+        if (size < 8 || icmp[0] != kIcmpEchoReply) continue;
+
+        // Ping-сокет переписує ідентифікатор сам і чужих відповідей не віддає
+        if (m_rawSocket && qFromBigEndian<quint16>(icmp + 4) != m_identifier) continue;
+
+        const quint16 wireSeq = qFromBigEndian<quint16>(icmp + 6);
+        auto it = m_pending.find(wireSeq);
+        if (it == m_pending.end() || it->address != qFromBigEndian(quint32(from.sin_addr.s_addr))) continue;
+
+        completePending(wireSeq, false, (receivedAt - it->sentAt) / 1e6, ttl, QString());
+    }
+    reschedule();
+}
+#endif
+
+void IcmpPinger::completePending(quint16 wireSeq, bool lost, double rttMs, int ttl, const QString &error)
+{
+    auto it = m_pending.find(wireSeq);
+    if (it == m_pending.end()) return;
+
+    const Pending pending = it.value();
+    m_pending.erase(it);
+
+#ifdef Q_OS_WIN
+    // Можемо бути всередині activated цього ж нотифікатора
+    pending.notifier->setEnabled(false);
+    pending.notifier->deleteLater();
+    CloseHandle(pending.event);
+#endif
+
+    if (!m_sessions.contains(pending.sessionId)) return;
+
+    PingSample sample;
+    sample.seq = pending.seq;
+    sample.lost = lost;
+    sample.rttMs = lost ? -1 : rttMs;
+    sample.ttl = ttl;
+    sample.error = error;
+    recordSample(pending.sessionId, sample);
+}
+
+void IcmpPinger::recordSample(int sessionId, const PingSample &sample)
+{
+    Session& session = m_sessions[sessionId];
+    if (session.window.size() < m_windowSize) {
+        session.window.append(sample);
+    } else {
+        session.window[session.windowPos] = sample;
+        session.windowPos = (session.windowPos + 1) % m_windowSize;
+    }
+    emit sampleReady(sessionId, sample);
+}
+
+PingStats IcmpPinger::stats(int sessionId) const
+{
+    PingStats stats;
+    auto it = m_sessions.constFind(sessionId);
+    if (it == m_sessions.constEnd() || it->window.isEmpty()) return stats;
+
+    const QVector<PingSample>& window = it->window;
+    QVector<double> rtts;
+    rtts.reserve(window.size());
+
+    // Обходимо кільцевий буфер у хронологічному порядку — для jitter важлива послідовність
+    double jitterSum = 0;
+    for (int i = 0; i < window.size(); ++i) {
+        const PingSample& sample = window.at((it->windowPos + i) % window.size());
+        if (sample.lost) continue;
+        if (!rtts.isEmpty()) jitterSum += std::abs(sample.rttMs - rtts.last());
+        rtts.append(sample.rttMs);
+    }
+
+    stats.sent = window.size();
+    stats.received = rtts.size();
+    stats.lossPercent = 100.0 * (stats.sent - stats.received) / stats.sent;
+    if (rtts.isEmpty()) return stats;
+
+    stats.jitterMs = rtts.size() > 1 ? jitterSum / (rtts.size() - 1) : 0;
+
+    double sum = 0;
+    for (double rtt : std::as_const(rtts)) sum += rtt;
+    stats.avgMs = sum / rtts.size();
+
+    std::sort(rtts.begin(), rtts.end());
+    stats.minMs = rtts.first();
+    stats.maxMs = rtts.last();
+    // Nearest-rank
+    const int rank = int(std::ceil(0.95 * rtts.size())) - 1;
+    stats.p95Ms = rtts.at(qBound(0, rank, int(rtts.size()) - 1));
+    return stats;
+}
@@ -0,0 +1,149 @@
+#ifndef ICMPPINGER_H
+#define ICMPPINGER_H
+
+#include <QObject>
+#include <QHash>
+#include <QVector>
+#include <QByteArray>
+#include <QString>
+#include <QHostAddress>
+#include <QMetaType>
+#include <QElapsedTimer>
+
+class QTimer;
+class QSocketNotifier;
+class QWinEventNotifier;
+
+/**
+ * @brief Одна ехо-відповідь (або її відсутність).
+ */
+struct PingSample {
+    int seq = 0;
+    bool lost = true;
+    double rttMs = -1;    // Час відгуку, якщо відповідь прийшла
+    int ttl = -1;         // TTL відповіді, якщо платформа його повертає
+    QString error;        // Причина втрати (таймаут, хост недосяжний тощо)
+};
+
+/**
+ * @brief Агрегати по ковзному вікну останніх семплів сесії.
+ */
+struct PingStats {
+    int sent = 0;
+    int received = 0;
+    double lossPercent = 0;
+    double minMs = 0;
+    double avgMs = 0;
+    double maxMs = 0;
+    double p95Ms = 0;
+    double jitterMs = 0;  // Середня різниця між сусідніми RTT (як у RFC 3550, без згладжування)
+};
+
+Q_DECLARE_METATYPE(PingSample)
+Q_DECLARE_METATYPE(PingStats)
+
+/**
+ * @brief Вбудований ICMP-пінгер, спільний на весь процес.
+ *
+ * Замість окремого процесу `ping` на кожне вікно — один ICMP-дескриптор на всі цілі
+ * і один таймер-планувальник, що мультиплексує всі сесії в циклі подій.
+ * Відповіді зіставляються з запитами за номером послідовності, який унікальний
+ * в межах пінгера, тож десяток відкритих вікон пінгу майже нічого не коштують.
+ *
+ * Windows: IcmpSendEcho2 на одному хендлі IcmpCreateFile (не потребує прав адміністратора),
+ * завершення кожного запиту приходить через QWinEventNotifier.
+ * Linux/macOS: непривілейований SOCK_DGRAM/IPPROTO_ICMP, якщо дозволено
+ * (net.ipv4.ping_group_range), інакше SOCK_RAW; читання через QSocketNotifier.
+ *
+ * Налаштування (Global): PingWindowSize (100) — розмір вікна для агрегатів.
+ */
+class IcmpPinger : public QObject
+{
+    Q_OBJECT
+public:
+    static IcmpPinger& instance();
+
+    /**
+     * @brief Запускає безперервний пінг хоста.
+     * @param intervalMs Період надсилання запитів
+     * @param timeoutMs Час очікування відповіді на один запит
+     * @return ID сесії (для фільтрації сигналів і stopSession)
+     */
+    int startSession(const QString& host, int intervalMs = 1000, int timeoutMs = 1000);
+    void stopSession(int sessionId);
+
+    PingStats stats(int sessionId) const;
+
+    // false — ОС не дала створити ICMP-дескриптор (причина в lastError)
+    bool isAvailable() const;
+    QString lastError() const { return m_lastError; }
+
+signals:
+    void sessionStarted(int sessionId, const QHostAddress& address);
+    void sampleReady(int sessionId, const PingSample& sample);
+    void sessionFailed(int sessionId, const QString& error);
+
+private:
+    explicit IcmpPinger(QObject *parent = nullptr);
+    ~IcmpPinger();
+
+    struct Session {
+        QString host;
+        QHostAddress address;     // Порожня, поки триває резолвінг
+        int intervalMs = 1000;
+        int timeoutMs = 1000;
+        int nextSeq = 1;          // Порядковий номер для відображення (icmp_seq)
+        qint64 nextSendAt = 0;    // Момент наступного запиту за m_clock
+        QVector<PingSample> window; // Кільцевий буфер останніх семплів
+        int windowPos = 0;
+    };
+
+    struct Pending {
+        int sessionId = 0;
+        int seq = 0;
+        quint32 address = 0;
+        qint64 sentAt = 0;        // Наносекунди за m_clock
+        qint64 deadline = 0;      // Мілісекунди за m_clock
+#ifdef Q_OS_WIN
+        void* event = nullptr;
+        QByteArray replyBuffer;
+        QWinEventNotifier* notifier = nullptr;
+#endif
+    };
+
+    void openSocket();
+    void closeSocket();
+    void onHostResolved(int sessionId, const QList<QHostAddress>& addresses, const QString& error);
+    void tick();
+    void reschedule();
+    void sendEcho(int sessionId, Session& session);
+    void completePending(quint16 wireSeq, bool lost, double rttMs, int ttl, const QString& error);
+    void recordSample(int sessionId, const PingSample& sample);
+
+#ifdef Q_OS_WIN
+    void onEchoCompleted(quint16 wireSeq);
+#else
+    void readReplies();
+#endif
+
+private:
+    QHash<int, Session> m_sessions;
+    QHash<quint16, Pending> m_pending; // Номер послідовності в пакеті -> запит
+    QTimer* m_scheduler;
+    QElapsedTimer m_clock;
+    int m_nextSessionId;
+    quint16 m_nextWireSeq;
+    int m_windowSize;
+    QString m_lastError;
+
+#ifdef Q_OS_WIN
+    void* m_icmpHandle;
+#else
+    int m_fd;
+    bool m_rawSocket;             // SOCK_RAW: відповідь містить IP-заголовок, ідентифікатор перевіряємо самі
+    quint16 m_identifier;
+    QSocketNotifier* m_notifier;
+#endif
+};
+
+#endif // ICMPPINGER_H
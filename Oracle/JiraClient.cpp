@@ -1,6 +1,8 @@
 #include "JiraClient.h"
 #include "Logger.h"
+#include "Metrics.h"
 #include "ApiClient.h" // Для ApiError
+#include "SecretCache.h"
 #include <QNetworkAccessManager>
 #include <QNetworkRequest>
 #include <QNetworkReply>
@@ -16,13 +18,22 @@
 #include <QFileInfo>
 
 
+namespace {
+// Лише поля, які показують бот і Gandalf: решта payload задачі Jira не потрібна.
+// issuetype разом з project/status — ключ кешу планів переходів у Conduit
+const QStringList kIssueListFields = {"summary", "status", "project", "issuetype"};
+const QStringList kTerminalSearchFields = {"summary", "status", "created", "project", "issuetype",
+                                           "customfield_15803", "customfield_14101", "customfield_10301"};
+}
+
 JiraClient::JiraClient(QObject *parent) : QObject(parent)
 {
     // Ініціалізуємо менеджер мережі
     m_networkManager = new QNetworkAccessManager(this);
 }
 
-QNetworkReply* JiraClient::fetchIssues(const QString& baseUrl, const QString& userLogin, const QString& userApiToken)
+QNetworkReply* JiraClient::fetchIssues(const QString& baseUrl, const QString& userLogin, const SecureBuffer& userApiToken,
+                                       int startAt, int maxResults)
 {
     if (baseUrl.isEmpty() || userLogin.isEmpty() || userApiToken.isEmpty()) {
         logCritical() << "JiraClient: Base URL, login, or API Key is empty.";
@@ -30,34 +41,37 @@ QNetworkReply* JiraClient::fetchIssues(const QString& baseUrl, const QString& us
         return nullptr;
     }
 
-    // --- 1. ФІНАЛЬНИЙ JQL: ВИКОРИСТАННЯ currentUser() ---
     // Jira автоматично визначить користувача за Bearer Token.
-    // Використовуємо точний стан Unresolved, як у вашому скріншоті.
     const QString jqlQuery = "assignee = currentUser() AND resolution = Unresolved ORDER BY updated DESC";
 
-    // --- 2. Створення JSON-об'єкту з запитом ---
+    return postSearch(baseUrl, jqlQuery, QJsonArray::fromStringList(kIssueListFields), userApiToken, startAt, maxResults);
+}
+
+QNetworkReply* JiraClient::postSearch(const QString& baseUrl, const QString& jql, const QJsonArray& fields,
+                                      const SecureBuffer& userApiToken, int startAt, int maxResults)
+{
     QJsonObject jsonPayload;
-    jsonPayload["jql"] = jqlQuery;
-    jsonPayload["fields"] = QJsonArray({"summary", "status", "key", "project"});
-    // !!! ВИДАЛЯЄМО: jsonPayload["maxResults"] = 10; !!! (бо це була тимчасова діагностика)
-    // --- 3. Створення мережевого запиту ---
+    jsonPayload["jql"] = jql;
+    jsonPayload["fields"] = fields;
+    jsonPayload["startAt"] = qMax(0, startAt);
+    if (maxResults > 0) {
+        jsonPayload["maxResults"] = maxResults;
+    }
+
     QUrl url(baseUrl + "/rest/api/2/search");
     QNetworkRequest request(url);
 
-    // 4. Встановлюємо заголовки для Bearer Token
+    // Заголовки для Bearer Token
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-    // !!! ВИКОРИСТОВУЄМО BEARER TOKEN (як у вашому прикладі) !!!
-    request.setRawHeader("Authorization", ("Bearer " + userApiToken).toUtf8());
+    request.setRawHeader("Authorization", userApiToken.toByteArray("Bearer "));
 
     // ВАЖЛИВО: Ігнорування SSL (для роботи з .local доменами або самопідписаними сертифікатами)
     QSslConfiguration sslConfig = request.sslConfiguration();
     sslConfig.setPeerVerifyMode(QSslSocket::VerifyNone);
     request.setSslConfiguration(sslConfig);
 
-    // --- 5. Відправляємо POST-запит ---
-    QNetworkReply *reply = m_networkManager->post(request, QJsonDocument(jsonPayload).toJson());
-
-    // Підключаємо наш слот обробки
+    QNetworkReply *reply = m_networkManager->post(request, QJsonDocument(jsonPayload).toJson(QJsonDocument::Compact));
+    MetricsRegistry::instance().observeUpstream(reply, "jira", "search");
     connect(reply, &QNetworkReply::finished, this, &JiraClient::onIssuesReplyFinished);
 
     return reply;
@@ -83,11 +97,19 @@ void JiraClient::onIssuesReplyFinished()
 
         // Jira повертає об'єкт з масивом "issues"
         if (doc.isObject() && doc.object().contains("issues") && doc.object()["issues"].isArray()) {
-            QJsonArray issues = doc.object()["issues"].toArray();
+            const QJsonObject page = doc.object();
+            QJsonArray issues = page["issues"].toArray();
+
+            // Курсор наступної сторінки: Jira повертає startAt/total для пошуку
+            const int startAt = page["startAt"].toInt();
+            const int total = page.contains("total") ? page["total"].toInt() : startAt + issues.size();
+            const int next = startAt + issues.size();
 
             // Встановлюємо властивості успіху
             reply->setProperty("success", true);
             reply->setProperty("tasksArray", issues);
+            reply->setProperty("total", total);
+            reply->setProperty("nextStartAt", (!issues.isEmpty() && next < total) ? next : -1);
         } else {
             // Помилка парсингу або невірний формат
             error.errorString = "Invalid response from Jira: expected issues array.";
@@ -111,7 +133,7 @@ void JiraClient::onIssuesReplyFinished()
 }
 
 
-QNetworkReply* JiraClient::fetchIssueDetails(const QString& baseUrl, const QString& issueKey, const QString& userApiToken)
+QNetworkReply* JiraClient::fetchIssueDetails(const QString& baseUrl, const QString& issueKey, const SecureBuffer& userApiToken)
 {
     if (baseUrl.isEmpty() || issueKey.isEmpty() || userApiToken.isEmpty()) return nullptr;
 
@@ -119,7 +141,7 @@ QNetworkReply* JiraClient::fetchIssueDetails(const QString& baseUrl, const QStri
     QUrl url(baseUrl + "/rest/api/2/issue/" + issueKey);
     QNetworkRequest request(url);
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-    request.setRawHeader("Authorization", ("Bearer " + userApiToken).toUtf8());
+    request.setRawHeader("Authorization", userApiToken.toByteArray("Bearer "));
 
     // --- ДОДАНО: Ігнорування SSL (важливо для .local доменів) ---
     QSslConfiguration sslConfig = request.sslConfiguration();
@@ -127,6 +149,7 @@ QNetworkReply* JiraClient::fetchIssueDetails(const QString& baseUrl, const QStri
     request.setSslConfiguration(sslConfig);
 
     QNetworkReply *reply = m_networkManager->get(request);
+    MetricsRegistry::instance().observeUpstream(reply, "jira", "fetchIssueDetails");
     connect(reply, &QNetworkReply::finished, this, &JiraClient::onIssueDetailsReplyFinished);
     return reply;
 }
@@ -149,7 +172,8 @@ void JiraClient::onIssueDetailsReplyFinished()
 }
 
 
-QNetworkReply* JiraClient::searchIssuesByTerminal(const QString& baseUrl, int terminalID, const QString& userApiToken)
+QNetworkReply* JiraClient::searchIssuesByTerminal(const QString& baseUrl, int terminalID, const SecureBuffer& userApiToken,
+                                                  int startAt, int maxResults)
 {
     if (baseUrl.isEmpty() || userApiToken.isEmpty()) return nullptr;
 
@@ -165,33 +189,13 @@ QNetworkReply* JiraClient::searchIssuesByTerminal(const QString& baseUrl, int te
     // Додаємо resolution = Unresolved, щоб не показувати старі закриті тікети
     QString jqlQuery = QString("project=AZS AND \"АЗС\"=\"%1\" AND resolution = Unresolved ORDER BY created DESC").arg(azsId);
 
-    // --- 3. Створення JSON-пейлоада ---
-    QJsonObject jsonPayload;
-    jsonPayload["jql"] = jqlQuery;
-    jsonPayload["fields"] = QJsonArray({"summary", "status", "created", "project", "customfield_15803", "customfield_14101", "customfield_10301"});
-
-    // --- 4. Мережевий запит ---
-    QUrl url(baseUrl + "/rest/api/2/search");
-    QNetworkRequest request(url);
-    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-    request.setRawHeader("Authorization", ("Bearer " + userApiToken).toUtf8());
-
-    // Ігнорування SSL (вже перевірено, що це необхідно)
-    QSslConfiguration sslConfig = request.sslConfiguration();
-    sslConfig.setPeerVerifyMode(QSslSocket::VerifyNone);
-    request.setSslConfiguration(sslConfig);
-
-    QNetworkReply *reply = m_networkManager->post(request, QJsonDocument(jsonPayload).toJson());
-
-    // Використовуємо існуючий слот onIssuesReplyFinished для обробки результату
-    connect(reply, &QNetworkReply::finished, this, &JiraClient::onIssuesReplyFinished);
-
-    return reply;
+    // Результат обробляє той самий onIssuesReplyFinished
+    return postSearch(baseUrl, jqlQuery, QJsonArray::fromStringList(kTerminalSearchFields), userApiToken, startAt, maxResults);
 }
 
 
 QNetworkReply* JiraClient::uploadAttachment(const QString& baseUrl, const QString& issueKey,
-                                            const QString& userApiToken, const QByteArray& fileData,
+                                            const SecureBuffer& userApiToken, const QByteArray& fileData,
                                             const QString& fileName)
 {
     if (baseUrl.isEmpty() || issueKey.isEmpty() || userApiToken.isEmpty()) {
@@ -205,7 +209,7 @@ QNetworkReply* JiraClient::uploadAttachment(const QString& baseUrl, const QStrin
 
     // --- ВАЖЛИВІ ЗАГОЛОВКИ JIRA ---
     // 1. Авторизація
-    request.setRawHeader("Authorization", ("Bearer " + userApiToken).toUtf8());
+    request.setRawHeader("Authorization", userApiToken.toByteArray("Bearer "));
     // 2. Обов'язковий заголовок для завантаження файлів (захист від XSRF)
     request.setRawHeader("X-Atlassian-Token", "no-check");
 
@@ -230,6 +234,7 @@ QNetworkReply* JiraClient::uploadAttachment(const QString& baseUrl, const QStrin
     logInfo() << "JiraClient: Uploading attachment to" << url.toString();
 
     QNetworkReply *reply = m_networkManager->post(request, multiPart);
+    MetricsRegistry::instance().observeUpstream(reply, "jira", "uploadAttachment");
     multiPart->setParent(reply); // Видалити multipart разом з відповіддю
 
     return reply;
@@ -237,7 +242,7 @@ QNetworkReply* JiraClient::uploadAttachment(const QString& baseUrl, const QStrin
 
 
 QNetworkReply* JiraClient::addComment(const QString& baseUrl, const QString& issueKey,
-                                      const QString& userApiToken, const QString& commentBody)
+                                      const SecureBuffer& userApiToken, const QString& commentBody)
 {
     if (baseUrl.isEmpty() || issueKey.isEmpty() || userApiToken.isEmpty()) {
         logCritical() << "JiraClient: Missing parameters for adding comment.";
@@ -250,9 +255,6 @@ QNetworkReply* JiraClient::addComment(const QString& baseUrl, const QString& iss
         cleanBaseUrl.chop(1);
     }
 
-    // Видаляємо пробіли та переноси рядків з токена (часта причина 401 у header-based auth)
-    QString cleanToken = userApiToken.trimmed();
-
     // Формуємо чистий URL
     QUrl url(cleanBaseUrl + QString("/rest/api/2/issue/%1/comment").arg(issueKey));
     QNetworkRequest request(url);
@@ -261,8 +263,9 @@ QNetworkReply* JiraClient::addComment(const QString& baseUrl, const QString& iss
     // Явно вказуємо кодування, Jira іноді вередує без charset=utf-8
     request.setRawHeader("Content-Type", "application/json; charset=utf-8");
 
-    // Авторизація (використовуємо почищений токен)
-    request.setRawHeader("Authorization", ("Bearer " + cleanToken).toUtf8());
+    // Авторизація: пробіли та переноси рядків навколо токена (часта причина 401 у header-based auth)
+    // прибираються вже в готовому заголовку, без проміжної копії токена
+    request.setRawHeader("Authorization", userApiToken.toByteArray("Bearer ").simplified());
 
     // XSRF захист (як у фото)
     request.setRawHeader("X-Atlassian-Token", "no-check");
@@ -282,13 +285,15 @@ QNetworkReply* JiraClient::addComment(const QString& baseUrl, const QString& iss
     // Логуємо для діагностики (щоб ви бачили в консолі, куди реально йде запит)
     logInfo() << "JiraClient: POST Comment URL:" << url.toString();
     // УВАГА: Не виводьте токен у лог, це небезпечно, але довжину можна перевірити
-    // logInfo() << "Token length:" << cleanToken.length();
+    // logInfo() << "Token length:" << userApiToken.size();
 
-    return m_networkManager->post(request, jsonData);
+    QNetworkReply* reply = m_networkManager->post(request, jsonData);
+    MetricsRegistry::instance().observeUpstream(reply, "jira", "addComment");
+    return reply;
 }
 
 QNetworkReply* JiraClient::changeIssueStatus(const QString& baseUrl, const QString& issueKey,
-                                             const QString& userApiToken, const QJsonObject& payload)
+                                             const SecureBuffer& userApiToken, const QJsonObject& payload)
 {
     if (baseUrl.isEmpty() || issueKey.isEmpty() || userApiToken.isEmpty()) {
         logCritical() << "JiraClient: Missing parameters for status change.";
@@ -301,7 +306,7 @@ QNetworkReply* JiraClient::changeIssueStatus(const QString& baseUrl, const QStri
 
     // Заголовки (ідентичні до addComment/uploadAttachment)
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-    request.setRawHeader("Authorization", ("Bearer " + userApiToken).toUtf8());
+    request.setRawHeader("Authorization", userApiToken.toByteArray("Bearer "));
 
     // Важливо для Jira (захист від XSRF), іноді переходи без цього блокуються
     request.setRawHeader("X-Atlassian-Token", "no-check");
@@ -315,18 +320,20 @@ QNetworkReply* JiraClient::changeIssueStatus(const QString& baseUrl, const QStri
     logInfo() << "JiraClient: Sending transition request to" << url.toString();
 
     // Відправляємо сформований JSON
-    return m_networkManager->post(request, QJsonDocument(payload).toJson());
+    QNetworkReply* reply = m_networkManager->post(request, QJsonDocument(payload).toJson());
+    MetricsRegistry::instance().observeUpstream(reply, "jira", "changeIssueStatus");
+    return reply;
 }
 
 QNetworkReply* JiraClient::addWorklog(const QString& baseUrl, const QString& issueKey,
-                                      const QString& userApiToken, const QString& timeSpent)
+                                      const SecureBuffer& userApiToken, const QString& timeSpent)
 {
     // API: POST /rest/api/2/issue/{issueIdOrKey}/worklog
     QUrl url(baseUrl + QString("/rest/api/2/issue/%1/worklog").arg(issueKey));
     QNetworkRequest request(url);
 
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-    request.setRawHeader("Authorization", ("Bearer " + userApiToken).toUtf8());
+    request.setRawHeader("Authorization", userApiToken.toByteArray("Bearer "));
     request.setRawHeader("X-Atlassian-Token", "no-check");
 
     QSslConfiguration sslConfig = request.sslConfiguration();
@@ -340,5 +347,7 @@ QNetworkReply* JiraClient::addWorklog(const QString& baseUrl, const QString& iss
 
     logInfo() << "JiraClient: Adding worklog" << timeSpent << "to" << url.toString();
 
-    return m_networkManager->post(request, QJsonDocument(json).toJson());
+    QNetworkReply* reply = m_networkManager->post(request, QJsonDocument(json).toJson());
+    MetricsRegistry::instance().observeUpstream(reply, "jira", "addWorklog");
+    return reply;
 }
@@ -9,6 +9,7 @@
 #include "ApiClient.h"
 
 class QNetworkAccessManager;
+class SecureBuffer;
 
 class JiraClient : public QObject
 {
@@ -17,17 +18,23 @@ public:
     explicit JiraClient(QObject *parent = nullptr);
 
     /**
-     * @brief Запитує задачі Jira для вказаного користувача.
+     * @brief Запитує одну сторінку задач Jira для вказаного користувача.
      * @param baseUrl Базовий URL Jira.
      * @param userLogin Логін користувача (для формування Basic Auth/Bearer).
-     * @param userApiToken API токен/пароль користувача (для аутентифікації).
+     * @param userApiToken API токен/пароль користувача (для аутентифікації, з SecretCache).
+     * @param startAt Зміщення першої задачі сторінки.
+     * @param maxResults Розмір сторінки; 0 — типовий розмір Jira.
      * @return QNetworkReply*, або nullptr у разі помилки конфігурації.
+     * Після finished: tasksArray, total, nextStartAt (-1 — сторінок більше немає).
      */
-    QNetworkReply* fetchIssues(const QString& baseUrl, const QString& userLogin, const QString& userApiToken);
+    QNetworkReply* fetchIssues(const QString& baseUrl, const QString& userLogin, const SecureBuffer& userApiToken,
+                               int startAt = 0, int maxResults = 0);
 
-    QNetworkReply* fetchIssueDetails(const QString& baseUrl, const QString& issueKey, const QString& userApiToken);
+    QNetworkReply* fetchIssueDetails(const QString& baseUrl, const QString& issueKey, const SecureBuffer& userApiToken);
 
-    QNetworkReply* searchIssuesByTerminal(const QString& baseUrl, int terminalID, const QString& userApiToken);
+    // Сторінка відкритих задач по АЗС; властивості відповіді ті самі, що й у fetchIssues
+    QNetworkReply* searchIssuesByTerminal(const QString& baseUrl, int terminalID, const SecureBuffer& userApiToken,
+                                          int startAt = 0, int maxResults = 0);
 
     /**
      * @brief Завантажує файл (вкладення) до задачі Jira.
@@ -38,25 +45,25 @@ public:
      * @param fileName Ім'я файлу
      */
     QNetworkReply* uploadAttachment(const QString& baseUrl, const QString& issueKey,
-                                    const QString& userApiToken, const QByteArray& fileData,
+                                    const SecureBuffer& userApiToken, const QByteArray& fileData,
                                     const QString& fileName);
 
 
     QNetworkReply* addComment(const QString& baseUrl, const QString& issueKey,
-                              const QString& userApiToken, const QString& commentBody);
+                              const SecureBuffer& userApiToken, const QString& commentBody);
 
     /**
      * @brief Виконує перехід (зміну статусу) задачі.
      * @param payload JSON-об'єкт, що містить ID переходу, поля та (опціонально) коментар.
      */
     QNetworkReply* changeIssueStatus(const QString& baseUrl, const QString& issueKey,
-                                     const QString& userApiToken, const QJsonObject& payload);
+                                     const SecureBuffer& userApiToken, const QJsonObject& payload);
 
     /**
      * @brief Додає запис про витрачений час (Worklog).
      */
     QNetworkReply* addWorklog(const QString& baseUrl, const QString& issueKey,
-                              const QString& userApiToken, const QString& timeSpent);
+                              const SecureBuffer& userApiToken, const QString& timeSpent);
 
     QNetworkAccessManager* networkManager() const { return m_networkManager; }
 
@@ -71,6 +78,9 @@ private slots:
     void onIssueDetailsReplyFinished();
 
 private:
+    QNetworkReply* postSearch(const QString& baseUrl, const QString& jql, const QJsonArray& fields,
+                              const SecureBuffer& userApiToken, int startAt, int maxResults);
+
     QNetworkAccessManager* m_networkManager;
 };
 
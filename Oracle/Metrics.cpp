@@ -0,0 +1,223 @@
+#include "Metrics.h"
+#include "Logger.h"
+#include "Tracing.h"
+
+#include <QNetworkReply>
+#include <QtNumeric>
+#include <QReadLocker>
+#include <QWriteLocker>
+
+#include <algorithm>
+
+namespace {
+
+void atomicAdd(std::atomic<double>& target, double delta)
+{
+    double current = target.load(std::memory_order_relaxed);
+    while (!target.compare_exchange_weak(current, current + delta, std::memory_order_relaxed)) {
+    }
+}
+
+QString escapeLabelValue(QString value)
+{
+    value.replace('\\', "\\\\");
+    value.replace('"', "\\\"");
+    value.replace('\n', "\\n");
+    return value;
+}
+
+QByteArray formatNumber(double value)
+{
+    if (qIsInf(value)) return value > 0 ? "+Inf" : "-Inf";
+    return QByteArray::number(value, 'g', 12);
+}
+
+// Мітки ряду + додаткова (le для кошика гістограми)
+QByteArray withLabel(const QString& labels, const QString& name, const QString& value)
+{
+    const QString extra = QString("%1=\"%2\"").arg(name, value);
+    if (labels.isEmpty()) return ('{' + extra + '}').toUtf8();
+    return (labels.chopped(1) + ',' + extra + '}').toUtf8();
+}
+
+}
+
+// ===================================================================
+// Gauge / Histogram
+// ===================================================================
+
+void Gauge::add(double delta)
+{
+    atomicAdd(m_value, delta);
+}
+
+Histogram::Histogram(const QVector<double> &bounds)
+    : m_bounds(bounds)
+    , m_buckets(new std::atomic<quint64>[bounds.size() + 1])
+{
+    std::sort(m_bounds.begin(), m_bounds.end());
+    for (int i = 0; i <= m_bounds.size(); ++i) m_buckets[i].store(0, std::memory_order_relaxed);
+}
+
+void Histogram::observe(double value)
+{
+    const int index = int(std::lower_bound(m_bounds.cbegin(), m_bounds.cend(), value) - m_bounds.cbegin());
+    m_buckets[index].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    atomicAdd(m_sum, value);
+}
+
+// ===================================================================
+// MetricsRegistry
+// ===================================================================
+
+MetricsRegistry& MetricsRegistry::instance()
+{
+    static MetricsRegistry self;
+    return self;
+}
+
+QVector<double> MetricsRegistry::latencyBuckets()
+{
+    return {0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10, 30};
+}
+
+QVector<double> MetricsRegistry::sizeBuckets()
+{
+    return {1, 10, 100, 1000, 10000, 100000};
+}
+
+QString MetricsRegistry::formatLabels(const MetricLabels &labels)
+{
+    if (labels.isEmpty()) return QString();
+
+    QStringList parts;
+    parts.reserve(labels.size());
+    for (const auto& label : labels) {
+        parts << QString("%1=\"%2\"").arg(label.first, escapeLabelValue(label.second));
+    }
+    return '{' + parts.join(',') + '}';
+}
+
+MetricsRegistry::Series& MetricsRegistry::series(const QString &name, const QString &help, Type type,
+                                                 const MetricLabels &labels, const QVector<double> &bounds)
+{
+    const QString key = formatLabels(labels);
+
+    // Типовий випадок — ряд уже є: лише блокування на читання
+    {
+        QReadLocker locker(&m_lock);
+        auto family = m_families.find(name);
+        if (family != m_families.end()) {
+            auto it = family->second.series.find(key);
+            if (it != family->second.series.end()) return it->second;
+        }
+    }
+
+    QWriteLocker locker(&m_lock);
+    Family& family = m_families[name];
+    if (family.series.empty()) {
+        family.help = help;
+        family.type = type;
+    } else if (family.type != type) {
+        logWarning() << "Metrics: Metric" << name << "is already registered with another type.";
+    }
+
+    Series& result = family.series[key];
+    if (!result.counter && !result.gauge && !result.histogram) {
+        result.labels = labels;
+        switch (family.type) {
+        case Type::Counter:   result.counter.reset(new Counter); break;
+        case Type::Gauge:     result.gauge.reset(new Gauge); break;
+        case Type::Histogram: result.histogram.reset(new Histogram(bounds)); break;
+        }
+    }
+    return result;
+}
+
+Counter& MetricsRegistry::counter(const QString &name, const QString &help, const MetricLabels &labels)
+{
+    Series& s = series(name, help, Type::Counter, labels, {});
+    if (s.counter) return *s.counter;
+    static Counter mismatched; // Назва вже зайнята іншим типом: пишемо "в нікуди", не падаємо
+    return mismatched;
+}
+
+Gauge& MetricsRegistry::gauge(const QString &name, const QString &help, const MetricLabels &labels)
+{
+    Series& s = series(name, help, Type::Gauge, labels, {});
+    if (s.gauge) return *s.gauge;
+    static Gauge mismatched;
+    return mismatched;
+}
+
+Histogram& MetricsRegistry::histogram(const QString &name, const QString &help, const MetricLabels &labels,
+                                      const QVector<double> &bounds)
+{
+    Series& s = series(name, help, Type::Histogram, labels, bounds);
+    if (s.histogram) return *s.histogram;
+    static Histogram mismatched(bounds);
+    return mismatched;
+}
+
+void MetricsRegistry::observeUpstream(QNetworkReply *reply, const QString &upstream, const QString &operation)
+{
+    if (!reply) return;
+
+    // Той самий запит — відрізком у трасі поточного запиту Conduit (якщо вона є)
+    traceReply(reply, QString("upstream.%1.%2").arg(upstream, operation));
+
+    const MetricLabels labels = {{"upstream", upstream}, {"operation", operation}};
+    Histogram* duration = &histogram("upstream_request_duration_seconds",
+                                     "Latency of requests to external trackers.", labels);
+
+    QElapsedTimer timer;
+    timer.start();
+    QObject::connect(reply, &QNetworkReply::finished, reply, [this, reply, labels, duration, timer]() {
+        duration->observe(timer.nsecsElapsed() / 1e9);
+
+        const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        QString outcome;
+        if (reply->error() != QNetworkReply::NoError && status == 0) outcome = "network_error";
+        else outcome = QString("%1xx").arg(status / 100);
+
+        MetricLabels counterLabels = labels;
+        counterLabels.append({"outcome", outcome});
+        counter("upstream_requests_total", "Requests to external trackers by outcome.", counterLabels).inc();
+    });
+}
+
+QByteArray MetricsRegistry::exposition() const
+{
+    static const char* const typeNames[] = {"counter", "gauge", "histogram"};
+
+    QByteArray out;
+    QReadLocker locker(&m_lock);
+
+    for (const auto& [name, family] : m_families) {
+        const QByteArray metric = name.toUtf8();
+        out += "# HELP " + metric + ' ' + family.help.toUtf8() + '\n';
+        out += "# TYPE " + metric + ' ' + typeNames[int(family.type)] + '\n';
+
+        for (const auto& [labels, s] : family.series) {
+            const QByteArray labelText = labels.toUtf8();
+            if (s.counter) {
+                out += metric + labelText + ' ' + QByteArray::number(s.counter->value()) + '\n';
+            } else if (s.gauge) {
+                out += metric + labelText + ' ' + formatNumber(s.gauge->value()) + '\n';
+            } else if (s.histogram) {
+                const Histogram& h = *s.histogram;
+                quint64 cumulative = 0;
+                for (int i = 0; i <= h.bounds().size(); ++i) {
+                    cumulative += h.bucketCount(i);
+                    const QString le = i < h.bounds().size() ? QString::fromLatin1(formatNumber(h.bounds().at(i)))
+                                                             : QStringLiteral("+Inf");
+                    out += metric + "_bucket" + withLabel(labels, "le", le) + ' ' + QByteArray::number(cumulative) + '\n';
+                }
+                out += metric + "_sum" + labelText + ' ' + formatNumber(h.sum()) + '\n';
+                out += metric + "_count" + labelText + ' ' + QByteArray::number(h.count()) + '\n';
+            }
+        }
+    }
+    return out;
+}
@@ -0,0 +1,154 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QPair>
+#include <QReadWriteLock>
+#include <QString>
+#include <QVector>
+
+#include <atomic>
+#include <map>
+#include <memory>
+
+class QNetworkReply;
+
+// Мітки ряду метрики: {{"route", "/api/users"}, {"method", "GET"}}
+using MetricLabels = QList<QPair<QString, QString>>;
+
+/**
+ * @brief Лічильник, що лише зростає. Оновлення — атомарні, без блокувань.
+ */
+class Counter
+{
+public:
+    void inc(quint64 delta = 1) { m_value.fetch_add(delta, std::memory_order_relaxed); }
+    quint64 value() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<quint64> m_value{0};
+};
+
+/**
+ * @brief Поточне значення (кількість запитів у роботі, розмір кешу тощо).
+ */
+class Gauge
+{
+public:
+    void set(double value) { m_value.store(value, std::memory_order_relaxed); }
+    void add(double delta);
+    void inc() { add(1); }
+    void dec() { add(-1); }
+    double value() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<double> m_value{0};
+};
+
+/**
+ * @brief Гістограма з фіксованими межами кошиків (верхні межі, як le у Prometheus).
+ */
+class Histogram
+{
+public:
+    explicit Histogram(const QVector<double>& bounds);
+
+    void observe(double value);
+
+    const QVector<double>& bounds() const { return m_bounds; }
+    // Кількість спостережень у кошику i (не накопичувальна); останній кошик — +Inf
+    quint64 bucketCount(int index) const { return m_buckets[index].load(std::memory_order_relaxed); }
+    quint64 count() const { return m_count.load(std::memory_order_relaxed); }
+    double sum() const { return m_sum.load(std::memory_order_relaxed); }
+
+private:
+    QVector<double> m_bounds;
+    std::unique_ptr<std::atomic<quint64>[]> m_buckets; // bounds.size() + 1
+    std::atomic<quint64> m_count{0};
+    std::atomic<double> m_sum{0};
+};
+
+/**
+ * @brief Вимірює час від створення до знищення і записує його (у секундах) у гістограму.
+ */
+class MetricsTimer
+{
+public:
+    explicit MetricsTimer(Histogram& histogram) : m_histogram(histogram) { m_timer.start(); }
+    ~MetricsTimer() { m_histogram.observe(elapsedSec()); }
+
+    MetricsTimer(const MetricsTimer&) = delete;
+    MetricsTimer& operator=(const MetricsTimer&) = delete;
+
+    double elapsedSec() const { return m_timer.nsecsElapsed() / 1e9; }
+
+private:
+    Histogram& m_histogram;
+    QElapsedTimer m_timer;
+};
+
+/**
+ * @brief Реєстр метрик процесу (Conduit, Isengard, Exporter) з виводом у текстовому форматі Prometheus.
+ *
+ * counter()/gauge()/histogram() повертають ряд за назвою та мітками, створюючи його при першому
+ * зверненні; посилання стабільне до кінця роботи процесу, тож на гарячому шляху його варто
+ * зберегти. Пошук ряду — під блокуванням на читання, самі оновлення — атомарні.
+ */
+class MetricsRegistry
+{
+public:
+    static MetricsRegistry& instance();
+
+    Counter& counter(const QString& name, const QString& help, const MetricLabels& labels = {});
+    Gauge& gauge(const QString& name, const QString& help, const MetricLabels& labels = {});
+    Histogram& histogram(const QString& name, const QString& help, const MetricLabels& labels = {},
+                         const QVector<double>& bounds = latencyBuckets());
+
+    // Межі для часу відповіді, с: від 5 мс до 30 с
+    static QVector<double> latencyBuckets();
+    // Межі для кількості рядків/елементів: від 1 до 100000
+    static QVector<double> sizeBuckets();
+
+    /**
+     * @brief Час і результат запиту до зовнішнього сервісу (Jira, Redmine):
+     * upstream_request_duration_seconds{upstream, operation} та upstream_requests_total{..., outcome}.
+     */
+    void observeUpstream(QNetworkReply* reply, const QString& upstream, const QString& operation);
+
+    // Текстовий формат експозиції Prometheus (text/plain; version=0.0.4)
+    QByteArray exposition() const;
+
+private:
+    MetricsRegistry() = default;
+    ~MetricsRegistry() = default;
+
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    enum class Type { Counter, Gauge, Histogram };
+
+    struct Series {
+        MetricLabels labels;
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<Histogram> histogram;
+    };
+
+    struct Family {
+        QString help;
+        Type type = Type::Counter;
+        std::map<QString, Series> series; // ключ — відформатовані мітки
+    };
+
+    Series& series(const QString& name, const QString& help, Type type, const MetricLabels& labels,
+                   const QVector<double>& bounds);
+
+    static QString formatLabels(const MetricLabels& labels);
+
+private:
+    mutable QReadWriteLock m_lock;
+    std::map<QString, Family> m_families; // впорядковано за назвою — стабільний вивід
+};
+
+#endif // METRICS_H
@@ -0,0 +1,211 @@
+#include "ReachabilityProbe.h"
+#include "IcmpPinger.h"
+#include "AppParams.h"
+#include "Logger.h"
+
+#include <QTcpSocket>
+#include <QTimer>
+#include <QRandomGenerator>
+#include <algorithm>
+
+ReachabilityProbe& ReachabilityProbe::instance()
+{
+    static ReachabilityProbe self;
+    return self;
+}
+
+ReachabilityProbe::ReachabilityProbe(QObject *parent)
+    : QObject(parent), m_active(0), m_nextBatchId(1)
+{
+    qRegisterMetaType<ProbeResult>("ProbeResult");
+
+    m_maxConcurrent = qMax(1, AppParams::instance().getParam("Global", "ProbeMaxConcurrency", 64).toInt());
+    m_jitterMs = qMax(0, AppParams::instance().getParam("Global", "ProbeJitterMs", 25).toInt());
+
+    // Результати пінгера для чужих сесій (вікна пінгу) відкидаються в completeIcmpJob
+    IcmpPinger& pinger = IcmpPinger::instance();
+    connect(&pinger, &IcmpPinger::sampleReady, this, [this](int sessionId, const PingSample& sample) {
+        completeIcmpJob(sessionId, !sample.lost, qRound(sample.rttMs), sample.error);
+    });
+    connect(&pinger, &IcmpPinger::sessionFailed, this, [this](int sessionId, const QString& error) {
+        completeIcmpJob(sessionId, false, -1, error);
+    });
+}
+
+int ReachabilityProbe::probe(const QList<ProbeTarget> &targets, int timeoutMs)
+{
+    const int batchId = m_nextBatchId++;
+    if (targets.isEmpty()) {
+        // Порожній пакет завершуємо асинхронно, як і звичайний
+        QTimer::singleShot(0, this, [this, batchId]() { emit batchFinished(batchId); });
+        return batchId;
+    }
+
+    for (const ProbeTarget& target : targets) {
+        Job job;
+        job.batchId = batchId;
+        job.target = target;
+        job.timeoutMs = timeoutMs > 0 ? timeoutMs : 1500;
+        m_queue.enqueue(job);
+    }
+    m_outstanding[batchId] = targets.size();
+
+    logDebug() << "ReachabilityProbe: Batch" << batchId << "queued" << targets.size() << "targets.";
+    pump();
+    return batchId;
+}
+
+void ReachabilityProbe::cancel(int batchId)
+{
+    if (!m_outstanding.contains(batchId)) return;
+    m_outstanding.remove(batchId);
+
+    // Черга: просто викидаємо
+    m_queue.erase(std::remove_if(m_queue.begin(), m_queue.end(),
+                                 [batchId](const Job& job) { return job.batchId == batchId; }),
+                  m_queue.end());
+
+    // Запущені: обриваємо з'єднання, слот звільниться в completeJob
+    const QList<QTcpSocket*> sockets = m_running.keys();
+    for (QTcpSocket* socket : sockets) {
+        if (m_running.value(socket).job.batchId == batchId) {
+            completeJob(socket, false, "Cancelled");
+        }
+    }
+    const QList<int> sessions = m_icmpRunning.keys();
+    for (int sessionId : sessions) {
+        if (m_icmpRunning.value(sessionId).job.batchId == batchId) {
+            completeIcmpJob(sessionId, false, -1, "Cancelled");
+        }
+    }
+}
+
+void ReachabilityProbe::pump()
+{
+    while (m_active < m_maxConcurrent && !m_queue.isEmpty()) {
+        const Job job = m_queue.dequeue();
+        ++m_active; // Слот займаємо одразу, навіть якщо старт відкладено jitter'ом
+
+        const int delay = m_jitterMs > 0 ? QRandomGenerator::global()->bounded(m_jitterMs + 1) : 0;
+        QTimer::singleShot(delay, this, [this, job]() {
+            // Пакет могли скасувати, поки перевірка чекала свого старту
+            if (!m_outstanding.contains(job.batchId)) {
+                --m_active;
+                pump();
+                return;
+            }
+            startJob(job);
+        });
+    }
+}
+
+void ReachabilityProbe::startJob(const Job &job)
+{
+    if (job.target.method == ProbeTarget::Method::Icmp) {
+        startIcmpJob(job);
+        return;
+    }
+
+    QTcpSocket* socket = new QTcpSocket(this);
+    QTimer* timer = new QTimer(socket);
+    timer->setSingleShot(true);
+
+    Running running;
+    running.job = job;
+    running.elapsed.start();
+    m_running.insert(socket, running);
+
+    connect(socket, &QTcpSocket::connected, this, [this, socket]() {
+        completeJob(socket, true, QString());
+    });
+    connect(socket, &QTcpSocket::errorOccurred, this, [this, socket](QAbstractSocket::SocketError) {
+        completeJob(socket, false, socket->errorString());
+    });
+    connect(timer, &QTimer::timeout, this, [this, socket]() {
+        completeJob(socket, false, "Timeout");
+    });
+
+    timer->start(job.timeoutMs);
+    socket->connectToHost(job.target.host, job.target.port);
+}
+
+void ReachabilityProbe::startIcmpJob(const Job &job)
+{
+    // Один запит: інтервал довший за таймаут, сесію зупиняємо на першому ж семплі
+    const int sessionId = IcmpPinger::instance().startSession(job.target.host, job.timeoutMs + 60000, job.timeoutMs);
+
+    Running running;
+    running.job = job;
+    running.elapsed.start();
+    m_icmpRunning.insert(sessionId, running);
+
+    // Таймаут запиту відпрацьовує пінгер; цей — на випадок, якщо ім'я хоста резолвиться довше
+    QTimer* timer = new QTimer(this);
+    timer->setSingleShot(true);
+    connect(timer, &QTimer::timeout, this, [this, sessionId]() {
+        completeIcmpJob(sessionId, false, -1, "Timeout");
+    });
+    m_icmpTimers.insert(sessionId, timer);
+    timer->start(job.timeoutMs * 2);
+}
+
+void ReachabilityProbe::completeJob(QTcpSocket *socket, bool reachable, const QString &error)
+{
+    // Повторні сигнали від того самого сокета (error після timeout тощо) ігноруємо
+    auto it = m_running.find(socket);
+    if (it == m_running.end()) return;
+
+    const Job job = it.value().job;
+    const int rttMs = int(it.value().elapsed.elapsed());
+    m_running.erase(it);
+
+    socket->disconnect(this);
+    socket->abort();
+    socket->deleteLater();
+
+    finishJob(job, reachable, rttMs, error);
+}
+
+void ReachabilityProbe::completeIcmpJob(int sessionId, bool reachable, int rttMs, const QString &error)
+{
+    auto it = m_icmpRunning.find(sessionId);
+    if (it == m_icmpRunning.end()) return;
+
+    const Job job = it.value().job;
+    m_icmpRunning.erase(it);
+    IcmpPinger::instance().stopSession(sessionId);
+    if (QTimer* timer = m_icmpTimers.take(sessionId)) {
+        timer->stop();
+        timer->deleteLater();
+    }
+
+    finishJob(job, reachable, rttMs, error);
+}
+
+void ReachabilityProbe::finishJob(const Job &job, bool reachable, int rttMs, const QString &error)
+{
+    --m_active;
+
+    if (m_outstanding.contains(job.batchId)) {
+        ProbeResult result;
+        result.target = job.target;
+        result.reachable = reachable;
+        result.rttMs = reachable ? rttMs : -1;
+        result.error = error;
+        emit probeFinished(job.batchId, result);
+        releaseBatchSlot(job.batchId);
+    }
+
+    pump();
+}
+
+void ReachabilityProbe::releaseBatchSlot(int batchId)
+{
+    auto it = m_outstanding.find(batchId);
+    if (it == m_outstanding.end()) return;
+
+    if (--it.value() <= 0) {
+        m_outstanding.erase(it);
+        emit batchFinished(batchId);
+    }
+}
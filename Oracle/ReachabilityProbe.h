@@ -0,0 +1,109 @@
+#ifndef REACHABILITYPROBE_H
+#define REACHABILITYPROBE_H
+
+#include <QObject>
+#include <QHash>
+#include <QQueue>
+#include <QString>
+#include <QMetaType>
+#include <QElapsedTimer>
+
+class QTcpSocket;
+class QTimer;
+
+/**
+ * @brief Ціль перевірки доступності: TCP connect на host:port або ICMP echo на host.
+ */
+struct ProbeTarget {
+    enum class Method {
+        Tcp,   // Чи слухає порт (VNC тощо)
+        Icmp   // Чи відповідає хост на ping (через спільний IcmpPinger; port не використовується)
+    };
+
+    QString host;
+    quint16 port = 0;
+    Method method = Method::Tcp;
+    int tag = 0; // Довільний ідентифікатор викликача (рядок таблиці, ID робочого місця...)
+};
+
+/**
+ * @brief Результат однієї перевірки.
+ */
+struct ProbeResult {
+    ProbeTarget target;
+    bool reachable = false;
+    int rttMs = -1;       // Час встановлення з'єднання (TCP) або відгуку (ICMP), якщо ціль доступна
+    QString error;        // Причина недоступності (таймаут, відмова тощо)
+};
+
+Q_DECLARE_METATYPE(ProbeResult)
+
+/**
+ * @brief Спільний асинхронний рушій перевірки доступності хостів (VNC-порти кас і т.п.).
+ *
+ * Цілі подаються пакетами (batch), результати приходять сигналом probeFinished по мірі готовності.
+ * Глобальне обмеження паралельних з'єднань — одне на весь процес, тож кілька відкритих
+ * карток/діалогів не створюють шторм SYN-пакетів. Старт кожної перевірки зсувається на
+ * випадкову затримку (jitter), щоб не вдаряти по одній підмережі одночасно.
+ * ICMP-перевірка — одна ехо-відповідь через IcmpPinger і займає той самий слот паралельності;
+ * якщо ОС не дала ICMP-дескриптор, ціль повертається недоступною з причиною від пінгера.
+ *
+ * Налаштування (Global): ProbeMaxConcurrency (64), ProbeJitterMs (25).
+ */
+class ReachabilityProbe : public QObject
+{
+    Q_OBJECT
+public:
+    static ReachabilityProbe& instance();
+
+    /**
+     * @brief Ставить цілі в чергу.
+     * @param timeoutMs Таймаут на одну ціль
+     * @return ID пакета (для фільтрації сигналів і cancel)
+     */
+    int probe(const QList<ProbeTarget>& targets, int timeoutMs);
+    // Скасовує ще не виконані перевірки пакета; результати для нього більше не надходять
+    void cancel(int batchId);
+
+    int activeCount() const { return m_active; }
+    int queuedCount() const { return m_queue.size(); }
+
+signals:
+    void probeFinished(int batchId, const ProbeResult& result);
+    void batchFinished(int batchId);
+
+private:
+    explicit ReachabilityProbe(QObject *parent = nullptr);
+
+    struct Job {
+        int batchId = 0;
+        ProbeTarget target;
+        int timeoutMs = 0;
+    };
+
+    struct Running {
+        Job job;
+        QElapsedTimer elapsed;
+    };
+
+    void pump();
+    void startJob(const Job& job);
+    void startIcmpJob(const Job& job);
+    void completeJob(QTcpSocket* socket, bool reachable, const QString& error);
+    void completeIcmpJob(int sessionId, bool reachable, int rttMs, const QString& error);
+    void finishJob(const Job& job, bool reachable, int rttMs, const QString& error);
+    void releaseBatchSlot(int batchId);
+
+private:
+    QQueue<Job> m_queue;
+    QHash<QTcpSocket*, Running> m_running;
+    QHash<int, Running> m_icmpRunning; // Сесія IcmpPinger -> перевірка
+    QHash<int, QTimer*> m_icmpTimers;  // Сесія IcmpPinger -> запобіжний таймаут (резолвінг імені тощо)
+    QHash<int, int> m_outstanding; // batchId -> скільки перевірок ще не завершено
+    int m_active;
+    int m_maxConcurrent;
+    int m_jitterMs;
+    int m_nextBatchId;
+};
+
+#endif // REACHABILITYPROBE_H
@@ -1,6 +1,8 @@
 #include "RedmineClient.h"
 #include "Logger.h"
+#include "Metrics.h"
 #include "ApiClient.h" // Потрібен для доступу до ApiError та parseReply
+#include "SecretCache.h"
 #include <QNetworkAccessManager>
 #include <QNetworkRequest>
 #include <QNetworkReply>
@@ -18,13 +20,28 @@
 
 extern ApiError parseReply(QNetworkReply* reply); // Припускаємо, що це оголошення доступне
 
+namespace {
+// Redmine не вміє проєкцію полів у issues.json, тому відрізаємо зайве одразу після розбору:
+// далі (WebServer -> бот) йдуть лише поля, які показує список задач
+const QStringList kIssueListFields = {"id", "subject", "status", "project"};
+
+QJsonObject projectIssue(const QJsonObject& issue)
+{
+    QJsonObject projected;
+    for (const QString& field : kIssueListFields) {
+        if (issue.contains(field)) projected[field] = issue[field];
+    }
+    return projected;
+}
+}
+
 RedmineClient::RedmineClient(QObject *parent)
     : QObject{parent}
 {
     m_networkManager = new QNetworkAccessManager(this);
 }
 
-QNetworkReply* RedmineClient::fetchOpenIssues(const QString& baseUrl, const QString& apiKey)
+QNetworkReply* RedmineClient::fetchOpenIssues(const QString& baseUrl, const SecureBuffer& apiKey, int offset, int limit)
 {
     if (baseUrl.isEmpty() || apiKey.isEmpty()) {
         logCritical() << "RedmineClient: Base URL or API Key is empty.";
@@ -48,17 +65,22 @@ QNetworkReply* RedmineClient::fetchOpenIssues(const QString& baseUrl, const QStr
     QUrlQuery query;
     query.addQueryItem("status_id", statusFilter);
     query.addQueryItem("assigned_to_id", "me");
+    query.addQueryItem("offset", QString::number(qMax(0, offset)));
+    if (limit > 0) {
+        query.addQueryItem("limit", QString::number(limit));
+    }
     url.setQuery(query);
 
     logDebug() << "RedmineClient: Preparing request to" << url.toString();
 
     // --- 2. Створення запиту та заголовків ---
     QNetworkRequest request(url);
-    request.setRawHeader("X-Redmine-API-Key", apiKey.toUtf8());
+    request.setRawHeader("X-Redmine-API-Key", apiKey.toByteArray());
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
 
     // --- 3. Відправка запиту ---
     QNetworkReply* reply = m_networkManager->get(request);
+    MetricsRegistry::instance().observeUpstream(reply, "redmine", "fetchOpenIssues");
 
     // З'єднання слота обробки відповіді
     connect(reply, &QNetworkReply::finished, this, &RedmineClient::onIssuesReplyFinished);
@@ -85,12 +107,22 @@ void RedmineClient::onIssuesReplyFinished()
         QJsonDocument doc = QJsonDocument::fromJson(error.responseBody);
 
         if (doc.isObject() && doc.object().contains("issues") && doc.object()["issues"].isArray()) {
-            issuesArray = doc.object()["issues"].toArray();
-            logInfo() << "RedmineClient: Successfully fetched" << issuesArray.count() << "issues.";
+            const QJsonObject page = doc.object();
+            for (const QJsonValue& issue : page["issues"].toArray()) {
+                issuesArray.append(projectIssue(issue.toObject()));
+            }
+
+            // Курсор наступної сторінки: Redmine повертає offset/total_count
+            const int offset = page["offset"].toInt();
+            const int total = page.contains("total_count") ? page["total_count"].toInt() : offset + issuesArray.size();
+            const int next = offset + issuesArray.size();
+            logInfo() << "RedmineClient: Successfully fetched" << issuesArray.count() << "issues of" << total;
 
             // !!! ЗБЕРІГАННЯ РЕЗУЛЬТАТУ ДЛЯ СИНХРОННОГО ВИКЛИКУ !!!
             reply->setProperty("issuesFetched", true);
             reply->setProperty("issuesArray", issuesArray); // Зберігаємо масив задач
+            reply->setProperty("totalCount", total);
+            reply->setProperty("nextOffset", (!issuesArray.isEmpty() && next < total) ? next : -1);
 
             emit issuesFetched(issuesArray); // Для асинхронних клієнтів
         } else {
@@ -127,7 +159,7 @@ void RedmineClient::onIssuesReplyFinished()
 /**
  * @brief Запит деталей будь-якої задачі за ID.
  */
-QNetworkReply* RedmineClient::fetchIssueDetails(const QString& baseUrl, const QString& taskId, const QString& apiKey)
+QNetworkReply* RedmineClient::fetchIssueDetails(const QString& baseUrl, const QString& taskId, const SecureBuffer& apiKey)
 {
     if (baseUrl.isEmpty() || taskId.isEmpty() || apiKey.isEmpty()) {
         logCritical() << "RedmineClient: Cannot fetch details, missing URL, ID or API Key.";
@@ -143,10 +175,11 @@ QNetworkReply* RedmineClient::fetchIssueDetails(const QString& baseUrl, const QS
     url.setPath(url.path() + QString("issues/%1.json").arg(taskId));
 
     QNetworkRequest request(url);
-    request.setRawHeader("X-Redmine-API-Key", apiKey.toUtf8());
+    request.setRawHeader("X-Redmine-API-Key", apiKey.toByteArray());
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
 
     QNetworkReply* reply = m_networkManager->get(request);
+    MetricsRegistry::instance().observeUpstream(reply, "redmine", "fetchIssueDetails");
     connect(reply, &QNetworkReply::finished, this, &RedmineClient::onIssueDetailsReplyFinished);
     return reply;
 }
@@ -154,7 +187,7 @@ QNetworkReply* RedmineClient::fetchIssueDetails(const QString& baseUrl, const QS
 /**
  * @brief Призначає задачу на вказаного користувача.
  */
-QNetworkReply* RedmineClient::assignIssue(const QString& baseUrl, const QString& taskId, const QString& apiKey, int userId)
+QNetworkReply* RedmineClient::assignIssue(const QString& baseUrl, const QString& taskId, const SecureBuffer& apiKey, int userId)
 {
     if (baseUrl.isEmpty() || taskId.isEmpty() || apiKey.isEmpty() || userId <= 0) {
         logCritical() << "RedmineClient: Cannot assign issue, missing URL, ID, Key or User ID.";
@@ -177,11 +210,12 @@ QNetworkReply* RedmineClient::assignIssue(const QString& baseUrl, const QString&
     payload["issue"] = issueObject;
 
     QNetworkRequest request(url);
-    request.setRawHeader("X-Redmine-API-Key", apiKey.toUtf8());
+    request.setRawHeader("X-Redmine-API-Key", apiKey.toByteArray());
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
 
     // Redmine вимагає PUT-запит для оновлення
     QNetworkReply* reply = m_networkManager->put(request, QJsonDocument(payload).toJson());
+    MetricsRegistry::instance().observeUpstream(reply, "redmine", "assignIssue");
     connect(reply, &QNetworkReply::finished, this, &RedmineClient::onAssignIssueReplyFinished);
     return reply;
 }
@@ -233,7 +267,7 @@ void RedmineClient::onAssignIssueReplyFinished()
 
 // RedmineClient.cpp (Додайте новий метод)
 
-QNetworkReply* RedmineClient::fetchCurrentUserId(const QString& baseUrl, const QString& apiKey)
+QNetworkReply* RedmineClient::fetchCurrentUserId(const QString& baseUrl, const SecureBuffer& apiKey)
 {
     if (baseUrl.isEmpty() || apiKey.isEmpty()) {
         logCritical() << "RedmineClient: Cannot fetch current user ID, missing URL or API Key.";
@@ -246,10 +280,11 @@ QNetworkReply* RedmineClient::fetchCurrentUserId(const QString& baseUrl, const Q
     url.setPath(url.path() + "users/current.json");
 
     QNetworkRequest request(url);
-    request.setRawHeader("X-Redmine-API-Key", apiKey.toUtf8());
+    request.setRawHeader("X-Redmine-API-Key", apiKey.toByteArray());
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
 
     QNetworkReply* reply = m_networkManager->get(request);
+    MetricsRegistry::instance().observeUpstream(reply, "redmine", "fetchCurrentUserId");
     connect(reply, &QNetworkReply::finished, this, &RedmineClient::onCurrentUserIdReplyFinished);
 
     // Властивості для синхронного читання WebServer'ом
@@ -295,8 +330,9 @@ void RedmineClient::onCurrentUserIdReplyFinished()
 }
 
 QNetworkReply* RedmineClient::reportTask(const QString& baseUrl, const QString& taskId,
-                                         const QString& apiKey, int redmineUserId,
-                                         const QString& action, const QString& comment)
+                                         const SecureBuffer& apiKey, int redmineUserId,
+                                         const QString& action, const QString& comment,
+                                         const QJsonArray& uploads)
 {
     if (baseUrl.isEmpty() || apiKey.isEmpty() || taskId.isEmpty() || redmineUserId <= 0) {
         logCritical() << "RedmineClient: Cannot report task, missing required parameters.";
@@ -309,7 +345,7 @@ QNetworkReply* RedmineClient::reportTask(const QString& baseUrl, const QString&
     url.setPath(url.path() + "issues/" + taskId + ".json");
 
     QNetworkRequest request(url);
-    request.setRawHeader("X-Redmine-API-Key", apiKey.toUtf8());
+    request.setRawHeader("X-Redmine-API-Key", apiKey.toByteArray());
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
 
     // --- ФОРМУВАННЯ ТІЛА ЗАПИТУ ---
@@ -331,11 +367,17 @@ QNetworkReply* RedmineClient::reportTask(const QString& baseUrl, const QString&
         issueObject["done_ratio"] = 100;
     }
 
+    // 3. Вкладення: токени, отримані від uploadFile
+    if (!uploads.isEmpty()) {
+        issueObject["uploads"] = uploads;
+    }
+
     QJsonObject payload;
     payload["issue"] = issueObject;
 
     // --- ВІДПРАВКА ЗАПИТУ (PUT) ---
     QNetworkReply* reply = m_networkManager->put(request, QJsonDocument(payload).toJson(QJsonDocument::Compact));
+    MetricsRegistry::instance().observeUpstream(reply, "redmine", "reportTask");
     connect(reply, &QNetworkReply::finished, this, &RedmineClient::onReportTaskReplyFinished);
 
     return reply;
@@ -366,8 +408,64 @@ void RedmineClient::onReportTaskReplyFinished()
     reply->deleteLater();
 }
 
+QNetworkReply* RedmineClient::uploadFile(const QString& baseUrl, const SecureBuffer& apiKey,
+                                         const QByteArray& fileData, const QString& fileName)
+{
+    if (baseUrl.isEmpty() || apiKey.isEmpty() || fileData.isEmpty()) {
+        logCritical() << "RedmineClient: Cannot upload file, missing required parameters.";
+        return nullptr;
+    }
+
+    // URL: /uploads.json?filename=<ім'я>
+    QUrl url(baseUrl);
+    if (!url.path().endsWith('/')) url.setPath(url.path() + "/");
+    url.setPath(url.path() + "uploads.json");
+    QUrlQuery query;
+    query.addQueryItem("filename", fileName);
+    url.setQuery(query);
+
+    QNetworkRequest request(url);
+    request.setRawHeader("X-Redmine-API-Key", apiKey.toByteArray());
+    // Redmine приймає лише сирі байти файлу
+    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/octet-stream");
+
+    logInfo() << "RedmineClient: Uploading" << fileName << "(" << fileData.size() << "bytes)";
+
+    QNetworkReply* reply = m_networkManager->post(request, fileData);
+    MetricsRegistry::instance().observeUpstream(reply, "redmine", "uploadFile");
+    connect(reply, &QNetworkReply::finished, this, &RedmineClient::onUploadReplyFinished);
+
+    reply->setProperty("success", false);
+    return reply;
+}
+
+void RedmineClient::onUploadReplyFinished()
+{
+    QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
+    if (!reply) return;
+
+    ApiError error = parseReply(reply);
+    reply->setProperty("success", false);
+
+    // Redmine відповідає 201 Created: {"upload": {"token": "..."}}
+    if (reply->error() == QNetworkReply::NoError && (error.httpStatusCode == 200 || error.httpStatusCode == 201)) {
+        const QString token = QJsonDocument::fromJson(error.responseBody).object()["upload"].toObject()["token"].toString();
+        if (!token.isEmpty()) {
+            reply->setProperty("success", true);
+            reply->setProperty("uploadToken", token);
+        } else {
+            error.errorString = "Invalid response from Redmine: upload token not found.";
+            logWarning() << error.errorString;
+        }
+    } else {
+        logCritical() << "RedmineClient: Upload failed. Error:" << error.errorString;
+    }
+    reply->setProperty("errorDetails", QVariant::fromValue(error));
+    reply->deleteLater();
+}
+
 QNetworkReply* RedmineClient::reportTaskWithAttachments(const QString& baseUrl, const QString& taskId,
-                                                        const QString& apiKey, int redmineUserId,
+                                                        const SecureBuffer& apiKey, int redmineUserId,
                                                         const QString& action, const QString& comment,
                                                         const QList<QByteArray>& fileContents)
 {
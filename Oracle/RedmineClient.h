@@ -9,6 +9,7 @@
 struct ApiError;
 
 class QNetworkAccessManager;
+class SecureBuffer;
 
 class RedmineClient : public QObject
 {
@@ -29,12 +30,15 @@ public:
     };
 
     /**
-     * @brief Надсилає асинхронний запит до Redmine API для отримання відкритих задач
+     * @brief Надсилає асинхронний запит до Redmine API для отримання сторінки відкритих задач
      * @param baseUrl Базовий URL Redmine (напр., http://redmine.mycompany.com)
      * @param apiKey РОЗШИФРОВАНИЙ ключ API користувача
+     * @param offset Зміщення першої задачі сторінки.
+     * @param limit Розмір сторінки; 0 — типовий розмір Redmine.
      * @return QNetworkReply* (потрібен для синхронного очікування на сервері)
+     * Після finished: issuesArray (лише поля списку), totalCount, nextOffset (-1 — сторінок більше немає).
      */
-    QNetworkReply* fetchOpenIssues(const QString& baseUrl, const QString& apiKey);
+    QNetworkReply* fetchOpenIssues(const QString& baseUrl, const SecureBuffer& apiKey, int offset = 0, int limit = 0);
 
     /**
      * @brief Запит деталей будь-якої задачі за ID.
@@ -42,7 +46,7 @@ public:
      * @param apiKey РОЗШИФРОВАНИЙ ключ API користувача.
      * @return QNetworkReply* (потрібен для синхронного очікування).
      */
-    QNetworkReply* fetchIssueDetails(const QString& baseUrl, const QString& taskId, const QString& apiKey);
+    QNetworkReply* fetchIssueDetails(const QString& baseUrl, const QString& taskId, const SecureBuffer& apiKey);
 
     /**
      * @brief Призначає задачу на вказаного користувача.
@@ -51,7 +55,7 @@ public:
      * @param userId ID користувача в Redmine (що має збігатися з нашим User ID).
      * @return QNetworkReply*.
      */
-    QNetworkReply* assignIssue(const QString& baseUrl, const QString& taskId, const QString& apiKey, int userId);
+    QNetworkReply* assignIssue(const QString& baseUrl, const QString& taskId, const SecureBuffer& apiKey, int userId);
 
     /**
      * @brief Отримує ID поточного користувача Redmine за API-ключем.
@@ -59,14 +63,14 @@ public:
      * @param apiKey РОЗШИФРОВАНИЙ ключ API користувача.
      * @return QNetworkReply* (потрібен для синхронного очікування).
      */
-    QNetworkReply* fetchCurrentUserId(const QString& baseUrl, const QString& apiKey);
+    QNetworkReply* fetchCurrentUserId(const QString& baseUrl, const SecureBuffer& apiKey);
 
     /**
      * @brief Додає коментар або закриває задачу в Redmine, включаючи вкладення.
      * @param fileContents Список бінарних даних файлів.
      */
     QNetworkReply* reportTaskWithAttachments(const QString& baseUrl, const QString& taskId,
-                                             const QString& apiKey, int redmineUserId,
+                                             const SecureBuffer& apiKey, int redmineUserId,
                                              const QString& action, const QString& comment,
                                              const QList<QByteArray>& fileContents);
 
@@ -78,11 +82,21 @@ public:
      * @param redmineUserId Числовий ID виконавця Redmine.
      * @param action Дія ("comment" або "close").
      * @param comment Текст коментаря/рішення.
+     * @param uploads Вкладення, вже завантажені через uploadFile: [{"token", "filename"}, ...].
      * @return QNetworkReply*
      */
     QNetworkReply* reportTask(const QString& baseUrl, const QString& taskId,
-                              const QString& apiKey, int redmineUserId,
-                              const QString& action, const QString& comment);
+                              const SecureBuffer& apiKey, int redmineUserId,
+                              const QString& action, const QString& comment,
+                              const QJsonArray& uploads = QJsonArray());
+
+    /**
+     * @brief Завантажує файл у Redmine (POST /uploads.json) для подальшого прикріплення до задачі.
+     * @param apiKey РОЗШИФРОВАНИЙ ключ API користувача.
+     * @return QNetworkReply*. Після finished: success, uploadToken або errorDetails.
+     */
+    QNetworkReply* uploadFile(const QString& baseUrl, const SecureBuffer& apiKey,
+                              const QByteArray& fileData, const QString& fileName);
 
 signals:
     /**
@@ -103,6 +117,7 @@ signals:
 
 
 private slots:
+    void onUploadReplyFinished();
     void onIssuesReplyFinished();
     void onIssueDetailsReplyFinished();
     void onAssignIssueReplyFinished();
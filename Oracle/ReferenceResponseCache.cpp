@@ -0,0 +1,67 @@
+#include "ReferenceResponseCache.h"
+#include "AppParams.h"
+#include "Logger.h"
+#include "Metrics.h"
+
+#include <QDateTime>
+#include <QMutexLocker>
+
+namespace {
+
+// Мітка для метрик: "settings:Gandalf" -> "settings"
+void countLookup(const QString& key, bool hit)
+{
+    MetricsRegistry::instance().counter("reference_cache_requests_total", "Reference data cache lookups.",
+                                        {{"key", key.section(':', 0, 0)}, {"result", hit ? "hit" : "miss"}}).inc();
+}
+
+}
+
+ReferenceResponseCache& ReferenceResponseCache::instance()
+{
+    static ReferenceResponseCache self;
+    return self;
+}
+
+ReferenceResponseCache::ReferenceResponseCache()
+{
+    m_ttlMs = qMax(0, AppParams::instance().getParam("Global", "ReferenceCacheTtlSec", 300).toInt()) * 1000LL;
+}
+
+bool ReferenceResponseCache::lookup(const QString &key, QByteArray *body, quint64 *generation)
+{
+    QMutexLocker locker(&m_mutex);
+    *generation = m_generation;
+
+    auto it = m_entries.constFind(key);
+    const bool hit = it != m_entries.constEnd() && it->expiresAtMs > QDateTime::currentMSecsSinceEpoch();
+    if (hit) *body = it->body;
+    countLookup(key, hit);
+    return hit;
+}
+
+void ReferenceResponseCache::store(const QString &key, const QByteArray &body, quint64 generation)
+{
+    if (m_ttlMs <= 0) return;
+
+    QMutexLocker locker(&m_mutex);
+    // Поки відповідь будувалась, дані змінились — така відповідь уже застаріла
+    if (qMax(m_invalidatedAt.value(key), m_invalidatedAllAt) > generation) return;
+    m_entries.insert(key, {body, QDateTime::currentMSecsSinceEpoch() + m_ttlMs});
+}
+
+void ReferenceResponseCache::invalidate(const QString &key)
+{
+    QMutexLocker locker(&m_mutex);
+    m_invalidatedAt.insert(key, ++m_generation);
+    m_entries.remove(key);
+    logDebug() << "ReferenceResponseCache: invalidated" << key;
+}
+
+void ReferenceResponseCache::invalidateAll()
+{
+    QMutexLocker locker(&m_mutex);
+    m_invalidatedAllAt = ++m_generation;
+    m_entries.clear();
+    logDebug() << "ReferenceResponseCache: invalidated all entries";
+}
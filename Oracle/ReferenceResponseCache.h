@@ -0,0 +1,65 @@
+#ifndef REFERENCERESPONSECACHE_H
+#define REFERENCERESPONSECACHE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+/**
+ * @brief Кеш готових JSON-відповідей для довідкових даних: ролі, методи генерації IP,
+ * список клієнтів, регіони, налаштування програм.
+ *
+ * Дані змінюються рідко, тому зберігаються вже серіалізовані байти. Скидання — адресне,
+ * з тих самих методів DbManager, що пишуть у відповідні таблиці (createClient, updateClient,
+ * saveSettings, завершення синхронізації). Для змін іншими процесами — TTL як страховка.
+ *
+ * Кожне скидання збільшує покоління кешу: відповідь, побудована до скидання, але збережена
+ * після нього, відкидається (store() з застарілим поколінням нічого не робить).
+ *
+ * Налаштування (Global): ReferenceCacheTtlSec (300).
+ */
+class ReferenceResponseCache
+{
+public:
+    static ReferenceResponseCache& instance();
+
+    inline static const QString Roles = QStringLiteral("roles");
+    inline static const QString IpGenMethods = QStringLiteral("ip-gen-methods");
+    inline static const QString Clients = QStringLiteral("clients");
+    inline static const QString Regions = QStringLiteral("regions");
+    static QString settingsKey(const QString& appName) { return "settings:" + appName; }
+
+    /**
+     * @brief Шукає відповідь у кеші.
+     * @param generation Поточне покоління — його треба передати в store() після побудови відповіді.
+     * @return true, якщо знайдено актуальний запис (тоді body заповнено).
+     */
+    bool lookup(const QString& key, QByteArray* body, quint64* generation);
+    void store(const QString& key, const QByteArray& body, quint64 generation);
+
+    void invalidate(const QString& key);
+    void invalidateAll();
+
+private:
+    ReferenceResponseCache();
+    ~ReferenceResponseCache() = default;
+
+    ReferenceResponseCache(const ReferenceResponseCache&) = delete;
+    ReferenceResponseCache& operator=(const ReferenceResponseCache&) = delete;
+
+    struct Entry {
+        QByteArray body;
+        qint64 expiresAtMs = 0;
+    };
+
+private:
+    QMutex m_mutex;
+    QHash<QString, Entry> m_entries;
+    QHash<QString, quint64> m_invalidatedAt; // Ключ -> покоління останнього скидання
+    quint64 m_generation = 0;
+    quint64 m_invalidatedAllAt = 0;
+    qint64 m_ttlMs;
+};
+
+#endif // REFERENCERESPONSECACHE_H
@@ -0,0 +1,240 @@
+#include "SecretCache.h"
+#include "criptpass.h"
+#include "AppParams.h"
+#include "Logger.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QMutexLocker>
+
+#include <cstring>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+qsizetype pageSize()
+{
+#ifdef Q_OS_WIN
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+#else
+    return sysconf(_SC_PAGESIZE);
+#endif
+}
+
+}
+
+// ===================================================================
+// SecureBuffer
+// ===================================================================
+
+SecureBuffer::SecureBuffer(const QByteArray &data)
+    : m_size(data.size())
+{
+    if (m_size == 0) return;
+
+    // Окремі сторінки на кожен буфер: munlock одного буфера не розблоковує сусідній
+    const qsizetype page = pageSize();
+    m_allocated = (m_size + page - 1) / page * page;
+
+#ifdef Q_OS_WIN
+    m_data = static_cast<char*>(VirtualAlloc(nullptr, m_allocated, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+    if (m_data) m_locked = VirtualLock(m_data, m_allocated) != 0;
+#else
+    void* mem = mmap(nullptr, m_allocated, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    m_data = mem == MAP_FAILED ? nullptr : static_cast<char*>(mem);
+    if (m_data) m_locked = mlock(m_data, m_allocated) == 0;
+#endif
+
+    if (!m_data) {
+        logWarning() << "SecureBuffer: Cannot allocate" << m_allocated << "bytes";
+        m_size = m_allocated = 0;
+        return;
+    }
+
+    // Ліміт заблокованої пам'яті (RLIMIT_MEMLOCK) не є фатальним: буфер все одно затирається
+    static bool lockWarned = false;
+    if (!m_locked && !lockWarned) {
+        lockWarned = true;
+        logWarning() << "SecureBuffer: Memory locking is not available, secrets may be swapped out.";
+    }
+
+    memcpy(m_data, data.constData(), m_size);
+}
+
+SecureBuffer::~SecureBuffer()
+{
+    if (!m_data) return;
+
+    wipe(m_data, m_allocated);
+#ifdef Q_OS_WIN
+    if (m_locked) VirtualUnlock(m_data, m_allocated);
+    VirtualFree(m_data, 0, MEM_RELEASE);
+#else
+    if (m_locked) munlock(m_data, m_allocated);
+    munmap(m_data, m_allocated);
+#endif
+}
+
+QByteArray SecureBuffer::toByteArray(const QByteArray &prefix) const
+{
+    // Один виділений буфер потрібного розміру: append не перевиділяє, тож проміжних копій не лишається
+    QByteArray result;
+    result.reserve(prefix.size() + m_size);
+    result.append(prefix.constData(), prefix.size());
+    result.append(m_data, m_size);
+    return result;
+}
+
+QString SecureBuffer::toString() const
+{
+    return QString::fromUtf8(m_data, m_size);
+}
+
+void SecureBuffer::wipe(void *data, qsizetype size)
+{
+    if (!data || size <= 0) return;
+#ifdef Q_OS_WIN
+    SecureZeroMemory(data, size);
+#else
+    // volatile — щоб компілятор не викинув запис у пам'ять, яку далі ніхто не читає
+    volatile char* p = static_cast<volatile char*>(data);
+    while (size--) *p++ = 0;
+#endif
+}
+
+void SecureBuffer::wipe(QByteArray &data)
+{
+    // Спільну (implicitly shared) копію не чіпаємо: data() відокремив би новий буфер, а старий лишився б
+    if (!data.isDetached()) {
+        data.clear();
+        return;
+    }
+    wipe(data.data(), data.size());
+    data.clear();
+}
+
+void SecureBuffer::wipe(QString &data)
+{
+    if (!data.isDetached()) {
+        data.clear();
+        return;
+    }
+    wipe(data.data(), data.size() * qsizetype(sizeof(QChar)));
+    data.clear();
+}
+
+// ===================================================================
+// SecretCache
+// ===================================================================
+
+SecretCache& SecretCache::instance()
+{
+    static SecretCache self;
+    return self;
+}
+
+SecretCache::SecretCache()
+{
+    m_ttlMs = qMax(0, AppParams::instance().getParam("Global", "SecretCacheTtlSec", 600).toInt()) * 1000LL;
+    m_maxEntries = qMax(1, AppParams::instance().getParam("Global", "SecretCacheMaxEntries", 512).toInt());
+}
+
+SecretCache::Secret SecretCache::acquire(const QString &ciphertext, const QString &owner)
+{
+    static const Secret empty = std::make_shared<const SecureBuffer>();
+    if (ciphertext.isEmpty()) return empty;
+
+    const QByteArray key = QCryptographicHash::hash(ciphertext.toUtf8(), QCryptographicHash::Sha256);
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+
+    {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_entries.find(key);
+        if (it != m_entries.end() && it->expiresAtMs > nowMs) {
+            if (!owner.isEmpty()) it->owner = owner;
+            return it->plain;
+        }
+    }
+
+    // AES — поза м'ютексом кешу: CriptPass має власний
+    QByteArray plain = CriptPass::instance().decriptPassBytes(ciphertext);
+    const Secret buffer = std::make_shared<const SecureBuffer>(plain);
+    SecureBuffer::wipe(plain);
+
+    QMutexLocker locker(&m_mutex);
+    Entry& entry = m_entries[key];
+    entry.plain = buffer;
+    entry.owner = owner;
+    entry.expiresAtMs = nowMs + m_ttlMs;
+    evictOverflow(nowMs);
+
+    return buffer;
+}
+
+void SecretCache::invalidateOwner(const QString &owner)
+{
+    if (owner.isEmpty()) return;
+
+    QMutexLocker locker(&m_mutex);
+    int removed = 0;
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it->owner == owner) {
+            it = m_entries.erase(it);
+            ++removed;
+        } else {
+            ++it;
+        }
+    }
+    if (removed > 0) {
+        logDebug() << "SecretCache: Invalidated" << removed << "secret(s) of" << owner;
+    }
+}
+
+void SecretCache::invalidateUsers()
+{
+    QMutexLocker locker(&m_mutex);
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it->owner.startsWith("user:")) it = m_entries.erase(it);
+        else ++it;
+    }
+}
+
+void SecretCache::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_entries.clear();
+}
+
+int SecretCache::size() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_entries.size();
+}
+
+void SecretCache::evictOverflow(qint64 nowMs)
+{
+    if (m_entries.size() <= m_maxEntries) return;
+
+    // Спершу прострочені
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it->expiresAtMs <= nowMs) it = m_entries.erase(it);
+        else ++it;
+    }
+
+    // Далі — ті, що протермінуються найраніше
+    while (m_entries.size() > m_maxEntries) {
+        auto oldest = m_entries.begin();
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+            if (it->expiresAtMs < oldest->expiresAtMs) oldest = it;
+        }
+        m_entries.erase(oldest);
+    }
+}
@@ -0,0 +1,110 @@
+#ifndef SECRETCACHE_H
+#define SECRETCACHE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <memory>
+
+/**
+ * @brief Буфер для відкритого тексту секрету: пам'ять заблокована від свопу
+ * (mlock / VirtualLock) і затирається нулями при звільненні.
+ *
+ * Байти беруться прямо з data()/size(). Копії для Qt API, що приймають лише
+ * QString/QByteArray (QSqlDatabase::setPassword, заголовок QNetworkRequest), живуть поза
+ * буфером: викликач тримає їх якомога коротше і затирає своїми wipe().
+ */
+class SecureBuffer
+{
+public:
+    SecureBuffer() = default;
+    explicit SecureBuffer(const QByteArray& data);
+    ~SecureBuffer();
+
+    SecureBuffer(const SecureBuffer&) = delete;
+    SecureBuffer& operator=(const SecureBuffer&) = delete;
+
+    const char* data() const { return m_data; }
+    qsizetype size() const { return m_size; }
+    bool isEmpty() const { return m_size == 0; }
+
+    // Копія з префіксом (напр. "Bearer ") — для значення, яке забирає собі Qt (заголовок запиту)
+    QByteArray toByteArray(const QByteArray& prefix = QByteArray()) const;
+    // Копія для API, що приймають лише QString; після використання — wipe(QString&)
+    QString toString() const;
+
+    // Затирає пам'ять, яку не контролює SecureBuffer (тимчасові QByteArray тощо)
+    static void wipe(void* data, qsizetype size);
+    static void wipe(QByteArray& data);
+    static void wipe(QString& data);
+
+private:
+    char* m_data = nullptr;
+    qsizetype m_size = 0;
+    qsizetype m_allocated = 0; // Цілі сторінки: mlock/munlock діють посторінково
+    bool m_locked = false;
+};
+
+/**
+ * @brief Кеш розшифрованих секретів: токени Jira/Redmine користувачів, паролі БД і VNC клієнтів.
+ *
+ * Ключ — SHA-256 шифротексту, тож повторний запит того самого токена не платить
+ * за Base64 + AES. Відкритий текст тримається у SecureBuffer з TTL і віддається
+ * спільним дескриптором (Secret), а не копією в QString: буфер живе, доки його тримає
+ * кеш або хоч один викликач, і затирається, коли відпустять усі.
+ * Власник (owner) дозволяє адресно скинути записи, коли користувача чи клієнта оновлено.
+ * Потокобезпечний: викликається з обробників WebServer і потоків синхронізації.
+ *
+ * Налаштування (Global): SecretCacheTtlSec (600), SecretCacheMaxEntries (512).
+ */
+class SecretCache
+{
+public:
+    static SecretCache& instance();
+
+    using Secret = std::shared_ptr<const SecureBuffer>;
+
+    /**
+     * @brief Розшифровує секрет або бере його з кешу.
+     * @param ciphertext Зашифрований рядок (Base64, як його зберігає CriptPass).
+     * @param owner Власник секрету: userOwner() або clientOwner().
+     * @return Дескриптор відкритого тексту (ніколи не nullptr); порожній буфер для порожнього шифротексту.
+     * Тримайте дескриптор лише на час запиту, що використовує секрет.
+     */
+    Secret acquire(const QString& ciphertext, const QString& owner = QString());
+
+    // Скидає всі секрети власника (після оновлення користувача/клієнта)
+    void invalidateOwner(const QString& owner);
+    // Скидає секрети всіх користувачів (USERS змінено ззовні — невідомо, чиї саме)
+    void invalidateUsers();
+    void clear();
+    // Кількість записів (діагностика)
+    int size() const;
+
+    static QString userOwner(int userId) { return "user:" + QString::number(userId); }
+    static QString clientOwner(int clientId) { return "client:" + QString::number(clientId); }
+
+private:
+    SecretCache();
+    ~SecretCache() = default;
+
+    SecretCache(const SecretCache&) = delete;
+    SecretCache& operator=(const SecretCache&) = delete;
+
+    struct Entry {
+        Secret plain;
+        QString owner;
+        qint64 expiresAtMs = 0;
+    };
+
+    void evictOverflow(qint64 nowMs);
+
+private:
+    mutable QMutex m_mutex;
+    QHash<QByteArray, Entry> m_entries; // SHA-256 шифротексту -> секрет
+    qint64 m_ttlMs;
+    int m_maxEntries;
+};
+
+#endif // SECRETCACHE_H
@@ -9,6 +9,8 @@ struct StationStruct {
     int terminalId;
     QString clientName; // З таблиці CLIENTS
     QString address;
+    QString name;       // NAME (заповнюється з локального довідника)
+    QString regionName; // REGION_NAME (заповнюється з локального довідника)
     bool isActive;      // IS_ACTIVE
     bool isWork;        // IS_WORK
 };
@@ -0,0 +1,38 @@
+#include "SyncEventBus.h"
+#include <QDateTime>
+
+SyncEventBus& SyncEventBus::instance()
+{
+    static SyncEventBus self;
+    return self;
+}
+
+SyncEventBus::SyncEventBus(QObject* parent) : QObject(parent)
+{
+}
+
+void SyncEventBus::publish(int clientId, const QString& status, const QString& message, const QJsonObject& extra)
+{
+    QJsonObject event = extra;
+    event["type"] = "sync";
+    event["client_id"] = clientId;
+    event["status"] = status;
+    event["message"] = message;
+    event["timestamp"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+
+    emit syncEvent(event);
+}
+
+void SyncEventBus::publishTaskProgress(int clientId, const QString& taskName, const QString& targetTable,
+                                       int rows, int totalProcessed)
+{
+    QJsonObject extra;
+    extra["task"] = taskName;
+    extra["table"] = targetTable;
+    extra["rows"] = rows;
+    extra["processed"] = totalProcessed;
+
+    publish(clientId, "RUNNING",
+            QString("%1: %2 рядків (всього %3)").arg(taskName).arg(rows).arg(totalProcessed),
+            extra);
+}
@@ -0,0 +1,47 @@
+#ifndef SYNCEVENTBUS_H
+#define SYNCEVENTBUS_H
+
+#include <QObject>
+#include <QJsonObject>
+
+/**
+ * @brief Шина подій життєвого циклу синхронізації клієнтів.
+ *
+ * DbManager та WebServer публікують сюди події (QUEUED, RUNNING з прогресом
+ * по завданнях, SUCCESS/ERROR), а Conduit розсилає їх підписаним GUI через WebSocket.
+ * publish() можна викликати з будь-якого потоку: сигнал доставляється
+ * отримувачам у їхніх потоках (AutoConnection).
+ */
+class SyncEventBus : public QObject
+{
+    Q_OBJECT
+public:
+    static SyncEventBus& instance();
+
+    /**
+     * @brief Публікує подію синхронізації.
+     * @param clientId ID клієнта.
+     * @param status QUEUED | RUNNING | SUCCESS | ERROR.
+     * @param message Людиночитне повідомлення (як у SYNC_STATUS.LAST_SYNC_MESSAGE).
+     * @param extra Додаткові поля (task, table, rows, processed ...).
+     */
+    void publish(int clientId, const QString& status, const QString& message,
+                 const QJsonObject& extra = QJsonObject());
+
+    /**
+     * @brief Прогрес одного завдання експорту під час RUNNING.
+     */
+    void publishTaskProgress(int clientId, const QString& taskName, const QString& targetTable,
+                             int rows, int totalProcessed);
+
+signals:
+    // Готовий JSON події: {"type":"sync","client_id":..,"status":..,"message":..,"timestamp":..,...}
+    void syncEvent(const QJsonObject& event);
+
+private:
+    explicit SyncEventBus(QObject* parent = nullptr);
+    SyncEventBus(const SyncEventBus&) = delete;
+    SyncEventBus& operator=(const SyncEventBus&) = delete;
+};
+
+#endif // SYNCEVENTBUS_H
@@ -0,0 +1,204 @@
+#include "Tracing.h"
+#include "AppParams.h"
+#include "Logger.h"
+
+#include <QDateTime>
+#include <QMutexLocker>
+#include <QNetworkReply>
+#include <QRandomGenerator>
+
+namespace {
+// Запит, що викликає DbManager у циклі, не повинен роздувати трасу
+const int kMaxSpansPerTrace = 256;
+}
+
+// ===================================================================
+// Trace
+// ===================================================================
+
+Trace::Trace(const QString &requestId, const QString &name)
+    : m_requestId(requestId)
+    , m_name(name)
+    , m_startedAtMs(QDateTime::currentMSecsSinceEpoch())
+{
+    m_timer.start();
+}
+
+void Trace::addSpan(const QString &name, qint64 startUs, qint64 durationUs, int depth)
+{
+    if (m_spans.size() >= kMaxSpansPerTrace) {
+        ++m_droppedSpans;
+        return;
+    }
+    m_spans.append({name, startUs, durationUs, depth});
+}
+
+void Trace::finish(int status)
+{
+    m_status = status;
+    m_durationUs = elapsedUs();
+    m_finished = true;
+}
+
+QString Trace::summary() const
+{
+    QStringList parts;
+    parts.reserve(m_spans.size());
+    for (const Span& span : m_spans) {
+        parts << QString("%1%2 %3ms").arg(QString(span.depth * 2, ' '), span.name)
+                                      .arg(span.durationUs / 1000.0, 0, 'f', 1);
+    }
+    QString line = QString("%1 %2 status=%3 total=%4ms")
+                       .arg(m_requestId, m_name).arg(m_status).arg(m_durationUs / 1000.0, 0, 'f', 1);
+    if (!parts.isEmpty()) line += " | " + parts.join(", ");
+    if (m_droppedSpans > 0) line += QString(" (+%1 spans dropped)").arg(m_droppedSpans);
+    return line;
+}
+
+QJsonObject Trace::toJson() const
+{
+    QJsonArray spans;
+    for (const Span& span : m_spans) {
+        spans.append(QJsonObject{
+            {"name", span.name},
+            {"start_ms", span.startUs / 1000.0},
+            {"duration_ms", span.durationUs / 1000.0},
+            {"depth", span.depth}
+        });
+    }
+    return QJsonObject{
+        {"request_id", m_requestId},
+        {"name", m_name},
+        {"started_at", QDateTime::fromMSecsSinceEpoch(m_startedAtMs).toString(Qt::ISODateWithMs)},
+        {"status", m_status},
+        {"duration_ms", m_durationUs / 1000.0},
+        {"dropped_spans", m_droppedSpans},
+        {"spans", spans}
+    };
+}
+
+// ===================================================================
+// Tracer
+// ===================================================================
+
+Tracer& Tracer::instance()
+{
+    static Tracer self;
+    return self;
+}
+
+Tracer::Tracer()
+{
+    m_slowMs = qMax(0, AppParams::instance().getParam("Global", "TraceSlowMs", 500).toInt());
+    m_ringSize = qMax(1, AppParams::instance().getParam("Global", "TraceRingSize", 200).toInt());
+}
+
+QString Tracer::newRequestId()
+{
+    return QString::number(QRandomGenerator::global()->generate64(), 16).rightJustified(16, '0');
+}
+
+QString Tracer::acceptRequestId(const QByteArray &header)
+{
+    if (header.isEmpty() || header.size() > 64) return newRequestId();
+    for (const char c : header) {
+        const bool allowed = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')
+                             || c == '-' || c == '_' || c == '.';
+        if (!allowed) return newRequestId();
+    }
+    return QString::fromLatin1(header);
+}
+
+std::shared_ptr<Trace>& Tracer::currentSlot()
+{
+    thread_local std::shared_ptr<Trace> slot;
+    return slot;
+}
+
+std::shared_ptr<Trace> Tracer::current()
+{
+    return currentSlot();
+}
+
+std::shared_ptr<Trace> Tracer::begin(const QString &requestId, const QString &name)
+{
+    return std::make_shared<Trace>(requestId, name);
+}
+
+void Tracer::finish(const std::shared_ptr<Trace> &trace, int status)
+{
+    if (!trace) return;
+    trace->finish(status);
+
+    if (trace->durationUs() >= m_slowMs * 1000) {
+        logWarning().noquote() << "Slow request" << trace->summary();
+    }
+
+    QMutexLocker locker(&m_mutex);
+    m_ring.prepend(trace);
+    while (m_ring.size() > m_ringSize) m_ring.removeLast();
+}
+
+QJsonArray Tracer::recent(int limit, bool slowOnly) const
+{
+    QJsonArray traces;
+    QMutexLocker locker(&m_mutex);
+    for (const auto& trace : m_ring) {
+        if (traces.size() >= limit) break;
+        if (slowOnly && trace->durationUs() < m_slowMs * 1000) continue;
+        traces.append(trace->toJson());
+    }
+    return traces;
+}
+
+// ===================================================================
+// TraceScope / TraceSpan
+// ===================================================================
+
+TraceScope::TraceScope(const std::shared_ptr<Trace> &trace)
+    : m_previous(Tracer::currentSlot())
+{
+    Tracer::currentSlot() = trace;
+}
+
+TraceScope::~TraceScope()
+{
+    Tracer::currentSlot() = m_previous;
+}
+
+TraceSpan::TraceSpan(const char *category, const char *name)
+    : m_trace(Tracer::currentSlot().get())
+    , m_category(category)
+    , m_name(name)
+{
+    if (!m_trace) return;
+    m_startUs = m_trace->elapsedUs();
+    m_depth = m_trace->m_depth++;
+}
+
+TraceSpan::~TraceSpan()
+{
+    if (!m_trace) return;
+    --m_trace->m_depth;
+
+    QString name = QString::fromLatin1(m_category);
+    if (m_name) name += '.' + QString::fromLatin1(m_name);
+    m_trace->addSpan(name, m_startUs, m_trace->elapsedUs() - m_startUs, m_depth);
+}
+
+void traceReply(QNetworkReply *reply, const QString &name)
+{
+    const std::shared_ptr<Trace> trace = Tracer::current();
+    if (!reply || !trace) return;
+
+    // Відповідь може прийти вже після завершення запиту (фонове оновлення) — тоді трасу не тримаємо,
+    // а якщо вона ще жива в кільці — відрізок відкидаємо: завершена траса не змінюється
+    const std::weak_ptr<Trace> weakTrace = trace;
+    const qint64 startUs = trace->elapsedUs();
+    const int depth = trace->m_depth;
+    QObject::connect(reply, &QNetworkReply::finished, reply, [weakTrace, name, startUs, depth]() {
+        const std::shared_ptr<Trace> owner = weakTrace.lock();
+        if (!owner || owner->isFinished()) return;
+        owner->addSpan(name, startUs, owner->elapsedUs() - startUs, depth);
+    });
+}
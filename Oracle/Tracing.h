@@ -0,0 +1,146 @@
+#ifndef TRACING_H
+#define TRACING_H
+
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QList>
+#include <QMutex>
+#include <QString>
+
+#include <memory>
+
+class QNetworkReply;
+
+/**
+ * @brief Трасування одного запиту Conduit: ID запиту та відрізки часу (spans) — auth, db.*, json, upstream.*.
+ *
+ * Трасу веде потік, що обробляє запит; DbManager та клієнти трекерів додають відрізки
+ * до поточної траси потоку (Tracer::current()). Без активної траси відрізки нічого не коштують.
+ */
+class Trace
+{
+public:
+    struct Span {
+        QString name;
+        qint64 startUs = 0;    // Від початку запиту
+        qint64 durationUs = 0;
+        int depth = 0;         // Вкладеність (db.* всередині auth тощо)
+    };
+
+    Trace(const QString& requestId, const QString& name);
+
+    const QString& requestId() const { return m_requestId; }
+    const QString& name() const { return m_name; }
+    int status() const { return m_status; }
+    qint64 durationUs() const { return m_durationUs; }
+    // Після finish() траса вже в кільці Tracer і читається звідти — нові відрізки не додаються
+    bool isFinished() const { return m_finished; }
+
+    qint64 elapsedUs() const { return m_timer.nsecsElapsed() / 1000; }
+    void addSpan(const QString& name, qint64 startUs, qint64 durationUs, int depth);
+    void finish(int status);
+
+    // Один рядок для журналу: "<id> GET /route status=200 total=812.0ms | auth 2.1ms, db.getObjects 640.3ms"
+    QString summary() const;
+    QJsonObject toJson() const;
+
+private:
+    friend class TraceSpan;
+
+    QString m_requestId;
+    QString m_name;
+    qint64 m_startedAtMs;
+    QElapsedTimer m_timer;
+    QList<Span> m_spans;
+    int m_droppedSpans = 0;
+    int m_depth = 0;
+    int m_status = 0;
+    qint64 m_durationUs = 0;
+    bool m_finished = false;
+};
+
+/**
+ * @brief Траси процесу: поточна траса потоку, кільце останніх трас, журнал повільних запитів.
+ *
+ * Налаштування (Global): TraceSlowMs (500) — поріг для запису в журнал, TraceRingSize (200).
+ */
+class Tracer
+{
+public:
+    static Tracer& instance();
+
+    // Короткий випадковий ID (16 hex-символів)
+    static QString newRequestId();
+    // ID із заголовка X-Request-ID, якщо він безпечний (літери, цифри, "-", "_", "."), інакше новий
+    static QString acceptRequestId(const QByteArray& header);
+
+    static std::shared_ptr<Trace> current();
+
+    std::shared_ptr<Trace> begin(const QString& requestId, const QString& name);
+    // Завершує трасу: у кільце, а якщо довша за поріг — рядок у журнал
+    void finish(const std::shared_ptr<Trace>& trace, int status);
+
+    // Останні траси, новіші першими; slowOnly — лише ті, що перевищили поріг
+    QJsonArray recent(int limit, bool slowOnly) const;
+    qint64 slowThresholdMs() const { return m_slowMs; }
+
+private:
+    Tracer();
+    ~Tracer() = default;
+
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    friend class TraceScope;
+    static std::shared_ptr<Trace>& currentSlot();
+
+private:
+    mutable QMutex m_mutex;
+    QList<std::shared_ptr<const Trace>> m_ring;
+    int m_ringSize;
+    qint64 m_slowMs;
+};
+
+/**
+ * @brief Робить трасу поточною для потоку до кінця області видимості.
+ * Попередня траса відновлюється: обробник, що чекає у вкладеному QEventLoop, отримає свою назад.
+ */
+class TraceScope
+{
+public:
+    explicit TraceScope(const std::shared_ptr<Trace>& trace);
+    ~TraceScope();
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    std::shared_ptr<Trace> m_previous;
+};
+
+/**
+ * @brief Відрізок часу в поточній трасі: TraceSpan span("db", __func__) -> "db.loadUser".
+ * category і name мають жити до кінця відрізка (рядкові літерали, __func__).
+ */
+class TraceSpan
+{
+public:
+    explicit TraceSpan(const char* category, const char* name = nullptr);
+    ~TraceSpan();
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    Trace* m_trace = nullptr;
+    const char* m_category;
+    const char* m_name;
+    qint64 m_startUs = 0;
+    int m_depth = 0;
+};
+
+// Відрізок для асинхронного запиту: від цього моменту до finished відповіді, у трасі, активній зараз
+void traceReply(QNetworkReply* reply, const QString& name);
+
+#endif // TRACING_H
@@ -0,0 +1,131 @@
+// Мікробенчмарк QAESEncryption: пропускна здатність рушіїв (Portable / TTable / AesNi)
+// і вартість одного виклику в стилі CriptPass (з розширенням ключа на кожен виклик і без).
+//
+// Запуск: aes_bench [кількість ітерацій коротких викликів, за замовчуванням 20000]
+
+#include "Oracle/qaesencryption.h"
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QElapsedTimer>
+#include <QList>
+#include <QTextStream>
+
+namespace {
+
+const QByteArray kKey = QCryptographicHash::hash("bench-key", QCryptographicHash::Sha256);
+const QByteArray kIV = QCryptographicHash::hash("bench-iv", QCryptographicHash::Md5);
+
+QTextStream& out()
+{
+    static QTextStream stream(stdout);
+    return stream;
+}
+
+QString engineName(QAESEncryption::Engine engine)
+{
+    switch (engine) {
+    case QAESEncryption::Portable: return "Portable";
+    case QAESEncryption::TTable:   return "TTable";
+    case QAESEncryption::AesNi:    return "AesNi";
+    }
+    return "?";
+}
+
+// Шифрування/розшифрування великого буфера одним об'єктом: чиста швидкість блочного шифру
+void benchThroughput(QAESEncryption::Engine engine, const QByteArray& plain)
+{
+    QAESEncryption aes(QAESEncryption::AES_256, QAESEncryption::CBC);
+    aes.setEngine(engine);
+    aes.prepareKey(kKey);
+
+    const int rounds = 20;
+    QElapsedTimer timer;
+
+    timer.start();
+    QByteArray cipher;
+    for (int i = 0; i < rounds; ++i) cipher = aes.encode(plain, kKey, kIV);
+    const double encMs = timer.nsecsElapsed() / 1e6;
+
+    timer.restart();
+    QByteArray decoded;
+    for (int i = 0; i < rounds; ++i) decoded = aes.decode(cipher, kKey, kIV);
+    const double decMs = timer.nsecsElapsed() / 1e6;
+
+    const double mb = double(plain.size()) * rounds / (1024.0 * 1024.0);
+    out() << QString("  %1  encrypt %2 MB/s   decrypt %3 MB/s\n")
+                 .arg(engineName(engine), -8)
+                 .arg(mb / (encMs / 1000.0), 9, 'f', 1)
+                 .arg(mb / (decMs / 1000.0), 9, 'f', 1);
+}
+
+// Розшифрування короткого пароля, як у CriptPass::decriptPass
+void benchShortCalls(QAESEncryption::Engine engine, const QByteArray& cipher, int iterations)
+{
+    QElapsedTimer timer;
+
+    // Як було: новий об'єкт і розширення ключа на кожен виклик
+    timer.start();
+    for (int i = 0; i < iterations; ++i) {
+        QAESEncryption aes(QAESEncryption::AES_256, QAESEncryption::CBC);
+        aes.setEngine(engine);
+        aes.removePadding(aes.decode(cipher, kKey, kIV));
+    }
+    const double perCallUs = timer.nsecsElapsed() / 1e3 / iterations;
+
+    // Як стало: один об'єкт з підготовленим розкладом ключа
+    QAESEncryption aes(QAESEncryption::AES_256, QAESEncryption::CBC);
+    aes.setEngine(engine);
+    aes.prepareKey(kKey);
+    timer.restart();
+    for (int i = 0; i < iterations; ++i) {
+        aes.removePadding(aes.decode(cipher, kKey, kIV));
+    }
+    const double reusedUs = timer.nsecsElapsed() / 1e3 / iterations;
+
+    out() << QString("  %1  new object %2 us/call   reused context %3 us/call\n")
+                 .arg(engineName(engine), -8)
+                 .arg(perCallUs, 8, 'f', 2)
+                 .arg(reusedUs, 8, 'f', 2);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    const QStringList args = app.arguments();
+    const int iterations = args.size() > 1 ? qMax(1, args.at(1).toInt()) : 20000;
+
+    QList<QAESEncryption::Engine> engines = { QAESEncryption::Portable, QAESEncryption::TTable };
+    if (QAESEncryption::bestEngine() == QAESEncryption::AesNi) engines << QAESEncryption::AesNi;
+
+    QByteArray plain(64 * 1024, Qt::Uninitialized);
+    for (int i = 0; i < plain.size(); ++i) plain[i] = char(i * 31 + 7);
+
+    // Спершу перевірка: усі рушії мають давати однаковий шифротекст і повертати вихідні дані
+    const QByteArray reference = QAESEncryption::Crypt(QAESEncryption::AES_256, QAESEncryption::CBC, plain, kKey, kIV);
+    for (QAESEncryption::Engine engine : engines) {
+        QAESEncryption aes(QAESEncryption::AES_256, QAESEncryption::CBC);
+        aes.setEngine(engine);
+        const QByteArray cipher = aes.encode(plain, kKey, kIV);
+        if (cipher != reference || aes.removePadding(aes.decode(cipher, kKey, kIV)) != plain) {
+            out() << "MISMATCH: engine " << engineName(engine) << " differs from reference\n";
+            return 1;
+        }
+    }
+
+    out() << "AES-256-CBC, best engine: " << engineName(QAESEncryption::bestEngine()) << "\n\n";
+
+    out() << "Throughput, " << plain.size() / 1024 << " KiB buffer:\n";
+    for (QAESEncryption::Engine engine : engines) benchThroughput(engine, plain);
+
+    const QByteArray password = QAESEncryption::Crypt(QAESEncryption::AES_256, QAESEncryption::CBC,
+                                                      "00112secret-password12", kKey, kIV);
+    out() << "\nShort password decrypt (CriptPass::decriptPass), " << iterations << " calls:\n";
+    for (QAESEncryption::Engine engine : engines) benchShortCalls(engine, password, iterations);
+
+    out().flush();
+    return 0;
+}
@@ -2,7 +2,10 @@
 #include "qaesencryption.h"
 // Вам потрібно буде створити файл AppSettings.h або замінити на реальні значення
 #include "AppParams.h" // Умовно, що цей файл є в Oracle
+#include "Logger.h"
+#include "SecretCache.h"
 #include <QCryptographicHash>
+#include <QMutexLocker>
 
 // Реалізація синглтона
 CriptPass& CriptPass::instance()
@@ -19,21 +22,38 @@ CriptPass::CriptPass()
 
     hashKey = QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha256);
     hashIV = QCryptographicHash::hash(iv.toUtf8(), QCryptographicHash::Md5);
+
+    m_aes = std::make_unique<QAESEncryption>(QAESEncryption::AES_256, QAESEncryption::CBC);
+    m_aes->prepareKey(hashKey);
+    logDebug() << "CriptPass: AES engine" << m_aes->engine();
 }
 
+CriptPass::~CriptPass() = default;
+
 QString CriptPass::criptPass(const QString& password)
 {
-    QAESEncryption encryption(QAESEncryption::AES_256, QAESEncryption::CBC);
-    QByteArray encodeText = encryption.encode(password.toUtf8(), hashKey, hashIV);
+    QMutexLocker locker(&m_aesMutex);
+    QByteArray encodeText = m_aes->encode(password.toUtf8(), hashKey, hashIV);
     return QString(encodeText.toBase64());
 }
 
 QString CriptPass::decriptPass(const QString& password)
 {
-    QAESEncryption encryption(QAESEncryption::AES_256, QAESEncryption::CBC);
+    QByteArray plain = decriptPassBytes(password);
+    const QString result = QString::fromUtf8(plain);
+    SecureBuffer::wipe(plain);
+    return result;
+}
+
+QByteArray CriptPass::decriptPassBytes(const QString& password)
+{
     QByteArray encodeText = QByteArray::fromBase64(password.toUtf8());
-    QByteArray decodeText = encryption.decode(encodeText, hashKey, hashIV);
-    return QString::fromUtf8(encryption.removePadding(decodeText));
+
+    QMutexLocker locker(&m_aesMutex);
+    QByteArray decodeText = m_aes->decode(encodeText, hashKey, hashIV);
+    QByteArray plain = m_aes->removePadding(decodeText);
+    SecureBuffer::wipe(decodeText);
+    return plain;
 }
 
 // ... решта методів залишається без змін ...
@@ -44,8 +64,10 @@ QString CriptPass::cryptVNCPass(const QString& termID, const QString& pass)
     while (termID_copy.length() < desiredLength) {
         termID_copy.prepend('0');
     }
-    QString password = termID_copy.right(3) + pass + termID_copy.left(2);
-    password = criptPass(password);
+    // Посолений відкритий текст затираємо, щойно він зашифрований
+    QString salted = termID_copy.right(3) + pass + termID_copy.left(2);
+    const QString password = criptPass(salted);
+    SecureBuffer::wipe(salted);
     return password;
 }
 
@@ -3,6 +3,10 @@
 
 #include <QString>
 #include <QByteArray>
+#include <QMutex>
+#include <memory>
+
+class QAESEncryption;
 
 class CriptPass
 {
@@ -12,12 +16,14 @@ public:
 
     QString criptPass(const QString& password);
     QString decriptPass(const QString& password);
+    // Те саме, але в UTF-8 байтах: проміжні буфери затерто, результат затирає викликач (див. SecretCache)
+    QByteArray decriptPassBytes(const QString& password);
     QString cryptVNCPass(const QString& termID, const QString& pass);
     QString decryptVNCPass(const QString& pass);
 
 private:
     CriptPass(); // Конструктор тепер приватний
-    ~CriptPass() = default;
+    ~CriptPass();
 
     // Забороняємо копіювання, щоб гарантувати унікальність екземпляра
     CriptPass(const CriptPass&) = delete;
@@ -25,6 +31,11 @@ private:
 
     QByteArray hashKey;
     QByteArray hashIV;
+
+    // Один шифратор на весь процес: ключ розширюється один раз у конструкторі,
+    // далі кожен виклик лише шифрує блоки. Об'єкт має внутрішній стан, тому під м'ютексом.
+    std::unique_ptr<QAESEncryption> m_aes;
+    QMutex m_aesMutex;
 };
 
 #endif // CRIPTPASS_H
@@ -1,5 +1,7 @@
 #include "qaesencryption.h"
 
+#include <cstring>
+
 #ifdef USE_INTEL_AES_IF_AVAILABLE
 #include "aesni/aesni-key-exp.h"
 #include "aesni/aesni-key-init.h"
@@ -27,6 +29,15 @@ QByteArray QAESEncryption::ExpandKey(QAESEncryption::Aes level, QAESEncryption::
      return QAESEncryption(level, mode).expandKey(key, isEncryptionKey);
 }
 
+QAESEncryption::Engine QAESEncryption::bestEngine()
+{
+#ifdef USE_INTEL_AES_IF_AVAILABLE
+    if (check_aesni_support())
+        return AesNi;
+#endif
+    return TTable;
+}
+
 QByteArray QAESEncryption::RemovePadding(const QByteArray &rawText, QAESEncryption::Padding padding)
 {
     if (rawText.isEmpty())
@@ -93,6 +104,62 @@ quint8 multiply(quint8 x, quint8 y)
             * xTime(xTime(xTime(x)))) ^ ((y>>4 & 1) * xTime(xTime(xTime(xTime(x))))));
 }
 
+quint32 rotr8(quint32 w)
+{
+    return (w >> 8) | (w << 24);
+}
+
+quint32 loadBigEndian(const quint8 *p)
+{
+    return (quint32(p[0]) << 24) | (quint32(p[1]) << 16) | (quint32(p[2]) << 8) | quint32(p[3]);
+}
+
+void storeBigEndian(quint32 w, quint8 *p)
+{
+    p[0] = quint8(w >> 24);
+    p[1] = quint8(w >> 16);
+    p[2] = quint8(w >> 8);
+    p[3] = quint8(w);
+}
+
+// T-tables: one lookup = SubBytes + MixColumns contribution of one state byte to its column.
+// Te1..Te3 (Td1..Td3) are byte rotations of Te0 (Td0) for rows 1..3.
+struct AesTables
+{
+    quint32 Te[4][256];
+    quint32 Td[4][256];
+    quint8 S[256];
+    quint8 Si[256];
+
+    AesTables(const quint8 *sbox, const quint8 *rsbox)
+    {
+        for (int x = 0; x < 256; ++x) {
+            S[x] = sbox[x];
+            Si[x] = rsbox[x];
+
+            const quint8 s = sbox[x];
+            Te[0][x] = (quint32(multiply(s, 0x02)) << 24) | (quint32(s) << 16)
+                     | (quint32(s) << 8) | quint32(multiply(s, 0x03));
+
+            const quint8 si = rsbox[x];
+            Td[0][x] = (quint32(multiply(si, 0x0e)) << 24) | (quint32(multiply(si, 0x09)) << 16)
+                     | (quint32(multiply(si, 0x0d)) << 8) | quint32(multiply(si, 0x0b));
+
+            for (int t = 1; t < 4; ++t) {
+                Te[t][x] = rotr8(Te[t - 1][x]);
+                Td[t][x] = rotr8(Td[t - 1][x]);
+            }
+        }
+    }
+};
+
+// Built once per process from the first instance's S-boxes (they are the same constants everywhere)
+const AesTables &aesTables(const quint8 *sbox, const quint8 *rsbox)
+{
+    static const AesTables tables(sbox, rsbox);
+    return tables;
+}
+
 }
 
 /*
@@ -102,10 +169,12 @@ quint8 multiply(quint8 x, quint8 y)
 QAESEncryption::QAESEncryption(Aes level, Mode mode,
                                Padding padding)
     : m_nb(4), m_blocklen(16), m_level(level), m_mode(mode), m_padding(padding)
-    , m_aesNIAvailable(false), m_state(nullptr)
+    , m_aesNIAvailable(false), m_engine(TTable), m_state(nullptr)
 {
 #ifdef USE_INTEL_AES_IF_AVAILABLE
     m_aesNIAvailable = check_aesni_support();
+    if (m_aesNIAvailable)
+        m_engine = AesNi;
 #endif
 
     switch (level)
@@ -173,7 +242,7 @@ QByteArray QAESEncryption::expandKey(const QByteArray &key, bool isEncryptionKey
 {
 
 #ifdef USE_INTEL_AES_IF_AVAILABLE
-    if (m_aesNIAvailable){
+    if (m_engine == AesNi){
           switch(m_level) {
           case AES_128: {
               AES128 aes128;
@@ -432,6 +501,12 @@ QByteArray QAESEncryption::byteXor(const QByteArray &a, const QByteArray &b)
 // Cipher is the main function that encrypts the PlainText.
 QByteArray QAESEncryption::cipher(const QByteArray &expKey, const QByteArray &in)
 {
+  // TTable round keys are built from the same prepared key as expKey
+  if (m_engine == TTable && in.size() == m_blocklen) {
+    QByteArray output(m_blocklen, Qt::Uninitialized);
+    encryptBlockTable(reinterpret_cast<const quint8*>(in.constData()), reinterpret_cast<quint8*>(output.data()));
+    return output;
+  }
 
   //m_state is the input buffer...
   QByteArray output(in);
@@ -461,6 +536,12 @@ QByteArray QAESEncryption::cipher(const QByteArray &expKey, const QByteArray &in
 
 QByteArray QAESEncryption::invCipher(const QByteArray &expKey, const QByteArray &in)
 {
+    if (m_engine == TTable && in.size() == m_blocklen) {
+        QByteArray output(m_blocklen, Qt::Uninitialized);
+        decryptBlockTable(reinterpret_cast<const quint8*>(in.constData()), reinterpret_cast<quint8*>(output.data()));
+        return output;
+    }
+
     //m_state is the input buffer.... handle it!
     QByteArray output(in);
     m_state = &output;
@@ -501,7 +582,9 @@ QByteArray QAESEncryption::encode(const QByteArray &rawText, const QByteArray &k
     if ((m_mode >= CBC && (iv.isEmpty() || iv.size() != m_blocklen)) || key.size() != m_keyLen)
            return QByteArray();
 
-        QByteArray expandedKey = expandKey(key, true);
+        if (!prepareKey(key))
+            return QByteArray();
+        const QByteArray &expandedKey = m_encExpKey;
         QByteArray alignedText(rawText);
 
         //Fill array with padding
@@ -511,7 +594,7 @@ QByteArray QAESEncryption::encode(const QByteArray &rawText, const QByteArray &k
     {
     case ECB: {
 #ifdef USE_INTEL_AES_IF_AVAILABLE
-        if (m_aesNIAvailable){
+        if (m_engine == AesNi){
             char expKey[expandedKey.size()];
             memcpy(expKey, expandedKey.data(), expandedKey.size());
 
@@ -525,6 +608,14 @@ QByteArray QAESEncryption::encode(const QByteArray &rawText, const QByteArray &k
             return outText;
         }
 #endif
+        if (m_engine == TTable){
+            QByteArray outText(alignedText.size(), Qt::Uninitialized);
+            const quint8 *src = reinterpret_cast<const quint8*>(alignedText.constData());
+            quint8 *dst = reinterpret_cast<quint8*>(outText.data());
+            for(int i=0; i < alignedText.size(); i+= m_blocklen)
+                encryptBlockTable(src + i, dst + i);
+            return outText;
+        }
         QByteArray ret;
         for(int i=0; i < alignedText.size(); i+= m_blocklen)
             ret.append(cipher(expandedKey, alignedText.mid(i, m_blocklen)));
@@ -533,7 +624,7 @@ QByteArray QAESEncryption::encode(const QByteArray &rawText, const QByteArray &k
     break;
     case CBC: {
 #ifdef USE_INTEL_AES_IF_AVAILABLE
-        if (m_aesNIAvailable){
+        if (m_engine == AesNi){
             quint8 ivec[iv.size()];
             memcpy(ivec, iv.data(), iv.size());
             char expKey[expandedKey.size()];
@@ -550,6 +641,20 @@ QByteArray QAESEncryption::encode(const QByteArray &rawText, const QByteArray &k
             return outText;
         }
 #endif
+        if (m_engine == TTable){
+            QByteArray outText(alignedText.size(), Qt::Uninitialized);
+            const quint8 *src = reinterpret_cast<const quint8*>(alignedText.constData());
+            quint8 *dst = reinterpret_cast<quint8*>(outText.data());
+            const quint8 *chain = reinterpret_cast<const quint8*>(iv.constData());
+            quint8 block[16];
+            for(int i=0; i < alignedText.size(); i+= m_blocklen) {
+                for(int j=0; j < m_blocklen; ++j)
+                    block[j] = src[i + j] ^ chain[j];
+                encryptBlockTable(block, dst + i);
+                chain = dst + i;
+            }
+            return outText;
+        }
         QByteArray ret;
         QByteArray ivTemp(iv);
         for(int i=0; i < alignedText.size(); i+= m_blocklen) {
@@ -593,17 +698,10 @@ QByteArray QAESEncryption::decode(const QByteArray &rawText, const QByteArray &k
            return QByteArray();
 
         QByteArray ret;
-        QByteArray expandedKey;
+        if (!prepareKey(key))
+            return QByteArray();
 
-    #ifdef USE_INTEL_AES_IF_AVAILABLE
-        if(m_aesNIAvailable && m_mode <= CBC){
-            expandedKey = expandKey(key, false);
-        }else{
-            expandedKey = expandKey(key, true);
-        }
-    #else
-        expandedKey = expandKey(key, true);
-    #endif
+        const QByteArray &expandedKey = (m_engine == AesNi && m_mode <= CBC) ? m_decExpKey : m_encExpKey;
         //false or true here is very important
         //the expandedKeys aren't the same for !aes-ni! ENcryption and DEcryption (only CBC and EBC)
         //but if you are !NOT! using aes-ni then the expandedKeys for encryption and decryption are the SAME!!!
@@ -613,7 +711,7 @@ QByteArray QAESEncryption::decode(const QByteArray &rawText, const QByteArray &k
     {
     case ECB:
 #ifdef USE_INTEL_AES_IF_AVAILABLE
-        if (m_aesNIAvailable){
+        if (m_engine == AesNi){
             char expKey[expandedKey.size()];                                //expandedKey
             memcpy(expKey, expandedKey.data(), expandedKey.size());
             ret.resize(rawText.size());
@@ -626,12 +724,22 @@ QByteArray QAESEncryption::decode(const QByteArray &rawText, const QByteArray &k
             break;
         }
 #endif
+        if (m_engine == TTable){
+            if (rawText.size() % m_blocklen)
+                break;
+            ret.resize(rawText.size());
+            const quint8 *src = reinterpret_cast<const quint8*>(rawText.constData());
+            quint8 *dst = reinterpret_cast<quint8*>(ret.data());
+            for(int i=0; i < rawText.size(); i+= m_blocklen)
+                decryptBlockTable(src + i, dst + i);
+            break;
+        }
         for(int i=0; i < rawText.size(); i+= m_blocklen)
             ret.append(invCipher(expandedKey, rawText.mid(i, m_blocklen)));
         break;
     case CBC:
 #ifdef USE_INTEL_AES_IF_AVAILABLE
-        if (m_aesNIAvailable){
+        if (m_engine == AesNi){
             quint8 ivec[iv.size()];                                         //IV
             memcpy(ivec, iv.constData(), iv.size());
             char expKey[expandedKey.size()];                                //expandedKey
@@ -647,6 +755,21 @@ QByteArray QAESEncryption::decode(const QByteArray &rawText, const QByteArray &k
             break;
         }
 #endif
+        if (m_engine == TTable){
+            if (rawText.size() % m_blocklen)
+                break;
+            ret.resize(rawText.size());
+            const quint8 *src = reinterpret_cast<const quint8*>(rawText.constData());
+            quint8 *dst = reinterpret_cast<quint8*>(ret.data());
+            const quint8 *chain = reinterpret_cast<const quint8*>(iv.constData());
+            for(int i=0; i < rawText.size(); i+= m_blocklen) {
+                decryptBlockTable(src + i, dst + i);
+                for(int j=0; j < m_blocklen; ++j)
+                    dst[i + j] ^= chain[j];
+                chain = src + i;
+            }
+            break;
+        }
         {
             QByteArray ivTemp(iv);
             for(int i=0; i < rawText.size(); i+= m_blocklen){
@@ -686,3 +809,135 @@ QByteArray QAESEncryption::removePadding(const QByteArray &rawText)
 {
     return RemovePadding(rawText, (Padding) m_padding);
 }
+
+bool QAESEncryption::setEngine(QAESEncryption::Engine engine)
+{
+    if (engine == AesNi && !m_aesNIAvailable)
+        return false;
+
+    if (m_engine != engine) {
+        m_engine = engine;
+        // The schedules differ between engines, the next call prepares them again
+        m_preparedKey.clear();
+    }
+    return true;
+}
+
+bool QAESEncryption::prepareKey(const QByteArray &key)
+{
+    if (key.size() != m_keyLen)
+        return false;
+    if (!m_preparedKey.isEmpty() && key == m_preparedKey)
+        return true;
+
+    m_encExpKey = expandKey(key, true);
+    m_decExpKey.clear();
+    m_encRoundKeys.clear();
+    m_decRoundKeys.clear();
+
+    if (m_engine == AesNi && m_mode <= CBC)
+        m_decExpKey = expandKey(key, false);
+    else if (m_engine == TTable)
+        buildTableRoundKeys();
+
+    m_preparedKey = key;
+    return true;
+}
+
+void QAESEncryption::buildTableRoundKeys()
+{
+    const AesTables &t = aesTables(sbox, rsbox);
+    const int words = m_nb * (m_nr + 1);
+    const quint8 *expKey = reinterpret_cast<const quint8*>(m_encExpKey.constData());
+
+    m_encRoundKeys.resize(words);
+    for (int i = 0; i < words; ++i)
+        m_encRoundKeys[i] = loadBigEndian(expKey + i * 4);
+
+    // Equivalent inverse cipher: round keys in reverse order,
+    // InvMixColumns applied to all of them except the first and the last one
+    m_decRoundKeys.resize(words);
+    for (int round = 0; round <= m_nr; ++round) {
+        for (int c = 0; c < m_nb; ++c) {
+            quint32 w = m_encRoundKeys[(m_nr - round) * m_nb + c];
+            if (round > 0 && round < m_nr) {
+                w = t.Td[0][t.S[w >> 24]] ^ t.Td[1][t.S[(w >> 16) & 0xff]]
+                  ^ t.Td[2][t.S[(w >> 8) & 0xff]] ^ t.Td[3][t.S[w & 0xff]];
+            }
+            m_decRoundKeys[round * m_nb + c] = w;
+        }
+    }
+}
+
+void QAESEncryption::encryptBlockTable(const quint8 *in, quint8 *out) const
+{
+    const AesTables &t = aesTables(sbox, rsbox);
+    const quint32 *rk = m_encRoundKeys.constData();
+
+    quint32 s0 = loadBigEndian(in)      ^ rk[0];
+    quint32 s1 = loadBigEndian(in + 4)  ^ rk[1];
+    quint32 s2 = loadBigEndian(in + 8)  ^ rk[2];
+    quint32 s3 = loadBigEndian(in + 12) ^ rk[3];
+    quint32 t0, t1, t2, t3;
+
+    for (int round = 1; round < m_nr; ++round) {
+        rk += 4;
+        t0 = t.Te[0][s0 >> 24] ^ t.Te[1][(s1 >> 16) & 0xff] ^ t.Te[2][(s2 >> 8) & 0xff] ^ t.Te[3][s3 & 0xff] ^ rk[0];
+        t1 = t.Te[0][s1 >> 24] ^ t.Te[1][(s2 >> 16) & 0xff] ^ t.Te[2][(s3 >> 8) & 0xff] ^ t.Te[3][s0 & 0xff] ^ rk[1];
+        t2 = t.Te[0][s2 >> 24] ^ t.Te[1][(s3 >> 16) & 0xff] ^ t.Te[2][(s0 >> 8) & 0xff] ^ t.Te[3][s1 & 0xff] ^ rk[2];
+        t3 = t.Te[0][s3 >> 24] ^ t.Te[1][(s0 >> 16) & 0xff] ^ t.Te[2][(s1 >> 8) & 0xff] ^ t.Te[3][s2 & 0xff] ^ rk[3];
+        s0 = t0; s1 = t1; s2 = t2; s3 = t3;
+    }
+
+    // The last round has no MixColumns: plain S-box lookups
+    rk += 4;
+    t0 = (quint32(t.S[s0 >> 24]) << 24) | (quint32(t.S[(s1 >> 16) & 0xff]) << 16)
+       | (quint32(t.S[(s2 >> 8) & 0xff]) << 8) | quint32(t.S[s3 & 0xff]);
+    t1 = (quint32(t.S[s1 >> 24]) << 24) | (quint32(t.S[(s2 >> 16) & 0xff]) << 16)
+       | (quint32(t.S[(s3 >> 8) & 0xff]) << 8) | quint32(t.S[s0 & 0xff]);
+    t2 = (quint32(t.S[s2 >> 24]) << 24) | (quint32(t.S[(s3 >> 16) & 0xff]) << 16)
+       | (quint32(t.S[(s0 >> 8) & 0xff]) << 8) | quint32(t.S[s1 & 0xff]);
+    t3 = (quint32(t.S[s3 >> 24]) << 24) | (quint32(t.S[(s0 >> 16) & 0xff]) << 16)
+       | (quint32(t.S[(s1 >> 8) & 0xff]) << 8) | quint32(t.S[s2 & 0xff]);
+
+    storeBigEndian(t0 ^ rk[0], out);
+    storeBigEndian(t1 ^ rk[1], out + 4);
+    storeBigEndian(t2 ^ rk[2], out + 8);
+    storeBigEndian(t3 ^ rk[3], out + 12);
+}
+
+void QAESEncryption::decryptBlockTable(const quint8 *in, quint8 *out) const
+{
+    const AesTables &t = aesTables(sbox, rsbox);
+    const quint32 *rk = m_decRoundKeys.constData();
+
+    quint32 s0 = loadBigEndian(in)      ^ rk[0];
+    quint32 s1 = loadBigEndian(in + 4)  ^ rk[1];
+    quint32 s2 = loadBigEndian(in + 8)  ^ rk[2];
+    quint32 s3 = loadBigEndian(in + 12) ^ rk[3];
+    quint32 t0, t1, t2, t3;
+
+    for (int round = 1; round < m_nr; ++round) {
+        rk += 4;
+        t0 = t.Td[0][s0 >> 24] ^ t.Td[1][(s3 >> 16) & 0xff] ^ t.Td[2][(s2 >> 8) & 0xff] ^ t.Td[3][s1 & 0xff] ^ rk[0];
+        t1 = t.Td[0][s1 >> 24] ^ t.Td[1][(s0 >> 16) & 0xff] ^ t.Td[2][(s3 >> 8) & 0xff] ^ t.Td[3][s2 & 0xff] ^ rk[1];
+        t2 = t.Td[0][s2 >> 24] ^ t.Td[1][(s1 >> 16) & 0xff] ^ t.Td[2][(s0 >> 8) & 0xff] ^ t.Td[3][s3 & 0xff] ^ rk[2];
+        t3 = t.Td[0][s3 >> 24] ^ t.Td[1][(s2 >> 16) & 0xff] ^ t.Td[2][(s1 >> 8) & 0xff] ^ t.Td[3][s0 & 0xff] ^ rk[3];
+        s0 = t0; s1 = t1; s2 = t2; s3 = t3;
+    }
+
+    rk += 4;
+    t0 = (quint32(t.Si[s0 >> 24]) << 24) | (quint32(t.Si[(s3 >> 16) & 0xff]) << 16)
+       | (quint32(t.Si[(s2 >> 8) & 0xff]) << 8) | quint32(t.Si[s1 & 0xff]);
+    t1 = (quint32(t.Si[s1 >> 24]) << 24) | (quint32(t.Si[(s0 >> 16) & 0xff]) << 16)
+       | (quint32(t.Si[(s3 >> 8) & 0xff]) << 8) | quint32(t.Si[s2 & 0xff]);
+    t2 = (quint32(t.Si[s2 >> 24]) << 24) | (quint32(t.Si[(s1 >> 16) & 0xff]) << 16)
+       | (quint32(t.Si[(s0 >> 8) & 0xff]) << 8) | quint32(t.Si[s3 & 0xff]);
+    t3 = (quint32(t.Si[s3 >> 24]) << 24) | (quint32(t.Si[(s2 >> 16) & 0xff]) << 16)
+       | (quint32(t.Si[(s1 >> 8) & 0xff]) << 8) | quint32(t.Si[s0 & 0xff]);
+
+    storeBigEndian(t0 ^ rk[0], out);
+    storeBigEndian(t1 ^ rk[1], out + 4);
+    storeBigEndian(t2 ^ rk[2], out + 8);
+    storeBigEndian(t3 ^ rk[3], out + 12);
+}
@@ -9,6 +9,7 @@
 
 #include <QObject>
 #include <QByteArray>
+#include <QVector>
 
 #ifdef __linux__
 #ifndef __LP64__
@@ -39,6 +40,24 @@ public:
       ISO
     };
 
+    /*!
+     * \brief block cipher implementation used by encode()/decode()
+     * Portable - reference byte-wise implementation (subBytes/shiftRows/mixColumns)
+     * TTable   - 32-bit lookup tables (SubBytes+ShiftRows+MixColumns in 4 lookups per column)
+     * AesNi    - Intel AES-NI instructions (only with USE_INTEL_AES_IF_AVAILABLE and CPU support)
+     */
+    enum Engine {
+      Portable,
+      TTable,
+      AesNi
+    };
+    Q_ENUM(Engine)
+
+    /*!
+     * \brief fastest engine available on this build and CPU (AesNi, otherwise TTable)
+     */
+    static QAESEncryption::Engine bestEngine();
+
     /*!
      * \brief static method call to encrypt data given by rawText
      * \param level:    AES::Aes level
@@ -121,6 +140,23 @@ public:
      */
     QByteArray removePadding(const QByteArray &rawText);
 
+    /*!
+     * \brief selects the block cipher implementation, the default is bestEngine()
+     * \param engine:   AES::Engine to use
+     * \return false if the engine is not available (the current one is kept)
+     */
+    bool setEngine(QAESEncryption::Engine engine);
+    QAESEncryption::Engine engine() const { return static_cast<Engine>(m_engine); }
+
+    /*!
+     * \brief expands the user key once and keeps the key schedules in the object
+     * encode()/decode() called with the same key reuse them instead of expanding the key again.
+     * Calling it explicitly is optional, encode()/decode() prepare a new key on demand.
+     * \param key:      user-key (key.size either 128, 192, 256 bits depending on AES::Aes)
+     * \return false if the key size does not match AES::Aes level
+     */
+    bool prepareKey(const QByteArray &key);
+
     QByteArray printArray(uchar *arr, int size);
 Q_SIGNALS:
 
@@ -137,8 +173,16 @@ private:
     int m_expandedKey;
     int m_padding;
     bool m_aesNIAvailable;
+    int m_engine;
     QByteArray* m_state;
 
+    // Key schedules of the last prepared key (see prepareKey)
+    QByteArray m_preparedKey;
+    QByteArray m_encExpKey;           // byte-wise expanded key (Portable, AesNi encryption, CFB/OFB)
+    QByteArray m_decExpKey;           // AesNi decryption schedule (ECB/CBC only)
+    QVector<quint32> m_encRoundKeys;  // TTable encryption round keys, big-endian words
+    QVector<quint32> m_decRoundKeys;  // TTable equivalent inverse cipher round keys
+
     struct AES256{
         int nk = 8;
         int keylen = 32;
@@ -176,6 +220,9 @@ private:
     QByteArray getPadding(int currSize, int alignment);
     QByteArray cipher(const QByteArray &expKey, const QByteArray &in);
     QByteArray invCipher(const QByteArray &expKey, const QByteArray &in);
+    void buildTableRoundKeys();
+    void encryptBlockTable(const quint8 *in, quint8 *out) const;
+    void decryptBlockTable(const quint8 *in, quint8 *out) const;
     QByteArray byteXor(const QByteArray &a, const QByteArray &b);
 
     const quint8 sbox[256] = {
@@ -0,0 +1,141 @@
+#ifndef HTTPSTUB_H
+#define HTTPSTUB_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QHostAddress>
+#include <QList>
+#include <QPointer>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <memory>
+#include <utility>
+
+/**
+ * @brief Мінімальний HTTP/1.1-сервер для тестів ApiClient.
+ *
+ * На будь-який запит відповідає тілом body і запам'ятовує запит у requests.
+ * З holdReplies відповіді чекають на release() — так тест бачить запити "у польоті".
+ * Якщо задано etag, відповідь 200 несе його, а запит з таким самим If-None-Match отримує 304.
+ */
+class HttpStub : public QObject
+{
+public:
+    struct Request {
+        QByteArray method;
+        QByteArray target;                      // Шлях разом із query
+        QHash<QByteArray, QByteArray> headers;  // Назви — у нижньому регістрі
+        QByteArray body;
+    };
+
+    explicit HttpStub(QObject* parent = nullptr) : QObject(parent)
+    {
+        connect(&m_server, &QTcpServer::newConnection, this, [this]() {
+            while (QTcpSocket* socket = m_server.nextPendingConnection()) {
+                // Буфер на з'єднання: QNetworkAccessManager шле кілька запитів одним keep-alive
+                auto buffer = std::make_shared<QByteArray>();
+                connect(socket, &QTcpSocket::readyRead, this, [this, socket, buffer]() { onReadyRead(socket, *buffer); });
+                connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+            }
+        });
+        m_server.listen(QHostAddress::LocalHost);
+    }
+
+    bool isListening() const { return m_server.isListening(); }
+    QString baseUrl() const { return QString("http://127.0.0.1:%1").arg(m_server.serverPort()); }
+
+    // Скільки запитів прийшло на target
+    int count(const QByteArray& target) const
+    {
+        int n = 0;
+        for (const Request& request : requests) {
+            if (request.target == target) ++n;
+        }
+        return n;
+    }
+
+    int pendingCount() const { return m_pending.size(); }
+
+    // Відповідає на всі затримані запити (з'єднання, закриті клієнтом, пропускаються)
+    void release()
+    {
+        const QList<Pending> pending = std::exchange(m_pending, {});
+        for (const Pending& item : pending) {
+            if (item.socket && item.socket->state() == QAbstractSocket::ConnectedState) {
+                reply(item.socket, item.request);
+            }
+        }
+    }
+
+    void reset()
+    {
+        requests.clear();
+        m_pending.clear();
+        holdReplies = false;
+        body = "[]";
+        etag.clear();
+    }
+
+    QList<Request> requests;
+    bool holdReplies = false;
+    QByteArray body = "[]";
+    QByteArray etag;
+
+private:
+    struct Pending {
+        QPointer<QTcpSocket> socket;
+        Request request;
+    };
+
+    void onReadyRead(QTcpSocket* socket, QByteArray& buffer)
+    {
+        buffer += socket->readAll();
+        for (;;) {
+            const qsizetype headerEnd = buffer.indexOf("\r\n\r\n");
+            if (headerEnd < 0) return;
+
+            Request request;
+            const QList<QByteArray> lines = buffer.left(headerEnd).split('\n');
+            const QList<QByteArray> requestLine = lines.first().trimmed().split(' ');
+            request.method = requestLine.value(0);
+            request.target = requestLine.value(1);
+            for (qsizetype i = 1; i < lines.size(); ++i) {
+                const qsizetype colon = lines.at(i).indexOf(':');
+                if (colon > 0) {
+                    request.headers.insert(lines.at(i).left(colon).trimmed().toLower(), lines.at(i).mid(colon + 1).trimmed());
+                }
+            }
+
+            const qsizetype length = request.headers.value("content-length").toLongLong();
+            if (buffer.size() < headerEnd + 4 + length) return;
+            request.body = buffer.mid(headerEnd + 4, length);
+            buffer.remove(0, headerEnd + 4 + length);
+
+            requests.append(request);
+            if (holdReplies) m_pending.append({socket, request});
+            else reply(socket, request);
+        }
+    }
+
+    void reply(QTcpSocket* socket, const Request& request)
+    {
+        QByteArray status = "200 OK";
+        QByteArray payload = body;
+        QByteArray headers = "Content-Type: application/json\r\n";
+        if (!etag.isEmpty()) {
+            headers += "ETag: " + etag + "\r\n";
+            if (request.headers.value("if-none-match") == etag) {
+                status = "304 Not Modified";
+                payload.clear();
+            }
+        }
+        socket->write("HTTP/1.1 " + status + "\r\n" + headers
+                      + "Content-Length: " + QByteArray::number(payload.size()) + "\r\n\r\n" + payload);
+    }
+
+private:
+    QTcpServer m_server;
+    QList<Pending> m_pending;
+};
+
+#endif // HTTPSTUB_H
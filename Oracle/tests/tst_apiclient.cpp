@@ -0,0 +1,218 @@
+#include "Oracle/ApiClient.h"
+#include "HttpStub.h"
+
+#include <QSignalSpy>
+#include <QTest>
+
+/**
+ * Поведінка ApiClient щодо мережі на локальному HttpStub: скільки запитів реально
+ * доходить до сервера і які сигнали отримують викликачі.
+ * Кожен тест бере свій terminalId, щоб стан ApiClient (singleton) не переходив між тестами.
+ */
+class TestApiClient : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void init();
+
+    // Об'єднання однакових GET (sendGet)
+    void coalescesIdenticalGets();
+    void keepsDifferentRequestsApart();
+    void sendsAgainAfterCompletion();
+
+    // Умовний GET: If-None-Match і тіло з кешу валідаторів на 304
+    void revalidatesWithEtag();
+
+    // Скасування (ApiRequestHandle / ApiRequestGroup) і пріоритети
+    void cancelSuppressesSignals();
+    void cancelReleasesOnlyOwnShare();
+    void groupCancelsWithParent();
+    void mapsPriorities();
+
+private:
+    static QByteArray tanksPath(int terminalId);
+
+    HttpStub* m_stub = nullptr;
+};
+
+void TestApiClient::initTestCase()
+{
+    m_stub = new HttpStub(this);
+    QVERIFY(m_stub->isListening());
+    ApiClient::instance().setServerUrl(m_stub->baseUrl());
+}
+
+void TestApiClient::init()
+{
+    m_stub->reset();
+}
+
+QByteArray TestApiClient::tanksPath(int terminalId)
+{
+    return "/api/clients/1/station/" + QByteArray::number(terminalId) + "/tanks";
+}
+
+void TestApiClient::coalescesIdenticalGets()
+{
+    ApiClient& api = ApiClient::instance();
+    QSignalSpy received(&api, &ApiClient::stationTanksReceived);
+    m_stub->holdReplies = true;
+    m_stub->body = R"([{"tank": 1}, {"tank": 2}])";
+
+    const ApiRequestHandle first = api.fetchStationTanks(1, 100);
+    const ApiRequestHandle second = api.fetchStationTanks(1, 100);
+    QVERIFY(first.isValid());
+    QVERIFY(second.isValid());
+
+    QTRY_COMPARE(m_stub->pendingCount(), 1);
+    m_stub->release();
+
+    // Один запит на сервер і одна відповідь для обох викликачів
+    QTRY_COMPARE(received.count(), 1);
+    QCOMPARE(m_stub->count(tanksPath(100)), 1);
+    QCOMPARE(received.first().at(0).toJsonArray().size(), 2);
+    QCOMPARE(received.first().at(2).toInt(), 100);
+}
+
+void TestApiClient::keepsDifferentRequestsApart()
+{
+    ApiClient& api = ApiClient::instance();
+    QSignalSpy received(&api, &ApiClient::stationTanksReceived);
+    m_stub->holdReplies = true;
+
+    // Інший URL
+    api.fetchStationTanks(1, 101);
+    api.fetchStationTanks(1, 102);
+    // Той самий URL, але інший контекст (telegramId у Gandalf не йде в заголовки)
+    api.fetchStationTanks(1, 103, 0);
+    api.fetchStationTanks(1, 103, 7);
+
+    QTRY_COMPARE(m_stub->pendingCount(), 4);
+    m_stub->release();
+
+    QTRY_COMPARE(received.count(), 4);
+    QCOMPARE(m_stub->count(tanksPath(101)), 1);
+    QCOMPARE(m_stub->count(tanksPath(102)), 1);
+    QCOMPARE(m_stub->count(tanksPath(103)), 2);
+}
+
+void TestApiClient::sendsAgainAfterCompletion()
+{
+    ApiClient& api = ApiClient::instance();
+    QSignalSpy received(&api, &ApiClient::stationTanksReceived);
+
+    api.fetchStationTanks(1, 104);
+    QTRY_COMPARE(received.count(), 1);
+
+    // Завершений reply знято з реєстру "у польоті": повторний виклик — новий запит
+    api.fetchStationTanks(1, 104);
+    QTRY_COMPARE(received.count(), 2);
+    QCOMPARE(m_stub->count(tanksPath(104)), 2);
+}
+
+void TestApiClient::revalidatesWithEtag()
+{
+    ApiClient& api = ApiClient::instance();
+    QSignalSpy received(&api, &ApiClient::stationTanksReceived);
+    m_stub->etag = "\"v1\"";
+    m_stub->body = R"([{"tank": 5}])";
+
+    api.fetchStationTanks(1, 105);
+    QTRY_COMPARE(received.count(), 1);
+    QVERIFY(!m_stub->requests.last().headers.contains("if-none-match"));
+
+    api.fetchStationTanks(1, 105);
+    QTRY_COMPARE(received.count(), 2);
+    QCOMPARE(m_stub->requests.last().headers.value("if-none-match"), QByteArray("\"v1\""));
+    // Сервер відповів 304 без тіла — викликач отримує збережене
+    QCOMPARE(received.at(1).at(0).toJsonArray(), received.at(0).at(0).toJsonArray());
+    QCOMPARE(received.at(1).at(0).toJsonArray().size(), 1);
+
+    // Дані змінились: новий ETag і нове тіло
+    m_stub->etag = "\"v2\"";
+    m_stub->body = R"([{"tank": 5}, {"tank": 6}])";
+    api.fetchStationTanks(1, 105);
+    QTRY_COMPARE(received.count(), 3);
+    QCOMPARE(received.at(2).at(0).toJsonArray().size(), 2);
+}
+
+void TestApiClient::cancelSuppressesSignals()
+{
+    ApiClient& api = ApiClient::instance();
+    QSignalSpy received(&api, &ApiClient::stationTanksReceived);
+    QSignalSpy failed(&api, &ApiClient::stationTanksFailed);
+    m_stub->holdReplies = true;
+
+    ApiRequestHandle handle = api.fetchStationTanks(1, 110);
+    QTRY_COMPARE(m_stub->pendingCount(), 1);
+    QVERIFY(handle.isRunning());
+
+    handle.cancel();
+    QVERIFY(!handle.isRunning());
+    m_stub->release();
+
+    // abort() не повинен дійти до обробників ні успіхом, ні помилкою
+    QTest::qWait(200);
+    QCOMPARE(received.count(), 0);
+    QCOMPARE(failed.count(), 0);
+
+    // Скасований reply знято з реєстру: той самий запит іде на сервер заново
+    m_stub->holdReplies = false;
+    api.fetchStationTanks(1, 110);
+    QTRY_COMPARE(received.count(), 1);
+    QCOMPARE(m_stub->count(tanksPath(110)), 2);
+}
+
+void TestApiClient::cancelReleasesOnlyOwnShare()
+{
+    ApiClient& api = ApiClient::instance();
+    QSignalSpy received(&api, &ApiClient::stationTanksReceived);
+    m_stub->holdReplies = true;
+
+    ApiRequestHandle first = api.fetchStationTanks(1, 111);
+    ApiRequestHandle second = api.fetchStationTanks(1, 111);
+    QTRY_COMPARE(m_stub->pendingCount(), 1);
+
+    // Перша вкладка закрилась — друга чекає на той самий reply далі
+    first.cancel();
+    first.cancel(); // Повторне скасування не відпускає чужу частку
+    QVERIFY(!first.isRunning());
+    QVERIFY(second.isRunning());
+
+    m_stub->release();
+    QTRY_COMPARE(received.count(), 1);
+    QCOMPARE(m_stub->count(tanksPath(111)), 1);
+}
+
+void TestApiClient::groupCancelsWithParent()
+{
+    ApiClient& api = ApiClient::instance();
+    QSignalSpy received(&api, &ApiClient::stationTanksReceived);
+    QSignalSpy failed(&api, &ApiClient::stationTanksFailed);
+    m_stub->holdReplies = true;
+
+    auto* tab = new QObject;
+    auto* group = new ApiRequestGroup(tab);
+    group->add(api.fetchStationTanks(1, 112));
+    group->add(api.fetchStationTanks(1, 113));
+    QTRY_COMPARE(m_stub->pendingCount(), 2);
+
+    delete tab; // Закриття вкладки АЗС
+    m_stub->release();
+
+    QTest::qWait(200);
+    QCOMPARE(received.count(), 0);
+    QCOMPARE(failed.count(), 0);
+}
+
+void TestApiClient::mapsPriorities()
+{
+    QCOMPARE(toNetworkPriority(RequestPriority::Interactive), QNetworkRequest::HighPriority);
+    QCOMPARE(toNetworkPriority(RequestPriority::Normal), QNetworkRequest::NormalPriority);
+    QCOMPARE(toNetworkPriority(RequestPriority::Background), QNetworkRequest::LowPriority);
+}
+
+QTEST_GUILESS_MAIN(TestApiClient)
+#include "tst_apiclient.moc"
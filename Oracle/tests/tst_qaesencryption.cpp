@@ -0,0 +1,202 @@
+#include "Oracle/qaesencryption.h"
+
+#include <QCryptographicHash>
+#include <QRandomGenerator>
+#include <QTest>
+
+/**
+ * Відомі відповіді FIPS-197 (додаток C) і SP 800-38A (F.2) для кожного рушія,
+ * плюс збіг рушіїв між собою на довільних даних. AesNi перевіряється лише там,
+ * де його зібрано і підтримує процесор.
+ */
+class TestQAESEncryption : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void fips197_data();
+    void fips197();
+    void cbcVectors_data();
+    void cbcVectors();
+    void enginesAgree_data();
+    void enginesAgree();
+    void reusedObjectSwitchesKeys();
+    void rejectsWrongKeySize();
+
+private:
+    static void addEngineRows(const char* name, QAESEncryption::Aes level, const QByteArray& key,
+                              const QByteArray& iv, const QByteArray& plain, const QByteArray& cipher);
+    static bool selectEngine(QAESEncryption& aes, int engine);
+};
+
+void TestQAESEncryption::addEngineRows(const char* name, QAESEncryption::Aes level, const QByteArray& key,
+                                       const QByteArray& iv, const QByteArray& plain, const QByteArray& cipher)
+{
+    const char* engineNames[] = {"Portable", "TTable", "AesNi"}; // Індекс — QAESEncryption::Engine
+    for (int engine : {QAESEncryption::Portable, QAESEncryption::TTable, QAESEncryption::AesNi}) {
+        QTest::addRow("%s/%s", name, engineNames[engine])
+            << engine << int(level) << QByteArray::fromHex(key) << QByteArray::fromHex(iv)
+            << QByteArray::fromHex(plain) << QByteArray::fromHex(cipher);
+    }
+}
+
+bool TestQAESEncryption::selectEngine(QAESEncryption& aes, int engine)
+{
+    return aes.setEngine(QAESEncryption::Engine(engine));
+}
+
+void TestQAESEncryption::fips197_data()
+{
+    QTest::addColumn<int>("engine");
+    QTest::addColumn<int>("level");
+    QTest::addColumn<QByteArray>("key");
+    QTest::addColumn<QByteArray>("iv");
+    QTest::addColumn<QByteArray>("plain");
+    QTest::addColumn<QByteArray>("cipher");
+
+    const QByteArray plain = "00112233445566778899aabbccddeeff";
+    addEngineRows("AES-128", QAESEncryption::AES_128, "000102030405060708090a0b0c0d0e0f", QByteArray(),
+                  plain, "69c4e0d86a7b0430d8cdb78070b4c55a");
+    addEngineRows("AES-192", QAESEncryption::AES_192, "000102030405060708090a0b0c0d0e0f1011121314151617", QByteArray(),
+                  plain, "dda97ca4864cdfe06eaf70a0ec0d7191");
+    addEngineRows("AES-256", QAESEncryption::AES_256,
+                  "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f", QByteArray(),
+                  plain, "8ea2b7ca516745bfeafc49904b496089");
+}
+
+void TestQAESEncryption::fips197()
+{
+    QFETCH(int, engine);
+    QFETCH(int, level);
+    QFETCH(QByteArray, key);
+    QFETCH(QByteArray, plain);
+    QFETCH(QByteArray, cipher);
+
+    QAESEncryption aes(QAESEncryption::Aes(level), QAESEncryption::ECB);
+    if (!selectEngine(aes, engine)) QSKIP("Engine is not available on this build or CPU");
+
+    // Рівно один блок: доповнення ISO не додається
+    QCOMPARE(aes.encode(plain, key).toHex(), cipher.toHex());
+    QCOMPARE(aes.decode(cipher, key).toHex(), plain.toHex());
+}
+
+void TestQAESEncryption::cbcVectors_data()
+{
+    QTest::addColumn<int>("engine");
+    QTest::addColumn<int>("level");
+    QTest::addColumn<QByteArray>("key");
+    QTest::addColumn<QByteArray>("iv");
+    QTest::addColumn<QByteArray>("plain");
+    QTest::addColumn<QByteArray>("cipher");
+
+    const QByteArray iv = "000102030405060708090a0b0c0d0e0f";
+    const QByteArray plain = "6bc1bee22e409f96e93d7e117393172a" "ae2d8a571e03ac9c9eb76fac45af8e51"
+                             "30c81c46a35ce411e5fbc1191a0a52ef" "f69f2445df4f9b17ad2b417be66c3710";
+    addEngineRows("CBC-AES128", QAESEncryption::AES_128, "2b7e151628aed2a6abf7158809cf4f3c", iv, plain,
+                  "7649abac8119b246cee98e9b12e9197d" "5086cb9b507219ee95db113a917678b2"
+                  "73bed6b8e3c1743b7116e69e22229516" "3ff1caa1681fac09120eca307586e1a7");
+    addEngineRows("CBC-AES256", QAESEncryption::AES_256,
+                  "603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4", iv, plain,
+                  "f58c4c04d6e5f1ba779eabfb5f7bfbd6" "9cfc4e967edb808d679f777bc6702c7d"
+                  "39f23369a9d9bacfa530e26304231461" "b2eb05e2c39be9fcda6c19078c6a9d1b");
+}
+
+void TestQAESEncryption::cbcVectors()
+{
+    QFETCH(int, engine);
+    QFETCH(int, level);
+    QFETCH(QByteArray, key);
+    QFETCH(QByteArray, iv);
+    QFETCH(QByteArray, plain);
+    QFETCH(QByteArray, cipher);
+
+    QAESEncryption aes(QAESEncryption::Aes(level), QAESEncryption::CBC);
+    if (!selectEngine(aes, engine)) QSKIP("Engine is not available on this build or CPU");
+
+    QCOMPARE(aes.encode(plain, key, iv).toHex(), cipher.toHex());
+    QCOMPARE(aes.decode(cipher, key, iv).toHex(), plain.toHex());
+}
+
+void TestQAESEncryption::enginesAgree_data()
+{
+    QTest::addColumn<int>("level");
+    QTest::addColumn<int>("mode");
+
+    const QList<QPair<const char*, int>> levels = {{"AES-128", QAESEncryption::AES_128},
+                                                   {"AES-192", QAESEncryption::AES_192},
+                                                   {"AES-256", QAESEncryption::AES_256}};
+    const QList<QPair<const char*, int>> modes = {{"ECB", QAESEncryption::ECB}, {"CBC", QAESEncryption::CBC},
+                                                  {"CFB", QAESEncryption::CFB}, {"OFB", QAESEncryption::OFB}};
+    for (const auto& level : levels) {
+        for (const auto& mode : modes) {
+            QTest::addRow("%s-%s", level.first, mode.first) << level.second << mode.second;
+        }
+    }
+}
+
+void TestQAESEncryption::enginesAgree()
+{
+    QFETCH(int, level);
+    QFETCH(int, mode);
+
+    const int keyLen = level == QAESEncryption::AES_128 ? 16 : level == QAESEncryption::AES_192 ? 24 : 32;
+    const QByteArray key = QCryptographicHash::hash("test-key", QCryptographicHash::Sha256).left(keyLen);
+    const QByteArray iv = QCryptographicHash::hash("test-iv", QCryptographicHash::Md5);
+
+    QRandomGenerator random(37);
+    QList<QAESEncryption::Engine> engines = {QAESEncryption::Portable, QAESEncryption::TTable};
+    if (QAESEncryption::bestEngine() == QAESEncryption::AesNi) engines << QAESEncryption::AesNi;
+
+    // Довжини навколо меж блоку, зокрема порожній рядок і короткий пароль, як у CriptPass
+    for (int size : {0, 1, 15, 16, 17, 31, 32, 100, 1000}) {
+        QByteArray plain(size, Qt::Uninitialized);
+        // ASCII без нуля, як пароль: байти 0x00 і 0x80 у кінці removePadding (ISO) прийняв би за доповнення
+        for (char& c : plain) c = char(random.bounded(1, 128));
+
+        QAESEncryption reference(QAESEncryption::Aes(level), QAESEncryption::Mode(mode));
+        QVERIFY(reference.setEngine(QAESEncryption::Portable));
+        const QByteArray expected = reference.encode(plain, key, iv);
+
+        for (QAESEncryption::Engine engine : engines) {
+            QAESEncryption aes(QAESEncryption::Aes(level), QAESEncryption::Mode(mode));
+            QVERIFY(aes.setEngine(engine));
+            const QByteArray cipher = aes.encode(plain, key, iv);
+            QCOMPARE(cipher.toHex(), expected.toHex());
+            QCOMPARE(aes.removePadding(aes.decode(cipher, key, iv)), plain);
+        }
+    }
+}
+
+void TestQAESEncryption::reusedObjectSwitchesKeys()
+{
+    const QByteArray keyA = QCryptographicHash::hash("key-a", QCryptographicHash::Sha256);
+    const QByteArray keyB = QCryptographicHash::hash("key-b", QCryptographicHash::Sha256);
+    const QByteArray iv = QCryptographicHash::hash("iv", QCryptographicHash::Md5);
+    const QByteArray plain = "00112secret-password12";
+
+    const QByteArray expectedA = QAESEncryption::Crypt(QAESEncryption::AES_256, QAESEncryption::CBC, plain, keyA, iv);
+    const QByteArray expectedB = QAESEncryption::Crypt(QAESEncryption::AES_256, QAESEncryption::CBC, plain, keyB, iv);
+    QVERIFY(expectedA != expectedB);
+
+    // Один об'єкт, як у CriptPass: розклад ключа підготовлено заздалегідь, але інший ключ його замінює
+    QAESEncryption aes(QAESEncryption::AES_256, QAESEncryption::CBC);
+    QVERIFY(aes.prepareKey(keyA));
+    QCOMPARE(aes.encode(plain, keyA, iv), expectedA);
+    QCOMPARE(aes.encode(plain, keyB, iv), expectedB);
+    QCOMPARE(aes.removePadding(aes.decode(expectedA, keyA, iv)), plain);
+    QCOMPARE(aes.removePadding(aes.decode(expectedB, keyB, iv)), plain);
+}
+
+void TestQAESEncryption::rejectsWrongKeySize()
+{
+    QAESEncryption aes(QAESEncryption::AES_256, QAESEncryption::CBC);
+    const QByteArray shortKey(16, 'k');
+    const QByteArray iv(16, 'i');
+
+    QVERIFY(!aes.prepareKey(shortKey));
+    QVERIFY(aes.encode("data", shortKey, iv).isEmpty());
+    QVERIFY(aes.encode("data", QByteArray(32, 'k'), QByteArray(8, 'i')).isEmpty()); // IV не 16 байт
+}
+
+QTEST_GUILESS_MAIN(TestQAESEncryption)
+#include "tst_qaesencryption.moc"
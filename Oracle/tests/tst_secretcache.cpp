@@ -0,0 +1,199 @@
+#include "Oracle/SecretCache.h"
+#include "Oracle/criptpass.h"
+#include "Oracle/AppParams.h"
+
+#include <QTest>
+
+#include <cstring>
+
+/**
+ * SecretCache — singleton: ліміт записів (3) задається до першого instance().
+ * Шифротексти готує CriptPass тим самим ключем, яким їх розшифровує кеш.
+ */
+class TestSecretCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void init();
+
+    void decryptsAndCachesByCiphertext();
+    void hitSharesBuffer();
+    void emptyCiphertextIsNotCached();
+    void invalidatesByOwner();
+    void hitUpdatesOwner();
+    void invalidatesAllUsersButNotClients();
+    void evictsBeyondCapacity();
+
+    void secureBufferCopiesData();
+    void wipeZeroesMemory();
+    void wipeLeavesSharedCopy();
+    void wipeString();
+
+private:
+    static QString encrypt(const QString& plain) { return CriptPass::instance().criptPass(plain); }
+};
+
+void TestSecretCache::initTestCase()
+{
+    AppParams::instance().setParam("Global", "SecretCacheMaxEntries", 3);
+}
+
+void TestSecretCache::init()
+{
+    SecretCache::instance().clear();
+}
+
+void TestSecretCache::decryptsAndCachesByCiphertext()
+{
+    SecretCache& cache = SecretCache::instance();
+    const QString ciphertext = encrypt("jira-token-1");
+
+    QCOMPARE(cache.acquire(ciphertext)->toString(), QString("jira-token-1"));
+    QCOMPARE(cache.size(), 1);
+
+    // Той самий шифротекст — той самий запис
+    QCOMPARE(cache.acquire(ciphertext)->toString(), QString("jira-token-1"));
+    QCOMPARE(cache.size(), 1);
+
+    // Не-ASCII у відкритому тексті переживає UTF-8 у SecureBuffer
+    QCOMPARE(cache.acquire(encrypt("пароль-АЗС"))->toString(), QString("пароль-АЗС"));
+    QCOMPARE(cache.size(), 2);
+}
+
+void TestSecretCache::hitSharesBuffer()
+{
+    SecretCache& cache = SecretCache::instance();
+    const QString ciphertext = encrypt("redmine-key");
+
+    // Влучання не робить копій відкритого тексту: викликачі тримають той самий SecureBuffer
+    const SecretCache::Secret first = cache.acquire(ciphertext);
+    const SecretCache::Secret second = cache.acquire(ciphertext);
+    QCOMPARE(first.get(), second.get());
+    QCOMPARE(first->toByteArray("Bearer "), QByteArray("Bearer redmine-key"));
+
+    // Скинутий запис живе, доки його тримає викликач
+    cache.clear();
+    QCOMPARE(first->toString(), QString("redmine-key"));
+}
+
+void TestSecretCache::emptyCiphertextIsNotCached()
+{
+    SecretCache& cache = SecretCache::instance();
+    QVERIFY(cache.acquire(QString())->isEmpty());
+    QCOMPARE(cache.size(), 0);
+}
+
+void TestSecretCache::invalidatesByOwner()
+{
+    SecretCache& cache = SecretCache::instance();
+    const QString userToken = encrypt("user-1-token");
+    cache.acquire(userToken, SecretCache::userOwner(1));
+    cache.acquire(encrypt("user-2-token"), SecretCache::userOwner(2));
+    cache.acquire(encrypt("client-1-password"), SecretCache::clientOwner(1));
+    QCOMPARE(cache.size(), 3);
+
+    cache.invalidateOwner(SecretCache::userOwner(1));
+    QCOMPARE(cache.size(), 2);
+    cache.invalidateOwner(QString()); // Без власника нічого не скидається
+    QCOMPARE(cache.size(), 2);
+
+    // Скинутий секрет розшифровується заново
+    QCOMPARE(cache.acquire(userToken, SecretCache::userOwner(1))->toString(), QString("user-1-token"));
+    QCOMPARE(cache.size(), 3);
+}
+
+void TestSecretCache::hitUpdatesOwner()
+{
+    SecretCache& cache = SecretCache::instance();
+    const QString ciphertext = encrypt("shared-password");
+    cache.acquire(ciphertext);
+    cache.acquire(ciphertext, SecretCache::clientOwner(5));
+
+    cache.invalidateOwner(SecretCache::clientOwner(5));
+    QCOMPARE(cache.size(), 0);
+}
+
+void TestSecretCache::invalidatesAllUsersButNotClients()
+{
+    SecretCache& cache = SecretCache::instance();
+    cache.acquire(encrypt("user-1-token"), SecretCache::userOwner(1));
+    cache.acquire(encrypt("user-2-token"), SecretCache::userOwner(2));
+    cache.acquire(encrypt("client-1-password"), SecretCache::clientOwner(1));
+
+    cache.invalidateUsers();
+    QCOMPARE(cache.size(), 1);
+    cache.invalidateOwner(SecretCache::clientOwner(1));
+    QCOMPARE(cache.size(), 0);
+}
+
+void TestSecretCache::evictsBeyondCapacity()
+{
+    SecretCache& cache = SecretCache::instance();
+    QStringList ciphertexts;
+    for (int i = 0; i < 5; ++i) {
+        ciphertexts << encrypt(QString("secret-%1").arg(i));
+        QCOMPARE(cache.acquire(ciphertexts.last())->toString(), QString("secret-%1").arg(i));
+        QVERIFY(cache.size() <= 3);
+    }
+    QCOMPARE(cache.size(), 3);
+
+    // Витіснений запис — лише промах, результат той самий
+    for (int i = 0; i < ciphertexts.size(); ++i) {
+        QCOMPARE(cache.acquire(ciphertexts.at(i))->toString(), QString("secret-%1").arg(i));
+    }
+}
+
+void TestSecretCache::secureBufferCopiesData()
+{
+    const SecureBuffer buffer(QByteArray("s3cr3t"));
+    QCOMPARE(buffer.size(), qsizetype(6));
+    QCOMPARE(QByteArray(buffer.data(), buffer.size()), QByteArray("s3cr3t"));
+
+    const SecureBuffer empty{QByteArray()};
+    QCOMPARE(empty.size(), qsizetype(0));
+    QVERIFY(empty.isEmpty());
+    QVERIFY(!empty.data());
+    QCOMPARE(empty.toByteArray("Bearer "), QByteArray("Bearer "));
+}
+
+void TestSecretCache::wipeZeroesMemory()
+{
+    char raw[] = "password";
+    SecureBuffer::wipe(raw, qsizetype(strlen(raw)));
+    for (char c : raw) QCOMPARE(c, '\0');
+
+    // Власний (не спільний) буфер QByteArray затирається і звільняється
+    QByteArray plain("password");
+    plain.detach();
+    SecureBuffer::wipe(plain);
+    QVERIFY(plain.isEmpty());
+}
+
+void TestSecretCache::wipeString()
+{
+    QString plain = QString::fromUtf8("пароль");
+    plain.detach();
+    SecureBuffer::wipe(plain);
+    QVERIFY(plain.isEmpty());
+
+    QString shared("password");
+    const QString copy = shared;
+    SecureBuffer::wipe(shared);
+    QVERIFY(shared.isEmpty());
+    QCOMPARE(copy, QString("password"));
+}
+
+void TestSecretCache::wipeLeavesSharedCopy()
+{
+    QByteArray plain("password");
+    const QByteArray copy = plain; // Спільний буфер
+
+    SecureBuffer::wipe(plain);
+    QVERIFY(plain.isEmpty());
+    QCOMPARE(copy, QByteArray("password"));
+}
+
+QTEST_GUILESS_MAIN(TestSecretCache)
+#include "tst_secretcache.moc"